@@ -32,7 +32,8 @@ extern "C" {
 
 /************************************************************************************************************
  * define QLIB_MAX_SPI_INPUT_SIZE to SPI input buffer limitation. If defined PLAT_SPI_WriteReadTransaction
- * will be invoked in chunks of that limit.
+ * will be invoked in chunks of that limit. The limit of standard reads can be changed at runtime using
+ * QLIB_SetReadChunkSize.
 ************************************************************************************************************/
 //example for 1024 bytes limit
 //#define QLIB_MAX_SPI_INPUT_SIZE 1024
@@ -58,6 +59,13 @@ extern "C" {
 //#define QLIB_HASH_OPTIMIZATION_ENABLED
 //#define QLIB_SPI_OPTIMIZATION_ENABLED
 
+/************************************************************************************************************
+ * Enable asynchronous (DMA) SPI read implementation if available. If defined, streamed reads submit the
+ * next chunk with PLAT_SPI_ReadAsync while the previous chunk is processed. The platform must implement
+ * PLAT_SPI_ReadAsync and PLAT_SPI_ReadAsync_WaitWhileBusy. Not supported with QLIB_SUPPORT_XIP
+************************************************************************************************************/
+//#define QLIB_SPI_ASYNC_READ_ENABLED
+
 /************************************************************************************************************
  * define SPI_INIT_ADDRESS_MODE_4_BYTES if the core operates in 4 bytes address mode on its initialization.
  * by default the flash powers up in 3 bytes address mode. If the user wants the flash to power up
@@ -316,6 +324,42 @@ void PLAT_SPI_MultiTransactionStop(void);
 
 #endif //QLIB_SPI_OPTIMIZATION_ENABLED
 
+#ifdef QLIB_SPI_ASYNC_READ_ENABLED
+
+/************************************************************************************************************
+ * @brief       This routine starts an asynchronous SPI write-read transaction (typically using DMA).
+ * The parameters are the same as in @ref PLAT_SPI_WriteReadTransaction. @p dataOutStream is valid only
+ * during the call, @p dataIn must not be accessed until @ref PLAT_SPI_ReadAsync_WaitWhileBusy returns.\n
+ * Only one asynchronous transaction is started at a time.
+ *
+ * @return
+ * QLIB_STATUS__OK = 0                      - no error occurred\n
+ * QLIB_STATUS__(ERROR)                     - Other error
+************************************************************************************************************/
+int PLAT_SPI_ReadAsync(const void*     userData,
+                       QLIB_BUS_MODE_T format,
+                       uint32_t        flags,
+                       const uint8_t*  dataOutStream,
+                       uint32_t        cmdSize,
+                       uint32_t        addressSize,
+                       uint32_t        dataOutSize,
+                       uint32_t        dummyCycles,
+                       uint8_t*        dataIn,
+                       uint32_t        dataInSize);
+
+/************************************************************************************************************
+ * @brief       This routine waits for the transaction started by @ref PLAT_SPI_ReadAsync to complete
+ *
+ * @param[in,out]   userData        User data which is set using @ref QLIB_SetUserData
+ *
+ * @return
+ * QLIB_STATUS__OK = 0                      - no error occurred\n
+ * QLIB_STATUS__(ERROR)                     - Other error
+************************************************************************************************************/
+int PLAT_SPI_ReadAsync_WaitWhileBusy(const void* userData);
+
+#endif //QLIB_SPI_ASYNC_READ_ENABLED
+
 #ifdef __cplusplus
 }
 #endif
@@ -18,6 +18,8 @@
 #include "qlib_server.h"
 #include "qlib_server_platform.h"
 #include "qlib_server_client_common.h"
+#include "qlib_server_client_codec.h"
+#include "qlib_utils_crc.h"
 
 /*---------------------------------------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------------------------------------*/
@@ -51,6 +53,22 @@ static QLIB_STATUS_T QLIB_SERVER_SendReceive_L(QLIB_SERVER_CLIENT_T*         cli
                                                QLIB_PACKET_STRUCT__HEADER_T* hdrIn,
                                                void*                         dataIn,
                                                U32                           dataInSize);
+static QLIB_STATUS_T QLIB_SERVER_SendPacket_L(QLIB_SERVER_CLIENT_T* client, QLIB_PACKET_STRUCT__HEADER_T* hdrOut, void* dataOut);
+static QLIB_STATUS_T QLIB_SERVER_LoadKeysToContext_L(QLIB_SERVER_CLIENT_T* client);
+static QLIB_STATUS_T QLIB_SERVER_GetPageCrc_L(QLIB_SERVER_CLIENT_T*       client,
+                                              U32                         sectionID,
+                                              U32                         offset,
+                                              U32                         size,
+                                              QLIB_PACKET_STRUCT__RESP_T* resp,
+                                              BOOL*                       crcValid);
+static BOOL          QLIB_SERVER_PageCrcMatch_L(const U8* data, U32 size, U32 crc);
+
+static QLIB_SERVER_DEVICE_CACHE_ENTRY_T* QLIB_SERVER_CacheFind_L(QLIB_SERVER_DEVICE_CACHE_T* cache, const void* wid);
+static BOOL QLIB_SERVER_CacheMatch_L(const QLIB_CONTEXT_T* cached, const QLIB_SYNC_OBJ_T* syncObject);
+static BOOL QLIB_SERVER_CacheRestore_L(QLIB_SERVER_CLIENT_T* client, const QLIB_SYNC_OBJ_T* syncObject);
+static void QLIB_SERVER_CacheStore_L(QLIB_SERVER_CLIENT_T* client, BOOL newEntry);
+static void QLIB_SERVER_InFlightLock_L(QLIB_SERVER_CLIENT_T* client, BOOL lock);
+static QLIB_STATUS_T QLIB_SERVER_Drain_L(QLIB_SERVER_CLIENT_T* client, U32 size);
 
 /*---------------------------------------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------------------------------------*/
@@ -67,6 +85,9 @@ static const QLIB_CLIENT_EVENT_T QLIB_SERVER_Events[QLIB__NUM_OF_PACKET_TYPES] =
     QLIB_SERVER_OnInvalidPacket_L, // QLIB_PACKET_TYPE__SEC_CMD         - We should never receive it on the server
     QLIB_SERVER_OnResponse_L,      // QLIB_PACKET_TYPE__CMD_RESP
     QLIB_SERVER_OnCustomCMD_L,     // QLIB_PACKET_TYPE__CUSTOM
+    QLIB_SERVER_OnInvalidPacket_L, // QLIB_PACKET_TYPE__WAIT_READY      - We should never receive it on the server
+    QLIB_SERVER_OnInvalidPacket_L, // QLIB_PACKET_TYPE__STD_CMD_RLE     - We should never receive it on the server
+    QLIB_SERVER_OnInvalidPacket_L, // QLIB_PACKET_TYPE__PAGE_CRC        - We should never receive it on the server
 };
 
 /*---------------------------------------------------------------------------------------------------------*/
@@ -86,7 +107,7 @@ QLIB_STATUS_T QLIB_TM_Connect(QLIB_CONTEXT_T* qlibContext)
     /*Build structures for communication                                                                   */
     /*-----------------------------------------------------------------------------------------------------*/
     QLIB_SERVER_CLIENT_T*        client      = (QLIB_SERVER_CLIENT_T*)QLIB_GetUserData(qlibContext);
-    QLIB_PACKET_STRUCT__HEADER_T connect_hdr = {QLIB_PACKET_TYPE__CONNECT, 0};
+    QLIB_PACKET_STRUCT__HEADER_T connect_hdr = {QLIB_PACKET_TYPE__CONNECT, 0, 0, 0};
     QLIB_PACKET_STRUCT__HEADER_T resp_hdr;
     QLIB_PACKET_STRUCT__RESP_T   resp;
 
@@ -114,7 +135,7 @@ QLIB_STATUS_T QLIB_TM_Disconnect(QLIB_CONTEXT_T* qlibContext)
     /*Build structures for communication                                                                   */
     /*-----------------------------------------------------------------------------------------------------*/
     QLIB_SERVER_CLIENT_T*        client      = (QLIB_SERVER_CLIENT_T*)QLIB_GetUserData(qlibContext);
-    QLIB_PACKET_STRUCT__HEADER_T connect_hdr = {QLIB_PACKET_TYPE__DISCONNECT, 0};
+    QLIB_PACKET_STRUCT__HEADER_T connect_hdr = {QLIB_PACKET_TYPE__DISCONNECT, 0, 0, 0};
     QLIB_PACKET_STRUCT__HEADER_T resp_hdr;
     QLIB_PACKET_STRUCT__RESP_T   resp;
 
@@ -155,12 +176,13 @@ QLIB_STATUS_T QLIB_TM_Standard(QLIB_CONTEXT_T*   qlibContext,
     QLIB_SERVER_CLIENT_T*               client       = (QLIB_SERVER_CLIENT_T*)QLIB_GetUserData(qlibContext);
     U16                                 std_cmd_size = (U16)(sizeof(QLIB_PACKET_STRUCT__STANDARD_CMD_T) + writeDataSize);
     U16                                 resp_size    = (U16)(sizeof(QLIB_PACKET_STRUCT__RESP_T) + readDataSize);
-    QLIB_PACKET_STRUCT__HEADER_T        std_hdr      = {QLIB_PACKET_TYPE__STD_CMD, 0};
+    QLIB_PACKET_STRUCT__HEADER_T        std_hdr      = {QLIB_PACKET_TYPE__STD_CMD, 0, 0, 0};
     QLIB_PACKET_STRUCT__STANDARD_CMD_T* std_cmd      = MALLOC(std_cmd_size);
     QLIB_PACKET_STRUCT__RESP_T*         resp         = MALLOC(resp_size);
     QLIB_PACKET_STRUCT__HEADER_T        resp_hdr;
-    QLIB_STATUS_T                       ret = QLIB_STATUS__SECURITY_ERR;
-    std_hdr.size                            = std_cmd_size;
+    QLIB_STATUS_T                       ret         = QLIB_STATUS__SECURITY_ERR;
+    U32                                 encodedSize = 0;
+    std_hdr.size                                    = std_cmd_size;
 
     /*-----------------------------------------------------------------------------------------------------*/
     /* Error checking                                                                                      */
@@ -180,7 +202,21 @@ QLIB_STATUS_T QLIB_TM_Standard(QLIB_CONTEXT_T*   qlibContext,
     std_cmd->writeDataSize   = writeDataSize;
     std_cmd->dummyCycles     = dummyCycles;
     std_cmd->readDataSize    = readDataSize;
-    memcpy(&std_cmd->writeData, writeData, writeDataSize);
+
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Encode write data if the client supports it and it is shorter (e.g. erased pattern padding)         */
+    /*-----------------------------------------------------------------------------------------------------*/
+    if (((client->capabilities & QLIB_PACKET_CAPS__STD_RLE) != 0u) && (writeDataSize >= QLIB_SERVER_RLE_MIN_SIZE) &&
+        (QLIB_CODEC_RleEncode(writeData, writeDataSize, (U8*)std_cmd->writeData, writeDataSize - 1u, &encodedSize) ==
+         QLIB_STATUS__OK))
+    {
+        std_hdr.type = QLIB_PACKET_TYPE__STD_CMD_RLE;
+        std_hdr.size = (U16)(sizeof(QLIB_PACKET_STRUCT__STANDARD_CMD_T) + encodedSize);
+    }
+    else
+    {
+        memcpy(&std_cmd->writeData, writeData, writeDataSize);
+    }
 
     /*-----------------------------------------------------------------------------------------------------*/
     /* Send 'std' command, and get 'response with data'                                                    */
@@ -228,7 +264,7 @@ QLIB_STATUS_T QLIB_TM_Secure(QLIB_CONTEXT_T* qlibContext,
     QLIB_SERVER_CLIENT_T*             client       = (QLIB_SERVER_CLIENT_T*)QLIB_GetUserData(qlibContext);
     U16                               sec_cmd_size = (U16)(sizeof(QLIB_PACKET_STRUCT__SECURE_CMD_T) + writeDataSize);
     U16                               resp_size    = (U16)(sizeof(QLIB_PACKET_STRUCT__RESP_T) + readDataSize);
-    QLIB_PACKET_STRUCT__HEADER_T      sec_hdr      = {QLIB_PACKET_TYPE__SEC_CMD, 0};
+    QLIB_PACKET_STRUCT__HEADER_T      sec_hdr      = {QLIB_PACKET_TYPE__SEC_CMD, 0, 0, 0};
     QLIB_PACKET_STRUCT__SECURE_CMD_T* sec_cmd      = MALLOC(sec_cmd_size);
     QLIB_PACKET_STRUCT__RESP_T*       resp         = MALLOC(resp_size);
     QLIB_PACKET_STRUCT__HEADER_T      resp_hdr;
@@ -281,6 +317,64 @@ exit:
     return ret;
 }
 
+QLIB_STATUS_T QLIB_TM_WaitReady(QLIB_CONTEXT_T*      qlibContext,
+                                QLIB_TM_WAIT_READY_T source,
+                                U32                  busyMask,
+                                U32                  maxPolls,
+                                U32*                 regValue,
+                                QLIB_REG_SSR_T*      ssr)
+{
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Build structures for communication                                                                  */
+    /*-----------------------------------------------------------------------------------------------------*/
+    QLIB_SERVER_CLIENT_T*                client   = (QLIB_SERVER_CLIENT_T*)QLIB_GetUserData(qlibContext);
+    QLIB_PACKET_STRUCT__HEADER_T         wait_hdr = {QLIB_PACKET_TYPE__WAIT_READY, 0, 0, 0};
+    QLIB_PACKET_STRUCT__WAIT_READY_CMD_T wait_cmd;
+    U32                                  resp_buf[(sizeof(QLIB_PACKET_STRUCT__RESP_T) / sizeof(U32)) + 1u];
+    QLIB_PACKET_STRUCT__RESP_T*          resp = (QLIB_PACKET_STRUCT__RESP_T*)resp_buf;
+    QLIB_PACKET_STRUCT__HEADER_T         resp_hdr;
+    wait_hdr.size                             = (U16)sizeof(QLIB_PACKET_STRUCT__WAIT_READY_CMD_T);
+
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Error checking                                                                                      */
+    /*-----------------------------------------------------------------------------------------------------*/
+    QLIB_ASSERT_RET((client->capabilities & QLIB_PACKET_CAPS__WAIT_READY) != 0u, QLIB_STATUS__NOT_SUPPORTED);
+    QLIB_ASSERT_RET(0u < maxPolls, QLIB_STATUS__INVALID_PARAMETER);
+
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Set command data                                                                                    */
+    /*-----------------------------------------------------------------------------------------------------*/
+    wait_cmd.source   = (U32)source;
+    wait_cmd.busyMask = busyMask;
+    wait_cmd.maxPolls = maxPolls;
+
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Send 'wait ready' command, the client polls locally and responds once                               */
+    /*-----------------------------------------------------------------------------------------------------*/
+    QLIB_STATUS_RET_CHECK(QLIB_SERVER_SendReceive_L(client, &wait_hdr, &wait_cmd, &resp_hdr, resp, sizeof(resp_buf)));
+
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Check response                                                                                      */
+    /*-----------------------------------------------------------------------------------------------------*/
+    QLIB_ASSERT_RET(resp_hdr.type == QLIB_PACKET_TYPE__CMD_RESP, QLIB_STATUS__COMMUNICATION_ERR);
+    QLIB_ASSERT_RET(resp_hdr.size == sizeof(resp_buf), QLIB_STATUS__COMMUNICATION_ERR);
+
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Extract response data                                                                               */
+    /*-----------------------------------------------------------------------------------------------------*/
+    if (ssr != NULL)
+    {
+        ssr->asUint = resp->ssr;
+    }
+
+    if (regValue != NULL)
+    {
+        *regValue = resp->data[0];
+    }
+
+    return (QLIB_STATUS_T)resp->status;
+}
+
 /*---------------------------------------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------------------------------------*/
 /*                                               Server API                                                */
@@ -297,12 +391,18 @@ QLIB_STATUS_T QLIB_SERVER_InitClient(QLIB_SERVER_CLIENT_T* client, void* socket,
     /*-----------------------------------------------------------------------------------------------------*/
     /*Set variables                                                                                        */
     /*-----------------------------------------------------------------------------------------------------*/
-    client->socket           = socket;
-    client->callbacks        = callbacks;
-    client->responseReady    = TRUE;
-    client->responseBuf      = NULL;
-    client->responseSize     = 0;
-    client->qlibContextReady = FALSE;
+    client->socket              = socket;
+    client->callbacks           = callbacks;
+    client->capabilities        = 0;
+    client->nextRequestId       = QLIB_PACKET_REQUEST_ID_NONE;
+    client->qlibContextReady    = FALSE;
+    client->deviceCache         = NULL;
+    client->inFlightLock        = NULL;
+    client->inFlightLockArg     = NULL;
+    client->registrationLock    = NULL;
+    client->registrationLockArg = NULL;
+    client->registering         = FALSE;
+    memset(client->inFlight, 0, sizeof(client->inFlight));
     memset(&client->qlibContext, 0, sizeof(QLIB_CONTEXT_T));
 
     return QLIB_STATUS__OK;
@@ -320,6 +420,7 @@ QLIB_STATUS_T QLIB_SERVER_HandlePacket(QLIB_SERVER_CLIENT_T* client)
     /*-----------------------------------------------------------------------------------------------------*/
     /* Process packet by type                                                                              */
     /*-----------------------------------------------------------------------------------------------------*/
+    QLIB_ASSERT_RET(hdr.version == QLIB_PACKET_HEADER_VERSION, QLIB_STATUS__COMMUNICATION_ERR);
     QLIB_ASSERT_RET(hdr.type < QLIB__NUM_OF_PACKET_TYPES, QLIB_STATUS__COMMUNICATION_ERR);
     QLIB_STATUS_RET_CHECK(QLIB_SERVER_Events[hdr.type](client, &hdr));
 
@@ -328,11 +429,417 @@ QLIB_STATUS_T QLIB_SERVER_HandlePacket(QLIB_SERVER_CLIENT_T* client)
 
 QLIB_STATUS_T QLIB_SERVER_SendCustomPacket(QLIB_SERVER_CLIENT_T* client, QLIB_PACKET_STRUCT__CUSTOM_T* packet, U16 packetSize)
 {
-    QLIB_PACKET_STRUCT__HEADER_T hdr = {QLIB_PACKET_TYPE__CUSTOM, 0};
+    QLIB_PACKET_STRUCT__HEADER_T hdr = {QLIB_PACKET_TYPE__CUSTOM, 0, 0, 0};
     hdr.size                         = packetSize;
+    hdr.requestId                    = QLIB_PACKET_REQUEST_ID_NONE;
+
+    QLIB_STATUS_RET_CHECK(QLIB_SERVER_SendPacket_L(client, &hdr, packet));
+
+    return QLIB_STATUS__OK;
+}
+
+QLIB_STATUS_T QLIB_SERVER_LoadKeys(QLIB_SERVER_CLIENT_T* client)
+{
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Error checking                                                                                      */
+    /*-----------------------------------------------------------------------------------------------------*/
+    QLIB_ASSERT_RET(client != NULL, QLIB_STATUS__INVALID_PARAMETER);
+
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Get keys, and refresh the cached keys and monotonic counter of this device                          */
+    /*-----------------------------------------------------------------------------------------------------*/
+    QLIB_STATUS_RET_CHECK(QLIB_SERVER_GetKeys(client->qlibContext.wid, client->fk, client->rk));
+    QLIB_SERVER_CacheStore_L(client, FALSE);
+
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Load keys                                                                                           */
+    /*-----------------------------------------------------------------------------------------------------*/
+    return QLIB_SERVER_LoadKeysToContext_L(client);
+}
+
+QLIB_STATUS_T QLIB_SERVER_InitDeviceCache(QLIB_SERVER_DEVICE_CACHE_T* cache, QLIB_SERVER_LOCK_CB lock, void* lockArg)
+{
+    QLIB_ASSERT_RET(cache != NULL, QLIB_STATUS__INVALID_PARAMETER);
 
-    QLIB_STATUS_RET_CHECK(QLIB_SERVER_Send(client->socket, &hdr, sizeof(QLIB_PACKET_STRUCT__HEADER_T)));
-    QLIB_STATUS_RET_CHECK(QLIB_SERVER_Send(client->socket, packet, packetSize));
+    memset(cache, 0, sizeof(QLIB_SERVER_DEVICE_CACHE_T));
+    cache->lock    = lock;
+    cache->lockArg = lockArg;
+
+    return QLIB_STATUS__OK;
+}
+
+QLIB_STATUS_T QLIB_SERVER_ClearDeviceCache(QLIB_SERVER_DEVICE_CACHE_T* cache)
+{
+    QLIB_ASSERT_RET(cache != NULL, QLIB_STATUS__INVALID_PARAMETER);
+
+    if (cache->lock != NULL)
+    {
+        cache->lock(cache->lockArg, TRUE);
+    }
+    memset(cache->entries, 0, sizeof(cache->entries));
+    if (cache->lock != NULL)
+    {
+        cache->lock(cache->lockArg, FALSE);
+    }
+
+    return QLIB_STATUS__OK;
+}
+
+QLIB_STATUS_T QLIB_SERVER_SetDeviceCache(QLIB_SERVER_CLIENT_T* client, QLIB_SERVER_DEVICE_CACHE_T* cache)
+{
+    QLIB_ASSERT_RET(client != NULL, QLIB_STATUS__INVALID_PARAMETER);
+
+    client->deviceCache = cache;
+
+    return QLIB_STATUS__OK;
+}
+
+QLIB_STATUS_T QLIB_SERVER_WriteDelta(QLIB_SERVER_CLIENT_T* client,
+                                     const U8*             buf,
+                                     U32                   sectionID,
+                                     U32                   offset,
+                                     U32                   size,
+                                     BOOL                  secure,
+                                     U32*                  pagesSkipped)
+{
+    QLIB_PACKET_STRUCT__RESP_T* resp       = NULL;
+    QLIB_STATUS_T               ret        = QLIB_STATUS__OK;
+    U32                         end        = offset + size;
+    U32                         chunkStart = offset;
+    U32                         chunkEnd   = 0;
+    U32                         pageStart  = 0;
+    U32                         pageEnd    = 0;
+    U32                         runStart   = offset;
+    U32                         page       = 0;
+    U32                         skipped    = 0;
+    BOOL                        crcValid   = FALSE;
+
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Error checking                                                                                      */
+    /*-----------------------------------------------------------------------------------------------------*/
+    QLIB_ASSERT_RET(client != NULL, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET(buf != NULL, QLIB_STATUS__INVALID_PARAMETER);
+
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Without client support all data is written                                                          */
+    /*-----------------------------------------------------------------------------------------------------*/
+    if ((client->capabilities & QLIB_PACKET_CAPS__PAGE_CRC) == 0u)
+    {
+        QLIB_STATUS_RET_CHECK_GOTO(QLIB_Write(&client->qlibContext, buf, sectionID, offset, size, secure), ret, exit);
+        goto exit;
+    }
+
+    resp = MALLOC(sizeof(QLIB_PACKET_STRUCT__RESP_T) + (QLIB_SERVER_DELTA_MAX_PAGES * sizeof(U32)));
+    QLIB_ASSERT_WITH_ERROR_GOTO(resp != NULL, QLIB_STATUS__OUT_OF_MEMORY, ret, exit);
+
+    while (chunkStart < end)
+    {
+        /*-------------------------------------------------------------------------------------------------*/
+        /* Get the CRC of the current content, up to QLIB_SERVER_DELTA_MAX_PAGES pages at a time.          */
+        /* If the client can not calculate it (e.g. no plain read access), the pages are written as is     */
+        /*-------------------------------------------------------------------------------------------------*/
+        chunkEnd = ROUND_DOWN(chunkStart, QLIB_SERVER_DELTA_PAGE_SIZE) + (QLIB_SERVER_DELTA_MAX_PAGES * QLIB_SERVER_DELTA_PAGE_SIZE);
+        chunkEnd = MIN(chunkEnd, end);
+        QLIB_STATUS_RET_CHECK_GOTO(QLIB_SERVER_GetPageCrc_L(client, sectionID, chunkStart, chunkEnd - chunkStart, resp, &crcValid),
+                                   ret,
+                                   exit);
+
+        /*-------------------------------------------------------------------------------------------------*/
+        /* Unchanged pages are skipped. Changed pages before them are written as a single run              */
+        /*-------------------------------------------------------------------------------------------------*/
+        for (page = 0, pageStart = chunkStart; (crcValid == TRUE) && (pageStart < chunkEnd); ++page, pageStart = pageEnd)
+        {
+            pageEnd = MIN(ROUND_DOWN(pageStart, QLIB_SERVER_DELTA_PAGE_SIZE) + QLIB_SERVER_DELTA_PAGE_SIZE, chunkEnd);
+
+            if (TRUE == QLIB_SERVER_PageCrcMatch_L(&buf[pageStart - offset], pageEnd - pageStart, resp->data[page]))
+            {
+                if (runStart < pageStart)
+                {
+                    QLIB_STATUS_RET_CHECK_GOTO(
+                        QLIB_Write(&client->qlibContext, &buf[runStart - offset], sectionID, runStart, pageStart - runStart, secure),
+                        ret,
+                        exit);
+                }
+                runStart = pageEnd;
+                skipped++;
+            }
+        }
+
+        chunkStart = chunkEnd;
+    }
+
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Write the last run of changed pages                                                                 */
+    /*-----------------------------------------------------------------------------------------------------*/
+    if (runStart < end)
+    {
+        QLIB_STATUS_RET_CHECK_GOTO(QLIB_Write(&client->qlibContext, &buf[runStart - offset], sectionID, runStart, end - runStart, secure),
+                                   ret,
+                                   exit);
+    }
+
+exit:
+    if (pagesSkipped != NULL)
+    {
+        *pagesSkipped = skipped;
+    }
+    FREE(resp);
+    return ret;
+}
+
+QLIB_STATUS_T QLIB_SERVER_EraseDelta(QLIB_SERVER_CLIENT_T* client,
+                                     U32                   sectionID,
+                                     U32                   offset,
+                                     U32                   size,
+                                     BOOL                  secure,
+                                     U32*                  sectorsSkipped)
+{
+    QLIB_PACKET_STRUCT__RESP_T* resp = NULL;
+    QLIB_STATUS_T               ret  = QLIB_STATUS__OK;
+    U32                         erasedPage[QLIB_SERVER_DELTA_PAGE_SIZE / sizeof(U32)];
+    U32                         erasedCrc  = 0;
+    U32                         end        = offset + size;
+    U32                         chunkStart = offset;
+    U32                         chunkEnd   = 0;
+    U32                         sector     = 0;
+    U32                         runStart   = offset;
+    U32                         page       = 0;
+    U32                         i          = 0;
+    U32                         skipped    = 0;
+    BOOL                        crcValid   = FALSE;
+    BOOL                        isErased   = FALSE;
+
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Error checking                                                                                      */
+    /*-----------------------------------------------------------------------------------------------------*/
+    QLIB_ASSERT_RET(client != NULL, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET((offset % FLASH_SECTOR_SIZE) == 0u, QLIB_STATUS__INVALID_DATA_ALIGNMENT);
+    QLIB_ASSERT_RET((size % FLASH_SECTOR_SIZE) == 0u, QLIB_STATUS__INVALID_DATA_SIZE);
+
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Without client support the whole range is erased                                                    */
+    /*-----------------------------------------------------------------------------------------------------*/
+    if ((client->capabilities & QLIB_PACKET_CAPS__PAGE_CRC) == 0u)
+    {
+        QLIB_STATUS_RET_CHECK_GOTO(QLIB_Erase(&client->qlibContext, sectionID, offset, size, secure), ret, exit);
+        goto exit;
+    }
+
+    (void)memset(erasedPage, 0xFF, sizeof(erasedPage));
+    QLIB_STATUS_RET_CHECK_GOTO(QLIB_UTILS_CalcCRCProgressive(erasedPage, sizeof(erasedPage), &erasedCrc), ret, exit);
+
+    resp = MALLOC(sizeof(QLIB_PACKET_STRUCT__RESP_T) + (QLIB_SERVER_DELTA_MAX_PAGES * sizeof(U32)));
+    QLIB_ASSERT_WITH_ERROR_GOTO(resp != NULL, QLIB_STATUS__OUT_OF_MEMORY, ret, exit);
+
+    while (chunkStart < end)
+    {
+        /*-------------------------------------------------------------------------------------------------*/
+        /* Get the CRC of the current content, whole sectors of up to QLIB_SERVER_DELTA_MAX_PAGES pages at */
+        /* a time. If the client can not calculate it (e.g. no plain read access), the sectors are erased  */
+        /*-------------------------------------------------------------------------------------------------*/
+        chunkEnd = MIN(chunkStart + ROUND_DOWN(QLIB_SERVER_DELTA_MAX_PAGES * QLIB_SERVER_DELTA_PAGE_SIZE, FLASH_SECTOR_SIZE), end);
+        QLIB_STATUS_RET_CHECK_GOTO(QLIB_SERVER_GetPageCrc_L(client, sectionID, chunkStart, chunkEnd - chunkStart, resp, &crcValid),
+                                   ret,
+                                   exit);
+
+        /*-------------------------------------------------------------------------------------------------*/
+        /* Erased sectors are skipped. Sectors with data before them are erased as a single run            */
+        /*-------------------------------------------------------------------------------------------------*/
+        for (page = 0, sector = chunkStart; (crcValid == TRUE) && (sector < chunkEnd); sector += FLASH_SECTOR_SIZE)
+        {
+            isErased = TRUE;
+            for (i = 0; i < (FLASH_SECTOR_SIZE / QLIB_SERVER_DELTA_PAGE_SIZE); ++i, ++page)
+            {
+                if (resp->data[page] != erasedCrc)
+                {
+                    isErased = FALSE;
+                }
+            }
+
+            if (TRUE == isErased)
+            {
+                if (runStart < sector)
+                {
+                    QLIB_STATUS_RET_CHECK_GOTO(QLIB_Erase(&client->qlibContext, sectionID, runStart, sector - runStart, secure),
+                                               ret,
+                                               exit);
+                }
+                runStart = sector + FLASH_SECTOR_SIZE;
+                skipped++;
+            }
+        }
+
+        chunkStart = chunkEnd;
+    }
+
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Erase the last run of sectors                                                                       */
+    /*-----------------------------------------------------------------------------------------------------*/
+    if (runStart < end)
+    {
+        QLIB_STATUS_RET_CHECK_GOTO(QLIB_Erase(&client->qlibContext, sectionID, runStart, end - runStart, secure), ret, exit);
+    }
+
+exit:
+    if (sectorsSkipped != NULL)
+    {
+        *sectorsSkipped = skipped;
+    }
+    FREE(resp);
+    return ret;
+}
+
+QLIB_STATUS_T QLIB_SERVER_SubmitRequest(QLIB_SERVER_CLIENT_T*         client,
+                                        QLIB_PACKET_STRUCT__HEADER_T* hdrOut,
+                                        void*                         dataOut,
+                                        void*                         dataIn,
+                                        U32                           dataInSize,
+                                        U32*                          slot)
+{
+    U32                     i;
+    QLIB_SERVER_INFLIGHT_T* req = NULL;
+    QLIB_STATUS_T           ret = QLIB_STATUS__OK;
+
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Error checking                                                                                      */
+    /*-----------------------------------------------------------------------------------------------------*/
+    QLIB_ASSERT_RET(client != NULL, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET(hdrOut != NULL, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET((dataIn != NULL) && (dataInSize != 0), QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET(slot != NULL, QLIB_STATUS__INVALID_PARAMETER);
+
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Find a free in-flight slot                                                                          */
+    /*-----------------------------------------------------------------------------------------------------*/
+    QLIB_SERVER_InFlightLock_L(client, TRUE);
+    if (client->registering == TRUE)
+    {
+        QLIB_SERVER_InFlightLock_L(client, FALSE);
+        return QLIB_STATUS__COMMUNICATION_ERR;
+    }
+    for (i = 0; i < QLIB_SERVER_MAX_INFLIGHT_REQUESTS; ++i)
+    {
+        if (client->inFlight[i].inUse == FALSE)
+        {
+            req = &client->inFlight[i];
+            break;
+        }
+    }
+    if (req == NULL)
+    {
+        QLIB_SERVER_InFlightLock_L(client, FALSE);
+        return QLIB_STATUS__DEVICE_BUSY;
+    }
+
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Allocate request ID. QLIB_PACKET_REQUEST_ID_NONE is reserved for non-transaction packets            */
+    /*-----------------------------------------------------------------------------------------------------*/
+    client->nextRequestId++;
+    if (client->nextRequestId == QLIB_PACKET_REQUEST_ID_NONE)
+    {
+        client->nextRequestId++;
+    }
+    hdrOut->requestId = client->nextRequestId;
+
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Register buffer for response read. Must be done before sending, response may arrive immediately     */
+    /*-----------------------------------------------------------------------------------------------------*/
+    req->requestId     = hdrOut->requestId;
+    req->responseBuf   = dataIn;
+    req->responseSize  = dataInSize;
+    req->responseReady = FALSE;
+    req->inUse         = TRUE;
+    QLIB_SERVER_InFlightLock_L(client, FALSE);
+
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Send the request                                                                                    */
+    /*-----------------------------------------------------------------------------------------------------*/
+    ret = QLIB_SERVER_SendPacket_L(client, hdrOut, dataOut);
+    if (ret != QLIB_STATUS__OK)
+    {
+        QLIB_SERVER_InFlightLock_L(client, TRUE);
+        req->inUse = FALSE;
+        QLIB_SERVER_InFlightLock_L(client, FALSE);
+        return ret;
+    }
+
+    *slot = i;
+
+    return QLIB_STATUS__OK;
+}
+
+QLIB_STATUS_T QLIB_SERVER_WaitResponse(QLIB_SERVER_CLIENT_T* client, U32 slot, QLIB_PACKET_STRUCT__HEADER_T* hdrIn)
+{
+    U64                     timeout = 0;
+    void*                   timer   = NULL;
+    QLIB_SERVER_INFLIGHT_T* req     = NULL;
+    QLIB_STATUS_T           ret     = QLIB_STATUS__OK;
+    BOOL                    ready   = FALSE;
+    BOOL                    aborted = FALSE;
+
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Error checking                                                                                      */
+    /*-----------------------------------------------------------------------------------------------------*/
+    QLIB_ASSERT_RET(client != NULL, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET(slot < QLIB_SERVER_MAX_INFLIGHT_REQUESTS, QLIB_STATUS__INVALID_PARAMETER);
+    req = &client->inFlight[slot];
+    QLIB_ASSERT_RET(req->inUse == TRUE, QLIB_STATUS__INVALID_PARAMETER);
+
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Wait for response with timeout. A device that registers again will not respond, so the wait is      */
+    /* aborted                                                                                             */
+    /*-----------------------------------------------------------------------------------------------------*/
+    QLIB_STATUS_RET_CHECK_GOTO(QLIB_SERVER_TimerStart(&timer), ret, exit);
+    while ((ready == FALSE) && (aborted == FALSE) && (timeout < QLIB_SERVER_CLIENT_TIMEOUT))
+    {
+        QLIB_SERVER_InFlightLock_L(client, TRUE);
+        ready   = req->responseReady;
+        aborted = client->registering;
+        QLIB_SERVER_InFlightLock_L(client, FALSE);
+        QLIB_STATUS_RET_CHECK_GOTO(QLIB_SERVER_TimerGetMS(timer, &timeout), ret, exit);
+    }
+    QLIB_STATUS_RET_CHECK_GOTO(QLIB_SERVER_TimerStop(timer), ret, exit);
+
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Check if the wait was aborted or timeout occurred                                                   */
+    /*-----------------------------------------------------------------------------------------------------*/
+    QLIB_ASSERT_WITH_ERROR_GOTO((ready == TRUE) || (aborted == FALSE), QLIB_STATUS__COMMUNICATION_ERR, ret, exit);
+    QLIB_ASSERT_WITH_ERROR_GOTO(ready == TRUE, QLIB_STATUS__COMMAND_FAIL, ret, exit);
+
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Data output is ready                                                                                */
+    /*-----------------------------------------------------------------------------------------------------*/
+    if (hdrIn != NULL)
+    {
+        memcpy(hdrIn, &req->hdrIn, sizeof(QLIB_PACKET_STRUCT__HEADER_T));
+    }
+
+exit:
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Release the slot. A late response to a timed-out request is dropped as unknown                      */
+    /*-----------------------------------------------------------------------------------------------------*/
+    QLIB_SERVER_InFlightLock_L(client, TRUE);
+    req->inUse = FALSE;
+    QLIB_SERVER_InFlightLock_L(client, FALSE);
+    return ret;
+}
+
+QLIB_STATUS_T QLIB_SERVER_SetInFlightLock(QLIB_SERVER_CLIENT_T* client, QLIB_SERVER_LOCK_CB lock, void* lockArg)
+{
+    QLIB_ASSERT_RET(client != NULL, QLIB_STATUS__INVALID_PARAMETER);
+
+    client->inFlightLock    = lock;
+    client->inFlightLockArg = lockArg;
+
+    return QLIB_STATUS__OK;
+}
+
+QLIB_STATUS_T QLIB_SERVER_SetRegistrationLock(QLIB_SERVER_CLIENT_T* client, QLIB_SERVER_LOCK_CB lock, void* lockArg)
+{
+    QLIB_ASSERT_RET(client != NULL, QLIB_STATUS__INVALID_PARAMETER);
+
+    client->registrationLock    = lock;
+    client->registrationLockArg = lockArg;
 
     return QLIB_STATUS__OK;
 }
@@ -346,8 +853,6 @@ QLIB_STATUS_T QLIB_SERVER_SendCustomPacket(QLIB_SERVER_CLIENT_T* client, QLIB_PA
 static QLIB_STATUS_T QLIB_SERVER_ClientRegistration_L(QLIB_SERVER_CLIENT_T* client, QLIB_PACKET_STRUCT__REGISTER_T* regPacket)
 {
     QLIB_STATUS_T ret = QLIB_STATUS__SECURITY_ERR;
-    U32           i;
-    QLIB_WID_T    wid;
 
     /*-----------------------------------------------------------------------------------------------------*/
     /*Set comm object into QLIB context                                                                    */
@@ -360,32 +865,24 @@ static QLIB_STATUS_T QLIB_SERVER_ClientRegistration_L(QLIB_SERVER_CLIENT_T* clie
     QLIB_ASSERT_RET(client != NULL, QLIB_STATUS__INVALID_PARAMETER);
     QLIB_ASSERT_RET(regPacket != NULL, QLIB_STATUS__INVALID_PARAMETER);
 
-    /*-----------------------------------------------------------------------------------------------------*/
-    /*Get keys                                                                                             */
-    /*-----------------------------------------------------------------------------------------------------*/
-    memcpy((void*)wid, (const void*)regPacket->syncObject.wid, sizeof(QLIB_WID_T));
-    QLIB_STATUS_RET_CHECK_GOTO(QLIB_SERVER_GetKeys(wid, client->fk, client->rk), ret, exit);
+    client->capabilities = regPacket->capabilities;
 
     /*-----------------------------------------------------------------------------------------------------*/
-    /*Initialize local QLIB                                                                                */
+    /*Initialize local QLIB and get keys. A device that registers again with unchanged layout gets its     */
+    /*context and keys from the cache                                                                      */
     /*-----------------------------------------------------------------------------------------------------*/
-    QLIB_STATUS_RET_CHECK_GOTO(QLIB_InitLib(&client->qlibContext), ret, exit);
-    QLIB_STATUS_RET_CHECK_GOTO(QLIB_ImportState(&client->qlibContext, &regPacket->syncObject), ret, exit);
+    if (FALSE == QLIB_SERVER_CacheRestore_L(client, &regPacket->syncObject))
+    {
+        QLIB_STATUS_RET_CHECK_GOTO(QLIB_InitLib(&client->qlibContext), ret, exit);
+        QLIB_STATUS_RET_CHECK_GOTO(QLIB_ImportState(&client->qlibContext, &regPacket->syncObject), ret, exit);
+        QLIB_STATUS_RET_CHECK_GOTO(QLIB_SERVER_GetKeys(client->qlibContext.wid, client->fk, client->rk), ret, exit);
+        QLIB_SERVER_CacheStore_L(client, TRUE);
+    }
 
     /*-----------------------------------------------------------------------------------------------------*/
     /*Load keys                                                                                            */
     /*-----------------------------------------------------------------------------------------------------*/
-    for (i = 0; i < QLIB_NUM_OF_SECTIONS; ++i)
-    {
-        if ((client->fk[i] != NULL) && (QLIB_KEY_MNGR__IS_KEY_VALID(client->fk[i])))
-        {
-            QLIB_STATUS_RET_CHECK_GOTO(QLIB_LoadKey(&client->qlibContext, i, client->fk[i], TRUE), ret, exit);
-        }
-        if ((client->rk[i] != NULL) && (QLIB_KEY_MNGR__IS_KEY_VALID(client->rk[i])))
-        {
-            QLIB_STATUS_RET_CHECK_GOTO(QLIB_LoadKey(&client->qlibContext, i, client->rk[i], FALSE), ret, exit);
-        }
-    }
+    QLIB_STATUS_RET_CHECK_GOTO(QLIB_SERVER_LoadKeysToContext_L(client), ret, exit);
 
     /*-----------------------------------------------------------------------------------------------------*/
     /* Mark qlibContext is ready                                                                           */
@@ -408,19 +905,17 @@ static QLIB_STATUS_T QLIB_SERVER_SendReceive_L(QLIB_SERVER_CLIENT_T*         cli
                                                void*                         dataIn,
                                                U32                           dataInSize)
 {
-    U64   timeout = 0;
-    void* timer   = NULL;
+    U32 slot = 0;
 
-    /*-----------------------------------------------------------------------------------------------------*/
-    /* Register buffer for response read                                                                   */
-    /*-----------------------------------------------------------------------------------------------------*/
-    if ((dataIn != NULL) && (dataInSize != 0))
-    {
-        client->responseBuf   = dataIn;
-        client->responseSize  = dataInSize;
-        client->responseReady = FALSE;
-        client->hdr_in        = hdrIn;
-    }
+    QLIB_STATUS_RET_CHECK(QLIB_SERVER_SubmitRequest(client, hdrOut, dataOut, dataIn, dataInSize, &slot));
+    QLIB_STATUS_RET_CHECK(QLIB_SERVER_WaitResponse(client, slot, hdrIn));
+
+    return QLIB_STATUS__OK;
+}
+
+static QLIB_STATUS_T QLIB_SERVER_SendPacket_L(QLIB_SERVER_CLIENT_T* client, QLIB_PACKET_STRUCT__HEADER_T* hdrOut, void* dataOut)
+{
+    hdrOut->version = QLIB_PACKET_HEADER_VERSION;
 
     /*-----------------------------------------------------------------------------------------------------*/
     /* Send header                                                                                         */
@@ -435,27 +930,6 @@ static QLIB_STATUS_T QLIB_SERVER_SendReceive_L(QLIB_SERVER_CLIENT_T*         cli
         QLIB_STATUS_RET_CHECK(QLIB_SERVER_Send(client->socket, dataOut, hdrOut->size));
     }
 
-    /*-----------------------------------------------------------------------------------------------------*/
-    /* Wait for response with timeout                                                                      */
-    /*-----------------------------------------------------------------------------------------------------*/
-    QLIB_STATUS_RET_CHECK(QLIB_SERVER_TimerStart(&timer));
-    while ((client->responseReady == FALSE) && (timeout < QLIB_SERVER_CLIENT_TIMEOUT))
-    {
-        QLIB_STATUS_RET_CHECK(QLIB_SERVER_TimerGetMS(timer, &timeout));
-    }
-    QLIB_STATUS_RET_CHECK(QLIB_SERVER_TimerStop(timer));
-
-    /*-----------------------------------------------------------------------------------------------------*/
-    /* Check if timeout occurred                                                                           */
-    /*-----------------------------------------------------------------------------------------------------*/
-    if (timeout >= QLIB_SERVER_CLIENT_TIMEOUT)
-    {
-        return QLIB_STATUS__COMMAND_FAIL;
-    }
-
-    /*-----------------------------------------------------------------------------------------------------*/
-    /* Data output is ready                                                                                */
-    /*-----------------------------------------------------------------------------------------------------*/
     return QLIB_STATUS__OK;
 }
 
@@ -480,51 +954,105 @@ static QLIB_STATUS_T QLIB_SERVER_OnInvalidPacket_L(QLIB_SERVER_CLIENT_T* client,
 static QLIB_STATUS_T QLIB_SERVER_OnRegistration_L(QLIB_SERVER_CLIENT_T* client, QLIB_PACKET_STRUCT__HEADER_T* hdr_in)
 {
     QLIB_PACKET_STRUCT__REGISTER_T regPacket;
-    QLIB_PACKET_STRUCT__HEADER_T   hdrResp = {QLIB_PACKET_TYPE__REGISTER_RESP, 0};
+    QLIB_PACKET_STRUCT__HEADER_T   hdrResp = {QLIB_PACKET_TYPE__REGISTER_RESP, 0, 0, 0};
+    QLIB_STATUS_T                  ret     = QLIB_STATUS__OK;
     QLIB_ASSERT_RET(hdr_in->size == sizeof(QLIB_PACKET_STRUCT__REGISTER_T), QLIB_STATUS__COMMUNICATION_ERR);
+    hdrResp.requestId = hdr_in->requestId;
 
     /*-----------------------------------------------------------------------------------------------------*/
     /* Get registration packet                                                                             */
     /*-----------------------------------------------------------------------------------------------------*/
     QLIB_STATUS_RET_CHECK(QLIB_SERVER_Receive(client->socket, &regPacket, hdr_in->size, TRUE));
 
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Abort the outstanding requests, so a thread that holds the registration lock while it waits for     */
+    /* responses releases it                                                                               */
+    /*-----------------------------------------------------------------------------------------------------*/
+    QLIB_SERVER_InFlightLock_L(client, TRUE);
+    client->registering = TRUE;
+    QLIB_SERVER_InFlightLock_L(client, FALSE);
+
     /*-----------------------------------------------------------------------------------------------------*/
     /* Perform registration                                                                                */
     /*-----------------------------------------------------------------------------------------------------*/
-    QLIB_STATUS_RET_CHECK(QLIB_SERVER_ClientRegistration_L(client, &regPacket));
+    if (client->registrationLock != NULL)
+    {
+        client->registrationLock(client->registrationLockArg, TRUE);
+    }
+
+    ret = QLIB_SERVER_ClientRegistration_L(client, &regPacket);
 
     /*-----------------------------------------------------------------------------------------------------*/
     /* Call callback                                                                                       */
     /*-----------------------------------------------------------------------------------------------------*/
-    if (client->callbacks)
+    if ((ret == QLIB_STATUS__OK) && (client->callbacks != NULL) && (client->callbacks->onRegistration != NULL))
     {
-        if (client->callbacks->onRegistration)
-        {
-            QLIB_STATUS_RET_CHECK(client->callbacks->onRegistration(client));
-        }
+        ret = client->callbacks->onRegistration(client);
+    }
+
+    QLIB_SERVER_InFlightLock_L(client, TRUE);
+    client->registering = FALSE;
+    QLIB_SERVER_InFlightLock_L(client, FALSE);
+
+    if (client->registrationLock != NULL)
+    {
+        client->registrationLock(client->registrationLockArg, FALSE);
     }
+    QLIB_STATUS_RET_CHECK(ret);
 
     /*-----------------------------------------------------------------------------------------------------*/
     /* Send registration response                                                                          */
     /*-----------------------------------------------------------------------------------------------------*/
-    QLIB_STATUS_RET_CHECK(QLIB_SERVER_Send(client->socket, &hdrResp, sizeof(QLIB_PACKET_STRUCT__HEADER_T)));
+    QLIB_STATUS_RET_CHECK(QLIB_SERVER_SendPacket_L(client, &hdrResp, NULL));
 
     return QLIB_STATUS__OK;
 }
 
 static QLIB_STATUS_T QLIB_SERVER_OnResponse_L(QLIB_SERVER_CLIENT_T* client, QLIB_PACKET_STRUCT__HEADER_T* hdr_in)
 {
-    QLIB_ASSERT_RET(client->responseReady == FALSE, QLIB_STATUS__COMMUNICATION_ERR);
-    QLIB_ASSERT_RET(client->responseBuf != NULL, QLIB_STATUS__COMMUNICATION_ERR);
-    QLIB_ASSERT_RET(client->responseSize == hdr_in->size, QLIB_STATUS__COMMUNICATION_ERR);
-    QLIB_ASSERT_RET(client->hdr_in != NULL, QLIB_STATUS__COMMUNICATION_ERR);
+    U32                     i;
+    QLIB_SERVER_INFLIGHT_T* req = NULL;
+    QLIB_STATUS_T           ret = QLIB_STATUS__OK;
 
-    QLIB_STATUS_RET_CHECK(QLIB_SERVER_Receive(client->socket, client->responseBuf, hdr_in->size, TRUE));
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Match the response to its outstanding request. The slot stays locked till the data is received      */
+    /*-----------------------------------------------------------------------------------------------------*/
+    QLIB_SERVER_InFlightLock_L(client, TRUE);
+    for (i = 0; i < QLIB_SERVER_MAX_INFLIGHT_REQUESTS; ++i)
+    {
+        if ((client->inFlight[i].inUse == TRUE) && (client->inFlight[i].responseReady == FALSE) &&
+            (client->inFlight[i].requestId == hdr_in->requestId))
+        {
+            req = &client->inFlight[i];
+            break;
+        }
+    }
 
-    memcpy(client->hdr_in, hdr_in, sizeof(QLIB_PACKET_STRUCT__HEADER_T));
-    client->responseReady = TRUE;
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Late response to a timed-out request. Drop its data so the next packet is read from its start       */
+    /*-----------------------------------------------------------------------------------------------------*/
+    if (req == NULL)
+    {
+        QLIB_SERVER_InFlightLock_L(client, FALSE);
+        return QLIB_SERVER_Drain_L(client, hdr_in->size);
+    }
 
-    return QLIB_STATUS__OK;
+    if ((req->responseBuf == NULL) || (req->responseSize != hdr_in->size))
+    {
+        QLIB_SERVER_InFlightLock_L(client, FALSE);
+        (void)QLIB_SERVER_Drain_L(client, hdr_in->size);
+        return QLIB_STATUS__COMMUNICATION_ERR;
+    }
+
+    ret = QLIB_SERVER_Receive(client->socket, req->responseBuf, hdr_in->size, TRUE);
+    if (ret == QLIB_STATUS__OK)
+    {
+        memcpy(&req->hdrIn, hdr_in, sizeof(QLIB_PACKET_STRUCT__HEADER_T));
+        req->responseReady = TRUE;
+    }
+    QLIB_SERVER_InFlightLock_L(client, FALSE);
+
+    return ret;
 }
 
 static QLIB_STATUS_T QLIB_SERVER_OnCustomCMD_L(QLIB_SERVER_CLIENT_T* client, QLIB_PACKET_STRUCT__HEADER_T* hdr_in)
@@ -540,4 +1068,296 @@ static QLIB_STATUS_T QLIB_SERVER_OnCustomCMD_L(QLIB_SERVER_CLIENT_T* client, QLI
     return QLIB_STATUS__OK;
 }
 
+static QLIB_STATUS_T QLIB_SERVER_GetPageCrc_L(QLIB_SERVER_CLIENT_T*       client,
+                                              U32                         sectionID,
+                                              U32                         offset,
+                                              U32                         size,
+                                              QLIB_PACKET_STRUCT__RESP_T* resp,
+                                              BOOL*                       crcValid)
+{
+    QLIB_PACKET_STRUCT__HEADER_T       crc_hdr  = {QLIB_PACKET_TYPE__PAGE_CRC, 0, 0, 0};
+    QLIB_PACKET_STRUCT__PAGE_CRC_CMD_T crc_cmd;
+    QLIB_PACKET_STRUCT__HEADER_T       resp_hdr;
+    U32                                numPages = 0;
+    U16                                resp_size;
+    crc_hdr.size                                = (U16)sizeof(QLIB_PACKET_STRUCT__PAGE_CRC_CMD_T);
+
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Set command data                                                                                    */
+    /*-----------------------------------------------------------------------------------------------------*/
+    numPages = ((ROUND_DOWN(offset + size - 1u, QLIB_SERVER_DELTA_PAGE_SIZE) - ROUND_DOWN(offset, QLIB_SERVER_DELTA_PAGE_SIZE)) /
+                QLIB_SERVER_DELTA_PAGE_SIZE) +
+               1u;
+    QLIB_ASSERT_RET(numPages <= QLIB_SERVER_DELTA_MAX_PAGES, QLIB_STATUS__INVALID_DATA_SIZE);
+    resp_size = (U16)(sizeof(QLIB_PACKET_STRUCT__RESP_T) + (numPages * sizeof(U32)));
+
+    crc_cmd.sectionID = sectionID;
+    crc_cmd.offset    = offset;
+    crc_cmd.size      = size;
+    crc_cmd.pageSize  = QLIB_SERVER_DELTA_PAGE_SIZE;
+
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Send 'page CRC' command, and get the CRC of every page                                              */
+    /*-----------------------------------------------------------------------------------------------------*/
+    QLIB_STATUS_RET_CHECK(QLIB_SERVER_SendReceive_L(client, &crc_hdr, &crc_cmd, &resp_hdr, resp, resp_size));
+
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Check response                                                                                      */
+    /*-----------------------------------------------------------------------------------------------------*/
+    QLIB_ASSERT_RET(resp_hdr.type == QLIB_PACKET_TYPE__CMD_RESP, QLIB_STATUS__COMMUNICATION_ERR);
+    QLIB_ASSERT_RET(resp_hdr.size == resp_size, QLIB_STATUS__COMMUNICATION_ERR);
+
+    *crcValid = ((QLIB_STATUS_T)resp->status == QLIB_STATUS__OK) ? TRUE : FALSE;
+
+    return QLIB_STATUS__OK;
+}
+
+static BOOL QLIB_SERVER_PageCrcMatch_L(const U8* data, U32 size, U32 crc)
+{
+    U32 page[QLIB_SERVER_DELTA_PAGE_SIZE / sizeof(U32)];
+    U32 dataCrc = 0;
+
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* The CRC is calculated on 32-bit words, a chunk of another size is treated as changed                */
+    /*-----------------------------------------------------------------------------------------------------*/
+    if ((size % sizeof(U32)) != 0u)
+    {
+        return FALSE;
+    }
+
+    (void)memcpy(page, data, size);
+    if (QLIB_STATUS__OK != QLIB_UTILS_CalcCRCProgressive(page, size, &dataCrc))
+    {
+        return FALSE;
+    }
+
+    return (dataCrc == crc) ? TRUE : FALSE;
+}
+
+static QLIB_STATUS_T QLIB_SERVER_LoadKeysToContext_L(QLIB_SERVER_CLIENT_T* client)
+{
+    U32 i;
+
+    for (i = 0; i < QLIB_NUM_OF_SECTIONS; ++i)
+    {
+        if ((client->fk[i] != NULL) && (QLIB_KEY_MNGR__IS_KEY_VALID(client->fk[i])))
+        {
+            QLIB_STATUS_RET_CHECK(QLIB_LoadKey(&client->qlibContext, i, client->fk[i], TRUE));
+        }
+        if ((client->rk[i] != NULL) && (QLIB_KEY_MNGR__IS_KEY_VALID(client->rk[i])))
+        {
+            QLIB_STATUS_RET_CHECK(QLIB_LoadKey(&client->qlibContext, i, client->rk[i], FALSE));
+        }
+    }
+
+    return QLIB_STATUS__OK;
+}
+
+static QLIB_SERVER_DEVICE_CACHE_ENTRY_T* QLIB_SERVER_CacheFind_L(QLIB_SERVER_DEVICE_CACHE_T* cache, const void* wid)
+{
+    U32 i;
+
+    for (i = 0; i < QLIB_SERVER_DEVICE_CACHE_SIZE; ++i)
+    {
+        if ((TRUE == cache->entries[i].valid) && (0 == memcmp(cache->entries[i].qlibContext.wid, wid, sizeof(QLIB_WID_T))))
+        {
+            return &cache->entries[i];
+        }
+    }
+
+    return NULL;
+}
+
+static BOOL QLIB_SERVER_CacheMatch_L(const QLIB_CONTEXT_T* cached, const QLIB_SYNC_OBJ_T* syncObject)
+{
+    U32 die;
+    U32 section;
+
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Bus interface and address mode                                                                      */
+    /*-----------------------------------------------------------------------------------------------------*/
+    if ((0 != memcmp(&cached->busInterface, &syncObject->busInterface, sizeof(QLIB_INTERFACE_T))) ||
+        (cached->addrSize != syncObject->addrSize) || (cached->addrMode != syncObject->addrMode) ||
+        (cached->fastReadDummy != syncObject->fastReadDummy))
+    {
+        return FALSE;
+    }
+
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Section layout. The plain access state changes with sessions and is taken from the device           */
+    /*-----------------------------------------------------------------------------------------------------*/
+    for (die = 0; die < QLIB_NUM_OF_DIES; die++)
+    {
+        if (cached->dieState[die].vaultSize != syncObject->vaultSize[die])
+        {
+            return FALSE;
+        }
+        for (section = 0; section < QLIB_NUM_OF_MAIN_SECTIONS; section++)
+        {
+            if ((cached->dieState[die].sectionsState[section].sizeTag != syncObject->sectionsState[die][section].sizeTag) ||
+                (cached->dieState[die].sectionsState[section].scale != syncObject->sectionsState[die][section].scale) ||
+                (cached->dieState[die].sectionsState[section].enabled != syncObject->sectionsState[die][section].enabled))
+            {
+                return FALSE;
+            }
+        }
+    }
+
+    return TRUE;
+}
+
+static BOOL QLIB_SERVER_CacheRestore_L(QLIB_SERVER_CLIENT_T* client, const QLIB_SYNC_OBJ_T* syncObject)
+{
+    QLIB_SERVER_DEVICE_CACHE_T*       cache = client->deviceCache;
+    QLIB_SERVER_DEVICE_CACHE_ENTRY_T* entry;
+    BOOL                              hit = FALSE;
+    U32                               die;
+
+    if (cache == NULL)
+    {
+        return FALSE;
+    }
+
+    if (cache->lock != NULL)
+    {
+        cache->lock(cache->lockArg, TRUE);
+    }
+
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* The entry is valid if the section layout, address mode and bus interface are unchanged. Any         */
+    /* reconfiguration or different bus setup falls back to a full registration                            */
+    /*-----------------------------------------------------------------------------------------------------*/
+    entry = QLIB_SERVER_CacheFind_L(cache, (const void*)syncObject->wid);
+    if ((entry != NULL) && (TRUE == QLIB_SERVER_CacheMatch_L(&entry->qlibContext, syncObject)))
+    {
+        memcpy(&client->qlibContext, &entry->qlibContext, sizeof(QLIB_CONTEXT_T));
+        QLIB_SetUserData(&client->qlibContext, client);
+
+        /*-------------------------------------------------------------------------------------------------*/
+        /* The cached monotonic counter is kept only if the device was not reset meanwhile                 */
+        /*-------------------------------------------------------------------------------------------------*/
+        if (0 != memcmp(&entry->qlibContext.resetStatus, &syncObject->resetStatus, sizeof(QLIB_RESET_STATUS_T)))
+        {
+            client->qlibContext.resetStatus = syncObject->resetStatus;
+            for (die = 0; die < QLIB_NUM_OF_DIES; die++)
+            {
+                client->qlibContext.dieState[die].mcInSync = FALSE;
+            }
+        }
+        for (die = 0; die < QLIB_NUM_OF_DIES; die++)
+        {
+            memcpy(client->qlibContext.dieState[die].sectionsState,
+                   syncObject->sectionsState[die],
+                   sizeof(client->qlibContext.dieState[die].sectionsState));
+        }
+
+        memcpy(client->fk, entry->fk, sizeof(KEY_ARRAY_T));
+        memcpy(client->rk, entry->rk, sizeof(KEY_ARRAY_T));
+        entry->lastUsed = ++cache->useCounter;
+        cache->hits++;
+        hit = TRUE;
+    }
+    else
+    {
+        cache->misses++;
+    }
+
+    if (cache->lock != NULL)
+    {
+        cache->lock(cache->lockArg, FALSE);
+    }
+
+    return hit;
+}
+
+static void QLIB_SERVER_CacheStore_L(QLIB_SERVER_CLIENT_T* client, BOOL newEntry)
+{
+    QLIB_SERVER_DEVICE_CACHE_T*       cache = client->deviceCache;
+    QLIB_SERVER_DEVICE_CACHE_ENTRY_T* entry;
+    U32                               i;
+    U32                               die;
+
+    if (cache == NULL)
+    {
+        return;
+    }
+
+    if (cache->lock != NULL)
+    {
+        cache->lock(cache->lockArg, TRUE);
+    }
+
+    entry = QLIB_SERVER_CacheFind_L(cache, (const void*)client->qlibContext.wid);
+
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* New devices replace the least recently used entry, whose keys are wiped. Keys refresh updates only  */
+    /* devices that are already cached                                                                     */
+    /*-----------------------------------------------------------------------------------------------------*/
+    if ((entry == NULL) && (TRUE == newEntry))
+    {
+        entry = &cache->entries[0];
+        for (i = 1; (i < QLIB_SERVER_DEVICE_CACHE_SIZE) && (TRUE == entry->valid); ++i)
+        {
+            if ((FALSE == cache->entries[i].valid) || (cache->entries[i].lastUsed < entry->lastUsed))
+            {
+                entry = &cache->entries[i];
+            }
+        }
+        memset(entry, 0, sizeof(QLIB_SERVER_DEVICE_CACHE_ENTRY_T));
+    }
+
+    if (entry != NULL)
+    {
+        /*-------------------------------------------------------------------------------------------------*/
+        /* The context is cached right after import, before keys are loaded. Later refreshes update only   */
+        /* the monotonic counter sync                                                                      */
+        /*-------------------------------------------------------------------------------------------------*/
+        if (TRUE == newEntry)
+        {
+            memcpy(&entry->qlibContext, &client->qlibContext, sizeof(QLIB_CONTEXT_T));
+            QLIB_SetUserData(&entry->qlibContext, NULL);
+        }
+        else
+        {
+            for (die = 0; die < QLIB_NUM_OF_DIES; die++)
+            {
+                memcpy(entry->qlibContext.dieState[die].mc, client->qlibContext.dieState[die].mc, sizeof(QLIB_MC_T));
+                entry->qlibContext.dieState[die].mcInSync = client->qlibContext.dieState[die].mcInSync;
+            }
+        }
+        memcpy(entry->fk, client->fk, sizeof(KEY_ARRAY_T));
+        memcpy(entry->rk, client->rk, sizeof(KEY_ARRAY_T));
+        entry->valid    = TRUE;
+        entry->lastUsed = ++cache->useCounter;
+    }
+
+    if (cache->lock != NULL)
+    {
+        cache->lock(cache->lockArg, FALSE);
+    }
+}
+
+static void QLIB_SERVER_InFlightLock_L(QLIB_SERVER_CLIENT_T* client, BOOL lock)
+{
+    if (client->inFlightLock != NULL)
+    {
+        client->inFlightLock(client->inFlightLockArg, lock);
+    }
+}
+
+static QLIB_STATUS_T QLIB_SERVER_Drain_L(QLIB_SERVER_CLIENT_T* client, U32 size)
+{
+    U8  buf[64];
+    U32 chunk;
+
+    while (size > 0u)
+    {
+        chunk = MIN(size, sizeof(buf));
+        QLIB_STATUS_RET_CHECK(QLIB_SERVER_Receive(client->socket, buf, chunk, TRUE));
+        size -= chunk;
+    }
+
+    return QLIB_STATUS__OK;
+}
+
 #undef QLIB_SERVER_C
@@ -23,6 +23,40 @@ extern "C" {
 #include "qlib.h"
 #include "qlib_server_client_common.h"
 
+/*---------------------------------------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------------------------------------*/
+/*                                               DEFINITIONS                                               */
+/*---------------------------------------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------------------------------------*/
+/* Maximal number of requests that can be outstanding on a single client at the same time                  */
+/*---------------------------------------------------------------------------------------------------------*/
+#ifndef QLIB_SERVER_MAX_INFLIGHT_REQUESTS
+#define QLIB_SERVER_MAX_INFLIGHT_REQUESTS 8
+#endif
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Number of devices whose state is kept in a device cache for fast re-registration                        */
+/*---------------------------------------------------------------------------------------------------------*/
+#ifndef QLIB_SERVER_DEVICE_CACHE_SIZE
+#define QLIB_SERVER_DEVICE_CACHE_SIZE 16
+#endif
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Minimal standard command write size that is RLE encoded, if supported by the client                     */
+/*---------------------------------------------------------------------------------------------------------*/
+#ifndef QLIB_SERVER_RLE_MIN_SIZE
+#define QLIB_SERVER_RLE_MIN_SIZE 32
+#endif
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Delta write granularity, and maximal number of page CRCs requested in a single round trip               */
+/*---------------------------------------------------------------------------------------------------------*/
+#define QLIB_SERVER_DELTA_PAGE_SIZE FLASH_PAGE_SIZE
+#ifndef QLIB_SERVER_DELTA_MAX_PAGES
+#define QLIB_SERVER_DELTA_MAX_PAGES 1024
+#endif
+
 /*---------------------------------------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------------------------------------*/
 /*                                                  TYPES                                                  */
@@ -37,6 +71,9 @@ typedef QLIB_STATUS_T (*QLIB_SERVER_CUSTOM_PACKET_CB)(struct _QLIB_SERVER_CLIENT
 // Default callback
 typedef QLIB_STATUS_T (*QLIB_SERVER_DEFAULT_CB)(struct _QLIB_SERVER_CLIENT_T* client);
 
+// Lock callback. Called with lock TRUE before accessing the shared object, and with FALSE after
+typedef void (*QLIB_SERVER_LOCK_CB)(void* lockArg, BOOL lock);
+
 // Callbacks object for the client
 typedef struct
 {
@@ -47,6 +84,38 @@ typedef struct
     QLIB_SERVER_DEFAULT_CB       onInvalidPacket;
 } QLIB_SERVER_CLIENT_CALLBACKS_T;
 
+// Outstanding request, waiting for the client response
+typedef struct
+{
+    BOOL                         inUse;
+    BOOL                         responseReady;
+    U16                          requestId;
+    void*                        responseBuf;
+    U32                          responseSize;
+    QLIB_PACKET_STRUCT__HEADER_T hdrIn;
+} QLIB_SERVER_INFLIGHT_T;
+
+// Cached state of a single device, by WID
+typedef struct
+{
+    BOOL           valid;
+    U32            lastUsed;
+    QLIB_CONTEXT_T qlibContext; // context imported on the last full registration, without keys, with the last MC
+    KEY_ARRAY_T    fk;          // wiped on eviction and on QLIB_SERVER_ClearDeviceCache
+    KEY_ARRAY_T    rk;
+} QLIB_SERVER_DEVICE_CACHE_ENTRY_T;
+
+// Device cache, may be shared between clients
+typedef struct
+{
+    QLIB_SERVER_DEVICE_CACHE_ENTRY_T entries[QLIB_SERVER_DEVICE_CACHE_SIZE];
+    U32                              useCounter;
+    U32                              hits;
+    U32                              misses;
+    QLIB_SERVER_LOCK_CB              lock;
+    void*                            lockArg;
+} QLIB_SERVER_DEVICE_CACHE_T;
+
 // Client object
 typedef struct _QLIB_SERVER_CLIENT_T
 {
@@ -55,11 +124,16 @@ typedef struct _QLIB_SERVER_CLIENT_T
     KEY_ARRAY_T                     fk;
     KEY_ARRAY_T                     rk;
     void*                           socket;
-    void*                           responseBuf;
-    U32                             responseSize;
-    BOOL                            responseReady;
+    U32                             capabilities;
+    QLIB_SERVER_INFLIGHT_T          inFlight[QLIB_SERVER_MAX_INFLIGHT_REQUESTS];
+    U16                             nextRequestId;
+    QLIB_SERVER_LOCK_CB             inFlightLock;
+    void*                           inFlightLockArg;
+    QLIB_SERVER_LOCK_CB             registrationLock;
+    void*                           registrationLockArg;
+    BOOL                            registering; // registration pending, requests are aborted
     QLIB_SERVER_CLIENT_CALLBACKS_T* callbacks;
-    QLIB_PACKET_STRUCT__HEADER_T*   hdr_in;
+    QLIB_SERVER_DEVICE_CACHE_T*     deviceCache;
 } QLIB_SERVER_CLIENT_T;
 
 /*---------------------------------------------------------------------------------------------------------*/
@@ -101,6 +175,164 @@ QLIB_STATUS_T QLIB_SERVER_HandlePacket(QLIB_SERVER_CLIENT_T* client);
 ************************************************************************************************************/
 QLIB_STATUS_T QLIB_SERVER_SendCustomPacket(QLIB_SERVER_CLIENT_T* client, QLIB_PACKET_STRUCT__CUSTOM_T* packet, U16 packetSize);
 
+/************************************************************************************************************
+ * @brief   This function gets the Client keys using @ref QLIB_SERVER_GetKeys and loads them into the Client
+ *          QLIB context. It is called on registration, and should be called again after the keys of the
+ *          device are provisioned (e.g. after QCONF configuration)
+ *
+ * @param[in]   client      Client object
+ *
+ * @return      0 if no error occurred, QLIB_STATUS__(ERROR) otherwise
+************************************************************************************************************/
+QLIB_STATUS_T QLIB_SERVER_LoadKeys(QLIB_SERVER_CLIENT_T* client);
+
+/************************************************************************************************************
+ * @brief   This function initializes a device cache. When a client with a cached WID registers again with
+ *          the same section layout, address mode and bus interface, its QLIB context is restored from the
+ *          cache instead of being initialized and imported, and the cached keys are used instead of
+ *          @ref QLIB_SERVER_GetKeys. The monotonic counter sync is kept if the device reports the same reset
+ *          status. The cached keys are wiped when an entry is evicted
+ *
+ * @param[out]  cache       Device cache object
+ * @param[in]   lock        Optional lock callback, needed if clients sharing the cache run in different threads
+ * @param[in]   lockArg     Argument of the lock callback
+ *
+ * @return      0 if no error occurred, QLIB_STATUS__(ERROR) otherwise
+************************************************************************************************************/
+QLIB_STATUS_T QLIB_SERVER_InitDeviceCache(QLIB_SERVER_DEVICE_CACHE_T* cache, QLIB_SERVER_LOCK_CB lock, void* lockArg);
+
+/************************************************************************************************************
+ * @brief   This function invalidates all entries of a device cache and wipes the cached keys. Should be
+ *          called before the cache is released
+ *
+ * @param[in]   cache       Device cache object
+ *
+ * @return      0 if no error occurred, QLIB_STATUS__(ERROR) otherwise
+************************************************************************************************************/
+QLIB_STATUS_T QLIB_SERVER_ClearDeviceCache(QLIB_SERVER_DEVICE_CACHE_T* cache);
+
+/************************************************************************************************************
+ * @brief   This function attaches a device cache to a Client. Should be called before the Client registers
+ *
+ * @param[in]   client      Client object
+ * @param[in]   cache       Device cache object, or NULL to detach
+ *
+ * @return      0 if no error occurred, QLIB_STATUS__(ERROR) otherwise
+************************************************************************************************************/
+QLIB_STATUS_T QLIB_SERVER_SetDeviceCache(QLIB_SERVER_CLIENT_T* client, QLIB_SERVER_DEVICE_CACHE_T* cache);
+
+/************************************************************************************************************
+ * @brief   This function writes data to the Client flash, skipping pages whose content is already
+ *          identical. The Client reports the CRC of the current content, and only the changed pages are
+ *          written using @ref QLIB_Write. If the Client does not support page CRC, all data is written
+ *
+ * @param[in]   client          Client object
+ * @param[in]   buf             The data to write
+ * @param[in]   sectionID       Section index
+ * @param[in]   offset          Section offset
+ * @param[in]   size            Size of the data
+ * @param[in]   secure          If TRUE then secure write, else standard write
+ * @param[out]  pagesSkipped    Optional, number of unchanged pages that were not written
+ *
+ * @return      0 if no error occurred, QLIB_STATUS__(ERROR) otherwise
+************************************************************************************************************/
+QLIB_STATUS_T QLIB_SERVER_WriteDelta(QLIB_SERVER_CLIENT_T* client,
+                                     const U8*             buf,
+                                     U32                   sectionID,
+                                     U32                   offset,
+                                     U32                   size,
+                                     BOOL                  secure,
+                                     U32*                  pagesSkipped);
+
+/************************************************************************************************************
+ * @brief   This function erases the Client flash, skipping sectors that are already erased. The Client
+ *          reports the CRC of the current content, and only sectors with a page that differs from the
+ *          erased pattern are erased using @ref QLIB_Erase. If the Client does not support page CRC, the
+ *          whole range is erased
+ *
+ * @param[in]   client          Client object
+ * @param[in]   sectionID       Section index
+ * @param[in]   offset          Section offset, aligned to FLASH_SECTOR_SIZE
+ * @param[in]   size            Size of the range, aligned to FLASH_SECTOR_SIZE
+ * @param[in]   secure          If TRUE then secure erase, else standard erase
+ * @param[out]  sectorsSkipped  Optional, number of erased sectors that were not erased again
+ *
+ * @return      0 if no error occurred, QLIB_STATUS__(ERROR) otherwise
+************************************************************************************************************/
+QLIB_STATUS_T QLIB_SERVER_EraseDelta(QLIB_SERVER_CLIENT_T* client,
+                                     U32                   sectionID,
+                                     U32                   offset,
+                                     U32                   size,
+                                     BOOL                  secure,
+                                     U32*                  sectorsSkipped);
+
+/************************************************************************************************************
+ * @brief   This function sends a request to the Client without waiting for its response.
+ *          Several requests can be submitted before their responses are collected with
+ *          @ref QLIB_SERVER_WaitResponse, up to QLIB_SERVER_MAX_INFLIGHT_REQUESTS
+ *
+ * @param[in]   client      Client object
+ * @param[in]   hdrOut      Request header. version and requestId fields are set by this function
+ * @param[in]   dataOut     Request data of hdrOut->size bytes
+ * @param[out]  dataIn      Buffer to hold the response data. Must remain valid till the response is collected
+ * @param[in]   dataInSize  Expected response data size
+ * @param[out]  slot        In-flight slot of the request, to be passed to @ref QLIB_SERVER_WaitResponse
+ *
+ * @return
+ * QLIB_STATUS__OK                 - request was sent\n
+ * QLIB_STATUS__DEVICE_BUSY        - all in-flight slots are in use\n
+ * QLIB_STATUS__(ERROR)            - other error
+************************************************************************************************************/
+QLIB_STATUS_T QLIB_SERVER_SubmitRequest(QLIB_SERVER_CLIENT_T*         client,
+                                        QLIB_PACKET_STRUCT__HEADER_T* hdrOut,
+                                        void*                         dataOut,
+                                        void*                         dataIn,
+                                        U32                           dataInSize,
+                                        U32*                          slot);
+
+/************************************************************************************************************
+ * @brief   This function waits for the response of a request submitted by @ref QLIB_SERVER_SubmitRequest
+ *          and releases its in-flight slot. Responses may arrive in any order
+ *
+ * @param[in]   client      Client object
+ * @param[in]   slot        In-flight slot returned by @ref QLIB_SERVER_SubmitRequest
+ * @param[out]  hdrIn       Response header
+ *
+ * @return
+ * QLIB_STATUS__OK                 - response received\n
+ * QLIB_STATUS__COMMAND_FAIL       - no response received within timeout\n
+ * QLIB_STATUS__(ERROR)            - other error
+************************************************************************************************************/
+QLIB_STATUS_T QLIB_SERVER_WaitResponse(QLIB_SERVER_CLIENT_T* client, U32 slot, QLIB_PACKET_STRUCT__HEADER_T* hdrIn);
+
+/************************************************************************************************************
+ * @brief   This function sets the lock of the Client in-flight requests table. Needed if requests are
+ *          submitted in a different thread than the one calling @ref QLIB_SERVER_HandlePacket
+ *
+ * @param[in]   client      Client object
+ * @param[in]   lock        Lock callback, or NULL if the Client is used by a single thread
+ * @param[in]   lockArg     Argument of the lock callback
+ *
+ * @return      0 if no error occurred, QLIB_STATUS__(ERROR) otherwise
+************************************************************************************************************/
+QLIB_STATUS_T QLIB_SERVER_SetInFlightLock(QLIB_SERVER_CLIENT_T* client, QLIB_SERVER_LOCK_CB lock, void* lockArg);
+
+/************************************************************************************************************
+ * @brief   This function sets the registration lock of the Client. The lock is held while a registration
+ *          packet re-initializes the Client context and while the registration callback runs. A thread
+ *          that uses the Client context outside the packet thread should hold the same lock.
+ *          Once a registration packet is received, and till the registration completes, the requests of
+ *          the Client fail with QLIB_STATUS__COMMUNICATION_ERR without waiting for a response. A thread
+ *          holding the lock across requests therefore releases it without help from the packet thread
+ *
+ * @param[in]   client      Client object
+ * @param[in]   lock        Lock callback, or NULL if the Client is used by a single thread
+ * @param[in]   lockArg     Argument of the lock callback
+ *
+ * @return      0 if no error occurred, QLIB_STATUS__(ERROR) otherwise
+************************************************************************************************************/
+QLIB_STATUS_T QLIB_SERVER_SetRegistrationLock(QLIB_SERVER_CLIENT_T* client, QLIB_SERVER_LOCK_CB lock, void* lockArg);
+
 #ifdef __cplusplus
 }
 #endif
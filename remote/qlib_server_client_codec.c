@@ -0,0 +1,155 @@
+/************************************************************************************************************
+* @internal
+* @remark     Winbond Electronics Corporation - Confidential
+* @copyright  Copyright (c) 2024 by Winbond Electronics Corporation . All rights reserved
+* @endinternal
+*
+* @file       qlib_server_client_codec.c
+* @brief      Payload codec shared by the server and the client of the remote protocol
+*
+************************************************************************************************************/
+#define QLIB_SERVER_CLIENT_CODEC_C
+
+/*---------------------------------------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------------------------------------*/
+/*                                                INCLUDES                                                 */
+/*---------------------------------------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------------------------------------*/
+#include "qlib_server_client_codec.h"
+
+/*---------------------------------------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------------------------------------*/
+/*                                           LOCAL FUNCTION API                                            */
+/*---------------------------------------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------------------------------------*/
+static QLIB_STATUS_T QLIB_CODEC_RleLiteral_L(const U8* src, U32 srcSize, U8* dst, U32 dstMaxSize, U32* dstSize);
+
+/*---------------------------------------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------------------------------------*/
+/*                                                Codec API                                                */
+/*---------------------------------------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------------------------------------*/
+
+QLIB_STATUS_T QLIB_CODEC_RleEncode(const U8* src, U32 srcSize, U8* dst, U32 dstMaxSize, U32* dstSize)
+{
+    U32 in         = 0;
+    U32 out        = 0;
+    U32 literalIn  = 0;
+    U32 run        = 0;
+    U32 recordSize = 0;
+
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Error checking                                                                                      */
+    /*-----------------------------------------------------------------------------------------------------*/
+    QLIB_ASSERT_RET((src != NULL) && (dst != NULL) && (dstSize != NULL), QLIB_STATUS__INVALID_PARAMETER);
+
+    while (in < srcSize)
+    {
+        /*-------------------------------------------------------------------------------------------------*/
+        /* Measure the run starting at the current byte                                                    */
+        /*-------------------------------------------------------------------------------------------------*/
+        run = 1;
+        while (((in + run) < srcSize) && (run < QLIB_CODEC_RLE_MAX_RUN) && (src[in + run] == src[in]))
+        {
+            run++;
+        }
+
+        if (run < QLIB_CODEC_RLE_MIN_RUN)
+        {
+            in += run;
+            continue;
+        }
+
+        /*-------------------------------------------------------------------------------------------------*/
+        /* Flush pending literal bytes, then emit the run                                                  */
+        /*-------------------------------------------------------------------------------------------------*/
+        QLIB_STATUS_RET_CHECK(QLIB_CODEC_RleLiteral_L(&src[literalIn], in - literalIn, &dst[out], dstMaxSize - out, &recordSize));
+        out += recordSize;
+
+        QLIB_ASSERT_RET((out + 2u) <= dstMaxSize, QLIB_STATUS__INVALID_DATA_SIZE);
+        dst[out++] = (U8)(QLIB_CODEC_RLE_RUN_FLAG | (run - QLIB_CODEC_RLE_MIN_RUN));
+        dst[out++] = src[in];
+
+        in += run;
+        literalIn = in;
+    }
+
+    QLIB_STATUS_RET_CHECK(QLIB_CODEC_RleLiteral_L(&src[literalIn], in - literalIn, &dst[out], dstMaxSize - out, &recordSize));
+    out += recordSize;
+
+    *dstSize = out;
+
+    return QLIB_STATUS__OK;
+}
+
+QLIB_STATUS_T QLIB_CODEC_RleDecode(const U8* src, U32 srcSize, U8* dst, U32 dstSize)
+{
+    U32 in  = 0;
+    U32 out = 0;
+    U32 len = 0;
+    U8  control;
+
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Error checking                                                                                      */
+    /*-----------------------------------------------------------------------------------------------------*/
+    QLIB_ASSERT_RET((src != NULL) && (dst != NULL), QLIB_STATUS__INVALID_PARAMETER);
+
+    while (in < srcSize)
+    {
+        control = src[in++];
+
+        if ((control & QLIB_CODEC_RLE_RUN_FLAG) != 0u)
+        {
+            len = (U32)(control & (U8)~QLIB_CODEC_RLE_RUN_FLAG) + QLIB_CODEC_RLE_MIN_RUN;
+            QLIB_ASSERT_RET(in < srcSize, QLIB_STATUS__COMMUNICATION_ERR);
+            QLIB_ASSERT_RET((out + len) <= dstSize, QLIB_STATUS__COMMUNICATION_ERR);
+            (void)memset(&dst[out], src[in], len);
+            in += 1u;
+        }
+        else
+        {
+            len = (U32)control + 1u;
+            QLIB_ASSERT_RET((in + len) <= srcSize, QLIB_STATUS__COMMUNICATION_ERR);
+            QLIB_ASSERT_RET((out + len) <= dstSize, QLIB_STATUS__COMMUNICATION_ERR);
+            (void)memcpy(&dst[out], &src[in], len);
+            in += len;
+        }
+
+        out += len;
+    }
+
+    QLIB_ASSERT_RET(out == dstSize, QLIB_STATUS__COMMUNICATION_ERR);
+
+    return QLIB_STATUS__OK;
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------------------------------------*/
+/*                                             LOCAL FUNCTIONS                                             */
+/*---------------------------------------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------------------------------------*/
+
+static QLIB_STATUS_T QLIB_CODEC_RleLiteral_L(const U8* src, U32 srcSize, U8* dst, U32 dstMaxSize, U32* dstSize)
+{
+    U32 in  = 0;
+    U32 out = 0;
+    U32 len = 0;
+
+    while (in < srcSize)
+    {
+        len = ((srcSize - in) < QLIB_CODEC_RLE_MAX_LITERAL) ? (srcSize - in) : QLIB_CODEC_RLE_MAX_LITERAL;
+        QLIB_ASSERT_RET((out + 1u + len) <= dstMaxSize, QLIB_STATUS__INVALID_DATA_SIZE);
+
+        dst[out++] = (U8)(len - 1u);
+        (void)memcpy(&dst[out], &src[in], len);
+
+        out += len;
+        in += len;
+    }
+
+    *dstSize = out;
+
+    return QLIB_STATUS__OK;
+}
+
+#undef QLIB_SERVER_CLIENT_CODEC_C
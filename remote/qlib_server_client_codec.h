@@ -0,0 +1,81 @@
+/************************************************************************************************************
+* @internal
+* @remark     Winbond Electronics Corporation - Confidential
+* @copyright  Copyright (c) 2024 by Winbond Electronics Corporation . All rights reserved
+* @endinternal
+*
+* @file       qlib_server_client_codec.h
+* @brief      Payload codec shared by the server and the client of the remote protocol
+*
+************************************************************************************************************/
+#ifndef __QLIB_SERVER_CLIENT_CODEC_H__
+#define __QLIB_SERVER_CLIENT_CODEC_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*---------------------------------------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------------------------------------*/
+/*                                                INCLUDES                                                 */
+/*---------------------------------------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------------------------------------*/
+#include "qlib.h"
+
+/*---------------------------------------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------------------------------------*/
+/*                                               DEFINITIONS                                               */
+/*---------------------------------------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------------------------------------*/
+/* RLE stream format. Each record starts with a control byte:                                              */
+/*  - bit 7 set   : run of ((control & 0x7F) + QLIB_CODEC_RLE_MIN_RUN) copies of the following byte        */
+/*  - bit 7 clear : literal of (control + 1) bytes that follow                                             */
+/*---------------------------------------------------------------------------------------------------------*/
+#define QLIB_CODEC_RLE_RUN_FLAG    0x80u
+#define QLIB_CODEC_RLE_MIN_RUN     3u
+#define QLIB_CODEC_RLE_MAX_RUN     (0x7Fu + QLIB_CODEC_RLE_MIN_RUN)
+#define QLIB_CODEC_RLE_MAX_LITERAL 0x80u
+
+/*---------------------------------------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------------------------------------*/
+/*                                                   API                                                   */
+/*---------------------------------------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------------------------------------*/
+
+/************************************************************************************************************
+ * @brief   This function RLE encodes a buffer
+ *
+ * @param[in]   src         Data to encode
+ * @param[in]   srcSize     Size of the data
+ * @param[out]  dst         Encoded data
+ * @param[in]   dstMaxSize  Size of the @p dst buffer
+ * @param[out]  dstSize     Size of the encoded data
+ *
+ * @return
+ * QLIB_STATUS__OK                 - data encoded\n
+ * QLIB_STATUS__INVALID_DATA_SIZE  - encoded data does not fit into @p dstMaxSize bytes\n
+ * QLIB_STATUS__(ERROR)            - other error
+************************************************************************************************************/
+QLIB_STATUS_T QLIB_CODEC_RleEncode(const U8* src, U32 srcSize, U8* dst, U32 dstMaxSize, U32* dstSize);
+
+/************************************************************************************************************
+ * @brief   This function decodes a buffer encoded by @ref QLIB_CODEC_RleEncode
+ *
+ * @param[in]   src         Encoded data
+ * @param[in]   srcSize     Size of the encoded data
+ * @param[out]  dst         Decoded data
+ * @param[in]   dstSize     Expected size of the decoded data
+ *
+ * @return
+ * QLIB_STATUS__OK                 - data decoded\n
+ * QLIB_STATUS__COMMUNICATION_ERR  - malformed stream, or decoded size differs from @p dstSize\n
+ * QLIB_STATUS__(ERROR)            - other error
+************************************************************************************************************/
+QLIB_STATUS_T QLIB_CODEC_RleDecode(const U8* src, U32 srcSize, U8* dst, U32 dstSize);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //__QLIB_SERVER_CLIENT_CODEC_H__
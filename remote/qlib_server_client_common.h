@@ -23,6 +23,28 @@ extern "C" {
 /*---------------------------------------------------------------------------------------------------------*/
 #include "qlib.h"
 
+/*---------------------------------------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------------------------------------*/
+/*                                               DEFINITIONS                                               */
+/*---------------------------------------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------------------------------------*/
+/* Packet header version. Bumped on any change to the header layout                                        */
+/*---------------------------------------------------------------------------------------------------------*/
+#define QLIB_PACKET_HEADER_VERSION 1
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Request ID of packets that are not a part of a request/response transaction (registration, custom)      */
+/*---------------------------------------------------------------------------------------------------------*/
+#define QLIB_PACKET_REQUEST_ID_NONE 0
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Client capabilities, reported on registration                                                           */
+/*---------------------------------------------------------------------------------------------------------*/
+#define QLIB_PACKET_CAPS__WAIT_READY (1u << 0u) // client handles QLIB_PACKET_TYPE__WAIT_READY
+#define QLIB_PACKET_CAPS__STD_RLE    (1u << 1u) // client handles QLIB_PACKET_TYPE__STD_CMD_RLE
+#define QLIB_PACKET_CAPS__PAGE_CRC   (1u << 2u) // client handles QLIB_PACKET_TYPE__PAGE_CRC
+
 /*---------------------------------------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------------------------------------*/
 /*                                                  TYPES                                                  */
@@ -43,6 +65,9 @@ typedef enum
     QLIB_PACKET_TYPE__SEC_CMD       = 6,
     QLIB_PACKET_TYPE__CMD_RESP      = 7,
     QLIB_PACKET_TYPE__CUSTOM        = 8,
+    QLIB_PACKET_TYPE__WAIT_READY    = 9,
+    QLIB_PACKET_TYPE__STD_CMD_RLE   = 10,
+    QLIB_PACKET_TYPE__PAGE_CRC      = 11,
 
     QLIB__NUM_OF_PACKET_TYPES
 } QLIB_PACKET_TYPE_T;
@@ -53,12 +78,16 @@ typedef enum
 PACKED_START
 
 /*---------------------------------------------------------------------------------------------------------*/
-/*Header packet                                                                                            */
+/* Header packet                                                                                           */
+/* requestId is set by the server on each command and must be echoed back by the client on its response.   */
+/* This allows several commands to be outstanding on the same connection                                   */
 /*---------------------------------------------------------------------------------------------------------*/
 typedef struct
 {
     U16 type;
     U16 size;
+    U16 version;
+    U16 requestId;
 } PACKED QLIB_PACKET_STRUCT__HEADER_T;
 
 /*---------------------------------------------------------------------------------------------------------*/
@@ -67,6 +96,7 @@ typedef struct
 typedef struct
 {
     QLIB_SYNC_OBJ_T syncObject;
+    U32             capabilities;
 } PACKED QLIB_PACKET_STRUCT__REGISTER_T;
 
 #ifdef _WIN32
@@ -87,6 +117,12 @@ typedef struct
     U32               writeData[];
 } PACKED QLIB_PACKET_STRUCT__STANDARD_CMD_T;
 
+/*---------------------------------------------------------------------------------------------------------*/
+/* QLIB_PACKET_TYPE__STD_CMD_RLE uses QLIB_PACKET_STRUCT__STANDARD_CMD_T with RLE encoded writeData        */
+/* (see qlib_server_client_codec.h). writeDataSize is the decoded size, the encoded size is derived from   */
+/* the header size                                                                                         */
+/*---------------------------------------------------------------------------------------------------------*/
+
 typedef struct
 {
     BOOL checkSsr;
@@ -96,6 +132,31 @@ typedef struct
     U32  writeData[];
 } PACKED QLIB_PACKET_STRUCT__SECURE_CMD_T;
 
+/*---------------------------------------------------------------------------------------------------------*/
+/* Wait-until-ready command. The client polls the given register locally till (value & busyMask) == 0      */
+/* and responds once, with the last register value in data[0]                                              */
+/*---------------------------------------------------------------------------------------------------------*/
+typedef struct
+{
+    U32 source;   // QLIB_TM_WAIT_READY_T
+    U32 busyMask; // bits that must be cleared
+    U32 maxPolls; // maximal number of polls, greater than 0
+} PACKED QLIB_PACKET_STRUCT__WAIT_READY_CMD_T;
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Page CRC command. The client splits size bytes of the section, starting at offset, into chunks at       */
+/* pageSize aligned boundaries (so the first and last chunks may be shorter), and responds with the        */
+/* CRC of each chunk in data[], as calculated by QLIB_MemCRC. The client may also use plain reads with     */
+/* QLIB_UTILS_CalcCRCProgressive. Chunks with a size that is not a multiple of 4 are always written        */
+/*---------------------------------------------------------------------------------------------------------*/
+typedef struct
+{
+    U32 sectionID;
+    U32 offset;
+    U32 size;     // total size of the chunks
+    U32 pageSize; // chunk alignment and maximal size
+} PACKED QLIB_PACKET_STRUCT__PAGE_CRC_CMD_T;
+
 typedef struct
 {
     U32 status;
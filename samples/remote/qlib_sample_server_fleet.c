@@ -0,0 +1,567 @@
+/************************************************************************************************************
+ * @internal
+ * @remark     Winbond Electronics Corporation - Confidential
+ * @copyright  Copyright (c) 2024 by Winbond Electronics Corporation . All rights reserved
+ * @endinternal
+ *
+ * @file       qlib_sample_server_fleet.c
+ * @brief      This file includes sample QLIB server fleet provisioning implementation.
+ *             Every connected client gets its own packet processing thread, while a bounded pool of
+ *             worker threads provisions registered devices (QCONF configuration and key loading).
+ *             Failed devices are retried with exponential backoff.
+ *
+ * ### project qlib
+ *
+ ***********************************************************************************************************/
+
+/*---------------------------------------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------------------------------------*/
+/*                                                INCLUDES                                                 */
+/*---------------------------------------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/socket.h>
+
+#include "qlib.h"
+#include "qlib_server.h"
+#include "qlib_sample_qconf.h"
+#include "qlib_sample_server_fleet.h"
+
+/*---------------------------------------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------------------------------------*/
+/*                                               DEFINITIONS                                               */
+/*---------------------------------------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------------------------------------*/
+/* Maximal time a worker sleeps when no device is ready                                                    */
+/*---------------------------------------------------------------------------------------------------------*/
+#define QLIB_SAMPLE_FLEET_IDLE_WAIT_MS 1000
+
+/*---------------------------------------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------------------------------------*/
+/*                                       LOCAL FUNCTION DECLARATIONS                                       */
+/*---------------------------------------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------------------------------------*/
+static U64                         QLIB_SAMPLE_FLEET_GetTimeMs_L(void);
+static void*                       QLIB_SAMPLE_FLEET_PacketThread_L(void* data);
+static void*                       QLIB_SAMPLE_FLEET_WorkerThread_L(void* data);
+static QLIB_STATUS_T               QLIB_SAMPLE_FLEET_OnRegistration_L(struct _QLIB_SERVER_CLIENT_T* client);
+static QLIB_SAMPLE_FLEET_DEVICE_T* QLIB_SAMPLE_FLEET_PickDevice_L(QLIB_SAMPLE_FLEET_T* fleet, U64 now, U64* nextWakeupMs);
+static QLIB_STATUS_T               QLIB_SAMPLE_FLEET_Provision_L(QLIB_SAMPLE_FLEET_DEVICE_T* device);
+static U32                         QLIB_SAMPLE_FLEET_BackoffMs_L(const QLIB_SAMPLE_FLEET_CONFIG_T* config, U32 attempts);
+static void                        QLIB_SAMPLE_FLEET_Lock_L(void* lockArg, BOOL lock);
+static void                        QLIB_SAMPLE_FLEET_RemoveDevice_L(QLIB_SAMPLE_FLEET_T*        fleet,
+                                                                    QLIB_SAMPLE_FLEET_DEVICE_T* device);
+
+/*---------------------------------------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------------------------------------*/
+/*                                                   API                                                   */
+/*---------------------------------------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------------------------------------*/
+
+QLIB_STATUS_T QLIB_SAMPLE_FLEET_Start(QLIB_SAMPLE_FLEET_T* fleet, const QLIB_SAMPLE_FLEET_CONFIG_T* config)
+{
+    pthread_condattr_t condAttr;
+    U32                i;
+
+    QLIB_ASSERT_RET(NULL != fleet, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET(NULL != config, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET(0 < config->numWorkers && config->numWorkers <= QLIB_SAMPLE_FLEET_MAX_WORKERS,
+                    QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET(0 < config->maxAttempts, QLIB_STATUS__INVALID_PARAMETER);
+
+    memset(fleet, 0, sizeof(QLIB_SAMPLE_FLEET_T));
+    fleet->config                   = *config;
+    fleet->startMs                  = QLIB_SAMPLE_FLEET_GetTimeMs_L();
+    fleet->callbacks.customBuf      = fleet->customBuf;
+    fleet->callbacks.customSize     = sizeof(fleet->customBuf);
+    fleet->callbacks.onRegistration = QLIB_SAMPLE_FLEET_OnRegistration_L;
+
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Backoff deadlines are monotonic, so the condition variable must use the same clock                  */
+    /*-----------------------------------------------------------------------------------------------------*/
+    QLIB_ASSERT_RET(0 == pthread_mutex_init(&fleet->lock, NULL), QLIB_STATUS__OUT_OF_MEMORY);
+    QLIB_ASSERT_RET(0 == pthread_condattr_init(&condAttr), QLIB_STATUS__OUT_OF_MEMORY);
+    QLIB_ASSERT_RET(0 == pthread_condattr_setclock(&condAttr, CLOCK_MONOTONIC), QLIB_STATUS__OUT_OF_MEMORY);
+    QLIB_ASSERT_RET(0 == pthread_cond_init(&fleet->wakeup, &condAttr), QLIB_STATUS__OUT_OF_MEMORY);
+    (void)pthread_condattr_destroy(&condAttr);
+
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Devices that reconnect with unchanged state skip fetching their keys                                */
+    /*-----------------------------------------------------------------------------------------------------*/
+    QLIB_ASSERT_RET(0 == pthread_mutex_init(&fleet->cacheLock, NULL), QLIB_STATUS__OUT_OF_MEMORY);
+    QLIB_STATUS_RET_CHECK(QLIB_SERVER_InitDeviceCache(&fleet->deviceCache, QLIB_SAMPLE_FLEET_Lock_L, &fleet->cacheLock));
+
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Start the workers                                                                                   */
+    /*-----------------------------------------------------------------------------------------------------*/
+    for (i = 0; i < fleet->config.numWorkers; i++)
+    {
+        QLIB_ASSERT_RET(0 == pthread_create(&fleet->workers[i], NULL, QLIB_SAMPLE_FLEET_WorkerThread_L, fleet),
+                        QLIB_STATUS__OUT_OF_MEMORY);
+    }
+
+    return QLIB_STATUS__OK;
+}
+
+QLIB_STATUS_T QLIB_SAMPLE_FLEET_AddClient(QLIB_SAMPLE_FLEET_T* fleet, int socket)
+{
+    QLIB_STATUS_T               ret    = QLIB_STATUS__OK;
+    QLIB_SAMPLE_FLEET_DEVICE_T* device = NULL;
+
+    QLIB_ASSERT_RET(NULL != fleet, QLIB_STATUS__INVALID_PARAMETER);
+
+    device = (QLIB_SAMPLE_FLEET_DEVICE_T*)MALLOC(sizeof(QLIB_SAMPLE_FLEET_DEVICE_T));
+    QLIB_ASSERT_RET(NULL != device, QLIB_STATUS__OUT_OF_MEMORY);
+    memset(device, 0, sizeof(QLIB_SAMPLE_FLEET_DEVICE_T));
+
+    device->socket     = socket;
+    device->fleet      = fleet;
+    device->state      = QLIB_SAMPLE_FLEET_DEVICE__WAIT_REGISTRATION;
+    device->lastStatus = QLIB_STATUS__OK;
+    device->connected  = TRUE;
+    (void)pthread_mutex_init(&device->inFlightLock, NULL);
+    (void)pthread_mutex_init(&device->registrationLock, NULL);
+
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Initialize the client and its QLIB context                                                          */
+    /*-----------------------------------------------------------------------------------------------------*/
+    QLIB_STATUS_RET_CHECK_GOTO(QLIB_SERVER_InitClient(&device->client, (void*)(intptr_t)socket, &fleet->callbacks), ret, error);
+    QLIB_STATUS_RET_CHECK_GOTO(QLIB_SERVER_SetDeviceCache(&device->client, &fleet->deviceCache), ret, error);
+    QLIB_STATUS_RET_CHECK_GOTO(QLIB_SERVER_SetInFlightLock(&device->client, QLIB_SAMPLE_FLEET_Lock_L, &device->inFlightLock),
+                               ret,
+                               error);
+    QLIB_STATUS_RET_CHECK_GOTO(QLIB_SERVER_SetRegistrationLock(&device->client,
+                                                               QLIB_SAMPLE_FLEET_Lock_L,
+                                                               &device->registrationLock),
+                               ret,
+                               error);
+    QLIB_STATUS_RET_CHECK_GOTO(QLIB_InitLib(&device->client.qlibContext), ret, error);
+
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Publish the device before its packets are processed, registration may complete immediately          */
+    /*-----------------------------------------------------------------------------------------------------*/
+    (void)pthread_mutex_lock(&fleet->lock);
+    if (fleet->numDevices >= QLIB_SAMPLE_FLEET_MAX_DEVICES)
+    {
+        (void)pthread_mutex_unlock(&fleet->lock);
+        ret = QLIB_STATUS__OUT_OF_MEMORY;
+        goto error;
+    }
+    fleet->devices[fleet->numDevices++] = device;
+    fleet->metrics.connected++;
+    (void)pthread_mutex_unlock(&fleet->lock);
+
+    if (0 != pthread_create(&device->packetThread, NULL, QLIB_SAMPLE_FLEET_PacketThread_L, device))
+    {
+        /*-------------------------------------------------------------------------------------------------*/
+        /* No packets were processed, so no worker could pick the device. The caller closes the socket     */
+        /*-------------------------------------------------------------------------------------------------*/
+        (void)pthread_mutex_lock(&fleet->lock);
+        fleet->devices[--fleet->numDevices] = NULL;
+        fleet->metrics.connected--;
+        (void)pthread_mutex_unlock(&fleet->lock);
+        ret = QLIB_STATUS__OUT_OF_MEMORY;
+        goto error;
+    }
+    (void)pthread_detach(device->packetThread);
+
+    return QLIB_STATUS__OK;
+
+error:
+    (void)pthread_mutex_destroy(&device->inFlightLock);
+    (void)pthread_mutex_destroy(&device->registrationLock);
+    FREE(device);
+    return ret;
+}
+
+QLIB_STATUS_T QLIB_SAMPLE_FLEET_GetMetrics(QLIB_SAMPLE_FLEET_T* fleet, QLIB_SAMPLE_FLEET_METRICS_T* metrics)
+{
+    U32 i;
+
+    QLIB_ASSERT_RET(NULL != fleet, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET(NULL != metrics, QLIB_STATUS__INVALID_PARAMETER);
+
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Removed devices are already counted in the fleet metrics                                            */
+    /*-----------------------------------------------------------------------------------------------------*/
+    (void)pthread_mutex_lock(&fleet->lock);
+    *metrics            = fleet->metrics;
+    metrics->waiting    = 0;
+    metrics->inProgress = 0;
+
+    for (i = 0; i < fleet->numDevices; i++)
+    {
+        switch (fleet->devices[i]->state)
+        {
+            case QLIB_SAMPLE_FLEET_DEVICE__PROVISIONING:
+                metrics->inProgress++;
+                break;
+            case QLIB_SAMPLE_FLEET_DEVICE__DONE:
+                metrics->succeeded++;
+                break;
+            case QLIB_SAMPLE_FLEET_DEVICE__FAILED:
+                metrics->failed++;
+                break;
+            default:
+                metrics->waiting++;
+                break;
+        }
+    }
+    (void)pthread_mutex_unlock(&fleet->lock);
+
+    QLIB_SAMPLE_FLEET_Lock_L(&fleet->cacheLock, TRUE);
+    metrics->cacheHits = fleet->deviceCache.hits;
+    QLIB_SAMPLE_FLEET_Lock_L(&fleet->cacheLock, FALSE);
+
+    metrics->elapsedMs = QLIB_SAMPLE_FLEET_GetTimeMs_L() - fleet->startMs;
+
+    return QLIB_STATUS__OK;
+}
+
+QLIB_STATUS_T QLIB_SAMPLE_FLEET_Stop(QLIB_SAMPLE_FLEET_T* fleet)
+{
+    U32 i;
+
+    QLIB_ASSERT_RET(NULL != fleet, QLIB_STATUS__INVALID_PARAMETER);
+
+    (void)pthread_mutex_lock(&fleet->lock);
+    fleet->stop = TRUE;
+    (void)pthread_cond_broadcast(&fleet->wakeup);
+    (void)pthread_mutex_unlock(&fleet->lock);
+
+    for (i = 0; i < fleet->config.numWorkers; i++)
+    {
+        (void)pthread_join(fleet->workers[i], NULL);
+    }
+
+    return QLIB_SERVER_ClearDeviceCache(&fleet->deviceCache);
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------------------------------------*/
+/*                                             LOCAL FUNCTIONS                                             */
+/*---------------------------------------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------------------------------------*/
+
+/************************************************************************************************************
+ * @brief       This function returns monotonic time in milliseconds
+ *
+ * @return      Time in milliseconds
+************************************************************************************************************/
+static U64 QLIB_SAMPLE_FLEET_GetTimeMs_L(void)
+{
+    struct timespec ts;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return ((U64)ts.tv_sec * 1000u) + ((U64)ts.tv_nsec / 1000000u);
+}
+
+/************************************************************************************************************
+ * @brief       Packet processing thread of a single device. Once the connection is lost the device is
+ *              removed from the fleet, or by its worker if it is being provisioned
+ *
+ * @param[in]   data    Fleet device object
+ *
+ * @return      NULL
+************************************************************************************************************/
+static void* QLIB_SAMPLE_FLEET_PacketThread_L(void* data)
+{
+    QLIB_SAMPLE_FLEET_DEVICE_T* device = (QLIB_SAMPLE_FLEET_DEVICE_T*)data;
+    QLIB_SAMPLE_FLEET_T*        fleet  = device->fleet;
+    QLIB_STATUS_T               ret;
+
+    do
+    {
+        ret = QLIB_SERVER_HandlePacket(&device->client);
+    } while (QLIB_STATUS__OK == ret);
+
+    (void)pthread_mutex_lock(&fleet->lock);
+    device->connected = FALSE;
+    if (QLIB_SAMPLE_FLEET_DEVICE__PROVISIONING != device->state)
+    {
+        if (QLIB_SAMPLE_FLEET_DEVICE__DONE != device->state)
+        {
+            device->state      = QLIB_SAMPLE_FLEET_DEVICE__FAILED;
+            device->lastStatus = ret;
+        }
+        QLIB_SAMPLE_FLEET_RemoveDevice_L(fleet, device);
+    }
+    (void)pthread_mutex_unlock(&fleet->lock);
+
+    return NULL;
+}
+
+/************************************************************************************************************
+ * @brief       Registration callback. Queues the device for provisioning
+ *
+ * @param[in]   client  Client object, the first field of the fleet device object
+ *
+ * @return      QLIB_STATUS__OK
+************************************************************************************************************/
+static QLIB_STATUS_T QLIB_SAMPLE_FLEET_OnRegistration_L(struct _QLIB_SERVER_CLIENT_T* client)
+{
+    QLIB_SAMPLE_FLEET_DEVICE_T* device = (QLIB_SAMPLE_FLEET_DEVICE_T*)client;
+    QLIB_SAMPLE_FLEET_T*        fleet  = device->fleet;
+
+    (void)pthread_mutex_lock(&fleet->lock);
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* A device may register again after reset. A device waiting for registration or for a retry is        */
+    /* queued. The provisioning of a device that was reset meanwhile was aborted, its worker restarts it   */
+    /*-----------------------------------------------------------------------------------------------------*/
+    if ((QLIB_SAMPLE_FLEET_DEVICE__WAIT_REGISTRATION == device->state) || (QLIB_SAMPLE_FLEET_DEVICE__BACKOFF == device->state))
+    {
+        device->state = QLIB_SAMPLE_FLEET_DEVICE__READY;
+        (void)pthread_cond_signal(&fleet->wakeup);
+    }
+    else if (QLIB_SAMPLE_FLEET_DEVICE__PROVISIONING == device->state)
+    {
+        device->restart = TRUE;
+    }
+    (void)pthread_mutex_unlock(&fleet->lock);
+
+    return QLIB_STATUS__OK;
+}
+
+/************************************************************************************************************
+ * @brief       This function picks the next device to provision. Must be called with the fleet lock held
+ *
+ * @param[in]   fleet           Fleet object
+ * @param[in]   now             Current time in milliseconds
+ * @param[out]  nextWakeupMs    Earliest backoff deadline, if no device is ready
+ *
+ * @return      Device to provision, or NULL if no device is ready
+************************************************************************************************************/
+static QLIB_SAMPLE_FLEET_DEVICE_T* QLIB_SAMPLE_FLEET_PickDevice_L(QLIB_SAMPLE_FLEET_T* fleet, U64 now, U64* nextWakeupMs)
+{
+    QLIB_SAMPLE_FLEET_DEVICE_T* device;
+    U32                         i;
+
+    *nextWakeupMs = now + QLIB_SAMPLE_FLEET_IDLE_WAIT_MS;
+
+    for (i = 0; i < fleet->numDevices; i++)
+    {
+        device = fleet->devices[i];
+
+        if (QLIB_SAMPLE_FLEET_DEVICE__READY == device->state)
+        {
+            return device;
+        }
+
+        if (QLIB_SAMPLE_FLEET_DEVICE__BACKOFF == device->state)
+        {
+            if (device->nextAttemptMs <= now)
+            {
+                return device;
+            }
+            if (device->nextAttemptMs < *nextWakeupMs)
+            {
+                *nextWakeupMs = device->nextAttemptMs;
+            }
+        }
+    }
+
+    return NULL;
+}
+
+/************************************************************************************************************
+ * @brief       Provisioning worker thread
+ *
+ * @param[in]   data    Fleet object
+ *
+ * @return      NULL
+************************************************************************************************************/
+static void* QLIB_SAMPLE_FLEET_WorkerThread_L(void* data)
+{
+    QLIB_SAMPLE_FLEET_T*        fleet = (QLIB_SAMPLE_FLEET_T*)data;
+    QLIB_SAMPLE_FLEET_DEVICE_T* device;
+    QLIB_STATUS_T               ret;
+    U64                         now;
+    U64                         nextWakeupMs;
+    struct timespec             deadline;
+
+    (void)pthread_mutex_lock(&fleet->lock);
+
+    while (FALSE == fleet->stop)
+    {
+        /*-------------------------------------------------------------------------------------------------*/
+        /* Pick a device, or sleep till the earliest backoff deadline                                      */
+        /*-------------------------------------------------------------------------------------------------*/
+        now    = QLIB_SAMPLE_FLEET_GetTimeMs_L();
+        device = QLIB_SAMPLE_FLEET_PickDevice_L(fleet, now, &nextWakeupMs);
+        if (NULL == device)
+        {
+            deadline.tv_sec  = (time_t)(nextWakeupMs / 1000u);
+            deadline.tv_nsec = (long)((nextWakeupMs % 1000u) * 1000000u);
+            (void)pthread_cond_timedwait(&fleet->wakeup, &fleet->lock, &deadline);
+            continue;
+        }
+
+        if (0 != device->attempts)
+        {
+            fleet->metrics.retries++;
+        }
+        device->attempts++;
+        device->state            = QLIB_SAMPLE_FLEET_DEVICE__PROVISIONING;
+        device->provisionStartMs = now;
+
+        /*-------------------------------------------------------------------------------------------------*/
+        /* Provision without holding the fleet lock, so other workers run concurrently. The registration   */
+        /* lock keeps a device that registers again from re-initializing the context meanwhile. Such a     */
+        /* registration aborts the requests of the provisioning, so the lock is released promptly          */
+        /*-------------------------------------------------------------------------------------------------*/
+        (void)pthread_mutex_unlock(&fleet->lock);
+        (void)pthread_mutex_lock(&device->registrationLock);
+        ret = QLIB_SAMPLE_FLEET_Provision_L(device);
+        (void)pthread_mutex_unlock(&device->registrationLock);
+        now = QLIB_SAMPLE_FLEET_GetTimeMs_L();
+        (void)pthread_mutex_lock(&fleet->lock);
+
+        device->lastStatus = ret;
+
+        if (TRUE == device->restart)
+        {
+            // the device was reset during provisioning, the aborted attempt is not counted
+            device->restart = FALSE;
+            device->attempts--;
+            device->state = QLIB_SAMPLE_FLEET_DEVICE__READY;
+        }
+        else if (QLIB_STATUS__OK == ret)
+        {
+            device->state = QLIB_SAMPLE_FLEET_DEVICE__DONE;
+            fleet->metrics.totalProvisionMs += now - device->provisionStartMs;
+        }
+        else if ((TRUE == device->connected) && (device->attempts < fleet->config.maxAttempts))
+        {
+            device->state         = QLIB_SAMPLE_FLEET_DEVICE__BACKOFF;
+            device->nextAttemptMs = now + QLIB_SAMPLE_FLEET_BackoffMs_L(&fleet->config, device->attempts);
+        }
+        else
+        {
+            device->state = QLIB_SAMPLE_FLEET_DEVICE__FAILED;
+        }
+
+        /*-------------------------------------------------------------------------------------------------*/
+        /* The packet thread leaves a device that lost its connection while provisioning to its worker.    */
+        /* A finished device is disconnected, so its packet thread removes it                              */
+        /*-------------------------------------------------------------------------------------------------*/
+        if (FALSE == device->connected)
+        {
+            QLIB_SAMPLE_FLEET_RemoveDevice_L(fleet, device);
+        }
+        else if ((QLIB_SAMPLE_FLEET_DEVICE__DONE == device->state) || (QLIB_SAMPLE_FLEET_DEVICE__FAILED == device->state))
+        {
+            (void)shutdown(device->socket, SHUT_RDWR);
+        }
+    }
+
+    (void)pthread_mutex_unlock(&fleet->lock);
+
+    return NULL;
+}
+
+/************************************************************************************************************
+ * @brief       This function provisions a single registered device: QCONF configuration (which includes
+ *              the device configuration) followed by loading the provisioned keys into the client context
+ *
+ * @param[in]   device  Fleet device object
+ *
+ * @return      QLIB_STATUS__OK if no error occurred, QLIB_STATUS__(ERROR) otherwise
+************************************************************************************************************/
+static QLIB_STATUS_T QLIB_SAMPLE_FLEET_Provision_L(QLIB_SAMPLE_FLEET_DEVICE_T* device)
+{
+    QLIB_STATUS_T ret;
+
+    ret = QLIB_SAMPLE_QconfConfig(&device->client.qlibContext);
+    if (QLIB_STATUS__OK != ret)
+    {
+        /*-------------------------------------------------------------------------------------------------*/
+        /* Release the bus so the next attempt starts from a clean state                                   */
+        /*-------------------------------------------------------------------------------------------------*/
+        (void)QLIB_Disconnect(&device->client.qlibContext);
+        return ret;
+    }
+
+    return QLIB_SERVER_LoadKeys(&device->client);
+}
+
+/************************************************************************************************************
+ * @brief       This function calculates the delay before the next provisioning attempt
+ *
+ * @param[in]   config      Fleet configuration
+ * @param[in]   attempts    Number of attempts made so far
+ *
+ * @return      Delay in milliseconds
+************************************************************************************************************/
+static U32 QLIB_SAMPLE_FLEET_BackoffMs_L(const QLIB_SAMPLE_FLEET_CONFIG_T* config, U32 attempts)
+{
+    U64 delay = config->backoffBaseMs;
+
+    while (1u < attempts-- && delay < config->backoffMaxMs)
+    {
+        delay <<= 1u;
+    }
+
+    return (U32)((delay < config->backoffMaxMs) ? delay : config->backoffMaxMs);
+}
+
+/************************************************************************************************************
+ * @brief       Device cache and in-flight requests lock callback
+ *
+ * @param[in]   lockArg     Mutex
+ * @param[in]   lock        TRUE to lock, FALSE to unlock
+************************************************************************************************************/
+static void QLIB_SAMPLE_FLEET_Lock_L(void* lockArg, BOOL lock)
+{
+    if (TRUE == lock)
+    {
+        (void)pthread_mutex_lock((pthread_mutex_t*)lockArg);
+    }
+    else
+    {
+        (void)pthread_mutex_unlock((pthread_mutex_t*)lockArg);
+    }
+}
+
+/************************************************************************************************************
+ * @brief       This function removes a disconnected device from the fleet, counts its outcome and frees
+ *              it. Must be called with the fleet lock held, once no thread uses the device
+ *
+ * @param[in]   fleet       Fleet object
+ * @param[in]   device      Fleet device object
+************************************************************************************************************/
+static void QLIB_SAMPLE_FLEET_RemoveDevice_L(QLIB_SAMPLE_FLEET_T* fleet, QLIB_SAMPLE_FLEET_DEVICE_T* device)
+{
+    U32 i;
+
+    for (i = 0; i < fleet->numDevices; i++)
+    {
+        if (device == fleet->devices[i])
+        {
+            fleet->devices[i]                   = fleet->devices[fleet->numDevices - 1u];
+            fleet->devices[--fleet->numDevices] = NULL;
+            break;
+        }
+    }
+
+    if (QLIB_SAMPLE_FLEET_DEVICE__DONE == device->state)
+    {
+        fleet->metrics.succeeded++;
+    }
+    else
+    {
+        fleet->metrics.failed++;
+    }
+
+    (void)close(device->socket);
+    (void)pthread_mutex_destroy(&device->inFlightLock);
+    (void)pthread_mutex_destroy(&device->registrationLock);
+    FREE(device);
+}
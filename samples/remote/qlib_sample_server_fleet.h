@@ -0,0 +1,169 @@
+/************************************************************************************************************
+ * @internal
+ * @remark     Winbond Electronics Corporation - Confidential
+ * @copyright  Copyright (c) 2024 by Winbond Electronics Corporation . All rights reserved
+ * @endinternal
+ *
+ * @file       qlib_sample_server_fleet.h
+ * @brief      This file includes sample QLIB server fleet provisioning definitions
+ *
+ * ### project qlib
+ *
+ ***********************************************************************************************************/
+#ifndef __QLIB_SAMPLE_SERVER_FLEET_H__
+#define __QLIB_SAMPLE_SERVER_FLEET_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*---------------------------------------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------------------------------------*/
+/*                                                INCLUDES                                                 */
+/*---------------------------------------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------------------------------------*/
+#include <pthread.h>
+
+#include "qlib.h"
+#include "qlib_server.h"
+
+/*---------------------------------------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------------------------------------*/
+/*                                               DEFINITIONS                                               */
+/*---------------------------------------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------------------------------------*/
+#ifndef QLIB_SAMPLE_FLEET_MAX_DEVICES
+#define QLIB_SAMPLE_FLEET_MAX_DEVICES 512
+#endif
+
+#ifndef QLIB_SAMPLE_FLEET_MAX_WORKERS
+#define QLIB_SAMPLE_FLEET_MAX_WORKERS 32
+#endif
+
+/*---------------------------------------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------------------------------------*/
+/*                                                  TYPES                                                  */
+/*---------------------------------------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------------------------------------*/
+
+// Provisioning state of a single device
+typedef enum
+{
+    QLIB_SAMPLE_FLEET_DEVICE__WAIT_REGISTRATION, // connected, registration packet not received yet
+    QLIB_SAMPLE_FLEET_DEVICE__READY,             // registered, waiting for a free worker
+    QLIB_SAMPLE_FLEET_DEVICE__PROVISIONING,      // a worker is provisioning the device
+    QLIB_SAMPLE_FLEET_DEVICE__BACKOFF,           // last attempt failed, waiting before retry
+    QLIB_SAMPLE_FLEET_DEVICE__DONE,              // provisioned successfully
+    QLIB_SAMPLE_FLEET_DEVICE__FAILED,            // retries exhausted or connection lost
+} QLIB_SAMPLE_FLEET_DEVICE_STATE_T;
+
+// Fleet configuration
+typedef struct
+{
+    U32 numWorkers;    // maximal number of devices provisioned concurrently
+    U32 maxAttempts;   // maximal number of provisioning attempts per device
+    U32 backoffBaseMs; // delay before the first retry, doubled on every retry
+    U32 backoffMaxMs;  // maximal delay between retries
+} QLIB_SAMPLE_FLEET_CONFIG_T;
+
+// Aggregate progress metrics
+typedef struct
+{
+    U32 connected;        // devices connected to the server
+    U32 waiting;          // devices waiting for registration, a worker or a retry
+    U32 inProgress;       // devices being provisioned
+    U32 succeeded;        // devices provisioned successfully
+    U32 failed;           // devices that failed provisioning
+    U32 retries;          // total number of retried attempts
+    U32 cacheHits;        // registrations served from the device cache
+    U64 elapsedMs;        // time since the fleet started
+    U64 totalProvisionMs; // sum of successful provisioning durations
+} QLIB_SAMPLE_FLEET_METRICS_T;
+
+// Device object. The client must be the first field, it is used to find the device from client callbacks
+typedef struct
+{
+    QLIB_SERVER_CLIENT_T             client;
+    pthread_mutex_t                  inFlightLock;
+    pthread_mutex_t                  registrationLock; // held while the context is registered or provisioned
+    BOOL                             connected;
+    BOOL                             restart; // registered again while provisioning, restart without an attempt
+    int                              socket;
+    pthread_t                        packetThread;
+    QLIB_SAMPLE_FLEET_DEVICE_STATE_T state;
+    U32                              attempts;
+    U64                              nextAttemptMs;
+    U64                              provisionStartMs;
+    QLIB_STATUS_T                    lastStatus;
+    struct _QLIB_SAMPLE_FLEET_T*     fleet;
+} QLIB_SAMPLE_FLEET_DEVICE_T;
+
+// Fleet object
+typedef struct _QLIB_SAMPLE_FLEET_T
+{
+    QLIB_SAMPLE_FLEET_CONFIG_T     config;
+    QLIB_SAMPLE_FLEET_DEVICE_T*    devices[QLIB_SAMPLE_FLEET_MAX_DEVICES];
+    U32                            numDevices;
+    pthread_t                      workers[QLIB_SAMPLE_FLEET_MAX_WORKERS];
+    pthread_mutex_t                lock;
+    pthread_cond_t                 wakeup;
+    BOOL                           stop;
+    U64                            startMs;
+    QLIB_SAMPLE_FLEET_METRICS_T    metrics;
+    QLIB_SERVER_CLIENT_CALLBACKS_T callbacks;
+    QLIB_SERVER_DEVICE_CACHE_T     deviceCache;
+    pthread_mutex_t                cacheLock;
+    U32                            customBuf[1024 / sizeof(U32)];
+} QLIB_SAMPLE_FLEET_T;
+
+/*---------------------------------------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------------------------------------*/
+/*                                                   API                                                   */
+/*---------------------------------------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------------------------------------*/
+
+/************************************************************************************************************
+ * @brief       This function initializes the fleet and starts its provisioning workers
+ *
+ * @param[out]  fleet       Fleet object
+ * @param[in]   config      Fleet configuration
+ *
+ * @return      QLIB_STATUS__OK if no error occurred, QLIB_STATUS__(ERROR) otherwise
+************************************************************************************************************/
+QLIB_STATUS_T QLIB_SAMPLE_FLEET_Start(QLIB_SAMPLE_FLEET_T* fleet, const QLIB_SAMPLE_FLEET_CONFIG_T* config);
+
+/************************************************************************************************************
+ * @brief       This function adds a newly connected client to the fleet. The device is provisioned by
+ *              one of the workers once its registration is completed
+ *
+ * @param[in]   fleet       Fleet object
+ * @param[in]   socket      Socket of the connected client
+ *
+ * @return      QLIB_STATUS__OK if no error occurred, QLIB_STATUS__(ERROR) otherwise
+************************************************************************************************************/
+QLIB_STATUS_T QLIB_SAMPLE_FLEET_AddClient(QLIB_SAMPLE_FLEET_T* fleet, int socket);
+
+/************************************************************************************************************
+ * @brief       This function returns a snapshot of the fleet progress metrics
+ *
+ * @param[in]   fleet       Fleet object
+ * @param[out]  metrics     Progress metrics
+ *
+ * @return      QLIB_STATUS__OK if no error occurred, QLIB_STATUS__(ERROR) otherwise
+************************************************************************************************************/
+QLIB_STATUS_T QLIB_SAMPLE_FLEET_GetMetrics(QLIB_SAMPLE_FLEET_T* fleet, QLIB_SAMPLE_FLEET_METRICS_T* metrics);
+
+/************************************************************************************************************
+ * @brief       This function stops the provisioning workers. Devices being provisioned are completed first
+ *
+ * @param[in]   fleet       Fleet object
+ *
+ * @return      QLIB_STATUS__OK if no error occurred, QLIB_STATUS__(ERROR) otherwise
+************************************************************************************************************/
+QLIB_STATUS_T QLIB_SAMPLE_FLEET_Stop(QLIB_SAMPLE_FLEET_T* fleet);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //__QLIB_SAMPLE_SERVER_FLEET_H__
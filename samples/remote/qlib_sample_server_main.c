@@ -32,6 +32,7 @@
 #include "qlib_sample_server_client_common.h"
 #include "qlib_sample_qconf.h"
 #include "qlib_sample_secure_storage.h"
+#include "qlib_sample_server_fleet.h"
 
 /*---------------------------------------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------------------------------------*/
@@ -51,7 +52,8 @@ typedef enum
 /*                                                 GLOBALS                                                 */
 /*---------------------------------------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------------------------------------*/
-static SERVER_STATE_T state;
+static SERVER_STATE_T  state;
+static pthread_mutex_t inFlightLock = PTHREAD_MUTEX_INITIALIZER;
 
 /*---------------------------------------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------------------------------------*/
@@ -81,6 +83,15 @@ static SERVER_STATE_T state;
         }                                          \
     }
 
+/*---------------------------------------------------------------------------------------------------------*/
+/* Fleet mode parameters                                                                                   */
+/*---------------------------------------------------------------------------------------------------------*/
+#define FLEET_DEFAULT_WORKERS     8
+#define FLEET_MAX_ATTEMPTS        3
+#define FLEET_BACKOFF_BASE_MS     500
+#define FLEET_BACKOFF_MAX_MS      8000
+#define FLEET_PROGRESS_PERIOD_SEC 5
+
 #ifndef PRINT_BUF
 #define PRINT_BUF(buf, size)                                           \
     {                                                                  \
@@ -157,18 +168,36 @@ QLIB_STATUS_T OnRegistration(struct _QLIB_SERVER_CLIENT_T* client)
 }
 
 /************************************************************************************************************
- * @brief   Custom packet callback
+ * @brief   In-flight requests lock callback, requests are sent by the main thread and their responses are
+ *          received by the packet processing thread
+ *
+ * @param[in]   lockArg     Mutex
+ * @param[in]   lock        TRUE to lock, FALSE to unlock
+************************************************************************************************************/
+void InFlightLock(void* lockArg, BOOL lock)
+{
+    if (TRUE == lock)
+    {
+        (void)pthread_mutex_lock((pthread_mutex_t*)lockArg);
+    }
+    else
+    {
+        (void)pthread_mutex_unlock((pthread_mutex_t*)lockArg);
+    }
+}
+
+/************************************************************************************************************
+ * @brief   Creates a listening socket
  *
  * @param[in]   port    Port number
- * @param[out]  sock    Pointer to the new socket handler
+ * @param[out]  sock    Pointer to the new listening socket handler
  *
  * @return  0 on successful termination
 ************************************************************************************************************/
-int OpenListenerSocket(char* port, int* sock)
+int CreateListenerSocket(char* port, int* sock)
 {
     int              iResult;
     int              listenSocket = -1;
-    int              clientSocket = -1;
     struct addrinfo* result       = NULL;
     struct addrinfo  hints;
 
@@ -216,6 +245,28 @@ int OpenListenerSocket(char* port, int* sock)
         return 1;
     }
 
+    *sock = listenSocket;
+    return 0;
+}
+
+/************************************************************************************************************
+ * @brief   Opens a listening socket and accepts a single client
+ *
+ * @param[in]   port    Port number
+ * @param[out]  sock    Pointer to the new socket handler
+ *
+ * @return  0 on successful termination
+************************************************************************************************************/
+int OpenListenerSocket(char* port, int* sock)
+{
+    int listenSocket = -1;
+    int clientSocket = -1;
+
+    if (CreateListenerSocket(port, &listenSocket))
+    {
+        return 1;
+    }
+
     // Accept a client socket
     clientSocket = accept(listenSocket, NULL, NULL);
     if (clientSocket == -1)
@@ -229,6 +280,95 @@ int OpenListenerSocket(char* port, int* sock)
     return 0;
 }
 
+/************************************************************************************************************
+ * @brief   Fleet progress printing thread
+ *
+ * @param   data    Fleet object
+ *
+ * @return NULL
+************************************************************************************************************/
+void* FleetProgressThread(void* data)
+{
+    QLIB_SAMPLE_FLEET_T*        fleet = (QLIB_SAMPLE_FLEET_T*)data;
+    QLIB_SAMPLE_FLEET_METRICS_T metrics;
+
+    while (1)
+    {
+        sleep(FLEET_PROGRESS_PERIOD_SEC);
+        if (QLIB_STATUS__OK != QLIB_SAMPLE_FLEET_GetMetrics(fleet, &metrics))
+        {
+            continue;
+        }
+
+        COLOR_PRINTF(TEXT_COLOR_YELLOW,
+                     "Fleet: %lu connected, %lu waiting, %lu in progress, %lu done, %lu failed, %lu retries, "
+                     "%lu cache hits, %lu devices/hour, %lu ms average\r\n",
+                     (unsigned long)metrics.connected,
+                     (unsigned long)metrics.waiting,
+                     (unsigned long)metrics.inProgress,
+                     (unsigned long)metrics.succeeded,
+                     (unsigned long)metrics.failed,
+                     (unsigned long)metrics.retries,
+                     (unsigned long)metrics.cacheHits,
+                     (unsigned long)((0 != metrics.elapsedMs) ? ((U64)metrics.succeeded * 3600000u) / metrics.elapsedMs : 0),
+                     (unsigned long)((0 != metrics.succeeded) ? metrics.totalProvisionMs / metrics.succeeded : 0));
+    }
+
+    return NULL;
+}
+
+/************************************************************************************************************
+ * @brief   Provisions every client that connects, using a bounded number of concurrent workers
+ *
+ * @param[in]   port        Port number
+ * @param[in]   numWorkers  Number of devices provisioned concurrently
+ *
+ * @return  0 on successful termination
+************************************************************************************************************/
+int RunFleet(char* port, U32 numWorkers)
+{
+    static QLIB_SAMPLE_FLEET_T fleet;
+    QLIB_SAMPLE_FLEET_CONFIG_T config = {numWorkers, FLEET_MAX_ATTEMPTS, FLEET_BACKOFF_BASE_MS, FLEET_BACKOFF_MAX_MS};
+    pthread_t                  thread_id;
+    int                        listenSocket;
+    int                        clientSocket;
+
+    if (CreateListenerSocket(port, &listenSocket))
+    {
+        return 1;
+    }
+
+    STATUS_RET_CHECK_RETURN_1(QLIB_SAMPLE_FLEET_Start(&fleet, &config), "Fleet start FAILED.\r\n");
+    if (0 != pthread_create(&thread_id, NULL, FleetProgressThread, &fleet))
+    {
+        COLOR_PRINTF(TEXT_COLOR_RED, "Fleet progress thread creation FAILED.\r\n");
+        close(listenSocket);
+        (void)QLIB_SAMPLE_FLEET_Stop(&fleet);
+        return 1;
+    }
+
+    while (1)
+    {
+        clientSocket = accept(listenSocket, NULL, NULL);
+        if (clientSocket == -1)
+        {
+            COLOR_PRINTF(TEXT_COLOR_RED, "accept failed with error: %s\n", strerror(errno));
+            break;
+        }
+
+        if (QLIB_STATUS__OK != QLIB_SAMPLE_FLEET_AddClient(&fleet, clientSocket))
+        {
+            COLOR_PRINTF(TEXT_COLOR_RED, "Adding client to fleet FAILED.\r\n");
+            close(clientSocket);
+        }
+    }
+
+    close(listenSocket);
+    (void)QLIB_SAMPLE_FLEET_Stop(&fleet);
+
+    return 1;
+}
+
 /*---------------------------------------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------------------------------------*/
 /*                                               ENTRY POINT                                               */
@@ -239,7 +379,8 @@ int OpenListenerSocket(char* port, int* sock)
  * @brief   MAIN ENTRY POINT
  *
  * @param   argc
- * @param   argv
+ * @param   argv    "--fleet [workers]" provisions every connecting client, otherwise a single client runs
+ *                  the samples
  *
  * @return  0 on successful termination
 ************************************************************************************************************/
@@ -253,10 +394,12 @@ int main(int argc, char** argv)
     int                            sock;
 
     /*-----------------------------------------------------------------------------------------------------*/
-    /* Unused parameters                                                                                   */
+    /* Fleet mode                                                                                          */
     /*-----------------------------------------------------------------------------------------------------*/
-    TOUCH(argc);
-    TOUCH(argv);
+    if (argc > 1 && 0 == strcmp(argv[1], "--fleet"))
+    {
+        return RunFleet(port, (argc > 2) ? (U32)strtoul(argv[2], NULL, 0) : FLEET_DEFAULT_WORKERS);
+    }
 
     /*-----------------------------------------------------------------------------------------------------*/
     /* Setup globals                                                                                       */
@@ -275,6 +418,7 @@ int main(int argc, char** argv)
     /* Initialize client                                                                                   */
     /*-----------------------------------------------------------------------------------------------------*/
     STATUS_RET_CHECK_RETURN_1(QLIB_SERVER_InitClient(&client, (void*)(intptr_t)sock, &callbacks), "Init client FAILED.\r\n");
+    STATUS_RET_CHECK_RETURN_1(QLIB_SERVER_SetInFlightLock(&client, InFlightLock, &inFlightLock), "Init client FAILED.\r\n");
 
     /*-----------------------------------------------------------------------------------------------------*/
     /* Initialize Qlib                                                                                     */
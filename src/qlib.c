@@ -28,6 +28,25 @@
 /*---------------------------------------------------------------------------------------------------------*/
 #define QLIB_DEVICE_INITIALIZED(qlibContext) ((qlibContext)->busInterface.busMode != QLIB_BUS_MODE_INVALID)
 
+// Section index used to invalidate the views or flush the write combining buffer of all sections
+#define QLIB_ALL_SECTIONS QLIB_NUM_OF_SECTIONS
+
+// Interval between busy polls of a read waiting for the background erase
+#define QLIB_BG_ERASE_POLL_US 100u
+
+// Maximal number of busy polls of a die when QLIB_RunDieOperations fails, a die still busy keeps its busy state
+#define QLIB_DIE_SCHED_ERROR_NUM_POLLS 0x10000u
+
+// Number of pages in a flash sector
+#define QLIB_PAGES_PER_SECTOR (FLASH_SECTOR_SIZE / FLASH_PAGE_SIZE)
+
+// Multi-die commands are waited for only with XIP, see QLIB_DieSched_Step_L
+#ifdef QLIB_SUPPORT_XIP
+#define QLIB_DIE_SCHED_BLOCKING TRUE
+#else
+#define QLIB_DIE_SCHED_BLOCKING FALSE
+#endif
+
 #ifdef Q2_API
 #ifdef QLIB_INIT_AFTER_FLASH_POWER_UP
 #define QLIB_INIT_AFTER_Q2_POWER_UP
@@ -52,6 +71,14 @@ typedef enum
         ((U8)QLIB_LOAD_ACLR_NON_AUTH |
          (U8)QLIB_LOAD_ACLR_PLAIN_WR), // load SSPR to ACLR only if non-authenticated plain write is configured for section
 } QLIB_LOAD_ACLR_T;
+
+#if QLIB_NUM_OF_DIES > 1
+typedef struct
+{
+    U32 op;   // index of the operation in progress, number of operations when the die has no more work
+    U32 done; // size of the operation in progress already issued
+} QLIB_DIE_SCHED_T;
+#endif
 /*---------------------------------------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------------------------------------*/
 /*                                        LOCAL FUNCTION PROTOTYPES                                        */
@@ -60,7 +87,56 @@ typedef enum
 
 static QLIB_STATUS_T QLIB_waitReadyAndInitBusMode_L(QLIB_CONTEXT_T* qlibContext);
 static QLIB_STATUS_T QLIB_PlainAccessGrant_L(QLIB_CONTEXT_T* qlibContext, U32 sectionID, QLIB_LOAD_ACLR_T condition);
+static void          QLIB_PlainAccessMark_L(QLIB_CONTEXT_T*      qlibContext,
+                                           U32                  sectionID,
+                                           const QLIB_POLICY_T* policy,
+                                           BOOL                 integrityErr);
 static QLIB_STATUS_T QLIB_GetTargetFlash_L(QLIB_HW_VER_T* hwVer, U32* target);
+static QLIB_STATUS_T QLIB_AutotuneSet_L(QLIB_CONTEXT_T* qlibContext, QLIB_BUS_FORMAT_T busFormat, U8 dummyCycles);
+static QLIB_STATUS_T QLIB_AutotuneCheck_L(QLIB_CONTEXT_T* qlibContext, const QLIB_AUTOTUNE_CONFIG_T* config, const U8* expected, BOOL* pass);
+static QLIB_STATUS_T QLIB_EraseRange_L(QLIB_CONTEXT_T* qlibContext, const QLIB_ERASE_RANGE_T* range, BOOL secure);
+static QLIB_STATUS_T QLIB_PreparePlainRead_L(QLIB_CONTEXT_T* qlibContext, U32 sectionID, U32 offset, U32 size);
+static QLIB_STATUS_T QLIB_View_GetPage_L(QLIB_VIEW_T* view, U32 pageOffset, const U8** data);
+static void          QLIB_ViewInvalidate_L(QLIB_CONTEXT_T* qlibContext, U32 sectionID, U32 offset, U32 size);
+static QLIB_STATUS_T QLIB_WriteCombine_Put_L(QLIB_CONTEXT_T* qlibContext, const U8* buf, U32 sectionID, U32 offset, U32 size);
+static QLIB_STATUS_T QLIB_WriteCombine_Flush_L(QLIB_CONTEXT_T* qlibContext, BOOL expiredOnly);
+static QLIB_STATUS_T QLIB_WriteCombine_Sync_L(QLIB_CONTEXT_T* qlibContext, U32 sectionID, U32 offset, U32 size);
+#ifndef EXCLUDE_W77Q_RNG_FEATURE
+static QLIB_STATUS_T QLIB_EntropyPool_Refill_L(QLIB_CONTEXT_T* qlibContext);
+#endif
+#ifndef EXCLUDE_SECURE_LOG
+static QLIB_STATUS_T QLIB_SecureLogWriter_Commit_L(QLIB_CONTEXT_T*           qlibContext,
+                                                   QLIB_SECURE_LOG_WRITER_T* writer,
+                                                   BOOL                      expiredOnly);
+#endif
+static QLIB_STATUS_T QLIB_PreparePlainErase_L(QLIB_CONTEXT_T* qlibContext, U32 sectionID, U32 offset, U32 size);
+static QLIB_STATUS_T QLIB_BgErase_Update_L(QLIB_BG_ERASE_T* bgErase, BOOL startNext);
+static QLIB_STATUS_T QLIB_BgErase_Read_L(QLIB_BG_ERASE_T* bgErase, U8* buf, U32 sectionID, U32 offset, U32 size);
+static QLIB_STATUS_T QLIB_BgErase_Attach_L(QLIB_BG_ERASE_T* bgErase, QLIB_STATUS_T status);
+#if QLIB_NUM_OF_DIES > 1
+static U32           QLIB_DieSched_NextOp_L(const QLIB_DIE_OP_T* ops, U32 numOps, U8 die, U32 first);
+static QLIB_STATUS_T QLIB_DieSched_Step_L(QLIB_CONTEXT_T* qlibContext, const QLIB_DIE_OP_T* ops, U32 numOps, QLIB_DIE_SCHED_T* sched);
+#endif
+static QLIB_STATUS_T QLIB_ComparePage_L(QLIB_CONTEXT_T* qlibContext,
+                                        const U8*       buf,
+                                        U32             sectionID,
+                                        U32             offset,
+                                        U32             size,
+                                        BOOL            secure,
+                                        BOOL*           identical);
+static QLIB_STATUS_T QLIB_PageCRC_L(const U8* buf, U32* crc);
+static QLIB_STATUS_T QLIB_ReadPageCRCs_L(QLIB_CONTEXT_T* qlibContext,
+                                         U32             sectionID,
+                                         U32             offset,
+                                         U32             numPages,
+                                         BOOL            secure,
+                                         U32*            crcs);
+static QLIB_STATUS_T QLIB_WriteSector_L(QLIB_CONTEXT_T* qlibContext,
+                                        const U8*       buf,
+                                        U32             sectionID,
+                                        U32             offset,
+                                        BOOL            secure,
+                                        U32*            pagesSkipped);
 
 #ifdef Q2_API
 #ifdef __cplusplus
@@ -96,6 +172,18 @@ QLIB_STATUS_T QLIB_InitLib(QLIB_CONTEXT_T* qlibContext)
     /*-----------------------------------------------------------------------------------------------------*/
     (void)memset(qlibContext, 0, sizeof(QLIB_CONTEXT_T));
 
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Start with typical erase times until calibrated                                                     */
+    /*-----------------------------------------------------------------------------------------------------*/
+    qlibContext->eraseCost.timeUs[QLIB_ERASE_COST_INDEX(QLIB_ERASE_SECTOR_4K)] = QLIB_ERASE_TIME_US__SECTOR_4K;
+    qlibContext->eraseCost.timeUs[QLIB_ERASE_COST_INDEX(QLIB_ERASE_BLOCK_32K)] = QLIB_ERASE_TIME_US__BLOCK_32K;
+    qlibContext->eraseCost.timeUs[QLIB_ERASE_COST_INDEX(QLIB_ERASE_BLOCK_64K)] = QLIB_ERASE_TIME_US__BLOCK_64K;
+    qlibContext->eraseCost.timeUs[QLIB_ERASE_COST_INDEX(QLIB_ERASE_SECTION)]   = QLIB_ERASE_TIME_US__SECTION_64K;
+
+#ifdef QLIB_MAX_SPI_INPUT_SIZE
+    qlibContext->readChunkSize = QLIB_MAX_SPI_INPUT_SIZE;
+#endif
+
     /*-----------------------------------------------------------------------------------------------------*/
     /* Initiate the standard module                                                                        */
     /*-----------------------------------------------------------------------------------------------------*/
@@ -168,6 +256,7 @@ QLIB_STATUS_T QLIB_InitDevice(QLIB_CONTEXT_T* qlibContext, QLIB_BUS_FORMAT_T bus
 
     // set configuration table according to detected device
     QLIB_STATUS_RET_CHECK(QLIB_Cfg_Init(qlibContext));
+    QLIB_STD_UpdateCmdTable(qlibContext);
 
 #if !defined QLIB_INIT_AFTER_FLASH_POWER_UP && QLIB_NUM_OF_DIES > 1
     {
@@ -192,85 +281,128 @@ QLIB_STATUS_T QLIB_InitDevice(QLIB_CONTEXT_T* qlibContext, QLIB_BUS_FORMAT_T bus
     return QLIB_STATUS__OK;
 }
 
-QLIB_STATUS_T QLIB_Read(QLIB_CONTEXT_T* qlibContext, U8* buf, U32 sectionID, U32 offset, U32 size, BOOL secure, BOOL auth)
+QLIB_STATUS_T QLIB_InitDeviceAutotune(QLIB_CONTEXT_T*               qlibContext,
+                                      QLIB_BUS_FORMAT_T             busFormat,
+                                      const QLIB_AUTOTUNE_CONFIG_T* config,
+                                      QLIB_AUTOTUNE_RESULT_T*       result)
 {
+    U8                reference[QLIB_AUTOTUNE_MAX_PATTERN_SIZE];
+    const U8*         expected = NULL;
+    QLIB_BUS_FORMAT_T candidate;
+    U8                baseDummy;
+    U8                minDummy;
+    U8                maxDummy;
+    U8                dummy;
+    BOOL              pass = FALSE;
+    U32               cycles;
+    U32               i;
+    U32               j;
+
     /*-----------------------------------------------------------------------------------------------------*/
     /* Error checking                                                                                      */
     /*-----------------------------------------------------------------------------------------------------*/
     QLIB_ASSERT_RET(NULL != qlibContext, QLIB_STATUS__INVALID_PARAMETER);
-    QLIB_ASSERT_RET(QLIB_DEVICE_INITIALIZED(qlibContext), QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE);
-    QLIB_ASSERT_RET(0u < size, QLIB_STATUS__PARAMETER_OUT_OF_RANGE);
-    QLIB_ASSERT_RET((offset + size) >= size, QLIB_STATUS__INVALID_PARAMETER);
-    QLIB_ASSERT_RET(QLIB_NUM_OF_SECTIONS > sectionID, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET(NULL != config, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET(NULL != result, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET((NULL != config->busFormats) || (0u == config->numBusFormats), QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET((0u < config->size) && (config->size <= QLIB_AUTOTUNE_MAX_PATTERN_SIZE), QLIB_STATUS__PARAMETER_OUT_OF_RANGE);
 
-    if (TRUE == secure)
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Initialize the device with the initial (conservative) bus format                                    */
+    /*-----------------------------------------------------------------------------------------------------*/
+    QLIB_STATUS_RET_CHECK(QLIB_InitDevice(qlibContext, busFormat));
+
+    baseDummy = qlibContext->fastReadDummy;
+    if (W77Q_FAST_READ_DUMMY_CONFIG(qlibContext) != 0u)
     {
-        QLIB_ASSERT_RET((W77Q_VAULT(qlibContext) != 0u) || (QLIB_SECTION_ID_VAULT != sectionID), QLIB_STATUS__INVALID_PARAMETER);
-        QLIB_ASSERT_RET((offset + size) <= QLIB_CALC_SECTION_SIZE(qlibContext, sectionID), QLIB_STATUS__PARAMETER_OUT_OF_RANGE);
-        return QLIB_SEC_Read(qlibContext, buf, sectionID, offset, size, auth);
+        QLIB_ASSERT_RET((0u < config->minDummyCycles) && (config->minDummyCycles <= config->maxDummyCycles) &&
+                            (config->maxDummyCycles <= 30u),
+                        QLIB_STATUS__INVALID_PARAMETER);
+        minDummy = config->minDummyCycles;
+        maxDummy = config->maxDummyCycles;
     }
     else
     {
-        U32 section = QLIB_FALLBACK_SECTION(qlibContext, sectionID);
-        QLIB_ASSERT_RET(sectionID < QLIB_SECTION_ID_VAULT, QLIB_STATUS__INVALID_PARAMETER);
-        QLIB_ASSERT_RET((offset + size) <= _QLIB_MAX_LEGACY_OFFSET(qlibContext), QLIB_STATUS__PARAMETER_OUT_OF_RANGE);
-        QLIB_ASSERT_RET((offset + size) <= QLIB_CALC_SECTION_SIZE(qlibContext, section), QLIB_STATUS__PARAMETER_OUT_OF_RANGE);
-#if QLIB_NUM_OF_DIES > 1
-        QLIB_ASSERT_RET(qlibContext->activeDie == QLIB_INIT_DIE_ID || qlibContext->addrMode == QLIB_STD_ADDR_MODE__4_BYTE,
-                        QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE);
-#endif
-        if ((QLIB_ACTIVE_DIE_STATE(qlibContext).sectionsState[section].plainEnabled & QLIB_SECTION_PLAIN_EN_RD) == 0u)
-        {
-            QLIB_STATUS_RET_CHECK(QLIB_PlainAccessGrant_L(qlibContext,
-                                                          section,
-                                                          W77Q_CMD_PA_GRANT_REVOKE(qlibContext) != 0u
-                                                              ? QLIB_LOAD_ACLR_PLAIN_RD
-                                                              : QLIB_LOAD_ACLR_NON_AUTH_PLAIN_RD));
-        }
-        return QLIB_STD_Read(qlibContext, buf, QLIB_MAKE_LOGICAL_ADDRESS(qlibContext, sectionID, offset), size);
+        minDummy = baseDummy;
+        maxDummy = baseDummy;
     }
-}
 
-QLIB_STATUS_T QLIB_Write(QLIB_CONTEXT_T* qlibContext, const U8* buf, U32 sectionID, U32 offset, U32 size, BOOL secure)
-{
     /*-----------------------------------------------------------------------------------------------------*/
-    /* Error checking                                                                                      */
+    /* Get the expected pattern                                                                            */
     /*-----------------------------------------------------------------------------------------------------*/
-    QLIB_ASSERT_RET(NULL != qlibContext, QLIB_STATUS__INVALID_PARAMETER);
-    QLIB_ASSERT_RET(QLIB_DEVICE_INITIALIZED(qlibContext), QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE);
-    QLIB_ASSERT_RET(0u < size, QLIB_STATUS__PARAMETER_OUT_OF_RANGE);
-    QLIB_ASSERT_RET((offset + size) >= size, QLIB_STATUS__INVALID_PARAMETER);
-    QLIB_ASSERT_RET(QLIB_NUM_OF_SECTIONS > sectionID, QLIB_STATUS__INVALID_PARAMETER);
-
-    if (TRUE == secure)
+    if (NULL != config->pattern)
     {
-        QLIB_ASSERT_RET((W77Q_VAULT(qlibContext) != 0u) || (QLIB_SECTION_ID_VAULT != sectionID), QLIB_STATUS__INVALID_PARAMETER);
-        QLIB_ASSERT_RET((offset + size) <= QLIB_CALC_SECTION_SIZE(qlibContext, sectionID), QLIB_STATUS__PARAMETER_OUT_OF_RANGE);
-        return QLIB_SEC_Write(qlibContext, buf, sectionID, offset, size);
+        expected = config->pattern;
     }
     else
     {
-        U32 section = QLIB_FALLBACK_SECTION(qlibContext, sectionID);
-        QLIB_ASSERT_RET(sectionID < QLIB_SECTION_ID_VAULT, QLIB_STATUS__INVALID_PARAMETER);
-        QLIB_ASSERT_RET((offset + size) <= _QLIB_MAX_LEGACY_OFFSET(qlibContext), QLIB_STATUS__PARAMETER_OUT_OF_RANGE);
-        QLIB_ASSERT_RET((offset + size) <= QLIB_CALC_SECTION_SIZE(qlibContext, section), QLIB_STATUS__PARAMETER_OUT_OF_RANGE);
-#if QLIB_NUM_OF_DIES > 1
-        QLIB_ASSERT_RET(qlibContext->activeDie == QLIB_INIT_DIE_ID || qlibContext->addrMode == QLIB_STD_ADDR_MODE__4_BYTE,
-                        QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE);
-#endif
-        if ((QLIB_ACTIVE_DIE_STATE(qlibContext).sectionsState[section].plainEnabled & QLIB_SECTION_PLAIN_EN_WR) == 0u)
+        QLIB_STATUS_RET_CHECK(QLIB_Read(qlibContext, reference, config->sectionID, config->offset, config->size, FALSE, FALSE));
+        expected = reference;
+    }
+
+    result->busFormat   = busFormat;
+    result->dummyCycles = baseDummy;
+    result->readCycles  = QLIB_STD_GetReadCycles(qlibContext, FLASH_PAGE_SIZE);
+    result->numTested   = 0;
+    result->numPassed   = 0;
+
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Try the candidates, keep the one with the least read cycles that passes the pattern check           */
+    /*-----------------------------------------------------------------------------------------------------*/
+    for (i = 0; i < config->numBusFormats; i++)
+    {
+        candidate = config->busFormats[i];
+
+        // a read that fails with some dummy cycles value also fails with any smaller value
+        for (j = 0; j <= (U32)(maxDummy - minDummy); j++)
         {
-            QLIB_STATUS_RET_CHECK(QLIB_PlainAccessGrant_L(qlibContext,
-                                                          section,
-                                                          W77Q_CMD_PA_GRANT_REVOKE(qlibContext) != 0u
-                                                              ? QLIB_LOAD_ACLR_PLAIN_WR
-                                                              : QLIB_LOAD_ACLR_NON_AUTH_PLAIN_WR));
+            dummy = (U8)(maxDummy - j);
+            result->numTested++;
+
+            if (QLIB_STATUS__OK == QLIB_AutotuneSet_L(qlibContext, candidate, dummy))
+            {
+                if (QLIB_STATUS__OK != QLIB_AutotuneCheck_L(qlibContext, config, expected, &pass))
+                {
+                    pass = FALSE;
+                }
+            }
+            else
+            {
+                pass = FALSE;
+            }
+
+            if (FALSE == pass)
+            {
+                // return to the working configuration before trying the next candidate
+                QLIB_STATUS_RET_CHECK(QLIB_AutotuneSet_L(qlibContext, busFormat, baseDummy));
+                break;
+            }
+
+            result->numPassed++;
+            cycles = QLIB_STD_GetReadCycles(qlibContext, FLASH_PAGE_SIZE);
+            if (cycles < result->readCycles)
+            {
+                result->busFormat   = candidate;
+                result->dummyCycles = dummy;
+                result->readCycles  = cycles;
+            }
         }
-        return QLIB_STD_Write(qlibContext, buf, QLIB_MAKE_LOGICAL_ADDRESS(qlibContext, sectionID, offset), size);
     }
+
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Set the selected configuration and verify it                                                        */
+    /*-----------------------------------------------------------------------------------------------------*/
+    QLIB_STATUS_RET_CHECK(QLIB_AutotuneSet_L(qlibContext, result->busFormat, result->dummyCycles));
+    QLIB_STATUS_RET_CHECK(QLIB_AutotuneCheck_L(qlibContext, config, expected, &pass));
+    QLIB_ASSERT_RET(TRUE == pass, QLIB_STATUS__CONNECTIVITY_ERR);
+
+    // Clear errors in SSR caused by failed candidates
+    QLIB_STATUS_RET_CHECK(QLIB_SEC_ClearSSR(qlibContext));
+
+    return QLIB_STATUS__OK;
 }
 
-QLIB_STATUS_T QLIB_Erase(QLIB_CONTEXT_T* qlibContext, U32 sectionID, U32 offset, U32 size, BOOL secure)
+QLIB_STATUS_T QLIB_Read(QLIB_CONTEXT_T* qlibContext, U8* buf, U32 sectionID, U32 offset, U32 size, BOOL secure, BOOL auth)
 {
     /*-----------------------------------------------------------------------------------------------------*/
     /* Error checking                                                                                      */
@@ -281,441 +413,375 @@ QLIB_STATUS_T QLIB_Erase(QLIB_CONTEXT_T* qlibContext, U32 sectionID, U32 offset,
     QLIB_ASSERT_RET((offset + size) >= size, QLIB_STATUS__INVALID_PARAMETER);
     QLIB_ASSERT_RET(QLIB_NUM_OF_SECTIONS > sectionID, QLIB_STATUS__INVALID_PARAMETER);
 
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* A plain read during a background erase suspends and resumes the erase, as in QLIB_BgErase_Read      */
+    /*-----------------------------------------------------------------------------------------------------*/
+    if ((NULL != qlibContext->bgErase) && (FALSE == secure))
+    {
+        return QLIB_BgErase_Read(qlibContext->bgErase, buf, sectionID, offset, size);
+    }
+
+    QLIB_STATUS_RET_CHECK(QLIB_WriteCombine_Sync_L(qlibContext, sectionID, offset, size));
+
     if (TRUE == secure)
     {
         QLIB_ASSERT_RET((W77Q_VAULT(qlibContext) != 0u) || (QLIB_SECTION_ID_VAULT != sectionID), QLIB_STATUS__INVALID_PARAMETER);
         QLIB_ASSERT_RET((offset + size) <= QLIB_CALC_SECTION_SIZE(qlibContext, sectionID), QLIB_STATUS__PARAMETER_OUT_OF_RANGE);
-        return QLIB_SEC_Erase(qlibContext, sectionID, offset, size);
+        return QLIB_SEC_Read(qlibContext, buf, sectionID, offset, size, auth);
     }
     else
     {
-        U32 section = QLIB_FALLBACK_SECTION(qlibContext, sectionID);
-        QLIB_ASSERT_RET(sectionID < QLIB_SECTION_ID_VAULT, QLIB_STATUS__INVALID_PARAMETER);
-        QLIB_ASSERT_RET((offset + size) <= _QLIB_MAX_LEGACY_OFFSET(qlibContext), QLIB_STATUS__PARAMETER_OUT_OF_RANGE);
-        QLIB_ASSERT_RET((offset + size) <= QLIB_CALC_SECTION_SIZE(qlibContext, section), QLIB_STATUS__PARAMETER_OUT_OF_RANGE);
-#if QLIB_NUM_OF_DIES > 1
-        QLIB_ASSERT_RET(qlibContext->activeDie == QLIB_INIT_DIE_ID || qlibContext->addrMode == QLIB_STD_ADDR_MODE__4_BYTE,
-                        QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE);
-#endif
-
-        if ((QLIB_ACTIVE_DIE_STATE(qlibContext).sectionsState[section].plainEnabled & QLIB_SECTION_PLAIN_EN_WR) == 0u)
-        {
-            QLIB_STATUS_RET_CHECK(QLIB_PlainAccessGrant_L(qlibContext,
-                                                          section,
-                                                          W77Q_CMD_PA_GRANT_REVOKE(qlibContext) != 0u
-                                                              ? QLIB_LOAD_ACLR_PLAIN_WR
-                                                              : QLIB_LOAD_ACLR_NON_AUTH_PLAIN_WR));
-        }
-        return QLIB_STD_Erase(qlibContext, QLIB_MAKE_LOGICAL_ADDRESS(qlibContext, sectionID, offset), size);
+        QLIB_STATUS_RET_CHECK(QLIB_PreparePlainRead_L(qlibContext, sectionID, offset, size));
+        return QLIB_STD_Read(qlibContext, buf, QLIB_MAKE_LOGICAL_ADDRESS(qlibContext, sectionID, offset), size);
     }
 }
 
-QLIB_STATUS_T QLIB_EraseSection(QLIB_CONTEXT_T* qlibContext, U32 sectionID, BOOL secure)
+QLIB_STATUS_T QLIB_ReadStream(QLIB_CONTEXT_T*        qlibContext,
+                              U32                    sectionID,
+                              U32                    offset,
+                              U32                    size,
+                              U8*                    buf,
+                              U32                    bufSize,
+                              QLIB_READ_CHUNK_FUNC_T consumer,
+                              void*                  arg)
 {
+    U32 chunkSize;
+
     /*-----------------------------------------------------------------------------------------------------*/
     /* Error checking                                                                                      */
     /*-----------------------------------------------------------------------------------------------------*/
     QLIB_ASSERT_RET(NULL != qlibContext, QLIB_STATUS__INVALID_PARAMETER);
     QLIB_ASSERT_RET(QLIB_DEVICE_INITIALIZED(qlibContext), QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE);
+    QLIB_ASSERT_RET((NULL != buf) && (NULL != consumer), QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET(2u <= bufSize, QLIB_STATUS__INVALID_DATA_SIZE);
+    QLIB_ASSERT_RET(0u < size, QLIB_STATUS__PARAMETER_OUT_OF_RANGE);
+    QLIB_ASSERT_RET((offset + size) >= size, QLIB_STATUS__INVALID_PARAMETER);
     QLIB_ASSERT_RET(QLIB_NUM_OF_SECTIONS > sectionID, QLIB_STATUS__INVALID_PARAMETER);
-    QLIB_ASSERT_RET(!((QLIB_SECTION_ID_VAULT == sectionID) && (QLIB_VAULT_GET_SIZE(qlibContext) == 0u)),
-                    QLIB_STATUS__DEVICE_PRIVILEGE_ERR);
 
-    if (FALSE == secure)
-    {
-        QLIB_ASSERT_RET(sectionID < QLIB_SECTION_ID_VAULT, QLIB_STATUS__INVALID_PARAMETER);
-        if ((QLIB_ACTIVE_DIE_STATE(qlibContext).sectionsState[sectionID].plainEnabled & QLIB_SECTION_PLAIN_EN_WR) == 0u)
-        {
-            QLIB_STATUS_RET_CHECK(QLIB_PlainAccessGrant_L(qlibContext,
-                                                          sectionID,
-                                                          W77Q_CMD_PA_GRANT_REVOKE(qlibContext) != 0u
-                                                              ? QLIB_LOAD_ACLR_PLAIN_WR
-                                                              : QLIB_LOAD_ACLR_NON_AUTH_PLAIN_WR));
-        }
-    }
-    else
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Each half of the buffer holds one chunk                                                             */
+    /*-----------------------------------------------------------------------------------------------------*/
+    chunkSize = bufSize / 2u;
+    if ((qlibContext->readChunkSize != 0u) && (qlibContext->readChunkSize < chunkSize))
     {
-        QLIB_ASSERT_RET((W77Q_VAULT(qlibContext) != 0u) || (QLIB_SECTION_ID_VAULT != sectionID), QLIB_STATUS__INVALID_PARAMETER);
+        chunkSize = qlibContext->readChunkSize;
     }
 
-    return QLIB_SEC_EraseSection(qlibContext, sectionID, secure);
+    QLIB_STATUS_RET_CHECK(QLIB_WriteCombine_Sync_L(qlibContext, sectionID, offset, size));
+    QLIB_STATUS_RET_CHECK(QLIB_PreparePlainRead_L(qlibContext, sectionID, offset, size));
+
+    return QLIB_STD_ReadStream(qlibContext,
+                               QLIB_MAKE_LOGICAL_ADDRESS(qlibContext, sectionID, offset),
+                               size,
+                               buf,
+                               chunkSize,
+                               consumer,
+                               arg);
 }
 
-QLIB_STATUS_T QLIB_Suspend(QLIB_CONTEXT_T* qlibContext)
+void QLIB_SetReadChunkSize(QLIB_CONTEXT_T* qlibContext, U32 chunkSize)
 {
-    /*-----------------------------------------------------------------------------------------------------*/
-    /* Error checking                                                                                      */
-    /*-----------------------------------------------------------------------------------------------------*/
-    QLIB_ASSERT_RET(NULL != qlibContext, QLIB_STATUS__INVALID_PARAMETER);
-    QLIB_ASSERT_RET(QLIB_DEVICE_INITIALIZED(qlibContext), QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE);
-    QLIB_ASSERT_RET(qlibContext->isSuspended == 0u, QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE);
-
-    QLIB_STATUS_RET_CHECK(QLIB_STD_EraseSuspend(qlibContext));
-
-    qlibContext->isSuspended = 1u;
-#if QLIB_NUM_OF_DIES > 1
-    qlibContext->suspendDie = qlibContext->activeDie;
-#endif
-    return QLIB_STATUS__OK;
+    qlibContext->readChunkSize = chunkSize;
 }
 
-QLIB_STATUS_T QLIB_Resume(QLIB_CONTEXT_T* qlibContext)
+QLIB_STATUS_T QLIB_View_Open(QLIB_VIEW_T* view, QLIB_CONTEXT_T* qlibContext, U32 sectionID, U8* cache, U32 cacheSize)
 {
     /*-----------------------------------------------------------------------------------------------------*/
     /* Error checking                                                                                      */
     /*-----------------------------------------------------------------------------------------------------*/
+    QLIB_ASSERT_RET(NULL != view, QLIB_STATUS__INVALID_PARAMETER);
     QLIB_ASSERT_RET(NULL != qlibContext, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET(NULL != cache, QLIB_STATUS__INVALID_PARAMETER);
     QLIB_ASSERT_RET(QLIB_DEVICE_INITIALIZED(qlibContext), QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE);
-    QLIB_ASSERT_RET(qlibContext->isSuspended == 1u, QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE);
-#if QLIB_NUM_OF_DIES > 1
-    QLIB_STATUS_RET_CHECK(QLIB_STD_SetActiveDie(qlibContext, qlibContext->suspendDie, FALSE));
-#endif
-    QLIB_STATUS_RET_CHECK(QLIB_STD_EraseResume(qlibContext, FALSE));
+    QLIB_ASSERT_RET(QLIB_SECTION_ID_VAULT > sectionID, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET(FLASH_SECTOR_SIZE <= cacheSize, QLIB_STATUS__INVALID_DATA_SIZE);
 
-    qlibContext->isSuspended                    = 0u;
-    QLIB_ACTIVE_DIE_STATE(qlibContext).mcInSync = 0u;
+    (void)memset(view, 0, sizeof(QLIB_VIEW_T));
+    view->qlibContext = qlibContext;
+    view->sectionID   = sectionID;
+    view->size        = MIN(QLIB_CALC_SECTION_SIZE(qlibContext, QLIB_FALLBACK_SECTION(qlibContext, sectionID)),
+                            _QLIB_MAX_LEGACY_OFFSET(qlibContext));
+    view->cache       = cache;
+    view->numPages    = MIN(cacheSize / FLASH_SECTOR_SIZE, QLIB_VIEW_MAX_PAGES);
+    QLIB_ASSERT_RET(0u < view->size, QLIB_STATUS__DEVICE_PRIVILEGE_ERR);
+
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Register the view for invalidation                                                                  */
+    /*-----------------------------------------------------------------------------------------------------*/
+    view->next         = qlibContext->views;
+    qlibContext->views = view;
 
     return QLIB_STATUS__OK;
 }
 
-QLIB_STATUS_T QLIB_Power(QLIB_CONTEXT_T* qlibContext, QLIB_POWER_T power)
+QLIB_STATUS_T QLIB_View_Close(QLIB_VIEW_T* view)
 {
-    U32 die;
+    QLIB_VIEW_T** link;
 
     /*-----------------------------------------------------------------------------------------------------*/
     /* Error checking                                                                                      */
     /*-----------------------------------------------------------------------------------------------------*/
-    QLIB_ASSERT_RET(NULL != qlibContext, QLIB_STATUS__INVALID_PARAMETER);
-    QLIB_ASSERT_RET(QLIB_DEVICE_INITIALIZED(qlibContext), QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE);
-    QLIB_STATUS_RET_CHECK(QLIB_STD_Power(qlibContext, power));
+    QLIB_ASSERT_RET(NULL != view, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET(NULL != view->qlibContext, QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE);
 
-    /*-----------------------------------------------------------------------------------------------------*/
-    /* During power down SW could try to communicate and increment counters                                */
-    /*-----------------------------------------------------------------------------------------------------*/
-    if (QLIB_POWER_UP == power)
+    for (link = &view->qlibContext->views; NULL != *link; link = &(*link)->next)
     {
-        for (die = 0; die < QLIB_NUM_OF_DIES; die++)
+        if (*link == view)
         {
-            qlibContext->dieState[die].mcInSync = 0u;
+            *link = view->next;
+            break;
         }
-    };
+    }
+    view->qlibContext = NULL;
 
     return QLIB_STATUS__OK;
 }
 
-QLIB_STATUS_T QLIB_ResetFlash(QLIB_CONTEXT_T* qlibContext)
+QLIB_STATUS_T QLIB_View_Map(QLIB_VIEW_T* view, U32 offset, const U8** data, U32* size)
 {
-    U32 dmc;
+    const U8* page       = NULL;
+    U32       pageOffset = ROUND_DOWN(offset, FLASH_SECTOR_SIZE);
+
     /*-----------------------------------------------------------------------------------------------------*/
     /* Error checking                                                                                      */
     /*-----------------------------------------------------------------------------------------------------*/
-    QLIB_ASSERT_RET(NULL != qlibContext, QLIB_STATUS__INVALID_PARAMETER);
-    QLIB_ASSERT_RET(QLIB_DEVICE_INITIALIZED(qlibContext), QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE);
+    QLIB_ASSERT_RET((NULL != view) && (NULL != data) && (NULL != size), QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET(NULL != view->qlibContext, QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE);
+    QLIB_ASSERT_RET(offset < view->size, QLIB_STATUS__PARAMETER_OUT_OF_RANGE);
 
-#if QLIB_NUM_OF_DIES > 1
-    QLIB_STATUS_RET_CHECK(QLIB_STD_SetActiveDie(qlibContext, QLIB_INIT_DIE_ID, FALSE));
-#endif
-    /*-----------------------------------------------------------------------------------------------------*/
-    /* Save previous value of DMC. DMC is incremented on flash reset                                       */
-    /*-----------------------------------------------------------------------------------------------------*/
-    QLIB_STATUS_RET_CHECK(QLIB_CMD_PROC__synch_MC(qlibContext));
-    dmc = qlibContext->dieState[QLIB_INIT_DIE_ID].mc[DMC];
+    QLIB_STATUS_RET_CHECK(QLIB_View_GetPage_L(view, pageOffset, &page));
 
-    /*-----------------------------------------------------------------------------------------------------*/
-    /* Perform reset                                                                                       */
-    /*-----------------------------------------------------------------------------------------------------*/
-    QLIB_STATUS_RET_CHECK(QLIB_STD_ResetFlash(qlibContext, TRUE));
+    *data = &page[offset - pageOffset];
+    *size = MIN(pageOffset + FLASH_SECTOR_SIZE, view->size) - offset;
 
-    /*-----------------------------------------------------------------------------------------------------*/
-    /* Sync qlib state after reset                                                                         */
-    /*-----------------------------------------------------------------------------------------------------*/
-    QLIB_STATUS_RET_CHECK(QLIB_SEC_SyncAfterFlashReset(qlibContext));
+    return QLIB_STATUS__OK;
+}
+
+QLIB_STATUS_T QLIB_View_Read(QLIB_VIEW_T* view, U8* buf, U32 offset, U32 size)
+{
+    const U8* data     = NULL;
+    U32       size_tmp = 0;
 
     /*-----------------------------------------------------------------------------------------------------*/
-    /* Verify reset occurred by testing DMC new value                                                      */
+    /* Error checking                                                                                      */
     /*-----------------------------------------------------------------------------------------------------*/
-    QLIB_STATUS_RET_CHECK(QLIB_CMD_PROC__synch_MC(qlibContext));
-    QLIB_ASSERT_RET(dmc < qlibContext->dieState[QLIB_INIT_DIE_ID].mc[DMC], QLIB_STATUS__COMMAND_IGNORED);
+    QLIB_ASSERT_RET((NULL != view) && (NULL != buf), QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET((offset + size) >= size, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET((offset + size) <= view->size, QLIB_STATUS__PARAMETER_OUT_OF_RANGE);
+
+    while (0u < size)
+    {
+        QLIB_STATUS_RET_CHECK(QLIB_View_Map(view, offset, &data, &size_tmp));
+        size_tmp = MIN(size_tmp, size);
+        (void)memcpy(buf, data, size_tmp);
+
+        buf += size_tmp;
+        offset += size_tmp;
+        size -= size_tmp;
+    }
 
     return QLIB_STATUS__OK;
 }
 
-QLIB_STATUS_T QLIB_Format(QLIB_CONTEXT_T* qlibContext, const KEY_T deviceMasterKey, BOOL eraseDataOnly, BOOL factoryDefault)
+QLIB_STATUS_T QLIB_WriteCombine_Enable(QLIB_CONTEXT_T*       qlibContext,
+                                       QLIB_WRITE_COMBINE_T* writeCombine,
+                                       QLIB_TIME_US_FUNC_T   getTimeUs,
+                                       U32                   timeoutUs)
 {
     /*-----------------------------------------------------------------------------------------------------*/
     /* Error checking                                                                                      */
     /*-----------------------------------------------------------------------------------------------------*/
     QLIB_ASSERT_RET(NULL != qlibContext, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET(NULL != writeCombine, QLIB_STATUS__INVALID_PARAMETER);
     QLIB_ASSERT_RET(QLIB_DEVICE_INITIALIZED(qlibContext), QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE);
-    QLIB_ASSERT_RET(FALSE == eraseDataOnly || QLIB_KEY_MNGR__IS_KEY_VALID(deviceMasterKey), QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET(NULL == qlibContext->writeCombine, QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE);
 
-    return QLIB_SEC_Format(qlibContext, deviceMasterKey, eraseDataOnly, factoryDefault);
+    (void)memset(writeCombine, 0, sizeof(QLIB_WRITE_COMBINE_T));
+    writeCombine->getTimeUs = getTimeUs;
+    writeCombine->timeoutUs = timeoutUs;
+
+    qlibContext->writeCombine = writeCombine;
+
+    return QLIB_STATUS__OK;
 }
 
-QLIB_STATUS_T QLIB_GetNotifications(QLIB_CONTEXT_T* qlibContext, QLIB_NOTIFICATIONS_T* notifs)
+QLIB_STATUS_T QLIB_WriteCombine_Disable(QLIB_CONTEXT_T* qlibContext)
 {
     /*-----------------------------------------------------------------------------------------------------*/
     /* Error checking                                                                                      */
     /*-----------------------------------------------------------------------------------------------------*/
     QLIB_ASSERT_RET(NULL != qlibContext, QLIB_STATUS__INVALID_PARAMETER);
-    QLIB_ASSERT_RET(QLIB_DEVICE_INITIALIZED(qlibContext), QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE);
-    QLIB_ASSERT_RET(NULL != notifs, QLIB_STATUS__INVALID_PARAMETER);
 
-    return QLIB_SEC_GetNotifications(qlibContext, notifs);
+    // on failure the buffer stays enabled so the data is not lost
+    QLIB_STATUS_RET_CHECK(QLIB_WriteCombine_Flush_L(qlibContext, FALSE));
+    qlibContext->writeCombine = NULL;
+
+    return QLIB_STATUS__OK;
 }
 
-QLIB_STATUS_T QLIB_PerformMaintenance(QLIB_CONTEXT_T* qlibContext)
+QLIB_STATUS_T QLIB_WriteCombine_Flush(QLIB_CONTEXT_T* qlibContext)
 {
-    /*-----------------------------------------------------------------------------------------------------*/
-    /* Error checking                                                                                      */
-    /*-----------------------------------------------------------------------------------------------------*/
     QLIB_ASSERT_RET(NULL != qlibContext, QLIB_STATUS__INVALID_PARAMETER);
 
-    return QLIB_SEC_PerformMCMaint(qlibContext);
+    return QLIB_WriteCombine_Flush_L(qlibContext, FALSE);
 }
 
-QLIB_STATUS_T QLIB_ConfigDevice(QLIB_CONTEXT_T*                   qlibContext,
-                                const KEY_T                       deviceMasterKey,
-                                const KEY_T                       deviceSecretKey,
-                                const QLIB_SECTION_CONFIG_TABLE_T sectionTable[QLIB_NUM_OF_DIES],
-                                const KEY_ARRAY_T                 restrictedKeys[QLIB_NUM_OF_DIES],
-                                const KEY_ARRAY_T                 fullAccessKeys[QLIB_NUM_OF_DIES],
-                                const QLIB_LMS_KEY_ARRAY_T        lmsKeys[QLIB_NUM_OF_DIES],
-                                const KEY_T                       preProvisionedMasterKey,
-                                const QLIB_WATCHDOG_CONF_T*       watchdogDefault,
-                                const QLIB_DEVICE_CONF_T*         deviceConf,
-                                const _128BIT                     suid)
+QLIB_STATUS_T QLIB_WriteCombine_Poll(QLIB_CONTEXT_T* qlibContext)
+{
+    QLIB_ASSERT_RET(NULL != qlibContext, QLIB_STATUS__INVALID_PARAMETER);
+
+    return QLIB_WriteCombine_Flush_L(qlibContext, TRUE);
+}
+
+QLIB_STATUS_T QLIB_Write(QLIB_CONTEXT_T* qlibContext, const U8* buf, U32 sectionID, U32 offset, U32 size, BOOL secure)
 {
     /*-----------------------------------------------------------------------------------------------------*/
     /* Error checking                                                                                      */
     /*-----------------------------------------------------------------------------------------------------*/
     QLIB_ASSERT_RET(NULL != qlibContext, QLIB_STATUS__INVALID_PARAMETER);
     QLIB_ASSERT_RET(QLIB_DEVICE_INITIALIZED(qlibContext), QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE);
+    QLIB_ASSERT_RET(0u < size, QLIB_STATUS__PARAMETER_OUT_OF_RANGE);
+    QLIB_ASSERT_RET((offset + size) >= size, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET(QLIB_NUM_OF_SECTIONS > sectionID, QLIB_STATUS__INVALID_PARAMETER);
 
-    if (NULL != sectionTable)
+    QLIB_ViewInvalidate_L(qlibContext, sectionID, offset, size);
+
+    if (TRUE == secure)
     {
-        uint_fast8_t die;
-        for (die = 0; die < QLIB_NUM_OF_DIES; die++)
+        QLIB_ASSERT_RET((W77Q_VAULT(qlibContext) != 0u) || (QLIB_SECTION_ID_VAULT != sectionID), QLIB_STATUS__INVALID_PARAMETER);
+        QLIB_ASSERT_RET((offset + size) <= QLIB_CALC_SECTION_SIZE(qlibContext, sectionID), QLIB_STATUS__PARAMETER_OUT_OF_RANGE);
+        QLIB_STATUS_RET_CHECK(QLIB_WriteCombine_Sync_L(qlibContext, sectionID, offset, size));
+        return QLIB_SEC_Write(qlibContext, buf, sectionID, offset, size);
+    }
+    else
+    {
+        QLIB_STATUS_RET_CHECK(QLIB_PreparePlainErase_L(qlibContext, sectionID, offset, size));
+        if (NULL != qlibContext->writeCombine)
         {
-            if (W77Q_VAULT(qlibContext) != 0u)
-            {
-                QLIB_ASSERT_RET(0u == sectionTable[die][QLIB_SECTION_ID_VAULT].policy.plainAccessReadEnable,
-                                QLIB_STATUS__INVALID_PARAMETER);
-                QLIB_ASSERT_RET(0u == sectionTable[die][QLIB_SECTION_ID_VAULT].policy.plainAccessWriteEnable,
-                                QLIB_STATUS__INVALID_PARAMETER);
-                QLIB_ASSERT_RET(0u == sectionTable[die][QLIB_SECTION_ID_VAULT].policy.authPlainAccess,
-                                QLIB_STATUS__INVALID_PARAMETER);
-                QLIB_ASSERT_RET(QLIB_VAULT_CFG_TO_SIZE(deviceConf->vaultSize[die]) ==
-                                    sectionTable[die][QLIB_SECTION_ID_VAULT].size,
-                                QLIB_STATUS__INVALID_PARAMETER);
-            }
-#ifndef Q2_API
-            else
-            {
-                QLIB_ASSERT_RET(sectionTable[die][QLIB_SECTION_ID_VAULT].size == 0u, QLIB_STATUS__INVALID_PARAMETER);
-                QLIB_ASSERT_RET(deviceConf->vaultSize[die] == QLIB_VAULT_DISABLED_RPMC_8_COUNTERS,
-                                QLIB_STATUS__INVALID_PARAMETER);
-            }
-#endif
+            return QLIB_WriteCombine_Put_L(qlibContext, buf, sectionID, offset, size);
         }
+        return QLIB_STD_Write(qlibContext, buf, QLIB_MAKE_LOGICAL_ADDRESS(qlibContext, sectionID, offset), size);
     }
-
-    /*-----------------------------------------------------------------------------------------------------*/
-    /* Configure the device                                                                                */
-    /*-----------------------------------------------------------------------------------------------------*/
-    QLIB_STATUS_RET_CHECK(QLIB_SEC_ConfigDevice(qlibContext,
-                                                deviceMasterKey,
-                                                deviceSecretKey,
-                                                sectionTable,
-                                                restrictedKeys,
-                                                fullAccessKeys,
-                                                lmsKeys,
-                                                preProvisionedMasterKey,
-                                                watchdogDefault,
-                                                deviceConf,
-                                                suid));
-    /*-----------------------------------------------------------------------------------------------------*/
-    /* Re-sync the device                                                                                  */
-    /*-----------------------------------------------------------------------------------------------------*/
-    QLIB_STATUS_RET_CHECK(QLIB_SEC_SyncState(qlibContext));
-
-    return QLIB_STATUS__OK;
 }
 
-QLIB_STATUS_T QLIB_GetDeviceConfig(QLIB_CONTEXT_T*       qlibContext,
-                                   QLIB_WATCHDOG_CONF_T* watchdogDefault,
-                                   QLIB_DEVICE_CONF_T*   deviceConf)
+QLIB_STATUS_T QLIB_WriteWithMode(QLIB_CONTEXT_T*   qlibContext,
+                                 const U8*         buf,
+                                 U32               sectionID,
+                                 U32               offset,
+                                 U32               size,
+                                 BOOL              secure,
+                                 QLIB_WRITE_MODE_T mode,
+                                 U32*              pagesSkipped)
 {
-    GMC_T         gmc;
-    DEVCFG_T      devCfg = 0;
-    AWDTCFG_T     awdtDefault;
-    BOOL          quadEnabled;
-    U32           val = 0u;
-    U8            sectionId;
-    U8            rstPAField = 0u;
-    U8            origDie    = qlibContext->activeDie;
-    QLIB_STATUS_T ret        = QLIB_STATUS__OK;
-#if QLIB_NUM_OF_DIES > 1
-    uint_fast8_t nextDie;
-#endif
+    U32  chunk     = 0;
+    U32  skipped   = 0;
+    U32  flashCrc  = 0;
+    U32  dataCrc   = 0;
+    BOOL identical = FALSE;
+
     /*-----------------------------------------------------------------------------------------------------*/
     /* Error checking                                                                                      */
     /*-----------------------------------------------------------------------------------------------------*/
     QLIB_ASSERT_RET(NULL != qlibContext, QLIB_STATUS__INVALID_PARAMETER);
     QLIB_ASSERT_RET(QLIB_DEVICE_INITIALIZED(qlibContext), QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE);
-    QLIB_ASSERT_RET(NULL != watchdogDefault, QLIB_STATUS__INVALID_PARAMETER);
-    QLIB_ASSERT_RET(NULL != deviceConf, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET(NULL != buf, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET(0u < size, QLIB_STATUS__PARAMETER_OUT_OF_RANGE);
+    QLIB_ASSERT_RET((offset + size) >= size, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET(QLIB_WRITE_MODE__LAST > mode, QLIB_STATUS__INVALID_PARAMETER);
 
-    (void)memset(watchdogDefault, 0, sizeof(QLIB_WATCHDOG_CONF_T));
-    (void)memset(deviceConf, 0, sizeof(QLIB_DEVICE_CONF_T));
-    do
+    if (NULL != pagesSkipped)
     {
-        QLIB_STATUS_RET_CHECK_GOTO(QLIB_SEC__get_GMC(qlibContext, gmc), ret, error);
-        devCfg = QLIB_REG_GMC_GET_DEVCFG(gmc);
-        if (qlibContext->activeDie == QLIB_INIT_DIE_ID)
-        {
-            awdtDefault = QLIB_REG_GMC_GET_AWDT_DFLT(gmc);
+        *pagesSkipped = 0;
+    }
 
-            //Set watchdogDefault values
-            watchdogDefault->enable        = INT_TO_BOOLEAN(READ_VAR_FIELD(awdtDefault, QLIB_REG_AWDTCFG__AWDT_EN));
-            watchdogDefault->lfOscEn       = INT_TO_BOOLEAN(READ_VAR_FIELD(awdtDefault, QLIB_REG_AWDTCFG__LFOSC_EN));
-            watchdogDefault->swResetEn     = INT_TO_BOOLEAN(READ_VAR_FIELD(awdtDefault, QLIB_REG_AWDTCFG__SRST_EN));
-            watchdogDefault->authenticated = INT_TO_BOOLEAN(READ_VAR_FIELD(awdtDefault, QLIB_REG_AWDTCFG__AUTH_WDT));
-            watchdogDefault->sectionID     = (U32)READ_VAR_FIELD(awdtDefault, QLIB_REG_AWDTCFG__KID);
-            watchdogDefault->threshold =
-                (QLIB_AWDT_TH_T)MIN((U32)READ_VAR_FIELD(awdtDefault, QLIB_REG_AWDTCFG__TH), (U32)QLIB_AWDT_TH_12_DAYS);
-            watchdogDefault->lock      = INT_TO_BOOLEAN(READ_VAR_FIELD(awdtDefault, QLIB_REG_AWDTCFG__LOCK));
-            watchdogDefault->oscRateHz = ((U32)READ_VAR_FIELD(awdtDefault, QLIB_REG_AWDTCFG__OSC_RATE_KHZ) << 10);
-            if (W77Q_AWDTCFG_OSC_RATE_FRAC(qlibContext) != 0u)
-            {
-                watchdogDefault->oscRateHz += ((U32)READ_VAR_FIELD(awdtDefault, QLIB_REG_AWDTCFG__OSC_RATE_FRAC) << 6);
-            }
-            watchdogDefault->fallbackEn = INT_TO_BOOLEAN(READ_VAR_FIELD(awdtDefault, QLIB_REG_AWDTCFG__FB_EN));
+    if (QLIB_WRITE_MODE__PROGRAM == mode)
+    {
+        return QLIB_Write(qlibContext, buf, sectionID, offset, size, secure);
+    }
 
-            //Set devCfg values
-            if ((0u == W77Q_RST_RESP(qlibContext)) || (0u == READ_VAR_FIELD(devCfg, QLIB_REG_DEVCFG__RST_RESP_EN)))
+    if (QLIB_WRITE_MODE__DIRTY_SECTORS == mode)
+    {
+        QLIB_ASSERT_RET(0u == (offset % FLASH_SECTOR_SIZE), QLIB_STATUS__INVALID_DATA_ALIGNMENT);
+        QLIB_ASSERT_RET(0u == (size % FLASH_SECTOR_SIZE), QLIB_STATUS__INVALID_DATA_ALIGNMENT);
+    }
+
+    while (0u < size)
+    {
+        if (QLIB_WRITE_MODE__DIRTY_SECTORS == mode)
+        {
+            /*---------------------------------------------------------------------------------------------*/
+            /* Erase the sector only if needed and program the required pages                              */
+            /*---------------------------------------------------------------------------------------------*/
+            chunk = FLASH_SECTOR_SIZE;
+            QLIB_STATUS_RET_CHECK(QLIB_WriteSector_L(qlibContext, buf, sectionID, offset, secure, &skipped));
+        }
+        else
+        {
+            /*---------------------------------------------------------------------------------------------*/
+            /* Program the page only if it differs from the flash content                                  */
+            /*---------------------------------------------------------------------------------------------*/
+            chunk = MIN(size, FLASH_PAGE_SIZE - (offset % FLASH_PAGE_SIZE));
+            if (FLASH_PAGE_SIZE == chunk)
             {
-                (void)memset(deviceConf->resetResp.response1, 0, sizeof(deviceConf->resetResp.response1));
-                (void)memset(deviceConf->resetResp.response2, 0, sizeof(deviceConf->resetResp.response2));
+                QLIB_STATUS_RET_CHECK(QLIB_ReadPageCRCs_L(qlibContext, sectionID, offset, 1, secure, &flashCrc));
+                QLIB_STATUS_RET_CHECK(QLIB_PageCRC_L(buf, &dataCrc));
+                identical = (flashCrc == dataCrc) ? TRUE : FALSE;
             }
             else
             {
-                QLIB_STATUS_RET_CHECK(QLIB_CMD_PROC__get_RST_RESP(qlibContext, deviceConf->resetResp.response1));
+                QLIB_STATUS_RET_CHECK(QLIB_ComparePage_L(qlibContext, buf, sectionID, offset, chunk, secure, &identical));
             }
-            deviceConf->safeFB            = INT_TO_BOOLEAN(READ_VAR_FIELD(devCfg, QLIB_REG_DEVCFG__FB_EN));
-            deviceConf->speculCK          = INT_TO_BOOLEAN(READ_VAR_FIELD(devCfg, QLIB_REG_DEVCFG__CK_SPECUL));
-            deviceConf->nonSecureFormatEn = INT_TO_BOOLEAN(READ_VAR_FIELD(devCfg, QLIB_REG_DEVCFG__FORMAT_EN));
-            deviceConf->lock =
-                (W77Q_DEVCFG_LOCK(qlibContext) != 0u) ? INT_TO_BOOLEAN(READ_VAR_FIELD(devCfg, QLIB_REG_DEVCFG__CFG_LOCK)) : FALSE;
-
-            QLIB_STATUS_RET_CHECK_GOTO(QLIB_STD_GetQuadEnable(qlibContext, &quadEnabled), ret, error);
-            deviceConf->pinMux.dedicatedResetInEn = INT_TO_BOOLEAN(READ_VAR_FIELD(awdtDefault, QLIB_REG_AWDTCFG__RST_IN_EN));
-
-            deviceConf->pinMux.io23Mux = QLIB_IO23_MODE__NONE;
-            if (quadEnabled == TRUE)
+            if (TRUE == identical)
             {
-                if ((READ_VAR_FIELD(awdtDefault, QLIB_REG_AWDTCFG__RSTI_OVRD) == 0u) &&
-                    (READ_VAR_FIELD(awdtDefault, QLIB_REG_AWDTCFG__RSTO_EN) == 0u))
-                {
-                    deviceConf->pinMux.io23Mux = QLIB_IO23_MODE__QUAD;
-                }
+                skipped++;
             }
             else
-            { //quadEnable == FALSE
-                if ((READ_VAR_FIELD(awdtDefault, QLIB_REG_AWDTCFG__RSTI_OVRD) == 0u) &&
-                    (READ_VAR_FIELD(awdtDefault, QLIB_REG_AWDTCFG__RSTO_EN) == 0u))
-                {
-                    deviceConf->pinMux.io23Mux = QLIB_IO23_MODE__LEGACY_WP_HOLD;
-                }
-                else
-                {
-                    if (
-                        (READ_VAR_FIELD(awdtDefault, QLIB_REG_AWDTCFG__RSTI_OVRD) == 1u) &&
-                        (READ_VAR_FIELD(awdtDefault, QLIB_REG_AWDTCFG__RSTO_EN) == 1u) &&
-                        (READ_VAR_FIELD(awdtDefault, QLIB_REG_AWDTCFG__RSTI_EN) == 1u))
-                    {
-                        deviceConf->pinMux.io23Mux = QLIB_IO23_MODE__RESET_IN_OUT;
-                    }
-                }
-            }
-
-            deviceConf->bootFailReset = (W77Q_DEVCFG_BOOT_FAIL_RST(qlibContext) != 0u)
-                                            ? INT_TO_BOOLEAN(READ_VAR_FIELD(devCfg, QLIB_REG_DEVCFG__BOOT_FAIL_RST))
-                                            : FALSE;
-            if (W77Q_FAST_READ_DUMMY_CONFIG(qlibContext) != 0u)
             {
-                QLIB_STATUS_RET_CHECK_GOTO(QLIB_STD_getPowerUpDummyCycles(qlibContext, &deviceConf->fastReadDummyCycles),
-                                           ret,
-                                           error);
+                QLIB_STATUS_RET_CHECK(QLIB_Write(qlibContext, buf, sectionID, offset, chunk, secure));
             }
-
-            val = (U32)(READ_VAR_FIELD(devCfg, QLIB_REG_DEVCFG__SECT_SEL) + (U32)LOG2(QLIB_MIN_SECTION_SIZE));
-            QLIB_ASSERT_WITH_ERROR_GOTO(val >= (U32)QLIB_STD_ADDR_LEN__22_BIT && val < (U32)QLIB_STD_ADDR_LEN__LAST,
-                                        QLIB_STATUS__INVALID_PARAMETER,
-                                        ret,
-                                        error)
-            deviceConf->stdAddrSize.addrLen = (QLIB_STD_ADDR_LEN_T)val;
-
-            QLIB_STATUS_RET_CHECK_GOTO(QLIB_STD_GetPowerUpAddressMode(qlibContext, &deviceConf->stdAddrSize.addrMode),
-                                       ret,
-                                       error);
-            deviceConf->rngPAEn = (W77Q_RNG_FEATURE(qlibContext) != 0u)
-                                      ? INT_TO_BOOLEAN(READ_VAR_FIELD(devCfg, QLIB_REG_DEVCFG__RNG_PA_EN))
-                                      : FALSE;
         }
-        deviceConf->ctagModeMulti =
-            (Q2_DEVCFG_CTAG_MODE(qlibContext) != 0u) ? INT_TO_BOOLEAN(READ_VAR_FIELD(devCfg, QLIB_REG_DEVCFG__CTAG_MODE)) : FALSE;
-
-        val = (U32)READ_VAR_FIELD(devCfg, QLIB_REG_DEVCFG__VAULT_MEM);
-        deviceConf->vaultSize[qlibContext->activeDie] =
-            (W77Q_VAULT(qlibContext) != 0u) ? (QLIB_VAULT_RPMC_CONFIG_T)val : QLIB_VAULT_DISABLED_RPMC_8_COUNTERS;
 
-        rstPAField = (W77Q_RST_PA(qlibContext) != 0u) ? (U8)READ_VAR_FIELD(devCfg, QLIB_REG_DEVCFG__RST_PA) : 1u;
-        for (sectionId = 0; sectionId < QLIB_NUM_OF_MAIN_SECTIONS; sectionId++)
-        {
-            deviceConf->resetPA[qlibContext->activeDie][sectionId] = INT_TO_BOOLEAN(rstPAField & (1u << sectionId));
-        }
+        buf += chunk;
+        offset += chunk;
+        size -= chunk;
+    }
 
-#if QLIB_NUM_OF_DIES > 1
-        nextDie = (qlibContext->activeDie + 1) % QLIB_NUM_OF_DIES;
-        QLIB_STATUS_RET_CHECK_GOTO(QLIB_SetActiveDie(qlibContext, nextDie), ret, error);
-#endif
-    } while (qlibContext->activeDie != origDie);
+    if (NULL != pagesSkipped)
+    {
+        *pagesSkipped = skipped;
+    }
 
     return QLIB_STATUS__OK;
-error:
-#if QLIB_NUM_OF_DIES > 1
-    QLIB_SetActiveDie(qlibContext, origDie);
-#endif
-    return ret;
 }
 
-QLIB_STATUS_T QLIB_GetSectionConfiguration(QLIB_CONTEXT_T* qlibContext,
-                                           U32             sectionID,
-                                           U32*            baseAddr,
-                                           U32*            size,
-                                           QLIB_POLICY_T*  policy,
-                                           U64*            digest,
-                                           U32*            crc,
-                                           U32*            version)
+QLIB_STATUS_T QLIB_Erase(QLIB_CONTEXT_T* qlibContext, U32 sectionID, U32 offset, U32 size, BOOL secure)
 {
     /*-----------------------------------------------------------------------------------------------------*/
     /* Error checking                                                                                      */
     /*-----------------------------------------------------------------------------------------------------*/
     QLIB_ASSERT_RET(NULL != qlibContext, QLIB_STATUS__INVALID_PARAMETER);
     QLIB_ASSERT_RET(QLIB_DEVICE_INITIALIZED(qlibContext), QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE);
+    QLIB_ASSERT_RET(0u < size, QLIB_STATUS__PARAMETER_OUT_OF_RANGE);
+    QLIB_ASSERT_RET((offset + size) >= size, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET(QLIB_NUM_OF_SECTIONS > sectionID, QLIB_STATUS__INVALID_PARAMETER);
 
-    return QLIB_SEC_GetSectionConfiguration(qlibContext, sectionID, baseAddr, size, policy, digest, crc, version);
+    QLIB_ViewInvalidate_L(qlibContext, sectionID, offset, size);
+    QLIB_STATUS_RET_CHECK(QLIB_WriteCombine_Sync_L(qlibContext, sectionID, offset, size));
+
+    if (TRUE == secure)
+    {
+        QLIB_ASSERT_RET((W77Q_VAULT(qlibContext) != 0u) || (QLIB_SECTION_ID_VAULT != sectionID), QLIB_STATUS__INVALID_PARAMETER);
+        QLIB_ASSERT_RET((offset + size) <= QLIB_CALC_SECTION_SIZE(qlibContext, sectionID), QLIB_STATUS__PARAMETER_OUT_OF_RANGE);
+        return QLIB_SEC_Erase(qlibContext, sectionID, offset, size);
+    }
+    else
+    {
+        QLIB_STATUS_RET_CHECK(QLIB_PreparePlainErase_L(qlibContext, sectionID, offset, size));
+        return QLIB_STD_Erase(qlibContext, QLIB_MAKE_LOGICAL_ADDRESS(qlibContext, sectionID, offset), size);
+    }
 }
 
-QLIB_STATUS_T QLIB_ConfigSection(QLIB_CONTEXT_T*            qlibContext,
-                                 U32                        sectionID,
-                                 const QLIB_POLICY_T*       policy,
-                                 const U64*                 digest,
-                                 const U32*                 crc,
-                                 const U32*                 newVersion,
-                                 BOOL                       swap,
-                                 QLIB_SECTION_CONF_ACTION_T action)
+QLIB_STATUS_T QLIB_EraseSection(QLIB_CONTEXT_T* qlibContext, U32 sectionID, BOOL secure)
 {
     /*-----------------------------------------------------------------------------------------------------*/
     /* Error checking                                                                                      */
@@ -723,312 +789,1041 @@ QLIB_STATUS_T QLIB_ConfigSection(QLIB_CONTEXT_T*            qlibContext,
     QLIB_ASSERT_RET(NULL != qlibContext, QLIB_STATUS__INVALID_PARAMETER);
     QLIB_ASSERT_RET(QLIB_DEVICE_INITIALIZED(qlibContext), QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE);
     QLIB_ASSERT_RET(QLIB_NUM_OF_SECTIONS > sectionID, QLIB_STATUS__INVALID_PARAMETER);
-    QLIB_ASSERT_RET((W77Q_VAULT(qlibContext) != 0u) || (QLIB_SECTION_ID_VAULT != sectionID), QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET(!((QLIB_SECTION_ID_VAULT == sectionID) && (QLIB_VAULT_GET_SIZE(qlibContext) == 0u)),
+                    QLIB_STATUS__DEVICE_PRIVILEGE_ERR);
 
-    /*-----------------------------------------------------------------------------------------------------*/
-    /* Perform Section Config                                                                              */
-    /*-----------------------------------------------------------------------------------------------------*/
-    QLIB_STATUS_RET_CHECK(QLIB_SEC_ConfigSection(qlibContext, sectionID, policy, digest, crc, newVersion, swap, action));
+    QLIB_ViewInvalidate_L(qlibContext, sectionID, 0, MAX_U32);
+    QLIB_STATUS_RET_CHECK(QLIB_WriteCombine_Sync_L(qlibContext, sectionID, 0, MAX_U32));
 
-    if ((W77Q_SET_SCR_MODE(qlibContext) == 0u) && (action != QLIB_SECTION_CONF_ACTION__NO))
+    if (FALSE == secure)
     {
-        /*-------------------------------------------------------------------------------------------------*/
-        /* Reopen the session to this section, after 'set_SCRn' revokes access privileges to the section   */
-        /*-------------------------------------------------------------------------------------------------*/
-        QLIB_STATUS_RET_CHECK(QLIB_SEC_OpenSession(qlibContext, sectionID, QLIB_SESSION_ACCESS_FULL));
+        QLIB_ASSERT_RET(sectionID < QLIB_SECTION_ID_VAULT, QLIB_STATUS__INVALID_PARAMETER);
+        if ((QLIB_ACTIVE_DIE_STATE(qlibContext).sectionsState[sectionID].plainEnabled & QLIB_SECTION_PLAIN_EN_WR) == 0u)
+        {
+            QLIB_STATUS_RET_CHECK(QLIB_PlainAccessGrant_L(qlibContext,
+                                                          sectionID,
+                                                          W77Q_CMD_PA_GRANT_REVOKE(qlibContext) != 0u
+                                                              ? QLIB_LOAD_ACLR_PLAIN_WR
+                                                              : QLIB_LOAD_ACLR_NON_AUTH_PLAIN_WR));
+        }
     }
-    return QLIB_STATUS__OK;
+    else
+    {
+        QLIB_ASSERT_RET((W77Q_VAULT(qlibContext) != 0u) || (QLIB_SECTION_ID_VAULT != sectionID), QLIB_STATUS__INVALID_PARAMETER);
+    }
+
+    return QLIB_SEC_EraseSection(qlibContext, sectionID, secure);
 }
 
-QLIB_STATUS_T QLIB_ConfigAccess(QLIB_CONTEXT_T* qlibContext, U32 sectionID, BOOL readEnable, BOOL writeEnable)
+QLIB_STATUS_T QLIB_EraseRanges(QLIB_CONTEXT_T* qlibContext, QLIB_ERASE_RANGE_T* ranges, U32 numRanges, BOOL secure)
 {
+    QLIB_ERASE_RANGE_T range;
+    U32                i;
+    U32                j;
+    U32                end;
+
     /*-----------------------------------------------------------------------------------------------------*/
     /* Error checking                                                                                      */
     /*-----------------------------------------------------------------------------------------------------*/
     QLIB_ASSERT_RET(NULL != qlibContext, QLIB_STATUS__INVALID_PARAMETER);
     QLIB_ASSERT_RET(QLIB_DEVICE_INITIALIZED(qlibContext), QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE);
+    QLIB_ASSERT_RET(NULL != ranges, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET(0u < numRanges, QLIB_STATUS__PARAMETER_OUT_OF_RANGE);
+
+    for (i = 0; i < numRanges; i++)
+    {
+        QLIB_ASSERT_RET(QLIB_NUM_OF_SECTIONS > ranges[i].sectionID, QLIB_STATUS__INVALID_PARAMETER);
+        QLIB_ASSERT_RET(0u < ranges[i].size, QLIB_STATUS__PARAMETER_OUT_OF_RANGE);
+        QLIB_ASSERT_RET((ranges[i].offset + ranges[i].size) >= ranges[i].size, QLIB_STATUS__INVALID_PARAMETER);
+    }
+
     /*-----------------------------------------------------------------------------------------------------*/
-    /* Perform configuration                                                                               */
+    /* Sort the ranges by section and offset                                                               */
     /*-----------------------------------------------------------------------------------------------------*/
-    return QLIB_SEC_ConfigAccess(qlibContext, sectionID, readEnable, writeEnable);
-}
+    for (i = 1; i < numRanges; i++)
+    {
+        range = ranges[i];
+        for (j = i; (j > 0u) && ((ranges[j - 1u].sectionID > range.sectionID) ||
+                                 ((ranges[j - 1u].sectionID == range.sectionID) && (ranges[j - 1u].offset > range.offset)));
+             j--)
+        {
+            ranges[j] = ranges[j - 1u];
+        }
+        ranges[j] = range;
+    }
 
-QLIB_STATUS_T QLIB_LoadKey(QLIB_CONTEXT_T* qlibContext, U32 sectionID, const KEY_T key, BOOL fullAccess)
-{
     /*-----------------------------------------------------------------------------------------------------*/
-    /* Error checking                                                                                      */
+    /* Coalesce overlapping and adjacent ranges of the same section                                        */
     /*-----------------------------------------------------------------------------------------------------*/
-    QLIB_ASSERT_RET(NULL != qlibContext, QLIB_STATUS__INVALID_PARAMETER);
-
-    return QLIB_SEC_LoadKey(qlibContext, sectionID, key, fullAccess);
-}
+    j = 0;
+    for (i = 1; i < numRanges; i++)
+    {
+        if ((ranges[i].sectionID == ranges[j].sectionID) && (ranges[i].offset <= (ranges[j].offset + ranges[j].size)))
+        {
+            end            = MAX(ranges[j].offset + ranges[j].size, ranges[i].offset + ranges[i].size);
+            ranges[j].size = end - ranges[j].offset;
+        }
+        else
+        {
+            j++;
+            ranges[j] = ranges[i];
+        }
+    }
+    numRanges = j + 1u;
 
-QLIB_STATUS_T QLIB_RemoveKey(QLIB_CONTEXT_T* qlibContext, U32 sectionID, BOOL fullAccess)
-{
     /*-----------------------------------------------------------------------------------------------------*/
-    /* Error checking                                                                                      */
+    /* Erase the ranges                                                                                    */
     /*-----------------------------------------------------------------------------------------------------*/
-    QLIB_ASSERT_RET(NULL != qlibContext, QLIB_STATUS__INVALID_PARAMETER);
+    for (i = 0; i < numRanges; i++)
+    {
+        QLIB_STATUS_RET_CHECK(QLIB_EraseRange_L(qlibContext, &ranges[i], secure));
+    }
 
-    return QLIB_SEC_RemoveKey(qlibContext, sectionID, fullAccess);
+    return QLIB_STATUS__OK;
 }
 
-QLIB_STATUS_T QLIB_Connect(QLIB_CONTEXT_T* qlibContext)
+QLIB_STATUS_T QLIB_CalibrateEraseTime(QLIB_CONTEXT_T* qlibContext, QLIB_ERASE_T eraseType, U32 size, U32 timeUs)
 {
+    U32  index;
+    U32* cost;
+
     /*-----------------------------------------------------------------------------------------------------*/
     /* Error checking                                                                                      */
     /*-----------------------------------------------------------------------------------------------------*/
     QLIB_ASSERT_RET(NULL != qlibContext, QLIB_STATUS__INVALID_PARAMETER);
-    QLIB_STATUS_RET_CHECK(QLIB_TM_Connect(qlibContext));
+    QLIB_ASSERT_RET((QLIB_ERASE_SECTOR_4K <= eraseType) && (QLIB_ERASE_SECTION >= eraseType), QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET(0u < timeUs, QLIB_STATUS__PARAMETER_OUT_OF_RANGE);
 
-#if QLIB_NUM_OF_DIES > 1
-    qlibContext->activeDie = QLIB_INIT_DIE_ID;
-#endif
-    return QLIB_STATUS__OK;
-}
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Section erase time is kept per 64KB of section size                                                 */
+    /*-----------------------------------------------------------------------------------------------------*/
+    if (QLIB_ERASE_SECTION == eraseType)
+    {
+        QLIB_ASSERT_RET(_64KB_ <= size, QLIB_STATUS__INVALID_DATA_SIZE);
+        timeUs = MAX(timeUs / (size / _64KB_), 1u);
+    }
 
-QLIB_STATUS_T QLIB_Disconnect(QLIB_CONTEXT_T* qlibContext)
-{
     /*-----------------------------------------------------------------------------------------------------*/
-    /* Error checking                                                                                      */
+    /* First measurement replaces the typical time, next measurements are averaged                         */
     /*-----------------------------------------------------------------------------------------------------*/
-    QLIB_ASSERT_RET(NULL != qlibContext, QLIB_STATUS__INVALID_PARAMETER);
-    QLIB_ASSERT_RET(!QLIB_KEY_MNGR__SESSION_IS_OPEN(qlibContext), QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE);
+    index = QLIB_ERASE_COST_INDEX(eraseType);
+    cost  = &qlibContext->eraseCost.timeUs[index];
+    if ((qlibContext->eraseCost.calibrated & (1u << index)) == 0u)
+    {
+        *cost = timeUs;
+        qlibContext->eraseCost.calibrated |= (1u << index);
+    }
+    else
+    {
+        *cost = (U32)((((U64)*cost * 3u) + timeUs) / 4u);
+    }
 
-#if QLIB_NUM_OF_DIES > 1
-    QLIB_STATUS_RET_CHECK(QLIB_SetActiveDie(qlibContext, QLIB_INIT_DIE_ID));
-#endif
-    QLIB_STATUS_RET_CHECK(QLIB_TM_Disconnect(qlibContext));
     return QLIB_STATUS__OK;
 }
 
-QLIB_STATUS_T QLIB_OpenSession(QLIB_CONTEXT_T* qlibContext, U32 sectionID, QLIB_SESSION_ACCESS_T sessionAccess)
+QLIB_STATUS_T QLIB_BgErase_Start(QLIB_BG_ERASE_T*              bgErase,
+                                 QLIB_CONTEXT_T*               qlibContext,
+                                 const QLIB_BG_ERASE_POLICY_T* policy,
+                                 QLIB_TIME_US_FUNC_T           getTimeUs,
+                                 QLIB_SLEEP_US_FUNC_T          sleepUs,
+                                 U32                           sectionID,
+                                 U32                           offset,
+                                 U32                           size)
 {
     /*-----------------------------------------------------------------------------------------------------*/
     /* Error checking                                                                                      */
     /*-----------------------------------------------------------------------------------------------------*/
+    QLIB_ASSERT_RET(NULL != bgErase, QLIB_STATUS__INVALID_PARAMETER);
     QLIB_ASSERT_RET(NULL != qlibContext, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET(NULL != policy, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET(NULL != getTimeUs, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET(NULL != sleepUs, QLIB_STATUS__INVALID_PARAMETER);
     QLIB_ASSERT_RET(QLIB_DEVICE_INITIALIZED(qlibContext), QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE);
+    QLIB_ASSERT_RET(qlibContext->isSuspended == 0u, QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE);
+    QLIB_ASSERT_RET(0u < size, QLIB_STATUS__PARAMETER_OUT_OF_RANGE);
+    QLIB_ASSERT_RET((offset + size) >= size, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET(QLIB_NUM_OF_SECTIONS > sectionID, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET(0u == (offset % FLASH_SECTOR_SIZE), QLIB_STATUS__INVALID_DATA_ALIGNMENT);
+    QLIB_ASSERT_RET(0u == (size % FLASH_SECTOR_SIZE), QLIB_STATUS__INVALID_DATA_ALIGNMENT);
+    QLIB_STATUS_RET_CHECK(QLIB_PreparePlainErase_L(qlibContext, sectionID, offset, size));
+    QLIB_ViewInvalidate_L(qlibContext, sectionID, offset, size);
+    QLIB_STATUS_RET_CHECK(QLIB_WriteCombine_Sync_L(qlibContext, sectionID, offset, size));
 
-    return QLIB_SEC_OpenSession(qlibContext, sectionID, sessionAccess);
-}
-
-QLIB_STATUS_T QLIB_CloseSession(QLIB_CONTEXT_T* qlibContext, U32 sectionID)
-{
     /*-----------------------------------------------------------------------------------------------------*/
-    /* Error checking                                                                                      */
+    /* Start the first erase command                                                                       */
     /*-----------------------------------------------------------------------------------------------------*/
-    QLIB_ASSERT_RET(NULL != qlibContext, QLIB_STATUS__INVALID_PARAMETER);
-    QLIB_ASSERT_RET(QLIB_DEVICE_INITIALIZED(qlibContext), QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE);
-
-    return QLIB_SEC_CloseSession(qlibContext, sectionID);
-}
+    (void)memset(bgErase, 0, sizeof(QLIB_BG_ERASE_T));
+    bgErase->qlibContext = qlibContext;
+    bgErase->policy      = *policy;
+    bgErase->getTimeUs   = getTimeUs;
+    bgErase->sleepUs     = sleepUs;
+    bgErase->sectionID   = sectionID;
+    bgErase->offset      = offset;
+    bgErase->size        = size;
 
-QLIB_STATUS_T QLIB_PlainAccessGrant(QLIB_CONTEXT_T* qlibContext, U32 sectionID)
-{
-    return QLIB_PlainAccessGrant_L(qlibContext, sectionID, QLIB_LOAD_ACLR_ANY);
+    return QLIB_BgErase_Attach_L(bgErase, QLIB_BgErase_Update_L(bgErase, TRUE));
 }
 
-QLIB_STATUS_T QLIB_PlainAccessRevoke(QLIB_CONTEXT_T* qlibContext, U32 sectionID, QLIB_PA_REVOKE_TYPE_T revokeType)
+QLIB_STATUS_T QLIB_BgErase_Poll(QLIB_BG_ERASE_T* bgErase, BOOL* done)
 {
-    QLIB_POLICY_T policy = {0};
-
     /*-----------------------------------------------------------------------------------------------------*/
     /* Error checking                                                                                      */
     /*-----------------------------------------------------------------------------------------------------*/
-    QLIB_ASSERT_RET(NULL != qlibContext, QLIB_STATUS__INVALID_PARAMETER);
-    QLIB_ASSERT_RET(QLIB_SECTION_ID_VAULT > sectionID, QLIB_STATUS__INVALID_PARAMETER);
-
-    /*-----------------------------------------------------------------------------------------------------*/
-    /* check if the section is authenticated plain access                                                  */
-    /*-----------------------------------------------------------------------------------------------------*/
-    QLIB_STATUS_RET_CHECK(QLIB_GetSectionConfiguration(qlibContext, sectionID, NULL, NULL, &policy, NULL, NULL, NULL));
-    QLIB_ASSERT_RET((W77Q_CMD_PA_GRANT_REVOKE(qlibContext) != 0u) || (policy.authPlainAccess == 1u), QLIB_STATUS__NOT_SUPPORTED);
+    QLIB_ASSERT_RET(NULL != bgErase, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET(NULL != bgErase->qlibContext, QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE);
 
-    if (((revokeType == QLIB_PA_REVOKE_ALL_ACCESS) &&
-         (QLIB_ACTIVE_DIE_STATE(qlibContext).sectionsState[sectionID].plainEnabled != QLIB_SECTION_PLAIN_EN_NO)) ||
-        ((QLIB_ACTIVE_DIE_STATE(qlibContext).sectionsState[sectionID].plainEnabled & QLIB_SECTION_PLAIN_EN_WR) != 0u))
+    QLIB_STATUS_RET_CHECK(QLIB_BgErase_Attach_L(bgErase, QLIB_BgErase_Update_L(bgErase, TRUE)));
 
+    if (NULL != done)
     {
-        QLIB_STATUS_RET_CHECK(QLIB_SEC_PlainAccess_Revoke(qlibContext, sectionID, revokeType));
-
-        /*-------------------------------------------------------------------------------------------------*/
-        /* Set plain access state in QLIB                                                                  */
-        /*-------------------------------------------------------------------------------------------------*/
-        QLIB_ACTIVE_DIE_STATE(qlibContext).sectionsState[sectionID].plainEnabled =
-            (revokeType == QLIB_PA_REVOKE_ALL_ACCESS || policy.plainAccessReadEnable == 0u) ? QLIB_SECTION_PLAIN_EN_NO
-                                                                                            : QLIB_SECTION_PLAIN_EN_RD;
+        *done = ((FALSE == bgErase->busy) && (0u == bgErase->size)) ? TRUE : FALSE;
     }
+
     return QLIB_STATUS__OK;
 }
 
-QLIB_STATUS_T QLIB_CheckIntegrity(QLIB_CONTEXT_T* qlibContext, U32 sectionID, QLIB_INTEGRITY_T integrityType)
+QLIB_STATUS_T QLIB_BgErase_Read(QLIB_BG_ERASE_T* bgErase, U8* buf, U32 sectionID, U32 offset, U32 size)
 {
     /*-----------------------------------------------------------------------------------------------------*/
     /* Error checking                                                                                      */
     /*-----------------------------------------------------------------------------------------------------*/
-    QLIB_ASSERT_RET(NULL != qlibContext, QLIB_STATUS__INVALID_PARAMETER);
-    QLIB_ASSERT_RET(QLIB_DEVICE_INITIALIZED(qlibContext), QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE);
-
-    return QLIB_SEC_CheckIntegrity(qlibContext, sectionID, integrityType);
-}
+    QLIB_ASSERT_RET(NULL != bgErase, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET(NULL != bgErase->qlibContext, QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE);
+    QLIB_ASSERT_RET(0u < size, QLIB_STATUS__PARAMETER_OUT_OF_RANGE);
+    QLIB_ASSERT_RET((offset + size) >= size, QLIB_STATUS__INVALID_PARAMETER);
 
-QLIB_STATUS_T QLIB_CalcCDI(QLIB_CONTEXT_T* qlibContext, _256BIT nextCdi, const _256BIT prevCdi, U32 sectionId)
-{
     /*-----------------------------------------------------------------------------------------------------*/
-    /* Error checking                                                                                      */
+    /* The reads of the background erase itself are not routed through it                                  */
     /*-----------------------------------------------------------------------------------------------------*/
-    QLIB_ASSERT_RET(NULL != qlibContext, QLIB_STATUS__INVALID_PARAMETER);
-    QLIB_ASSERT_RET(QLIB_DEVICE_INITIALIZED(qlibContext), QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE);
-    QLIB_ASSERT_RET(NULL != nextCdi, QLIB_STATUS__INVALID_PARAMETER);
-    QLIB_ASSERT_RET(QLIB_NUM_OF_SECTIONS > sectionId, QLIB_STATUS__INVALID_PARAMETER);
-    QLIB_ASSERT_RET((W77Q_VAULT(qlibContext) != 0u) || (QLIB_SECTION_ID_VAULT != sectionId), QLIB_STATUS__INVALID_PARAMETER);
+    bgErase->qlibContext->bgErase = NULL;
 
-    return QLIB_SEC_CalcCDI(qlibContext, nextCdi, prevCdi, sectionId);
+    return QLIB_BgErase_Attach_L(bgErase, QLIB_BgErase_Read_L(bgErase, buf, sectionID, offset, size));
 }
 
-QLIB_STATUS_T QLIB_Watchdog_ConfigSet(QLIB_CONTEXT_T* qlibContext, const QLIB_WATCHDOG_CONF_T* watchdogCFG)
+QLIB_STATUS_T QLIB_Suspend(QLIB_CONTEXT_T* qlibContext)
 {
     /*-----------------------------------------------------------------------------------------------------*/
     /* Error checking                                                                                      */
     /*-----------------------------------------------------------------------------------------------------*/
     QLIB_ASSERT_RET(NULL != qlibContext, QLIB_STATUS__INVALID_PARAMETER);
     QLIB_ASSERT_RET(QLIB_DEVICE_INITIALIZED(qlibContext), QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE);
-    QLIB_ASSERT_RET(NULL != watchdogCFG, QLIB_STATUS__INVALID_PARAMETER);
-    QLIB_ASSERT_RET(qlibContext->activeDie == QLIB_INIT_DIE_ID, QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE);
+    QLIB_ASSERT_RET(qlibContext->isSuspended == 0u, QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE);
 
-    return QLIB_SEC_Watchdog_ConfigSet(qlibContext, watchdogCFG);
+    QLIB_STATUS_RET_CHECK(QLIB_STD_EraseSuspend(qlibContext));
+
+    qlibContext->isSuspended = 1u;
+#if QLIB_NUM_OF_DIES > 1
+    qlibContext->suspendDie = qlibContext->activeDie;
+#endif
+    return QLIB_STATUS__OK;
 }
 
-QLIB_STATUS_T QLIB_Watchdog_ConfigGet(QLIB_CONTEXT_T* qlibContext, QLIB_WATCHDOG_CONF_T* watchdogCFG)
+QLIB_STATUS_T QLIB_Resume(QLIB_CONTEXT_T* qlibContext)
 {
     /*-----------------------------------------------------------------------------------------------------*/
     /* Error checking                                                                                      */
     /*-----------------------------------------------------------------------------------------------------*/
     QLIB_ASSERT_RET(NULL != qlibContext, QLIB_STATUS__INVALID_PARAMETER);
     QLIB_ASSERT_RET(QLIB_DEVICE_INITIALIZED(qlibContext), QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE);
-    QLIB_ASSERT_RET(NULL != watchdogCFG, QLIB_STATUS__INVALID_PARAMETER);
-    QLIB_ASSERT_RET(qlibContext->activeDie == QLIB_INIT_DIE_ID, QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE);
+    QLIB_ASSERT_RET(qlibContext->isSuspended == 1u, QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE);
+#if QLIB_NUM_OF_DIES > 1
+    QLIB_STATUS_RET_CHECK(QLIB_STD_SetActiveDie(qlibContext, qlibContext->suspendDie, FALSE));
+#endif
+    QLIB_STATUS_RET_CHECK(QLIB_STD_EraseResume(qlibContext, FALSE));
 
-    return QLIB_SEC_Watchdog_ConfigGet(qlibContext, watchdogCFG);
+    qlibContext->isSuspended                    = 0u;
+    QLIB_ACTIVE_DIE_STATE(qlibContext).mcInSync = 0u;
+
+    return QLIB_STATUS__OK;
 }
 
-#ifdef Q2_API
-QLIB_STATUS_T QLIB2_Watchdog_Get(QLIB_CONTEXT_T* qlibContext, U32* secondsPassed, U32* ticksResidue, BOOL* expired)
+QLIB_STATUS_T QLIB_Power(QLIB_CONTEXT_T* qlibContext, QLIB_POWER_T power)
 {
-    AWDTSR_T AWDTSR = 0;
+    U32 die;
 
     /*-----------------------------------------------------------------------------------------------------*/
     /* Error checking                                                                                      */
     /*-----------------------------------------------------------------------------------------------------*/
     QLIB_ASSERT_RET(NULL != qlibContext, QLIB_STATUS__INVALID_PARAMETER);
     QLIB_ASSERT_RET(QLIB_DEVICE_INITIALIZED(qlibContext), QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE);
-    QLIB_ASSERT_RET(qlibContext->activeDie == QLIB_INIT_DIE_ID, QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE);
+    QLIB_STATUS_RET_CHECK(QLIB_WriteCombine_Sync_L(qlibContext, QLIB_ALL_SECTIONS, 0, 0));
+    QLIB_STATUS_RET_CHECK(QLIB_STD_Power(qlibContext, power));
 
     /*-----------------------------------------------------------------------------------------------------*/
-    /* Secure command is ignored if power is down or suspended                                             */
+    /* During power down SW could try to communicate and increment counters                                */
     /*-----------------------------------------------------------------------------------------------------*/
-    QLIB_ASSERT_RET(QLIB_ACTIVE_DIE_STATE(qlibContext).isPoweredDown == 0u, QLIB_STATUS__COMMAND_IGNORED);
-    QLIB_ASSERT_RET(qlibContext->isSuspended == 0u, QLIB_STATUS__COMMAND_IGNORED);
-    QLIB_STATUS_RET_CHECK(QLIB_CMD_PROC__get_AWDTSR(qlibContext, &AWDTSR));
-
-    if (NULL != secondsPassed)
-    {
-        *secondsPassed = (U32)READ_VAR_FIELD(AWDTSR, QLIB_REG_AWDTSR__AWDT_VAL(qlibContext));
-    }
-
-    if (NULL != ticksResidue)
-    {
-        *ticksResidue = (U32)READ_VAR_FIELD(AWDTSR, QLIB_REG_AWDTSR__AWDT_RES(qlibContext));
-    }
-
-    if (NULL != expired)
+    if (QLIB_POWER_UP == power)
     {
-        *expired = (1u == READ_VAR_FIELD(AWDTSR, QLIB_REG_AWDTSR__AWDT_EXP_S)) ? TRUE : FALSE;
-    }
+        for (die = 0; die < QLIB_NUM_OF_DIES; die++)
+        {
+            qlibContext->dieState[die].mcInSync = 0u;
+        }
+    };
 
     return QLIB_STATUS__OK;
 }
-#endif
 
-QLIB_STATUS_T QLIB_Watchdog_Touch(QLIB_CONTEXT_T* qlibContext)
+QLIB_STATUS_T QLIB_ResetFlash(QLIB_CONTEXT_T* qlibContext)
 {
+    U32 dmc;
     /*-----------------------------------------------------------------------------------------------------*/
     /* Error checking                                                                                      */
     /*-----------------------------------------------------------------------------------------------------*/
     QLIB_ASSERT_RET(NULL != qlibContext, QLIB_STATUS__INVALID_PARAMETER);
     QLIB_ASSERT_RET(QLIB_DEVICE_INITIALIZED(qlibContext), QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE);
-    QLIB_ASSERT_RET(qlibContext->activeDie == QLIB_INIT_DIE_ID, QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE);
+    QLIB_STATUS_RET_CHECK(QLIB_WriteCombine_Sync_L(qlibContext, QLIB_ALL_SECTIONS, 0, 0));
 
-    return QLIB_SEC_Watchdog_Touch(qlibContext);
+#if QLIB_NUM_OF_DIES > 1
+    QLIB_STATUS_RET_CHECK(QLIB_STD_SetActiveDie(qlibContext, QLIB_INIT_DIE_ID, FALSE));
+#endif
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Save previous value of DMC. DMC is incremented on flash reset                                       */
+    /*-----------------------------------------------------------------------------------------------------*/
+    QLIB_STATUS_RET_CHECK(QLIB_CMD_PROC__synch_MC(qlibContext));
+    dmc = qlibContext->dieState[QLIB_INIT_DIE_ID].mc[DMC];
+
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Perform reset                                                                                       */
+    /*-----------------------------------------------------------------------------------------------------*/
+    QLIB_STATUS_RET_CHECK(QLIB_STD_ResetFlash(qlibContext, TRUE));
+
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Sync qlib state after reset                                                                         */
+    /*-----------------------------------------------------------------------------------------------------*/
+    QLIB_STATUS_RET_CHECK(QLIB_SEC_SyncAfterFlashReset(qlibContext));
+
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Verify reset occurred by testing DMC new value                                                      */
+    /*-----------------------------------------------------------------------------------------------------*/
+    QLIB_STATUS_RET_CHECK(QLIB_CMD_PROC__synch_MC(qlibContext));
+    QLIB_ASSERT_RET(dmc < qlibContext->dieState[QLIB_INIT_DIE_ID].mc[DMC], QLIB_STATUS__COMMAND_IGNORED);
+
+    return QLIB_STATUS__OK;
 }
 
-QLIB_STATUS_T QLIB_Watchdog_Trigger(QLIB_CONTEXT_T* qlibContext)
+QLIB_STATUS_T QLIB_Format(QLIB_CONTEXT_T* qlibContext, const KEY_T deviceMasterKey, BOOL eraseDataOnly, BOOL factoryDefault)
 {
     /*-----------------------------------------------------------------------------------------------------*/
     /* Error checking                                                                                      */
     /*-----------------------------------------------------------------------------------------------------*/
     QLIB_ASSERT_RET(NULL != qlibContext, QLIB_STATUS__INVALID_PARAMETER);
     QLIB_ASSERT_RET(QLIB_DEVICE_INITIALIZED(qlibContext), QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE);
-    QLIB_ASSERT_RET(qlibContext->activeDie == QLIB_INIT_DIE_ID, QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE);
+    QLIB_ASSERT_RET(FALSE == eraseDataOnly || QLIB_KEY_MNGR__IS_KEY_VALID(deviceMasterKey), QLIB_STATUS__INVALID_PARAMETER);
 
-    return QLIB_SEC_Watchdog_Trigger(qlibContext);
+    QLIB_ViewInvalidate_L(qlibContext, QLIB_ALL_SECTIONS, 0, 0);
+    QLIB_STATUS_RET_CHECK(QLIB_WriteCombine_Sync_L(qlibContext, QLIB_ALL_SECTIONS, 0, 0));
+
+    return QLIB_SEC_Format(qlibContext, deviceMasterKey, eraseDataOnly, factoryDefault);
 }
 
-QLIB_STATUS_T QLIB_Watchdog_Get(QLIB_CONTEXT_T* qlibContext, U32* milliSecondsPassed, BOOL* expired)
+QLIB_STATUS_T QLIB_GetNotifications(QLIB_CONTEXT_T* qlibContext, QLIB_NOTIFICATIONS_T* notifs)
 {
     /*-----------------------------------------------------------------------------------------------------*/
     /* Error checking                                                                                      */
     /*-----------------------------------------------------------------------------------------------------*/
     QLIB_ASSERT_RET(NULL != qlibContext, QLIB_STATUS__INVALID_PARAMETER);
     QLIB_ASSERT_RET(QLIB_DEVICE_INITIALIZED(qlibContext), QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE);
-    QLIB_ASSERT_RET(qlibContext->activeDie == QLIB_INIT_DIE_ID, QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE);
+    QLIB_ASSERT_RET(NULL != notifs, QLIB_STATUS__INVALID_PARAMETER);
 
-    return QLIB_SEC_Watchdog_Get(qlibContext, milliSecondsPassed, expired);
+    return QLIB_SEC_GetNotifications(qlibContext, notifs);
 }
 
-QLIB_STATUS_T QLIB_GetId(QLIB_CONTEXT_T* qlibContext, QLIB_ID_T* id_p)
+QLIB_STATUS_T QLIB_PerformMaintenance(QLIB_CONTEXT_T* qlibContext)
 {
     /*-----------------------------------------------------------------------------------------------------*/
     /* Error checking                                                                                      */
     /*-----------------------------------------------------------------------------------------------------*/
     QLIB_ASSERT_RET(NULL != qlibContext, QLIB_STATUS__INVALID_PARAMETER);
-    QLIB_ASSERT_RET(QLIB_DEVICE_INITIALIZED(qlibContext), QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE);
-    QLIB_ASSERT_RET(NULL != id_p, QLIB_STATUS__INVALID_PARAMETER);
 
-        QLIB_STATUS_RET_CHECK(QLIB_STD_GetId(qlibContext, &(id_p->std)));
-    QLIB_STATUS_RET_CHECK(QLIB_SEC_GetId(qlibContext, &(id_p->sec)));
-
-    return QLIB_STATUS__OK;
+    return QLIB_SEC_PerformMCMaint(qlibContext);
 }
 
-QLIB_STATUS_T QLIB_GetHWVersion(QLIB_CONTEXT_T* qlibContext, QLIB_HW_VER_T* hwVer)
+QLIB_STATUS_T QLIB_ConfigDevice(QLIB_CONTEXT_T*                   qlibContext,
+                                const KEY_T                       deviceMasterKey,
+                                const KEY_T                       deviceSecretKey,
+                                const QLIB_SECTION_CONFIG_TABLE_T sectionTable[QLIB_NUM_OF_DIES],
+                                const KEY_ARRAY_T                 restrictedKeys[QLIB_NUM_OF_DIES],
+                                const KEY_ARRAY_T                 fullAccessKeys[QLIB_NUM_OF_DIES],
+                                const QLIB_LMS_KEY_ARRAY_T        lmsKeys[QLIB_NUM_OF_DIES],
+                                const KEY_T                       preProvisionedMasterKey,
+                                const QLIB_WATCHDOG_CONF_T*       watchdogDefault,
+                                const QLIB_DEVICE_CONF_T*         deviceConf,
+                                const _128BIT                     suid)
 {
     /*-----------------------------------------------------------------------------------------------------*/
     /* Error checking                                                                                      */
     /*-----------------------------------------------------------------------------------------------------*/
     QLIB_ASSERT_RET(NULL != qlibContext, QLIB_STATUS__INVALID_PARAMETER);
     QLIB_ASSERT_RET(QLIB_DEVICE_INITIALIZED(qlibContext), QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE);
-    QLIB_ASSERT_RET(NULL != hwVer, QLIB_STATUS__INVALID_PARAMETER);
-
-        QLIB_STATUS_RET_CHECK(QLIB_STD_GetHwVersion(qlibContext, &(hwVer->std)));
-        hwVer->info.isSingleDie = ((hwVer->std.memoryType == 0x8Bu) || (hwVer->std.memoryType == 0x8Du) ? FALSE : TRUE);
-
-        hwVer->info.flashSize = DEVICE_ID_TO_TARGET_SIZE(hwVer->std.deviceID);
-        hwVer->info.voltage   = (hwVer->std.memoryType == 0x4Au) || (hwVer->std.memoryType == 0x4Bu) ||
-                                      (hwVer->std.memoryType == 0x4Cu) || (hwVer->std.memoryType == 0x4Du)
-                                    ? QLIB_TARGET_VOLTAGE_3_3V
-                                    : QLIB_TARGET_VOLTAGE_1_8V;
-
-    QLIB_STATUS_RET_CHECK(QLIB_SEC_GetHWVersion(qlibContext, &(hwVer->sec)));
 
-    switch (hwVer->sec.revision)
+    if (NULL != sectionTable)
     {
-        case 0:
-            hwVer->info.revision = QLIB_TARGET_REVISION_A;
-            break;
-        case 1:
-            hwVer->info.revision = QLIB_TARGET_REVISION_B;
+        uint_fast8_t die;
+        for (die = 0; die < QLIB_NUM_OF_DIES; die++)
+        {
+            if (W77Q_VAULT(qlibContext) != 0u)
+            {
+                QLIB_ASSERT_RET(0u == sectionTable[die][QLIB_SECTION_ID_VAULT].policy.plainAccessReadEnable,
+                                QLIB_STATUS__INVALID_PARAMETER);
+                QLIB_ASSERT_RET(0u == sectionTable[die][QLIB_SECTION_ID_VAULT].policy.plainAccessWriteEnable,
+                                QLIB_STATUS__INVALID_PARAMETER);
+                QLIB_ASSERT_RET(0u == sectionTable[die][QLIB_SECTION_ID_VAULT].policy.authPlainAccess,
+                                QLIB_STATUS__INVALID_PARAMETER);
+                QLIB_ASSERT_RET(QLIB_VAULT_CFG_TO_SIZE(deviceConf->vaultSize[die]) ==
+                                    sectionTable[die][QLIB_SECTION_ID_VAULT].size,
+                                QLIB_STATUS__INVALID_PARAMETER);
+            }
+#ifndef Q2_API
+            else
+            {
+                QLIB_ASSERT_RET(sectionTable[die][QLIB_SECTION_ID_VAULT].size == 0u, QLIB_STATUS__INVALID_PARAMETER);
+                QLIB_ASSERT_RET(deviceConf->vaultSize[die] == QLIB_VAULT_DISABLED_RPMC_8_COUNTERS,
+                                QLIB_STATUS__INVALID_PARAMETER);
+            }
+#endif
+        }
+    }
+
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Configure the device                                                                                */
+    /*-----------------------------------------------------------------------------------------------------*/
+    QLIB_STATUS_RET_CHECK(QLIB_SEC_ConfigDevice(qlibContext,
+                                                deviceMasterKey,
+                                                deviceSecretKey,
+                                                sectionTable,
+                                                restrictedKeys,
+                                                fullAccessKeys,
+                                                lmsKeys,
+                                                preProvisionedMasterKey,
+                                                watchdogDefault,
+                                                deviceConf,
+                                                suid));
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Re-sync the device                                                                                  */
+    /*-----------------------------------------------------------------------------------------------------*/
+    QLIB_STATUS_RET_CHECK(QLIB_SEC_SyncState(qlibContext));
+
+    return QLIB_STATUS__OK;
+}
+
+QLIB_STATUS_T QLIB_GetDeviceConfig(QLIB_CONTEXT_T*       qlibContext,
+                                   QLIB_WATCHDOG_CONF_T* watchdogDefault,
+                                   QLIB_DEVICE_CONF_T*   deviceConf)
+{
+    GMC_T         gmc;
+    DEVCFG_T      devCfg = 0;
+    AWDTCFG_T     awdtDefault;
+    BOOL          quadEnabled;
+    U32           val = 0u;
+    U8            sectionId;
+    U8            rstPAField = 0u;
+    U8            origDie    = qlibContext->activeDie;
+    QLIB_STATUS_T ret        = QLIB_STATUS__OK;
+#if QLIB_NUM_OF_DIES > 1
+    uint_fast8_t nextDie;
+#endif
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Error checking                                                                                      */
+    /*-----------------------------------------------------------------------------------------------------*/
+    QLIB_ASSERT_RET(NULL != qlibContext, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET(QLIB_DEVICE_INITIALIZED(qlibContext), QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE);
+    QLIB_ASSERT_RET(NULL != watchdogDefault, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET(NULL != deviceConf, QLIB_STATUS__INVALID_PARAMETER);
+
+    (void)memset(watchdogDefault, 0, sizeof(QLIB_WATCHDOG_CONF_T));
+    (void)memset(deviceConf, 0, sizeof(QLIB_DEVICE_CONF_T));
+    do
+    {
+        QLIB_STATUS_RET_CHECK_GOTO(QLIB_SEC__get_GMC(qlibContext, gmc), ret, error);
+        devCfg = QLIB_REG_GMC_GET_DEVCFG(gmc);
+        if (qlibContext->activeDie == QLIB_INIT_DIE_ID)
+        {
+            awdtDefault = QLIB_REG_GMC_GET_AWDT_DFLT(gmc);
+
+            //Set watchdogDefault values
+            watchdogDefault->enable        = INT_TO_BOOLEAN(READ_VAR_FIELD(awdtDefault, QLIB_REG_AWDTCFG__AWDT_EN));
+            watchdogDefault->lfOscEn       = INT_TO_BOOLEAN(READ_VAR_FIELD(awdtDefault, QLIB_REG_AWDTCFG__LFOSC_EN));
+            watchdogDefault->swResetEn     = INT_TO_BOOLEAN(READ_VAR_FIELD(awdtDefault, QLIB_REG_AWDTCFG__SRST_EN));
+            watchdogDefault->authenticated = INT_TO_BOOLEAN(READ_VAR_FIELD(awdtDefault, QLIB_REG_AWDTCFG__AUTH_WDT));
+            watchdogDefault->sectionID     = (U32)READ_VAR_FIELD(awdtDefault, QLIB_REG_AWDTCFG__KID);
+            watchdogDefault->threshold =
+                (QLIB_AWDT_TH_T)MIN((U32)READ_VAR_FIELD(awdtDefault, QLIB_REG_AWDTCFG__TH), (U32)QLIB_AWDT_TH_12_DAYS);
+            watchdogDefault->lock      = INT_TO_BOOLEAN(READ_VAR_FIELD(awdtDefault, QLIB_REG_AWDTCFG__LOCK));
+            watchdogDefault->oscRateHz = ((U32)READ_VAR_FIELD(awdtDefault, QLIB_REG_AWDTCFG__OSC_RATE_KHZ) << 10);
+            if (W77Q_AWDTCFG_OSC_RATE_FRAC(qlibContext) != 0u)
+            {
+                watchdogDefault->oscRateHz += ((U32)READ_VAR_FIELD(awdtDefault, QLIB_REG_AWDTCFG__OSC_RATE_FRAC) << 6);
+            }
+            watchdogDefault->fallbackEn = INT_TO_BOOLEAN(READ_VAR_FIELD(awdtDefault, QLIB_REG_AWDTCFG__FB_EN));
+
+            //Set devCfg values
+            if ((0u == W77Q_RST_RESP(qlibContext)) || (0u == READ_VAR_FIELD(devCfg, QLIB_REG_DEVCFG__RST_RESP_EN)))
+            {
+                (void)memset(deviceConf->resetResp.response1, 0, sizeof(deviceConf->resetResp.response1));
+                (void)memset(deviceConf->resetResp.response2, 0, sizeof(deviceConf->resetResp.response2));
+            }
+            else
+            {
+                QLIB_STATUS_RET_CHECK(QLIB_CMD_PROC__get_RST_RESP(qlibContext, deviceConf->resetResp.response1));
+            }
+            deviceConf->safeFB            = INT_TO_BOOLEAN(READ_VAR_FIELD(devCfg, QLIB_REG_DEVCFG__FB_EN));
+            deviceConf->speculCK          = INT_TO_BOOLEAN(READ_VAR_FIELD(devCfg, QLIB_REG_DEVCFG__CK_SPECUL));
+            deviceConf->nonSecureFormatEn = INT_TO_BOOLEAN(READ_VAR_FIELD(devCfg, QLIB_REG_DEVCFG__FORMAT_EN));
+            deviceConf->lock =
+                (W77Q_DEVCFG_LOCK(qlibContext) != 0u) ? INT_TO_BOOLEAN(READ_VAR_FIELD(devCfg, QLIB_REG_DEVCFG__CFG_LOCK)) : FALSE;
+
+            QLIB_STATUS_RET_CHECK_GOTO(QLIB_STD_GetQuadEnable(qlibContext, &quadEnabled), ret, error);
+            deviceConf->pinMux.dedicatedResetInEn = INT_TO_BOOLEAN(READ_VAR_FIELD(awdtDefault, QLIB_REG_AWDTCFG__RST_IN_EN));
+
+            deviceConf->pinMux.io23Mux = QLIB_IO23_MODE__NONE;
+            if (quadEnabled == TRUE)
+            {
+                if ((READ_VAR_FIELD(awdtDefault, QLIB_REG_AWDTCFG__RSTI_OVRD) == 0u) &&
+                    (READ_VAR_FIELD(awdtDefault, QLIB_REG_AWDTCFG__RSTO_EN) == 0u))
+                {
+                    deviceConf->pinMux.io23Mux = QLIB_IO23_MODE__QUAD;
+                }
+            }
+            else
+            { //quadEnable == FALSE
+                if ((READ_VAR_FIELD(awdtDefault, QLIB_REG_AWDTCFG__RSTI_OVRD) == 0u) &&
+                    (READ_VAR_FIELD(awdtDefault, QLIB_REG_AWDTCFG__RSTO_EN) == 0u))
+                {
+                    deviceConf->pinMux.io23Mux = QLIB_IO23_MODE__LEGACY_WP_HOLD;
+                }
+                else
+                {
+                    if (
+                        (READ_VAR_FIELD(awdtDefault, QLIB_REG_AWDTCFG__RSTI_OVRD) == 1u) &&
+                        (READ_VAR_FIELD(awdtDefault, QLIB_REG_AWDTCFG__RSTO_EN) == 1u) &&
+                        (READ_VAR_FIELD(awdtDefault, QLIB_REG_AWDTCFG__RSTI_EN) == 1u))
+                    {
+                        deviceConf->pinMux.io23Mux = QLIB_IO23_MODE__RESET_IN_OUT;
+                    }
+                }
+            }
+
+            deviceConf->bootFailReset = (W77Q_DEVCFG_BOOT_FAIL_RST(qlibContext) != 0u)
+                                            ? INT_TO_BOOLEAN(READ_VAR_FIELD(devCfg, QLIB_REG_DEVCFG__BOOT_FAIL_RST))
+                                            : FALSE;
+            if (W77Q_FAST_READ_DUMMY_CONFIG(qlibContext) != 0u)
+            {
+                QLIB_STATUS_RET_CHECK_GOTO(QLIB_STD_getPowerUpDummyCycles(qlibContext, &deviceConf->fastReadDummyCycles),
+                                           ret,
+                                           error);
+            }
+
+            val = (U32)(READ_VAR_FIELD(devCfg, QLIB_REG_DEVCFG__SECT_SEL) + (U32)LOG2(QLIB_MIN_SECTION_SIZE));
+            QLIB_ASSERT_WITH_ERROR_GOTO(val >= (U32)QLIB_STD_ADDR_LEN__22_BIT && val < (U32)QLIB_STD_ADDR_LEN__LAST,
+                                        QLIB_STATUS__INVALID_PARAMETER,
+                                        ret,
+                                        error)
+            deviceConf->stdAddrSize.addrLen = (QLIB_STD_ADDR_LEN_T)val;
+
+            QLIB_STATUS_RET_CHECK_GOTO(QLIB_STD_GetPowerUpAddressMode(qlibContext, &deviceConf->stdAddrSize.addrMode),
+                                       ret,
+                                       error);
+            deviceConf->rngPAEn = (W77Q_RNG_FEATURE(qlibContext) != 0u)
+                                      ? INT_TO_BOOLEAN(READ_VAR_FIELD(devCfg, QLIB_REG_DEVCFG__RNG_PA_EN))
+                                      : FALSE;
+        }
+        deviceConf->ctagModeMulti =
+            (Q2_DEVCFG_CTAG_MODE(qlibContext) != 0u) ? INT_TO_BOOLEAN(READ_VAR_FIELD(devCfg, QLIB_REG_DEVCFG__CTAG_MODE)) : FALSE;
+
+        val = (U32)READ_VAR_FIELD(devCfg, QLIB_REG_DEVCFG__VAULT_MEM);
+        deviceConf->vaultSize[qlibContext->activeDie] =
+            (W77Q_VAULT(qlibContext) != 0u) ? (QLIB_VAULT_RPMC_CONFIG_T)val : QLIB_VAULT_DISABLED_RPMC_8_COUNTERS;
+
+        rstPAField = (W77Q_RST_PA(qlibContext) != 0u) ? (U8)READ_VAR_FIELD(devCfg, QLIB_REG_DEVCFG__RST_PA) : 1u;
+        for (sectionId = 0; sectionId < QLIB_NUM_OF_MAIN_SECTIONS; sectionId++)
+        {
+            deviceConf->resetPA[qlibContext->activeDie][sectionId] = INT_TO_BOOLEAN(rstPAField & (1u << sectionId));
+        }
+
+#if QLIB_NUM_OF_DIES > 1
+        nextDie = (qlibContext->activeDie + 1) % QLIB_NUM_OF_DIES;
+        QLIB_STATUS_RET_CHECK_GOTO(QLIB_SetActiveDie(qlibContext, nextDie), ret, error);
+#endif
+    } while (qlibContext->activeDie != origDie);
+
+    return QLIB_STATUS__OK;
+error:
+#if QLIB_NUM_OF_DIES > 1
+    QLIB_SetActiveDie(qlibContext, origDie);
+#endif
+    return ret;
+}
+
+QLIB_STATUS_T QLIB_GetSectionConfiguration(QLIB_CONTEXT_T* qlibContext,
+                                           U32             sectionID,
+                                           U32*            baseAddr,
+                                           U32*            size,
+                                           QLIB_POLICY_T*  policy,
+                                           U64*            digest,
+                                           U32*            crc,
+                                           U32*            version)
+{
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Error checking                                                                                      */
+    /*-----------------------------------------------------------------------------------------------------*/
+    QLIB_ASSERT_RET(NULL != qlibContext, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET(QLIB_DEVICE_INITIALIZED(qlibContext), QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE);
+
+    return QLIB_SEC_GetSectionConfiguration(qlibContext, sectionID, baseAddr, size, policy, digest, crc, version);
+}
+
+QLIB_STATUS_T QLIB_ConfigSection(QLIB_CONTEXT_T*            qlibContext,
+                                 U32                        sectionID,
+                                 const QLIB_POLICY_T*       policy,
+                                 const U64*                 digest,
+                                 const U32*                 crc,
+                                 const U32*                 newVersion,
+                                 BOOL                       swap,
+                                 QLIB_SECTION_CONF_ACTION_T action)
+{
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Error checking                                                                                      */
+    /*-----------------------------------------------------------------------------------------------------*/
+    QLIB_ASSERT_RET(NULL != qlibContext, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET(QLIB_DEVICE_INITIALIZED(qlibContext), QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE);
+    QLIB_ASSERT_RET(QLIB_NUM_OF_SECTIONS > sectionID, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET((W77Q_VAULT(qlibContext) != 0u) || (QLIB_SECTION_ID_VAULT != sectionID), QLIB_STATUS__INVALID_PARAMETER);
+
+    // swap changes the mapping of the section and its fallback section
+    QLIB_ViewInvalidate_L(qlibContext, QLIB_ALL_SECTIONS, 0, 0);
+    QLIB_STATUS_RET_CHECK(QLIB_WriteCombine_Sync_L(qlibContext, QLIB_ALL_SECTIONS, 0, 0));
+
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Perform Section Config                                                                              */
+    /*-----------------------------------------------------------------------------------------------------*/
+    QLIB_STATUS_RET_CHECK(QLIB_SEC_ConfigSection(qlibContext, sectionID, policy, digest, crc, newVersion, swap, action));
+
+    if ((W77Q_SET_SCR_MODE(qlibContext) == 0u) && (action != QLIB_SECTION_CONF_ACTION__NO))
+    {
+        /*-------------------------------------------------------------------------------------------------*/
+        /* Reopen the session to this section, after 'set_SCRn' revokes access privileges to the section   */
+        /*-------------------------------------------------------------------------------------------------*/
+        QLIB_STATUS_RET_CHECK(QLIB_SEC_OpenSession(qlibContext, sectionID, QLIB_SESSION_ACCESS_FULL));
+    }
+    return QLIB_STATUS__OK;
+}
+
+QLIB_STATUS_T QLIB_ConfigAccess(QLIB_CONTEXT_T* qlibContext, U32 sectionID, BOOL readEnable, BOOL writeEnable)
+{
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Error checking                                                                                      */
+    /*-----------------------------------------------------------------------------------------------------*/
+    QLIB_ASSERT_RET(NULL != qlibContext, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET(QLIB_DEVICE_INITIALIZED(qlibContext), QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE);
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Perform configuration                                                                               */
+    /*-----------------------------------------------------------------------------------------------------*/
+    return QLIB_SEC_ConfigAccess(qlibContext, sectionID, readEnable, writeEnable);
+}
+
+QLIB_STATUS_T QLIB_LoadKey(QLIB_CONTEXT_T* qlibContext, U32 sectionID, const KEY_T key, BOOL fullAccess)
+{
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Error checking                                                                                      */
+    /*-----------------------------------------------------------------------------------------------------*/
+    QLIB_ASSERT_RET(NULL != qlibContext, QLIB_STATUS__INVALID_PARAMETER);
+
+    return QLIB_SEC_LoadKey(qlibContext, sectionID, key, fullAccess);
+}
+
+QLIB_STATUS_T QLIB_RemoveKey(QLIB_CONTEXT_T* qlibContext, U32 sectionID, BOOL fullAccess)
+{
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Error checking                                                                                      */
+    /*-----------------------------------------------------------------------------------------------------*/
+    QLIB_ASSERT_RET(NULL != qlibContext, QLIB_STATUS__INVALID_PARAMETER);
+
+    return QLIB_SEC_RemoveKey(qlibContext, sectionID, fullAccess);
+}
+
+QLIB_STATUS_T QLIB_Connect(QLIB_CONTEXT_T* qlibContext)
+{
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Error checking                                                                                      */
+    /*-----------------------------------------------------------------------------------------------------*/
+    QLIB_ASSERT_RET(NULL != qlibContext, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_STATUS_RET_CHECK(QLIB_TM_Connect(qlibContext));
+
+#if QLIB_NUM_OF_DIES > 1
+    qlibContext->activeDie = QLIB_INIT_DIE_ID;
+#endif
+    return QLIB_STATUS__OK;
+}
+
+QLIB_STATUS_T QLIB_Disconnect(QLIB_CONTEXT_T* qlibContext)
+{
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Error checking                                                                                      */
+    /*-----------------------------------------------------------------------------------------------------*/
+    QLIB_ASSERT_RET(NULL != qlibContext, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET(!QLIB_KEY_MNGR__SESSION_IS_OPEN(qlibContext), QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE);
+
+#if QLIB_NUM_OF_DIES > 1
+    QLIB_STATUS_RET_CHECK(QLIB_SetActiveDie(qlibContext, QLIB_INIT_DIE_ID));
+#endif
+    QLIB_STATUS_RET_CHECK(QLIB_TM_Disconnect(qlibContext));
+    return QLIB_STATUS__OK;
+}
+
+QLIB_STATUS_T QLIB_OpenSession(QLIB_CONTEXT_T* qlibContext, U32 sectionID, QLIB_SESSION_ACCESS_T sessionAccess)
+{
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Error checking                                                                                      */
+    /*-----------------------------------------------------------------------------------------------------*/
+    QLIB_ASSERT_RET(NULL != qlibContext, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET(QLIB_DEVICE_INITIALIZED(qlibContext), QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE);
+
+    return QLIB_SEC_OpenSession(qlibContext, sectionID, sessionAccess);
+}
+
+QLIB_STATUS_T QLIB_CloseSession(QLIB_CONTEXT_T* qlibContext, U32 sectionID)
+{
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Error checking                                                                                      */
+    /*-----------------------------------------------------------------------------------------------------*/
+    QLIB_ASSERT_RET(NULL != qlibContext, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET(QLIB_DEVICE_INITIALIZED(qlibContext), QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE);
+
+    // buffered data may depend on plain access granted by the session
+    QLIB_STATUS_RET_CHECK(QLIB_WriteCombine_Sync_L(qlibContext, QLIB_ALL_SECTIONS, 0, 0));
+
+    return QLIB_SEC_CloseSession(qlibContext, sectionID);
+}
+
+QLIB_STATUS_T QLIB_PlainAccessGrant(QLIB_CONTEXT_T* qlibContext, U32 sectionID)
+{
+    return QLIB_PlainAccessGrant_L(qlibContext, sectionID, QLIB_LOAD_ACLR_ANY);
+}
+
+QLIB_STATUS_T QLIB_PlainAccessGrantMulti(QLIB_CONTEXT_T* qlibContext, const U32* sectionIDs, U32 num)
+{
+    QLIB_POLICY_T policy[QLIB_NUM_OF_MAIN_SECTIONS];
+    U32           authSections[QLIB_NUM_OF_MAIN_SECTIONS];
+    U32           numAuth          = 0;
+    U32           integrityErrMask = 0;
+    U32           authErrMask      = 0;
+    U32           grantedMask      = 0;
+    U32           sectionSize;
+    U32           i;
+    QLIB_STATUS_T ret;
+
+    /********************************************************************************************************
+     * Error checking
+    ********************************************************************************************************/
+    QLIB_ASSERT_RET(NULL != qlibContext, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET(NULL != sectionIDs, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET((0u < num) && (QLIB_NUM_OF_MAIN_SECTIONS >= num), QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET(QLIB_DEVICE_INITIALIZED(qlibContext), QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE);
+
+    /********************************************************************************************************
+     * Check the configuration of all the sections before any grant
+    ********************************************************************************************************/
+    for (i = 0; i < num; i++)
+    {
+        QLIB_ASSERT_RET(QLIB_SECTION_ID_VAULT > sectionIDs[i], QLIB_STATUS__INVALID_PARAMETER);
+        QLIB_STATUS_RET_CHECK(
+            QLIB_GetSectionConfiguration(qlibContext, sectionIDs[i], NULL, &sectionSize, &policy[i], NULL, NULL, NULL));
+        QLIB_ASSERT_RET(sectionSize != 0u, QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE); // section is disabled
+
+        if (policy[i].authPlainAccess == 1u)
+        {
+            authSections[numAuth] = sectionIDs[i];
+            numAuth++;
+        }
+    }
+
+    /********************************************************************************************************
+     * Enable plain access to the non-authenticated sections
+    ********************************************************************************************************/
+    for (i = 0; i < num; i++)
+    {
+        if (policy[i].authPlainAccess == 0u)
+        {
+            ret = QLIB_SEC_EnablePlainAccess(qlibContext, sectionIDs[i]);
+            QLIB_ASSERT_RET((QLIB_STATUS__OK == ret) || (QLIB_STATUS__DEVICE_INTEGRITY_ERR == ret), ret);
+            if (QLIB_STATUS__DEVICE_INTEGRITY_ERR == ret)
+            {
+                integrityErrMask |= (1u << sectionIDs[i]);
+            }
+            QLIB_PlainAccessMark_L(qlibContext, sectionIDs[i], &policy[i], INT_TO_BOOLEAN(QLIB_STATUS__OK != ret));
+        }
+    }
+
+    /********************************************************************************************************
+     * Grant plain access to the authenticated sections
+    ********************************************************************************************************/
+    if (0u < numAuth)
+    {
+        ret = QLIB_SEC_AuthPlainAccess_GrantMulti(qlibContext, authSections, numAuth, &grantedMask, &authErrMask);
+        integrityErrMask |= authErrMask;
+
+        // sections granted before a failure are marked as well
+        for (i = 0; i < num; i++)
+        {
+            if ((policy[i].authPlainAccess == 1u) && ((grantedMask & (1u << sectionIDs[i])) != 0u))
+            {
+                QLIB_PlainAccessMark_L(qlibContext,
+                                       sectionIDs[i],
+                                       &policy[i],
+                                       INT_TO_BOOLEAN((integrityErrMask & (1u << sectionIDs[i])) != 0u));
+            }
+        }
+        QLIB_STATUS_RET_CHECK(ret);
+    }
+
+    return (0u == integrityErrMask) ? QLIB_STATUS__OK : QLIB_STATUS__DEVICE_INTEGRITY_ERR;
+}
+
+QLIB_STATUS_T QLIB_PlainAccessRevoke(QLIB_CONTEXT_T* qlibContext, U32 sectionID, QLIB_PA_REVOKE_TYPE_T revokeType)
+{
+    QLIB_POLICY_T policy = {0};
+
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Error checking                                                                                      */
+    /*-----------------------------------------------------------------------------------------------------*/
+    QLIB_ASSERT_RET(NULL != qlibContext, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET(QLIB_SECTION_ID_VAULT > sectionID, QLIB_STATUS__INVALID_PARAMETER);
+
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* check if the section is authenticated plain access                                                  */
+    /*-----------------------------------------------------------------------------------------------------*/
+    QLIB_STATUS_RET_CHECK(QLIB_GetSectionConfiguration(qlibContext, sectionID, NULL, NULL, &policy, NULL, NULL, NULL));
+    QLIB_ASSERT_RET((W77Q_CMD_PA_GRANT_REVOKE(qlibContext) != 0u) || (policy.authPlainAccess == 1u), QLIB_STATUS__NOT_SUPPORTED);
+
+    if (((revokeType == QLIB_PA_REVOKE_ALL_ACCESS) &&
+         (QLIB_ACTIVE_DIE_STATE(qlibContext).sectionsState[sectionID].plainEnabled != QLIB_SECTION_PLAIN_EN_NO)) ||
+        ((QLIB_ACTIVE_DIE_STATE(qlibContext).sectionsState[sectionID].plainEnabled & QLIB_SECTION_PLAIN_EN_WR) != 0u))
+
+    {
+        QLIB_STATUS_RET_CHECK(QLIB_SEC_PlainAccess_Revoke(qlibContext, sectionID, revokeType));
+
+        /*-------------------------------------------------------------------------------------------------*/
+        /* Set plain access state in QLIB                                                                  */
+        /*-------------------------------------------------------------------------------------------------*/
+        QLIB_ACTIVE_DIE_STATE(qlibContext).sectionsState[sectionID].plainEnabled =
+            (revokeType == QLIB_PA_REVOKE_ALL_ACCESS || policy.plainAccessReadEnable == 0u) ? QLIB_SECTION_PLAIN_EN_NO
+                                                                                            : QLIB_SECTION_PLAIN_EN_RD;
+    }
+    return QLIB_STATUS__OK;
+}
+
+QLIB_STATUS_T QLIB_CheckIntegrity(QLIB_CONTEXT_T* qlibContext, U32 sectionID, QLIB_INTEGRITY_T integrityType)
+{
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Error checking                                                                                      */
+    /*-----------------------------------------------------------------------------------------------------*/
+    QLIB_ASSERT_RET(NULL != qlibContext, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET(QLIB_DEVICE_INITIALIZED(qlibContext), QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE);
+    QLIB_STATUS_RET_CHECK(QLIB_WriteCombine_Sync_L(qlibContext, sectionID, 0, MAX_U32));
+
+    return QLIB_SEC_CheckIntegrity(qlibContext, sectionID, integrityType);
+}
+
+QLIB_STATUS_T QLIB_CheckIntegrityAll(QLIB_CONTEXT_T*  qlibContext,
+                                     U32              sectionMask,
+                                     QLIB_INTEGRITY_T integrityType,
+                                     U32*             checkedMask,
+                                     U32*             failedMask)
+{
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Error checking                                                                                      */
+    /*-----------------------------------------------------------------------------------------------------*/
+    QLIB_ASSERT_RET(NULL != qlibContext, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET((NULL != checkedMask) && (NULL != failedMask), QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET(QLIB_DEVICE_INITIALIZED(qlibContext), QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE);
+    QLIB_STATUS_RET_CHECK(QLIB_WriteCombine_Sync_L(qlibContext, QLIB_ALL_SECTIONS, 0, 0));
+
+    return QLIB_SEC_CheckIntegrityAll(qlibContext, sectionMask, integrityType, checkedMask, failedMask);
+}
+
+QLIB_STATUS_T QLIB_CalcCDI(QLIB_CONTEXT_T* qlibContext, _256BIT nextCdi, const _256BIT prevCdi, U32 sectionId)
+{
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Error checking                                                                                      */
+    /*-----------------------------------------------------------------------------------------------------*/
+    QLIB_ASSERT_RET(NULL != qlibContext, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET(QLIB_DEVICE_INITIALIZED(qlibContext), QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE);
+    QLIB_ASSERT_RET(NULL != nextCdi, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET(QLIB_NUM_OF_SECTIONS > sectionId, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET((W77Q_VAULT(qlibContext) != 0u) || (QLIB_SECTION_ID_VAULT != sectionId), QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_STATUS_RET_CHECK(QLIB_WriteCombine_Sync_L(qlibContext, sectionId, 0, MAX_U32));
+
+    return QLIB_SEC_CalcCDI(qlibContext, nextCdi, prevCdi, sectionId);
+}
+
+QLIB_STATUS_T QLIB_CalcCDIChain(QLIB_CONTEXT_T* qlibContext,
+                                _256BIT*        cdis,
+                                const _256BIT   prevCdi,
+                                const U32*      sectionIds,
+                                U32             num)
+{
+    U32 i;
+
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Error checking                                                                                      */
+    /*-----------------------------------------------------------------------------------------------------*/
+    QLIB_ASSERT_RET(NULL != qlibContext, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET(QLIB_DEVICE_INITIALIZED(qlibContext), QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE);
+    QLIB_ASSERT_RET(NULL != cdis, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET(NULL != sectionIds, QLIB_STATUS__INVALID_PARAMETER);
+    for (i = 0; i < num; i++)
+    {
+        QLIB_ASSERT_RET(QLIB_NUM_OF_SECTIONS > sectionIds[i], QLIB_STATUS__INVALID_PARAMETER);
+        QLIB_ASSERT_RET((W77Q_VAULT(qlibContext) != 0u) || (QLIB_SECTION_ID_VAULT != sectionIds[i]),
+                        QLIB_STATUS__INVALID_PARAMETER);
+        QLIB_STATUS_RET_CHECK(QLIB_WriteCombine_Sync_L(qlibContext, sectionIds[i], 0, MAX_U32));
+    }
+
+    return QLIB_SEC_CalcCDIChain(qlibContext, cdis, prevCdi, sectionIds, num);
+}
+
+QLIB_STATUS_T QLIB_Watchdog_ConfigSet(QLIB_CONTEXT_T* qlibContext, const QLIB_WATCHDOG_CONF_T* watchdogCFG)
+{
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Error checking                                                                                      */
+    /*-----------------------------------------------------------------------------------------------------*/
+    QLIB_ASSERT_RET(NULL != qlibContext, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET(QLIB_DEVICE_INITIALIZED(qlibContext), QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE);
+    QLIB_ASSERT_RET(NULL != watchdogCFG, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET(qlibContext->activeDie == QLIB_INIT_DIE_ID, QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE);
+
+    return QLIB_SEC_Watchdog_ConfigSet(qlibContext, watchdogCFG);
+}
+
+QLIB_STATUS_T QLIB_Watchdog_ConfigGet(QLIB_CONTEXT_T* qlibContext, QLIB_WATCHDOG_CONF_T* watchdogCFG)
+{
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Error checking                                                                                      */
+    /*-----------------------------------------------------------------------------------------------------*/
+    QLIB_ASSERT_RET(NULL != qlibContext, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET(QLIB_DEVICE_INITIALIZED(qlibContext), QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE);
+    QLIB_ASSERT_RET(NULL != watchdogCFG, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET(qlibContext->activeDie == QLIB_INIT_DIE_ID, QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE);
+
+    return QLIB_SEC_Watchdog_ConfigGet(qlibContext, watchdogCFG);
+}
+
+#ifdef Q2_API
+QLIB_STATUS_T QLIB2_Watchdog_Get(QLIB_CONTEXT_T* qlibContext, U32* secondsPassed, U32* ticksResidue, BOOL* expired)
+{
+    AWDTSR_T AWDTSR = 0;
+
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Error checking                                                                                      */
+    /*-----------------------------------------------------------------------------------------------------*/
+    QLIB_ASSERT_RET(NULL != qlibContext, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET(QLIB_DEVICE_INITIALIZED(qlibContext), QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE);
+    QLIB_ASSERT_RET(qlibContext->activeDie == QLIB_INIT_DIE_ID, QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE);
+
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Secure command is ignored if power is down or suspended                                             */
+    /*-----------------------------------------------------------------------------------------------------*/
+    QLIB_ASSERT_RET(QLIB_ACTIVE_DIE_STATE(qlibContext).isPoweredDown == 0u, QLIB_STATUS__COMMAND_IGNORED);
+    QLIB_ASSERT_RET(qlibContext->isSuspended == 0u, QLIB_STATUS__COMMAND_IGNORED);
+    QLIB_STATUS_RET_CHECK(QLIB_CMD_PROC__get_AWDTSR(qlibContext, &AWDTSR));
+
+    if (NULL != secondsPassed)
+    {
+        *secondsPassed = (U32)READ_VAR_FIELD(AWDTSR, QLIB_REG_AWDTSR__AWDT_VAL(qlibContext));
+    }
+
+    if (NULL != ticksResidue)
+    {
+        *ticksResidue = (U32)READ_VAR_FIELD(AWDTSR, QLIB_REG_AWDTSR__AWDT_RES(qlibContext));
+    }
+
+    if (NULL != expired)
+    {
+        *expired = (1u == READ_VAR_FIELD(AWDTSR, QLIB_REG_AWDTSR__AWDT_EXP_S)) ? TRUE : FALSE;
+    }
+
+    return QLIB_STATUS__OK;
+}
+#endif
+
+QLIB_STATUS_T QLIB_Watchdog_Touch(QLIB_CONTEXT_T* qlibContext)
+{
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Error checking                                                                                      */
+    /*-----------------------------------------------------------------------------------------------------*/
+    QLIB_ASSERT_RET(NULL != qlibContext, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET(QLIB_DEVICE_INITIALIZED(qlibContext), QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE);
+    QLIB_ASSERT_RET(qlibContext->activeDie == QLIB_INIT_DIE_ID, QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE);
+
+    return QLIB_SEC_Watchdog_Touch(qlibContext);
+}
+
+QLIB_STATUS_T QLIB_Watchdog_Trigger(QLIB_CONTEXT_T* qlibContext)
+{
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Error checking                                                                                      */
+    /*-----------------------------------------------------------------------------------------------------*/
+    QLIB_ASSERT_RET(NULL != qlibContext, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET(QLIB_DEVICE_INITIALIZED(qlibContext), QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE);
+    QLIB_ASSERT_RET(qlibContext->activeDie == QLIB_INIT_DIE_ID, QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE);
+
+    return QLIB_SEC_Watchdog_Trigger(qlibContext);
+}
+
+QLIB_STATUS_T QLIB_Watchdog_Get(QLIB_CONTEXT_T* qlibContext, U32* milliSecondsPassed, BOOL* expired)
+{
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Error checking                                                                                      */
+    /*-----------------------------------------------------------------------------------------------------*/
+    QLIB_ASSERT_RET(NULL != qlibContext, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET(QLIB_DEVICE_INITIALIZED(qlibContext), QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE);
+    QLIB_ASSERT_RET(qlibContext->activeDie == QLIB_INIT_DIE_ID, QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE);
+
+    return QLIB_SEC_Watchdog_Get(qlibContext, milliSecondsPassed, expired);
+}
+
+QLIB_STATUS_T QLIB_GetId(QLIB_CONTEXT_T* qlibContext, QLIB_ID_T* id_p)
+{
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Error checking                                                                                      */
+    /*-----------------------------------------------------------------------------------------------------*/
+    QLIB_ASSERT_RET(NULL != qlibContext, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET(QLIB_DEVICE_INITIALIZED(qlibContext), QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE);
+    QLIB_ASSERT_RET(NULL != id_p, QLIB_STATUS__INVALID_PARAMETER);
+
+        QLIB_STATUS_RET_CHECK(QLIB_STD_GetId(qlibContext, &(id_p->std)));
+    QLIB_STATUS_RET_CHECK(QLIB_SEC_GetId(qlibContext, &(id_p->sec)));
+
+    return QLIB_STATUS__OK;
+}
+
+QLIB_STATUS_T QLIB_GetHWVersion(QLIB_CONTEXT_T* qlibContext, QLIB_HW_VER_T* hwVer)
+{
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Error checking                                                                                      */
+    /*-----------------------------------------------------------------------------------------------------*/
+    QLIB_ASSERT_RET(NULL != qlibContext, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET(QLIB_DEVICE_INITIALIZED(qlibContext), QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE);
+    QLIB_ASSERT_RET(NULL != hwVer, QLIB_STATUS__INVALID_PARAMETER);
+
+        QLIB_STATUS_RET_CHECK(QLIB_STD_GetHwVersion(qlibContext, &(hwVer->std)));
+        hwVer->info.isSingleDie = ((hwVer->std.memoryType == 0x8Bu) || (hwVer->std.memoryType == 0x8Du) ? FALSE : TRUE);
+
+        hwVer->info.flashSize = DEVICE_ID_TO_TARGET_SIZE(hwVer->std.deviceID);
+        hwVer->info.voltage   = (hwVer->std.memoryType == 0x4Au) || (hwVer->std.memoryType == 0x4Bu) ||
+                                      (hwVer->std.memoryType == 0x4Cu) || (hwVer->std.memoryType == 0x4Du)
+                                    ? QLIB_TARGET_VOLTAGE_3_3V
+                                    : QLIB_TARGET_VOLTAGE_1_8V;
+
+    QLIB_STATUS_RET_CHECK(QLIB_SEC_GetHWVersion(qlibContext, &(hwVer->sec)));
+
+    switch (hwVer->sec.revision)
+    {
+        case 0:
+            hwVer->info.revision = QLIB_TARGET_REVISION_A;
+            break;
+        case 1:
+            hwVer->info.revision = QLIB_TARGET_REVISION_B;
             break;
         case 2:
             hwVer->info.revision = QLIB_TARGET_REVISION_C;
@@ -1037,638 +1832,2130 @@ QLIB_STATUS_T QLIB_GetHWVersion(QLIB_CONTEXT_T* qlibContext, QLIB_HW_VER_T* hwVe
             hwVer->info.revision = QLIB_TARGET_REVISION_UNKNOWN;
             break;
     }
-    QLIB_STATUS_RET_CHECK(QLIB_GetTargetFlash_L(hwVer, &hwVer->info.target));
+    QLIB_STATUS_RET_CHECK(QLIB_GetTargetFlash_L(hwVer, &hwVer->info.target));
+
+    return QLIB_STATUS__OK;
+}
+
+QLIB_STATUS_T QLIB_GetStatus(QLIB_CONTEXT_T* qlibContext)
+{
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Error checking                                                                                      */
+    /*-----------------------------------------------------------------------------------------------------*/
+    QLIB_ASSERT_RET(NULL != qlibContext, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET(QLIB_DEVICE_INITIALIZED(qlibContext), QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE);
+
+    return QLIB_SEC_GetStatus(qlibContext);
+}
+
+void* QLIB_GetUserData(QLIB_CONTEXT_T* qlibContext)
+{
+    if (qlibContext == NULL)
+    {
+        return NULL;
+    }
+    else
+    {
+        return qlibContext->userData;
+    }
+}
+
+void QLIB_SetUserData(QLIB_CONTEXT_T* qlibContext, void* userData)
+{
+    if (qlibContext != NULL)
+    {
+        qlibContext->userData = userData;
+    }
+}
+
+QLIB_STATUS_T QLIB_ExportState(QLIB_CONTEXT_T* qlibContext, QLIB_SYNC_OBJ_T* syncObject)
+{
+    U32 die;
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Error checking                                                                                      */
+    /*-----------------------------------------------------------------------------------------------------*/
+    QLIB_ASSERT_RET(NULL != qlibContext, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET(QLIB_DEVICE_INITIALIZED(qlibContext), QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE);
+    QLIB_ASSERT_RET(NULL != syncObject, QLIB_STATUS__INVALID_PARAMETER);
+
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Fill the synchronization object                                                                     */
+    /*-----------------------------------------------------------------------------------------------------*/
+    (void)memset(syncObject, 0, sizeof(QLIB_SYNC_OBJ_T));
+    (void)memcpy(&syncObject->busInterface, &qlibContext->busInterface, sizeof(qlibContext->busInterface));
+    syncObject->busInterface.busIsLocked = FALSE;
+    (void)memcpy((void*)syncObject->wid, (void*)qlibContext->wid, sizeof(QLIB_WID_T));
+
+    syncObject->resetStatus = qlibContext->resetStatus;
+    syncObject->addrSize    = qlibContext->addrSize;
+    syncObject->addrMode    = qlibContext->addrMode;
+
+    for (die = 0; die < QLIB_NUM_OF_DIES; die++)
+    {
+        (void)memcpy(syncObject->sectionsState[die],
+                     qlibContext->dieState[die].sectionsState,
+                     sizeof(qlibContext->dieState[die].sectionsState));
+        syncObject->vaultSize[die] = qlibContext->dieState[die].vaultSize;
+    }
+    (void)memcpy(syncObject->cfgBitArr, qlibContext->cfgBitArr, sizeof(qlibContext->cfgBitArr));
+    syncObject->detectedDeviceID = qlibContext->detectedDeviceID;
+    syncObject->fastReadDummy    = qlibContext->fastReadDummy;
+    return QLIB_STATUS__OK;
+}
+
+QLIB_STATUS_T QLIB_ImportState(QLIB_CONTEXT_T* qlibContext, const QLIB_SYNC_OBJ_T* syncObject)
+{
+    BOOL busIsLocked = FALSE;
+    U32  die;
+
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Error checking                                                                                      */
+    /*-----------------------------------------------------------------------------------------------------*/
+    QLIB_ASSERT_RET(NULL != qlibContext, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET(NULL != syncObject, QLIB_STATUS__INVALID_PARAMETER);
+
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Update the lib context                                                                              */
+    /*-----------------------------------------------------------------------------------------------------*/
+    busIsLocked = qlibContext->busInterface.busIsLocked;
+    (void)memcpy(&qlibContext->busInterface, &syncObject->busInterface, sizeof(qlibContext->busInterface));
+    qlibContext->busInterface.busIsLocked = busIsLocked;
+    (void)memcpy((void*)qlibContext->wid, (const void*)syncObject->wid, sizeof(QLIB_WID_T));
+    qlibContext->resetStatus = syncObject->resetStatus;
+    qlibContext->addrSize    = syncObject->addrSize;
+    qlibContext->addrMode    = syncObject->addrMode;
+
+    for (die = 0; die < QLIB_NUM_OF_DIES; die++)
+    {
+        (void)memcpy(qlibContext->dieState[die].sectionsState,
+                     syncObject->sectionsState[die],
+                     sizeof(qlibContext->dieState[die].sectionsState));
+        qlibContext->dieState[die].vaultSize          = syncObject->vaultSize[die];
+        qlibContext->dieState[die].configShadow.valid = 0;
+    }
+    (void)memcpy(qlibContext->cfgBitArr, syncObject->cfgBitArr, sizeof(qlibContext->cfgBitArr));
+    qlibContext->detectedDeviceID = syncObject->detectedDeviceID;
+    qlibContext->fastReadDummy    = syncObject->fastReadDummy;
+    QLIB_STD_UpdateCmdTable(qlibContext);
+
+    return QLIB_STATUS__OK;
+}
+
+QLIB_STATUS_T QLIB_GetVersion(QLIB_SW_VERSION_T* versionInfo)
+{
+    versionInfo->qlibVersion = QLIB_VERSION;
+#ifdef Q2_API
+    versionInfo->qlibTarget.isSingleDie = TRUE;
+#if (QLIB_TARGET == w77q32jw_revB)
+    versionInfo->qlibTarget.flashSize = QLIB_TARGET_SIZE_32Mb;
+    versionInfo->qlibTarget.revision  = QLIB_TARGET_REVISION_C;
+#elif ((QLIB_TARGET == w77q64jw_revA) || (QLIB_TARGET == w77q64jv_revA))
+    versionInfo->qlibTarget.flashSize = QLIB_TARGET_SIZE_64Mb;
+    versionInfo->qlibTarget.revision  = QLIB_TARGET_REVISION_A;
+#elif ((QLIB_TARGET == w77q128jw_revA) || (QLIB_TARGET == w77q128jv_revA))
+    versionInfo->qlibTarget.flashSize = QLIB_TARGET_SIZE_128Mb;
+    versionInfo->qlibTarget.revision  = QLIB_TARGET_REVISION_A;
+#else
+    versionInfo->qlibTarget.flashSize = QLIB_TARGET_SIZE_UNKNOWN;
+    versionInfo->qlibTarget.revision  = QLIB_TARGET_REVISION_UNKNOWN;
+#endif
+#if ((QLIB_TARGET == w77q128jv_revA) || (QLIB_TARGET == w77q64jv_revA))
+    versionInfo->qlibTarget.voltage = QLIB_TARGET_VOLTAGE_3_3V;
+#elif ((QLIB_TARGET == w77q32jw_revB) || (QLIB_TARGET == w77q128jw_revA) || (QLIB_TARGET == w77q64jw_revA))
+    versionInfo->qlibTarget.voltage   = QLIB_TARGET_VOLTAGE_1_8V;
+#else
+    versionInfo->qlibTarget.voltage   = QLIB_TARGET_VOLTAGE_UNKNOWN;
+#endif
+#else
+    versionInfo->qlibTarget = (U32)(QLIB_TARGET);
+#endif
+    return QLIB_STATUS__OK;
+}
+
+
+#if QLIB_NUM_OF_DIES > 1
+QLIB_STATUS_T QLIB_SetActiveDie(QLIB_CONTEXT_T* qlibContext, U8 die)
+{
+    QLIB_ASSERT_RET(NULL != qlibContext, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET(QLIB_DEVICE_INITIALIZED(qlibContext), QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE);
+    QLIB_ASSERT_RET(QLIB_NUM_OF_DIES > die, QLIB_STATUS__INVALID_PARAMETER);
+
+    if (die != qlibContext->activeDie)
+    {
+        // the buffered page belongs to the active die
+        QLIB_STATUS_RET_CHECK(QLIB_WriteCombine_Sync_L(qlibContext, QLIB_ALL_SECTIONS, 0, 0));
+#ifdef QLIB_RESUME_ON_DIE_SELECT
+        // before leaving the previous die, resume suspend
+        {
+            if (QLIB_ACTIVE_DIE_STATE(qlibContext).isPoweredDown == 0u && qlibContext->isSuspended == 1u)
+            {
+                QLIB_STATUS_RET_CHECK(QLIB_Resume(qlibContext));
+            }
+        }
+#endif //QLIB_RESUME_ON_DIE_SELECT
+        QLIB_STATUS_RET_CHECK(QLIB_STD_SetActiveDie(qlibContext, die, FALSE));
+        qlibContext->activeDie = die;
+    }
+
+    return QLIB_STATUS__OK;
+}
+
+QLIB_STATUS_T QLIB_RunDieOperations(QLIB_CONTEXT_T* qlibContext, const QLIB_DIE_OP_T* ops, U32 numOps)
+{
+    QLIB_DIE_SCHED_T sched[QLIB_NUM_OF_DIES];
+    QLIB_STATUS_T    ret     = QLIB_STATUS__OK;
+    BOOL             pending = TRUE;
+    BOOL             busy    = TRUE;
+    U8               origDie;
+    U8               die;
+    U32              i;
+
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Error checking                                                                                      */
+    /*-----------------------------------------------------------------------------------------------------*/
+    QLIB_ASSERT_RET(NULL != qlibContext, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET(QLIB_DEVICE_INITIALIZED(qlibContext), QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE);
+    QLIB_ASSERT_RET(qlibContext->isSuspended == 0u, QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE);
+    QLIB_ASSERT_RET((NULL != ops) || (0u == numOps), QLIB_STATUS__INVALID_PARAMETER);
+
+    for (i = 0; i < numOps; i++)
+    {
+        QLIB_ASSERT_RET(QLIB_DIE_OP__LAST > ops[i].type, QLIB_STATUS__INVALID_PARAMETER);
+        QLIB_ASSERT_RET(QLIB_NUM_OF_DIES > ops[i].die, QLIB_STATUS__INVALID_PARAMETER);
+        QLIB_ASSERT_RET(QLIB_NUM_OF_SECTIONS > ops[i].sectionID, QLIB_STATUS__INVALID_PARAMETER);
+        QLIB_ASSERT_RET(0u < ops[i].size, QLIB_STATUS__PARAMETER_OUT_OF_RANGE);
+        QLIB_ASSERT_RET((ops[i].offset + ops[i].size) >= ops[i].size, QLIB_STATUS__INVALID_PARAMETER);
+        if (QLIB_DIE_OP__ERASE == ops[i].type)
+        {
+            QLIB_ASSERT_RET(0u == (ops[i].offset % FLASH_SECTOR_SIZE), QLIB_STATUS__INVALID_DATA_ALIGNMENT);
+            QLIB_ASSERT_RET(0u == (ops[i].size % FLASH_SECTOR_SIZE), QLIB_STATUS__INVALID_DATA_ALIGNMENT);
+        }
+        else
+        {
+            QLIB_ASSERT_RET(NULL != ops[i].buf, QLIB_STATUS__INVALID_PARAMETER);
+        }
+    }
+
+    QLIB_STATUS_RET_CHECK(QLIB_WriteCombine_Sync_L(qlibContext, QLIB_ALL_SECTIONS, 0, 0));
+
+    for (die = 0; die < QLIB_NUM_OF_DIES; die++)
+    {
+        sched[die].op   = QLIB_DieSched_NextOp_L(ops, numOps, die, 0);
+        sched[die].done = 0;
+    }
+    origDie = qlibContext->activeDie;
+
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Round robin over the dies. Each visit checks the command in progress on the die and issues its next */
+    /* command without waiting, so the dies program and erase in parallel                                  */
+    /*-----------------------------------------------------------------------------------------------------*/
+    while (TRUE == pending)
+    {
+        pending = FALSE;
+        for (die = 0; die < QLIB_NUM_OF_DIES; die++)
+        {
+            if ((qlibContext->dieState[die].isBusy == 0u) && (numOps == sched[die].op))
+            {
+                continue;
+            }
+            pending = TRUE;
+
+            QLIB_STATUS_RET_CHECK_GOTO(QLIB_STD_SwitchDie(qlibContext, die), ret, error);
+            QLIB_STATUS_RET_CHECK_GOTO(QLIB_DieSched_Step_L(qlibContext, ops, numOps, &sched[die]), ret, error);
+        }
+    }
+
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* All dies are ready, restore and verify the original die                                             */
+    /*-----------------------------------------------------------------------------------------------------*/
+    return QLIB_STD_SetActiveDie(qlibContext, origDie, FALSE);
+
+error:
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Wait for the commands still in progress. A die that does not complete keeps its busy state, so the  */
+    /* next call checks it before issuing a command                                                        */
+    /*-----------------------------------------------------------------------------------------------------*/
+    for (die = 0; die < QLIB_NUM_OF_DIES; die++)
+    {
+        if ((qlibContext->dieState[die].isBusy == 1u) && (QLIB_STATUS__OK == QLIB_STD_SwitchDie(qlibContext, die)))
+        {
+            busy = TRUE;
+            for (i = 0; (i < QLIB_DIE_SCHED_ERROR_NUM_POLLS) && (TRUE == busy); i++)
+            {
+                if (QLIB_STATUS__OK != QLIB_STD_IsBusy(qlibContext, &busy))
+                {
+                    break;
+                }
+            }
+            if (FALSE == busy)
+            {
+                qlibContext->dieState[die].isBusy = 0u;
+            }
+        }
+    }
+    (void)QLIB_STD_SetActiveDie(qlibContext, origDie, FALSE);
+
+    return ret;
+}
+#endif
+
+QLIB_STATUS_T QLIB_GetResetStatus(QLIB_CONTEXT_T* qlibContext, QLIB_RESET_STATUS_T* resetStatus)
+{
+    QLIB_ASSERT_RET(NULL != qlibContext, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET(NULL != resetStatus, QLIB_STATUS__INVALID_PARAMETER);
+
+    *resetStatus = qlibContext->resetStatus;
+
+    return QLIB_STATUS__OK;
+}
+
+#ifndef EXCLUDE_Q2_4_BYTES_ADDRESS_MODE
+QLIB_STATUS_T QLIB_SetAddressMode(QLIB_CONTEXT_T* qlibContext, QLIB_STD_ADDR_MODE_T addrMode)
+{
+    QLIB_ASSERT_RET(NULL != qlibContext, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET(QLIB_DEVICE_INITIALIZED(qlibContext), QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE);
+    QLIB_ASSERT_RET(Q2_4_BYTES_ADDRESS_MODE(qlibContext) != 0u, QLIB_STATUS__NOT_SUPPORTED);
+    QLIB_STATUS_RET_CHECK(QLIB_STD_SetAddressMode(qlibContext, addrMode));
+    return QLIB_STATUS__OK;
+}
+#endif
+
+
+#ifdef QLIB_SIGN_DATA_BY_FLASH
+QLIB_STATUS_T QLIB_Sign(QLIB_CONTEXT_T* qlibContext, U32 sectionID, U8* dataIn, U32 dataSize, _256BIT signature)
+{
+    QLIB_POLICY_T policy;
+
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Error checking                                                                                      */
+    /*-----------------------------------------------------------------------------------------------------*/
+    QLIB_ASSERT_RET(NULL != qlibContext, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET(QLIB_DEVICE_INITIALIZED(qlibContext), QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE);
+    QLIB_ASSERT_RET(NULL != dataIn, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET(0u != dataSize, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET(NULL != signature, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET(QLIB_NUM_OF_SECTIONS > sectionID, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET((W77Q_VAULT(qlibContext) != 0u) || (QLIB_SECTION_ID_VAULT != sectionID), QLIB_STATUS__INVALID_PARAMETER);
+    if (W77Q_SUPPORT_LMS_ATTESTATION(qlibContext) != 0u)
+    {
+        return QLIB_STATUS__NOT_SUPPORTED;
+    }
+    else
+    {
+        /*-------------------------------------------------------------------------------------------------*/
+        /* Verify section is not rollback protected since both active and inactive partitions are erased   */
+        /*-------------------------------------------------------------------------------------------------*/
+        QLIB_STATUS_RET_CHECK(QLIB_SEC_GetSectionConfiguration(qlibContext, sectionID, NULL, NULL, &policy, NULL, NULL, NULL));
+        QLIB_ASSERT_RET(policy.rollbackProt == 0u, QLIB_STATUS__INVALID_PARAMETER);
+
+        /*-------------------------------------------------------------------------------------------------*/
+        /* Secure command is ignored if power is down or suspended                                         */
+        /*-------------------------------------------------------------------------------------------------*/
+        QLIB_ASSERT_RET(QLIB_ACTIVE_DIE_STATE(qlibContext).isPoweredDown == 0u, QLIB_STATUS__COMMAND_IGNORED);
+        QLIB_ASSERT_RET(qlibContext->isSuspended == 0u, QLIB_STATUS__COMMAND_IGNORED);
+
+        /*-------------------------------------------------------------------------------------------------*/
+        /* The data is written to the section                                                              */
+        /*-------------------------------------------------------------------------------------------------*/
+        QLIB_ViewInvalidate_L(qlibContext, sectionID, 0, MAX_U32);
+        QLIB_STATUS_RET_CHECK(QLIB_WriteCombine_Sync_L(qlibContext, sectionID, 0, MAX_U32));
+
+        return QLIB_SEC_SignVerify(qlibContext, sectionID, dataIn, dataSize, signature, FALSE);
+    }
+}
+
+QLIB_STATUS_T QLIB_Verify(QLIB_CONTEXT_T* qlibContext, U32 sectionID, U8* dataIn, U32 dataSize, const _256BIT signature)
+{
+    _256BIT tempSignature;
+
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Error checking                                                                                      */
+    /*-----------------------------------------------------------------------------------------------------*/
+    QLIB_ASSERT_RET(NULL != (void*)qlibContext, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET(QLIB_DEVICE_INITIALIZED(qlibContext), QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE);
+    QLIB_ASSERT_RET(NULL != (void*)dataIn, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET(0u != dataSize, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET(NULL != signature, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET(QLIB_NUM_OF_SECTIONS > sectionID, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET((W77Q_VAULT(qlibContext) != 0u) || (QLIB_SECTION_ID_VAULT != sectionID), QLIB_STATUS__INVALID_PARAMETER);
+    if (W77Q_SUPPORT_LMS_ATTESTATION(qlibContext) != 0u)
+    {
+        return QLIB_STATUS__NOT_SUPPORTED;
+    }
+    else
+    {
+        /*-------------------------------------------------------------------------------------------------*/
+        /* Open session is required for Verify                                                             */
+        /*-------------------------------------------------------------------------------------------------*/
+        QLIB_ASSERT_RET(QLIB_KEY_MNGR__SESSION_IS_OPEN(qlibContext), QLIB_STATUS__DEVICE_SESSION_ERR);
+
+        /*-----------------------------------------------------------------------------------------------------*/
+        /* Copy the signature to a temporary variable as the QLIB_SEC_SignVerify gets a non-const signature    */
+        /*-----------------------------------------------------------------------------------------------------*/
+        (void)memcpy(tempSignature, signature, sizeof(tempSignature));
+        QLIB_ViewInvalidate_L(qlibContext, sectionID, 0, MAX_U32);
+        QLIB_STATUS_RET_CHECK(QLIB_WriteCombine_Sync_L(qlibContext, sectionID, 0, MAX_U32));
+        return QLIB_SEC_SignVerify(qlibContext, sectionID, dataIn, dataSize, tempSignature, TRUE);
+    }
+}
+
+QLIB_STATUS_T QLIB_SignHashed(QLIB_CONTEXT_T* qlibContext, U32 sectionID, const U8* dataIn, U32 dataSize, _256BIT signature)
+{
+    _256BIT digest;
+
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Error checking                                                                                      */
+    /*-----------------------------------------------------------------------------------------------------*/
+    QLIB_ASSERT_RET(NULL != dataIn, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET(0u != dataSize, QLIB_STATUS__INVALID_PARAMETER);
+
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Only the digest is signed by the flash                                                              */
+    /*-----------------------------------------------------------------------------------------------------*/
+    QLIB_STATUS_RET_CHECK(QLIB_HASH(digest, dataIn, dataSize));
+
+    return QLIB_Sign(qlibContext, sectionID, (U8*)digest, sizeof(digest), signature);
+}
+
+QLIB_STATUS_T QLIB_VerifyHashed(QLIB_CONTEXT_T* qlibContext, U32 sectionID, const U8* dataIn, U32 dataSize, const _256BIT signature)
+{
+    _256BIT digest;
+
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Error checking                                                                                      */
+    /*-----------------------------------------------------------------------------------------------------*/
+    QLIB_ASSERT_RET(NULL != dataIn, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET(0u != dataSize, QLIB_STATUS__INVALID_PARAMETER);
+
+    QLIB_STATUS_RET_CHECK(QLIB_HASH(digest, dataIn, dataSize));
+
+    return QLIB_Verify(qlibContext, sectionID, (U8*)digest, sizeof(digest), signature);
+}
+
+#endif
+
+#ifndef EXCLUDE_LMS
+QLIB_STATUS_T QLIB_SendLMSCommand(QLIB_CONTEXT_T* qlibContext, const U32* cmd, U32 cmdSize, U32 sectionID)
+{
+    /********************************************************************************************************
+     * Error checking
+    ********************************************************************************************************/
+    QLIB_ASSERT_RET(NULL != qlibContext, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET(QLIB_DEVICE_INITIALIZED(qlibContext), QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE);
+    QLIB_ASSERT_RET(W77Q_SUPPORT_LMS(qlibContext) != 0u, QLIB_STATUS__NOT_SUPPORTED);
+    QLIB_ASSERT_RET(NULL != cmd, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET(QLIB_LMS_COMMAND_SIZE == cmdSize, QLIB_STATUS__PARAMETER_OUT_OF_RANGE);
+    QLIB_ASSERT_RET(QLIB_NUM_OF_SECTIONS > sectionID, QLIB_STATUS__INVALID_PARAMETER);
+
+    return QLIB_SEC_SendLMSCommand(qlibContext, cmd, cmdSize, sectionID);
+}
+#endif
+
+#ifndef EXCLUDE_MEM_COPY
+QLIB_STATUS_T QLIB_MemCpy(QLIB_CONTEXT_T* qlibContext, U32 sectionID, U32 dest, U32 src, U32 size)
+{
+    /********************************************************************************************************
+     * Error checking
+    ********************************************************************************************************/
+    QLIB_ASSERT_RET(NULL != qlibContext, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET(QLIB_DEVICE_INITIALIZED(qlibContext), QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE);
+    QLIB_ASSERT_RET(W77Q_MEM_COPY(qlibContext) != 0u, QLIB_STATUS__NOT_SUPPORTED);
+    QLIB_ASSERT_RET(0u < size, QLIB_STATUS__PARAMETER_OUT_OF_RANGE);
+    QLIB_ASSERT_RET((dest + size) >= size, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET((src + size) >= size, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET(QLIB_NUM_OF_SECTIONS > sectionID, QLIB_STATUS__INVALID_PARAMETER);
+
+    QLIB_ViewInvalidate_L(qlibContext, sectionID, dest, size);
+    QLIB_STATUS_RET_CHECK(QLIB_WriteCombine_Sync_L(qlibContext, sectionID, dest, size));
+    QLIB_STATUS_RET_CHECK(QLIB_WriteCombine_Sync_L(qlibContext, sectionID, src, size));
+
+    return QLIB_SEC_MemCopy(qlibContext, dest, src, size, sectionID);
+}
+
+QLIB_STATUS_T QLIB_MemCpyChunked(QLIB_CONTEXT_T*      qlibContext,
+                                 U32                  sectionID,
+                                 U32                  dest,
+                                 U32                  src,
+                                 U32                  size,
+                                 U32                  chunkSize,
+                                 QLIB_PROGRESS_FUNC_T progressFunc,
+                                 void*                arg)
+{
+    U32  buf[QLIB_SEC_READ_PAGE_SIZE_BYTE / sizeof(U32)];
+    U32  head       = 0;
+    U32  middle     = 0;
+    U32  done       = 0;
+    U32  step       = 0;
+    U32  segEnd     = 0;
+    BOOL sameAlign  = FALSE;
+    BOOL deviceCopy = FALSE;
+
+    /********************************************************************************************************
+     * Error checking
+    ********************************************************************************************************/
+    QLIB_ASSERT_RET(NULL != qlibContext, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET(QLIB_DEVICE_INITIALIZED(qlibContext), QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE);
+    QLIB_ASSERT_RET(W77Q_MEM_COPY(qlibContext) != 0u, QLIB_STATUS__NOT_SUPPORTED);
+    QLIB_ASSERT_RET(0u < size, QLIB_STATUS__PARAMETER_OUT_OF_RANGE);
+    QLIB_ASSERT_RET((dest + size) >= size, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET((src + size) >= size, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET(QLIB_NUM_OF_SECTIONS > sectionID, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET(((dest + size) <= src) || ((src + size) <= dest),
+                    QLIB_STATUS__PARAMETER_OUT_OF_RANGE); // src and dest shall not overlap
+
+    /********************************************************************************************************
+     * MEM_COPY length is 24 bits
+    ********************************************************************************************************/
+    chunkSize = ROUND_DOWN(MIN(chunkSize, _16MB_ - 1u), QLIB_SEC_READ_PAGE_SIZE_BYTE);
+    QLIB_ASSERT_RET(0u < chunkSize, QLIB_STATUS__PARAMETER_OUT_OF_RANGE);
+
+    /********************************************************************************************************
+     * Split the range to an unaligned head, an aligned middle copied by the device and an unaligned tail
+    ********************************************************************************************************/
+    sameAlign = INT_TO_BOOLEAN(((dest ^ src) & (QLIB_SEC_READ_PAGE_SIZE_BYTE - 1u)) == 0u);
+    if (sameAlign == TRUE)
+    {
+        head   = MIN(size, (QLIB_SEC_READ_PAGE_SIZE_BYTE - (src & (QLIB_SEC_READ_PAGE_SIZE_BYTE - 1u))) &
+                             (QLIB_SEC_READ_PAGE_SIZE_BYTE - 1u));
+        middle = ROUND_DOWN(size - head, QLIB_SEC_READ_PAGE_SIZE_BYTE);
+    }
+    else
+    {
+        head = size;
+    }
+
+    QLIB_ViewInvalidate_L(qlibContext, sectionID, dest, size);
+    QLIB_STATUS_RET_CHECK(QLIB_WriteCombine_Sync_L(qlibContext, sectionID, dest, size));
+    QLIB_STATUS_RET_CHECK(QLIB_WriteCombine_Sync_L(qlibContext, sectionID, src, size));
+
+    for (done = 0; done < size; done += step)
+    {
+        /****************************************************************************************************
+         * Find the size of the next chunk, it does not cross the segment boundaries
+        ****************************************************************************************************/
+        deviceCopy = INT_TO_BOOLEAN((head <= done) && (done < (head + middle)));
+        if (deviceCopy == TRUE)
+        {
+            step = MIN(chunkSize, (head + middle) - done);
+        }
+        else
+        {
+            segEnd = (done < head) ? head : size;
+            step   = MIN(QLIB_SEC_READ_PAGE_SIZE_BYTE, segEnd - done);
+        }
+
+        /****************************************************************************************************
+         * Copy the chunk. The destination is erased, so the head and tail bytes are programmed directly
+        ****************************************************************************************************/
+        if (deviceCopy == TRUE)
+        {
+            QLIB_STATUS_RET_CHECK(QLIB_SEC_MemCopy(qlibContext, dest + done, src + done, step, sectionID));
+        }
+        else
+        {
+            QLIB_STATUS_RET_CHECK(QLIB_Read(qlibContext, (U8*)buf, sectionID, src + done, step, TRUE, FALSE));
+            QLIB_STATUS_RET_CHECK(QLIB_Write(qlibContext, (const U8*)buf, sectionID, dest + done, step, TRUE));
+        }
+
+        if (progressFunc != NULL)
+        {
+            QLIB_STATUS_RET_CHECK(progressFunc(arg, done + step, size));
+        }
+    }
+
+    return QLIB_STATUS__OK;
+}
+#endif
+
+#ifndef EXCLUDE_MEM_CRC
+QLIB_STATUS_T QLIB_MemCRC(QLIB_CONTEXT_T* qlibContext, U32* crc32, U32 sectionID, U32 offset, U32 size)
+{
+    QLIB_POLICY_T policy = {0};
+    /********************************************************************************************************
+     * Error checking
+    ********************************************************************************************************/
+    QLIB_ASSERT_RET(NULL != qlibContext, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET(QLIB_DEVICE_INITIALIZED(qlibContext), QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE);
+    QLIB_ASSERT_RET(W77Q_MEM_CRC(qlibContext) != 0u, QLIB_STATUS__NOT_SUPPORTED);
+    QLIB_ASSERT_RET(0u < size, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET(QLIB_NUM_OF_SECTIONS > sectionID, QLIB_STATUS__INVALID_PARAMETER);
+    /********************************************************************************************************
+     * Read current section version tag and check policy
+    ********************************************************************************************************/
+    QLIB_STATUS_RET_CHECK(QLIB_GetSectionConfiguration(qlibContext, sectionID, NULL, NULL, &policy, NULL, NULL, NULL));
+    QLIB_ASSERT_RET((offset + size) <= QLIB_CALC_SECTION_SIZE(qlibContext, sectionID), QLIB_STATUS__PARAMETER_OUT_OF_RANGE);
+    QLIB_STATUS_RET_CHECK(QLIB_WriteCombine_Sync_L(qlibContext, sectionID, offset, size));
+
+    return QLIB_SEC_MemCrc(qlibContext, crc32, sectionID, offset, size);
+}
+
+QLIB_STATUS_T QLIB_MemCRCMap(QLIB_CONTEXT_T* qlibContext, U32* crcMap, U32 sectionID, U32 offset, U32 size, U32 blockSize)
+{
+    QLIB_POLICY_T policy = {0};
+    /********************************************************************************************************
+     * Error checking
+    ********************************************************************************************************/
+    QLIB_ASSERT_RET(NULL != qlibContext, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET(NULL != crcMap, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET(QLIB_DEVICE_INITIALIZED(qlibContext), QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE);
+    QLIB_ASSERT_RET(W77Q_MEM_CRC(qlibContext) != 0u, QLIB_STATUS__NOT_SUPPORTED);
+    QLIB_ASSERT_RET(0u < size, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET(0u < blockSize, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET((offset % QLIB_SEC_READ_PAGE_SIZE_BYTE) == 0u, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET((size % QLIB_SEC_READ_PAGE_SIZE_BYTE) == 0u, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET((blockSize % QLIB_SEC_READ_PAGE_SIZE_BYTE) == 0u, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET(QLIB_NUM_OF_SECTIONS > sectionID, QLIB_STATUS__INVALID_PARAMETER);
+    /********************************************************************************************************
+     * Read current section version tag and check policy
+    ********************************************************************************************************/
+    QLIB_STATUS_RET_CHECK(QLIB_GetSectionConfiguration(qlibContext, sectionID, NULL, NULL, &policy, NULL, NULL, NULL));
+    QLIB_ASSERT_RET((offset + size) <= QLIB_CALC_SECTION_SIZE(qlibContext, sectionID), QLIB_STATUS__PARAMETER_OUT_OF_RANGE);
+    QLIB_STATUS_RET_CHECK(QLIB_WriteCombine_Sync_L(qlibContext, sectionID, offset, size));
+
+    return QLIB_SEC_MemCrcMap(qlibContext, crcMap, sectionID, offset, size, blockSize);
+}
+#endif
+
+#ifndef EXCLUDE_SECURE_LOG
+QLIB_STATUS_T QLIB_SecureLogRead(QLIB_CONTEXT_T* qlibContext, U8* buf, U32* addr, U32 sectionID, BOOL secure)
+{
+    /********************************************************************************************************
+     * Error checking
+    ********************************************************************************************************/
+    QLIB_ASSERT_RET(NULL != qlibContext, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET(QLIB_DEVICE_INITIALIZED(qlibContext), QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE);
+    QLIB_ASSERT_RET(W77Q_SECURE_LOG(qlibContext) != 0u, QLIB_STATUS__NOT_SUPPORTED);
+    QLIB_ASSERT_RET(QLIB_NUM_OF_SECTIONS > sectionID, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET(!((FALSE == secure) && (QLIB_SECTION_ID_VAULT == sectionID)), QLIB_STATUS__INVALID_PARAMETER);
+
+    return QLIB_SEC_SecureLogRead(qlibContext, buf, addr, sectionID, secure);
+}
+
+QLIB_STATUS_T QLIB_SecureLogWrite(QLIB_CONTEXT_T* qlibContext, const U8* buf, U32 sectionID, U32 size, BOOL secure)
+{
+    /********************************************************************************************************
+     * Error checking
+    ********************************************************************************************************/
+    QLIB_ASSERT_RET(NULL != qlibContext, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET(QLIB_DEVICE_INITIALIZED(qlibContext), QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE);
+    QLIB_ASSERT_RET(W77Q_SECURE_LOG(qlibContext) != 0u, QLIB_STATUS__NOT_SUPPORTED);
+    QLIB_ASSERT_RET(0u < size, QLIB_STATUS__PARAMETER_OUT_OF_RANGE);
+    QLIB_ASSERT_RET(QLIB_NUM_OF_SECTIONS > sectionID, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET(!((FALSE == secure) && (QLIB_SECTION_ID_VAULT == sectionID)), QLIB_STATUS__INVALID_PARAMETER);
+
+    return QLIB_SEC_SecureLogWrite(qlibContext, buf, sectionID, size, secure, NULL);
+}
+
+QLIB_STATUS_T QLIB_SecureLogIter_Start(QLIB_CONTEXT_T* qlibContext, QLIB_SECURE_LOG_ITER_T* iter, U32 sectionID, BOOL secure)
+{
+    U32 head;
+
+    /********************************************************************************************************
+     * Error checking
+    ********************************************************************************************************/
+    QLIB_ASSERT_RET(NULL != qlibContext, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET(NULL != iter, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET(QLIB_DEVICE_INITIALIZED(qlibContext), QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE);
+
+    (void)memset(iter, 0, sizeof(QLIB_SECURE_LOG_ITER_T));
+
+    /********************************************************************************************************
+     * Read the entry at the head of the log and its address
+    ********************************************************************************************************/
+    QLIB_STATUS_RET_CHECK(QLIB_SecureLogRead(qlibContext, iter->head, &iter->headAddr, sectionID, secure));
+    QLIB_STATUS_RET_CHECK(
+        QLIB_SEC_GetSectionConfiguration(qlibContext, sectionID, NULL, &iter->sectionSize, NULL, NULL, NULL, NULL));
+
+    /********************************************************************************************************
+     * The head must point to an entry inside the section
+    ********************************************************************************************************/
+    head = _QLIB_OFFSET_FROM_LOGICAL_ADDRESS(iter->headAddr, qlibContext->addrSize);
+    QLIB_ASSERT_RET(ALIGNED_TO(head, QLIB_SEC_LOG_ENTRY_SIZE) && (head < iter->sectionSize), QLIB_STATUS__SECURITY_ERR);
+
+    iter->sectionID = sectionID;
+    iter->secure    = secure;
+    iter->next      = head + QLIB_SEC_LOG_ENTRY_SIZE;
+    iter->remaining = iter->sectionSize / QLIB_SEC_LOG_ENTRY_SIZE;
+
+    return QLIB_STATUS__OK;
+}
+
+QLIB_STATUS_T QLIB_SecureLogIter_Next(QLIB_CONTEXT_T*         qlibContext,
+                                      QLIB_SECURE_LOG_ITER_T* iter,
+                                      U8*                     buf,
+                                      U32                     maxEntries,
+                                      U32*                    numEntries)
+{
+    U8   entry[QLIB_SEC_LOG_ENTRY_SIZE];
+    U32  size;
+    U32  wrapSize = 0;
+    U32  first;
+    U32  last;
+    U32  i;
+    BOOL isFirst;
+
+    /********************************************************************************************************
+     * Error checking
+    ********************************************************************************************************/
+    QLIB_ASSERT_RET((NULL != iter) && (NULL != buf) && (NULL != numEntries), QLIB_STATUS__INVALID_PARAMETER);
+
+    *numEntries = MIN(maxEntries, iter->remaining);
+    if (0u == *numEntries)
+    {
+        return QLIB_STATUS__OK;
+    }
+    size    = *numEntries * QLIB_SEC_LOG_ENTRY_SIZE;
+    isFirst = INT_TO_BOOLEAN((iter->remaining * QLIB_SEC_LOG_ENTRY_SIZE) == iter->sectionSize);
+
+    /********************************************************************************************************
+     * Read the entries preceding iter->next in bulk, older entries wrap to the end of the section.
+     * Secure reads are authenticated, so every entry is verified by the device signature
+    ********************************************************************************************************/
+    if (size > iter->next)
+    {
+        wrapSize = size - iter->next;
+        QLIB_STATUS_RET_CHECK(
+            QLIB_Read(qlibContext, buf, iter->sectionID, iter->sectionSize - wrapSize, wrapSize, iter->secure, iter->secure));
+    }
+    QLIB_STATUS_RET_CHECK(QLIB_Read(qlibContext,
+                                    &buf[wrapSize],
+                                    iter->sectionID,
+                                    iter->next - (size - wrapSize),
+                                    size - wrapSize,
+                                    iter->secure,
+                                    iter->secure));
+
+    /********************************************************************************************************
+     * The newest entry of the first batch is the head returned by the log command
+    ********************************************************************************************************/
+    if (TRUE == isFirst)
+    {
+        QLIB_ASSERT_RET(0 == memcmp(&buf[size - QLIB_SEC_LOG_ENTRY_SIZE], iter->head, QLIB_SEC_LOG_ENTRY_SIZE),
+                        QLIB_STATUS__SECURITY_ERR);
+    }
+
+    /********************************************************************************************************
+     * Return the newest entry first
+    ********************************************************************************************************/
+    for (first = 0, last = size - QLIB_SEC_LOG_ENTRY_SIZE; first < last;
+         first += QLIB_SEC_LOG_ENTRY_SIZE, last -= QLIB_SEC_LOG_ENTRY_SIZE)
+    {
+        (void)memcpy(entry, &buf[first], QLIB_SEC_LOG_ENTRY_SIZE);
+        (void)memcpy(&buf[first], &buf[last], QLIB_SEC_LOG_ENTRY_SIZE);
+        (void)memcpy(&buf[last], entry, QLIB_SEC_LOG_ENTRY_SIZE);
+    }
+
+    iter->next = (0u != wrapSize) ? (iter->sectionSize - wrapSize) : (iter->next - size);
+    iter->remaining -= *numEntries;
+
+    /********************************************************************************************************
+     * An erased entry was never written, the log did not wrap yet and the older entries are erased as well
+    ********************************************************************************************************/
+    for (first = 0; first < size; first += QLIB_SEC_LOG_ENTRY_SIZE)
+    {
+        for (i = 0; i < QLIB_SEC_LOG_ENTRY_SIZE; i++)
+        {
+            if (buf[first + i] != 0xFFu)
+            {
+                break;
+            }
+        }
+        if (QLIB_SEC_LOG_ENTRY_SIZE == i)
+        {
+            *numEntries     = first / QLIB_SEC_LOG_ENTRY_SIZE;
+            iter->remaining = 0;
+            break;
+        }
+    }
+
+    return QLIB_STATUS__OK;
+}
+
+QLIB_STATUS_T QLIB_SecureLogWriter_Init(QLIB_SECURE_LOG_WRITER_T* writer,
+                                        U32                       sectionID,
+                                        BOOL                      secure,
+                                        U8*                       buf,
+                                        U32                       maxEntries,
+                                        QLIB_TIME_US_FUNC_T       getTimeUs,
+                                        U32                       intervalUs)
+{
+    /********************************************************************************************************
+     * Error checking
+    ********************************************************************************************************/
+    QLIB_ASSERT_RET((NULL != writer) && (NULL != buf), QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET(0u < maxEntries, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET(QLIB_NUM_OF_SECTIONS > sectionID, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET(!((FALSE == secure) && (QLIB_SECTION_ID_VAULT == sectionID)), QLIB_STATUS__INVALID_PARAMETER);
+
+    (void)memset(writer, 0, sizeof(QLIB_SECURE_LOG_WRITER_T));
+    writer->sectionID  = sectionID;
+    writer->secure     = secure;
+    writer->buf        = buf;
+    writer->maxEntries = maxEntries;
+    writer->getTimeUs  = getTimeUs;
+    writer->intervalUs = intervalUs;
+
+    return QLIB_STATUS__OK;
+}
+
+QLIB_STATUS_T QLIB_SecureLogWriter_Append(QLIB_CONTEXT_T*           qlibContext,
+                                          QLIB_SECURE_LOG_WRITER_T* writer,
+                                          const U8*                 buf,
+                                          U32                       size,
+                                          U32*                      appended)
+{
+    /********************************************************************************************************
+     * Error checking
+    ********************************************************************************************************/
+    QLIB_ASSERT_RET(NULL != qlibContext, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET((NULL != writer) && (NULL != buf), QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET(ALIGNED_TO(size, QLIB_SEC_LOG_ENTRY_SIZE), QLIB_STATUS__INVALID_DATA_SIZE);
+
+    if (NULL != appended)
+    {
+        *appended = 0;
+    }
+
+    while (0u != size)
+    {
+        /****************************************************************************************************
+         * A full buffer is committed before more entries are added. If the commit fails, the buffer stays
+         * full and the remaining entries are rejected
+        ****************************************************************************************************/
+        if (writer->numEntries == writer->maxEntries)
+        {
+            QLIB_STATUS_RET_CHECK(QLIB_SecureLogWriter_Commit_L(qlibContext, writer, FALSE));
+        }
+
+        if ((0u == writer->numEntries) && (NULL != writer->getTimeUs))
+        {
+            writer->firstUs = writer->getTimeUs();
+        }
+
+        (void)memcpy(&writer->buf[writer->numEntries * QLIB_SEC_LOG_ENTRY_SIZE], buf, QLIB_SEC_LOG_ENTRY_SIZE);
+        writer->numEntries++;
+        buf += QLIB_SEC_LOG_ENTRY_SIZE;
+        size -= QLIB_SEC_LOG_ENTRY_SIZE;
+
+        if (NULL != appended)
+        {
+            (*appended)++;
+        }
+    }
+
+    return QLIB_SecureLogWriter_Commit_L(qlibContext, writer, (writer->numEntries == writer->maxEntries) ? FALSE : TRUE);
+}
+
+QLIB_STATUS_T QLIB_SecureLogWriter_Flush(QLIB_CONTEXT_T* qlibContext, QLIB_SECURE_LOG_WRITER_T* writer)
+{
+    QLIB_ASSERT_RET((NULL != qlibContext) && (NULL != writer), QLIB_STATUS__INVALID_PARAMETER);
+
+    return QLIB_SecureLogWriter_Commit_L(qlibContext, writer, FALSE);
+}
+
+QLIB_STATUS_T QLIB_SecureLogWriter_Poll(QLIB_CONTEXT_T* qlibContext, QLIB_SECURE_LOG_WRITER_T* writer)
+{
+    QLIB_ASSERT_RET((NULL != qlibContext) && (NULL != writer), QLIB_STATUS__INVALID_PARAMETER);
+
+    return QLIB_SecureLogWriter_Commit_L(qlibContext, writer, TRUE);
+}
+#endif
+
+#ifndef EXCLUDE_W77Q_RNG_FEATURE
+QLIB_STATUS_T QLIB_GetRandom(QLIB_CONTEXT_T* qlibContext, U8* random, U32 randomSize)
+{
+    /********************************************************************************************************
+     * Error checking
+    ********************************************************************************************************/
+    QLIB_ASSERT_RET(NULL != qlibContext, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET(QLIB_DEVICE_INITIALIZED(qlibContext), QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE);
+    QLIB_ASSERT_RET(W77Q_RNG_FEATURE(qlibContext) != 0u, QLIB_STATUS__NOT_SUPPORTED);
+    QLIB_ASSERT_RET(NULL != random, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET(0u != randomSize, QLIB_STATUS__INVALID_PARAMETER);
+
+    if (NULL == qlibContext->entropyPool)
+    {
+        return QLIB_SEC_GetRandom(qlibContext, random, randomSize);
+    }
+
+    /********************************************************************************************************
+     * Serve from the end of the available bytes, and clear the bytes served
+    ********************************************************************************************************/
+    while (0u < randomSize)
+    {
+        QLIB_ENTROPY_POOL_T* pool = qlibContext->entropyPool;
+        U32                  size;
+
+        if ((0u == pool->level) || ((FALSE == pool->secure) && QLIB_EXECUTE_SIGNED_GET(qlibContext)))
+        {
+            QLIB_STATUS_RET_CHECK(QLIB_EntropyPool_Refill_L(qlibContext));
+        }
+
+        size = MIN(randomSize, pool->level);
+        pool->level -= size;
+        (void)memcpy(random, &pool->buf[pool->level], size);
+        (void)memset(&pool->buf[pool->level], 0, size);
+        random += size;
+        randomSize -= size;
+    }
 
     return QLIB_STATUS__OK;
 }
 
-QLIB_STATUS_T QLIB_GetStatus(QLIB_CONTEXT_T* qlibContext)
+QLIB_STATUS_T QLIB_EntropyPool_Enable(QLIB_CONTEXT_T* qlibContext, QLIB_ENTROPY_POOL_T* pool, U8* buf, U32 size, U32 lowLevel)
 {
+    QLIB_STATUS_T ret;
+
     /*-----------------------------------------------------------------------------------------------------*/
     /* Error checking                                                                                      */
     /*-----------------------------------------------------------------------------------------------------*/
     QLIB_ASSERT_RET(NULL != qlibContext, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET(NULL != pool, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET(NULL != buf, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET(0u != size, QLIB_STATUS__INVALID_PARAMETER);
     QLIB_ASSERT_RET(QLIB_DEVICE_INITIALIZED(qlibContext), QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE);
+    QLIB_ASSERT_RET(W77Q_RNG_FEATURE(qlibContext) != 0u, QLIB_STATUS__NOT_SUPPORTED);
+    QLIB_ASSERT_RET(NULL == qlibContext->entropyPool, QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE);
 
-    return QLIB_SEC_GetStatus(qlibContext);
+    (void)memset(pool, 0, sizeof(QLIB_ENTROPY_POOL_T));
+    pool->buf      = buf;
+    pool->size     = size;
+    pool->lowLevel = MIN(lowLevel, size);
+
+    qlibContext->entropyPool = pool;
+
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Fill the pool, so the first requests are served from memory                                         */
+    /*-----------------------------------------------------------------------------------------------------*/
+    ret = QLIB_EntropyPool_Refill_L(qlibContext);
+    if (QLIB_STATUS__OK != ret)
+    {
+        qlibContext->entropyPool = NULL;
+        (void)memset(buf, 0, size);
+    }
+
+    return ret;
 }
 
-void* QLIB_GetUserData(QLIB_CONTEXT_T* qlibContext)
+QLIB_STATUS_T QLIB_EntropyPool_Disable(QLIB_CONTEXT_T* qlibContext)
+{
+    QLIB_ASSERT_RET(NULL != qlibContext, QLIB_STATUS__INVALID_PARAMETER);
+
+    if (NULL != qlibContext->entropyPool)
+    {
+        (void)memset(qlibContext->entropyPool->buf, 0, qlibContext->entropyPool->size);
+        qlibContext->entropyPool->level = 0;
+        qlibContext->entropyPool        = NULL;
+    }
+
+    return QLIB_STATUS__OK;
+}
+
+QLIB_STATUS_T QLIB_EntropyPool_Poll(QLIB_CONTEXT_T* qlibContext)
+{
+    QLIB_ASSERT_RET(NULL != qlibContext, QLIB_STATUS__INVALID_PARAMETER);
+
+    if ((NULL == qlibContext->entropyPool) || (qlibContext->entropyPool->level >= qlibContext->entropyPool->lowLevel))
+    {
+        return QLIB_STATUS__OK;
+    }
+
+    return QLIB_EntropyPool_Refill_L(qlibContext);
+}
+
+QLIB_STATUS_T QLIB_EntropyPool_Reseed(QLIB_CONTEXT_T* qlibContext)
+{
+    U64 entropy = 0;
+
+    QLIB_STATUS_RET_CHECK(QLIB_GetRandom(qlibContext, (U8*)&entropy, sizeof(entropy)));
+    QLIB_CRYPTO_ReseedWithEntropy(&qlibContext->prng, entropy);
+
+    return QLIB_STATUS__OK;
+}
+#endif
+
+#if !defined EXCLUDE_LMS_ATTESTATION && !defined Q2_API
+QLIB_STATUS_T                                    QLIB_LMS_Attest_SetPrivateKey(QLIB_CONTEXT_T*                 qlibContext,
+                                                                               const LMS_ATTEST_PRIVATE_SEED_T seed,
+                                                                               const LMS_ATTEST_KEY_ID_T       keyId)
+{
+    /********************************************************************************************************
+     * Error checking
+    ********************************************************************************************************/
+    QLIB_ASSERT_RET(NULL != qlibContext, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET(QLIB_DEVICE_INITIALIZED(qlibContext), QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE);
+    QLIB_ASSERT_RET(W77Q_SUPPORT_LMS_ATTESTATION(qlibContext) != 0u, QLIB_STATUS__NOT_SUPPORTED);
+    QLIB_ASSERT_RET(NULL != seed, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET(NULL != keyId, QLIB_STATUS__INVALID_PARAMETER);
+
+    return QLIB_SEC_LMS_Attest_SetPrivateKey(qlibContext, seed, keyId);
+}
+
+QLIB_STATUS_T QLIB_LMS_Attest_GetPublicKey(QLIB_CONTEXT_T*    qlibContext,
+                                           LMS_ATTEST_CHUNK_T pubKey,
+                                           LMS_ATTEST_CHUNK_T pubCache[],
+                                           U32                pubCacheLen)
+{
+    /********************************************************************************************************
+     * Error checking
+    ********************************************************************************************************/
+    QLIB_ASSERT_RET(NULL != qlibContext, QLIB_STATUS__INVALID_PARAMETER)
+    QLIB_ASSERT_RET(QLIB_DEVICE_INITIALIZED(qlibContext), QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE);
+    QLIB_ASSERT_RET(W77Q_SUPPORT_LMS_ATTESTATION(qlibContext) != 0u, QLIB_STATUS__NOT_SUPPORTED);
+    QLIB_ASSERT_RET(NULL != pubKey, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET(0u == pubCacheLen || NULL != pubCache, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET(pubCacheLen <= QLIB_LMS_ATTEST_ALL_NODES, QLIB_STATUS__INVALID_PARAMETER);
+
+    return QLIB_SEC_LMS_Attest_GetPublicKey(qlibContext, pubKey, pubCache, pubCacheLen);
+}
+
+QLIB_STATUS_T QLIB_LMS_Attest_Sign(QLIB_CONTEXT_T*          qlibContext,
+                                   const U8*                msg,
+                                   U32                      msgSize,
+                                   const LMS_ATTEST_NONCE_T nonce,
+                                   LMS_ATTEST_CHUNK_T       pubCache[],
+                                   U32                      pubCacheLen,
+                                   QLIB_OTS_SIG_T*          sig)
+{
+    /********************************************************************************************************
+     * Error checking
+    ********************************************************************************************************/
+    QLIB_ASSERT_RET(NULL != qlibContext, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET(QLIB_DEVICE_INITIALIZED(qlibContext), QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE);
+    QLIB_ASSERT_RET(W77Q_SUPPORT_LMS_ATTESTATION(qlibContext) != 0u, QLIB_STATUS__NOT_SUPPORTED);
+    QLIB_ASSERT_RET(NULL != msg, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET(0u < msgSize, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET(NULL != nonce, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET(NULL != sig, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET(0u == pubCacheLen || NULL != pubCache, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET(pubCacheLen <= QLIB_LMS_ATTEST_ALL_NODES, QLIB_STATUS__INVALID_PARAMETER);
+
+    return QLIB_SEC_LMS_Attest_Sign(qlibContext, msg, msgSize, nonce, pubCache, pubCacheLen, sig);
+}
+#endif
+
+QLIB_STATUS_T QLIB_IsKeyProvisioned(QLIB_CONTEXT_T* qlibContext, QLIB_KID_TYPE_T keyIdType, U32 sectionID, BOOL* isProvisioned)
+{
+    QLIB_STATUS_T status = QLIB_STATUS__OK;
+
+    QLIB_ASSERT_RET(NULL != qlibContext, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET(NULL != isProvisioned, QLIB_STATUS__INVALID_PARAMETER);
+
+    if (W77Q_CMD_GET_KEYS_STATUS(qlibContext) != 0u)
+    {
+        status = QLIB_SEC_IsKeyProvisioned(qlibContext, keyIdType, sectionID, isProvisioned);
+    }
+    else
+    {
+        status = QLIB_STATUS__NOT_SUPPORTED;
+    }
+    return status;
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------------------------------------*/
+/*                                             LOCAL FUNCTIONS                                             */
+/*---------------------------------------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------------------------------------*/
+
+/************************************************************************************************************
+* @brief       This routine waits till flash is ready and detects and sets the bus mode (SPI/QPI) and flash device ID
+*
+* @param       qlibContext   qlib context object
+*
+* @return      0 if no error occurred, QLIB_STATUS__(ERROR) otherwise
+************************************************************************************************************/
+static QLIB_STATUS_T QLIB_waitReadyAndInitBusMode_L(QLIB_CONTEXT_T* qlibContext)
+{
+    QLIB_BUS_FORMAT_T currentFormat;
+
+    // identify and set current bus mode
+    QLIB_STATUS_RET_CHECK(QLIB_STD_WaitTillFlashIsReady(qlibContext, &currentFormat, &qlibContext->detectedDeviceID));
+
+    // Set bus mode
+    qlibContext->busInterface.busMode = QLIB_BUS_FORMAT_GET_MODE(currentFormat);
+    qlibContext->busInterface.dtr     = QLIB_BUS_FORMAT_GET_DTR(currentFormat);
+    QLIB_STATUS_RET_CHECK(QLIB_SetInterface(qlibContext, currentFormat));
+
+    // Clear errors in SSR caused by AutoSense
+    QLIB_STATUS_RET_CHECK(QLIB_SEC_ClearSSR(qlibContext));
+
+    return QLIB_STATUS__OK;
+}
+
+/************************************************************************************************************
+ * @brief       This routine sets the bus format and the fast read dummy cycles of an autotune candidate
+ *
+ * @param       qlibContext   qlib context object
+ * @param[in]   busFormat     Bus format
+ * @param[in]   dummyCycles   Fast read dummy cycles, used only if configurable in the device
+ *
+ * @return      0 if no error occurred, QLIB_STATUS__(ERROR) otherwise
+************************************************************************************************************/
+static QLIB_STATUS_T QLIB_AutotuneSet_L(QLIB_CONTEXT_T* qlibContext, QLIB_BUS_FORMAT_T busFormat, U8 dummyCycles)
+{
+    QLIB_STATUS_RET_CHECK(QLIB_SetInterface(qlibContext, busFormat));
+
+    if ((W77Q_FAST_READ_DUMMY_CONFIG(qlibContext) != 0u) && (qlibContext->fastReadDummy != dummyCycles))
+    {
+        QLIB_STATUS_RET_CHECK(QLIB_STD_SetFastReadDummyCycles(qlibContext, dummyCycles));
+    }
+
+    return QLIB_STATUS__OK;
+}
+
+/************************************************************************************************************
+ * @brief       This routine reads the autotune pattern with the current read configuration and compares it
+ *              to the expected data
+ *
+ * @param       qlibContext   qlib context object
+ * @param[in]   config        Autotune configuration
+ * @param[in]   expected      Expected pattern
+ * @param[out]  pass          TRUE if the data read matches the expected pattern
+ *
+ * @return      0 if no error occurred, QLIB_STATUS__(ERROR) otherwise
+************************************************************************************************************/
+static QLIB_STATUS_T QLIB_AutotuneCheck_L(QLIB_CONTEXT_T* qlibContext, const QLIB_AUTOTUNE_CONFIG_T* config, const U8* expected, BOOL* pass)
+{
+    U8 data[QLIB_AUTOTUNE_MAX_PATTERN_SIZE];
+
+    *pass = FALSE;
+    QLIB_STATUS_RET_CHECK(QLIB_Read(qlibContext, data, config->sectionID, config->offset, config->size, FALSE, FALSE));
+    *pass = (0 == memcmp(data, expected, config->size)) ? TRUE : FALSE;
+
+    return QLIB_STATUS__OK;
+}
+
+/************************************************************************************************************
+* @brief       This routine loads the ACL from Section Security Policy Register (SSPR), affecting the 
+*              plain access runtime privileges of the Section
+*
+* @param       qlibContext   qlib context object
+* @param       sectionID     Section ID
+* @param       condition     load ACL only if the section is with specific authentication or access. fail otherwise
+*
+* @return      0 if no error occurred, QLIB_STATUS__(ERROR) otherwise
+************************************************************************************************************/
+static QLIB_STATUS_T QLIB_PlainAccessGrant_L(QLIB_CONTEXT_T* qlibContext, U32 sectionID, QLIB_LOAD_ACLR_T condition)
+{
+    QLIB_POLICY_T policy = {0};
+    U32           sectionSize;
+    QLIB_STATUS_T ret;
+
+    /********************************************************************************************************
+     * Error checking
+    ********************************************************************************************************/
+    QLIB_ASSERT_RET(NULL != qlibContext, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET(QLIB_DEVICE_INITIALIZED(qlibContext), QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE);
+    QLIB_ASSERT_RET(QLIB_SECTION_ID_VAULT > sectionID, QLIB_STATUS__INVALID_PARAMETER);
+
+    /********************************************************************************************************
+     * check if the section is authenticated plain access
+    ********************************************************************************************************/
+    QLIB_STATUS_RET_CHECK(QLIB_GetSectionConfiguration(qlibContext, sectionID, NULL, &sectionSize, &policy, NULL, NULL, NULL));
+    QLIB_ASSERT_RET(sectionSize != 0u, QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE); // section is disabled
+
+    QLIB_ASSERT_RET((policy.plainAccessWriteEnable == 1u) || (((U8)condition & (U8)QLIB_LOAD_ACLR_PLAIN_WR) == 0u),
+                    QLIB_STATUS__DEVICE_PRIVILEGE_ERR);
+    QLIB_ASSERT_RET((policy.plainAccessReadEnable == 1u) || (((U8)condition & (U8)QLIB_LOAD_ACLR_PLAIN_RD) == 0u),
+                    QLIB_STATUS__DEVICE_PRIVILEGE_ERR);
+
+    if (policy.authPlainAccess == 1u)
+    {
+        QLIB_ASSERT_RET(((U8)condition & (U8)QLIB_LOAD_ACLR_NON_AUTH) == 0u, QLIB_STATUS__DEVICE_PRIVILEGE_ERR);
+        ret = QLIB_SEC_AuthPlainAccess_Grant(qlibContext, sectionID);
+    }
+    else
+    {
+        ret = QLIB_SEC_EnablePlainAccess(qlibContext, sectionID);
+    }
+
+    /*---------------------------------------------------------------------------------------------*/
+    /* Mark plain access is enabled                                                                */
+    /*---------------------------------------------------------------------------------------------*/
+    if (QLIB_STATUS__OK == ret || QLIB_STATUS__DEVICE_INTEGRITY_ERR == ret)
+    {
+        QLIB_PlainAccessMark_L(qlibContext, sectionID, &policy, INT_TO_BOOLEAN(QLIB_STATUS__DEVICE_INTEGRITY_ERR == ret));
+    }
+    QLIB_STATUS_RET_CHECK(ret);
+    return QLIB_STATUS__OK;
+}
+
+/************************************************************************************************************
+ * @brief       This function marks the plain access granted to a section.
+ *              Plain read access is not granted if the section failed the integrity check
+ *
+ * @param       qlibContext    QLIB state object
+ * @param       sectionID      Section index
+ * @param       policy         Section policy
+ * @param       integrityErr   TRUE if the grant failed the integrity check
+************************************************************************************************************/
+static void QLIB_PlainAccessMark_L(QLIB_CONTEXT_T* qlibContext, U32 sectionID, const QLIB_POLICY_T* policy, BOOL integrityErr)
+{
+    QLIB_ACTIVE_DIE_STATE(qlibContext).sectionsState[sectionID].plainEnabled = QLIB_SECTION_PLAIN_EN_NO;
+    if (policy->plainAccessWriteEnable == 1u)
+    {
+        QLIB_ACTIVE_DIE_STATE(qlibContext).sectionsState[sectionID].plainEnabled |= QLIB_SECTION_PLAIN_EN_WR;
+    }
+    if (policy->plainAccessReadEnable == 1u && FALSE == integrityErr)
+    {
+        QLIB_ACTIVE_DIE_STATE(qlibContext).sectionsState[sectionID].plainEnabled |= QLIB_SECTION_PLAIN_EN_RD;
+    }
+}
+
+/************************************************************************************************************
+ * @brief       This function translates the flash HW version to qlib target as defined in @ref qlib_targets.h
+ *
+ * @param[in]   hwVer        Hardware version information
+ * @param[out]  target       The detected flash target
+ *
+ * @return      QLIB_STATUS__OK on success or QLIB_STATUS__[ERROR] otherwise
+************************************************************************************************************/
+static QLIB_STATUS_T QLIB_GetTargetFlash_L(QLIB_HW_VER_T* hwVer, U32* target)
 {
-    if (qlibContext == NULL)
+    if ((hwVer->sec.securityVersion & 0xF0u) == 0x20u)
     {
-        return NULL;
+        // Q2 flash
+        if (hwVer->sec.securityVersion == 0x20u)
+        {
+            // Q2 MCD (32Mb)
+            if (hwVer->info.revision == QLIB_TARGET_REVISION_B || hwVer->info.revision == QLIB_TARGET_REVISION_C)
+            {
+                *target = w77q32jw_revB;
+            }
+            else
+            {
+                return QLIB_STATUS__NOT_SUPPORTED;
+            }
+        }
+        else if ((hwVer->sec.securityVersion == 0x24u) || (hwVer->sec.securityVersion == 0x28u))
+        {
+            // Q2 HCD (64Mb/128Mb)
+            if (hwVer->info.voltage == QLIB_TARGET_VOLTAGE_1_8V)
+            {
+                if (hwVer->info.revision == QLIB_TARGET_REVISION_A)
+                {
+                    *target = (hwVer->info.flashSize == QLIB_TARGET_SIZE_64Mb ? w77q64jw_revA : w77q128jw_revA);
+                }
+                else
+                {
+                    return QLIB_STATUS__NOT_SUPPORTED;
+                }
+            }
+            else
+            {
+                // QLIB_TARGET_VOLTAGE_3_3V
+                if (hwVer->info.revision == QLIB_TARGET_REVISION_A)
+                {
+                    *target = (hwVer->info.flashSize == QLIB_TARGET_SIZE_64Mb ? w77q64jv_revA : w77q128jv_revA);
+                }
+                else
+                {
+                    return QLIB_STATUS__NOT_SUPPORTED;
+                }
+            }
+        }
+        else
+        {
+            return QLIB_STATUS__NOT_SUPPORTED;
+        }
+    }
+    else if ((hwVer->sec.securityVersion & 0xF0u) == 0x30u)
+    {
+        // Q3 chip
+        if (hwVer->sec.securityVersion == 0x30u)
+        {
+            // Q3 chip W77Q/T industrial
+            if (hwVer->std.memoryType == 0x8Eu)
+            {
+                // W77T : Octal SPI secure flash
+                *target = w77t25nwxxi_revA;
+            }
+            else
+            {
+                // W77Q: Quad SPI secure flash
+                *target = w77q25nwxxi_revA;
+            }
+        }
+        else if (hwVer->sec.securityVersion == 0x34u)
+        {
+            // Q3 chip W77Q/T automotive
+            if (hwVer->std.memoryType == 0x8Eu)
+            {
+                // W77T : Octal SPI secure flash
+                *target = w77t25nwxxa_revA;
+            }
+            else
+            {
+                // W77Q: Quad SPI secure flash
+                *target = w77q25nwxxa_revA;
+            }
+        }
+        else
+        {
+            return QLIB_STATUS__NOT_SUPPORTED;
+        }
     }
     else
     {
-        return qlibContext->userData;
+        return QLIB_STATUS__NOT_SUPPORTED;
     }
+
+    return QLIB_STATUS__OK;
 }
 
-void QLIB_SetUserData(QLIB_CONTEXT_T* qlibContext, void* userData)
+/************************************************************************************************************
+ * @brief       This routine returns a cached page of a section view, reading it from the flash if needed.
+ *              The least recently used page is replaced
+ *
+ * @param       view         Section view
+ * @param[in]   pageOffset   Section offset of the page, aligned to FLASH_SECTOR_SIZE
+ * @param[out]  data         Page data
+ *
+ * @return      0 if no error occurred, QLIB_STATUS__(ERROR) otherwise
+************************************************************************************************************/
+static QLIB_STATUS_T QLIB_View_GetPage_L(QLIB_VIEW_T* view, U32 pageOffset, const U8** data)
 {
-    if (qlibContext != NULL)
+    QLIB_VIEW_PAGE_T* page   = NULL;
+    U32               victim = 0;
+    U32               i;
+
+    view->useCounter++;
+
+    for (i = 0; i < view->numPages; i++)
     {
-        qlibContext->userData = userData;
+        page = &view->pages[i];
+        if ((page->valid != 0u) && (page->offset == pageOffset))
+        {
+            view->hits++;
+            page->lastUse = view->useCounter;
+            *data         = &view->cache[i * FLASH_SECTOR_SIZE];
+            return QLIB_STATUS__OK;
+        }
+
+        // prefer an empty page, else the least recently used one
+        if ((view->pages[victim].valid != 0u) && ((page->valid == 0u) || (page->lastUse < view->pages[victim].lastUse)))
+        {
+            victim = i;
+        }
     }
-}
 
-QLIB_STATUS_T QLIB_ExportState(QLIB_CONTEXT_T* qlibContext, QLIB_SYNC_OBJ_T* syncObject)
-{
-    U32 die;
     /*-----------------------------------------------------------------------------------------------------*/
-    /* Error checking                                                                                      */
+    /* Read the page from the flash                                                                        */
     /*-----------------------------------------------------------------------------------------------------*/
-    QLIB_ASSERT_RET(NULL != qlibContext, QLIB_STATUS__INVALID_PARAMETER);
-    QLIB_ASSERT_RET(QLIB_DEVICE_INITIALIZED(qlibContext), QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE);
-    QLIB_ASSERT_RET(NULL != syncObject, QLIB_STATUS__INVALID_PARAMETER);
+    view->misses++;
+    page        = &view->pages[victim];
+    page->valid = 0;
+    QLIB_STATUS_RET_CHECK(QLIB_Read(view->qlibContext,
+                                    &view->cache[victim * FLASH_SECTOR_SIZE],
+                                    view->sectionID,
+                                    pageOffset,
+                                    MIN(FLASH_SECTOR_SIZE, view->size - pageOffset),
+                                    FALSE,
+                                    FALSE));
+    page->offset  = pageOffset;
+    page->lastUse = view->useCounter;
+    page->valid   = 1;
+    *data         = &view->cache[victim * FLASH_SECTOR_SIZE];
 
-    /*-----------------------------------------------------------------------------------------------------*/
-    /* Fill the synchronization object                                                                     */
-    /*-----------------------------------------------------------------------------------------------------*/
-    (void)memset(syncObject, 0, sizeof(QLIB_SYNC_OBJ_T));
-    (void)memcpy(&syncObject->busInterface, &qlibContext->busInterface, sizeof(qlibContext->busInterface));
-    syncObject->busInterface.busIsLocked = FALSE;
-    (void)memcpy((void*)syncObject->wid, (void*)qlibContext->wid, sizeof(QLIB_WID_T));
+    return QLIB_STATUS__OK;
+}
 
-    syncObject->resetStatus = qlibContext->resetStatus;
-    syncObject->addrSize    = qlibContext->addrSize;
-    syncObject->addrMode    = qlibContext->addrMode;
+/************************************************************************************************************
+ * @brief       This routine drops the cached pages of the open views that overlap a changed flash range
+ *
+ * @param       qlibContext   qlib context object
+ * @param[in]   sectionID     Section index, or QLIB_ALL_SECTIONS to drop the pages of all views
+ * @param[in]   offset        Section offset of the changed range
+ * @param[in]   size          Size of the changed range
+ *
+ * @return      none
+************************************************************************************************************/
+static void QLIB_ViewInvalidate_L(QLIB_CONTEXT_T* qlibContext, U32 sectionID, U32 offset, U32 size)
+{
+    QLIB_VIEW_T* view;
+    U32          i;
 
-    for (die = 0; die < QLIB_NUM_OF_DIES; die++)
+    for (view = qlibContext->views; NULL != view; view = view->next)
     {
-        (void)memcpy(syncObject->sectionsState[die],
-                     qlibContext->dieState[die].sectionsState,
-                     sizeof(qlibContext->dieState[die].sectionsState));
-        syncObject->vaultSize[die] = qlibContext->dieState[die].vaultSize;
+        if ((QLIB_ALL_SECTIONS != sectionID) && (view->sectionID != sectionID))
+        {
+            continue;
+        }
+        for (i = 0; i < view->numPages; i++)
+        {
+            if ((QLIB_ALL_SECTIONS == sectionID) ||
+                (((view->pages[i].offset + FLASH_SECTOR_SIZE) > offset) && (view->pages[i].offset < (offset + size))))
+            {
+                view->pages[i].valid = 0;
+            }
+        }
     }
-    (void)memcpy(syncObject->cfgBitArr, qlibContext->cfgBitArr, sizeof(qlibContext->cfgBitArr));
-    syncObject->detectedDeviceID = qlibContext->detectedDeviceID;
-    syncObject->fastReadDummy    = qlibContext->fastReadDummy;
-    return QLIB_STATUS__OK;
 }
 
-QLIB_STATUS_T QLIB_ImportState(QLIB_CONTEXT_T* qlibContext, const QLIB_SYNC_OBJ_T* syncObject)
+/************************************************************************************************************
+ * @brief       This routine adds a plain write to the write combining buffer. Buffered data of another page is
+ *              flushed first, and the page is flushed once it is full. Writes that cross a page boundary are
+ *              not combined
+ *
+ * @param       qlibContext   qlib context object
+ * @param[in]   buf           Data to write
+ * @param[in]   sectionID     Section index
+ * @param[in]   offset        Section offset
+ * @param[in]   size          Data size
+ *
+ * @return      0 if no error occurred, QLIB_STATUS__(ERROR) otherwise
+************************************************************************************************************/
+static QLIB_STATUS_T QLIB_WriteCombine_Put_L(QLIB_CONTEXT_T* qlibContext, const U8* buf, U32 sectionID, U32 offset, U32 size)
 {
-    BOOL busIsLocked = FALSE;
-    U32  die;
+    QLIB_WRITE_COMBINE_T* wc         = qlibContext->writeCombine;
+    U32                   pageOffset = ROUND_DOWN(offset, FLASH_PAGE_SIZE);
+    U32                   start      = offset - pageOffset;
+    U32                   i;
+
+    QLIB_ASSERT_RET(NULL != buf, QLIB_STATUS__INVALID_PARAMETER);
 
     /*-----------------------------------------------------------------------------------------------------*/
-    /* Error checking                                                                                      */
+    /* Flush data buffered for too long or buffered for another page                                       */
     /*-----------------------------------------------------------------------------------------------------*/
-    QLIB_ASSERT_RET(NULL != qlibContext, QLIB_STATUS__INVALID_PARAMETER);
-    QLIB_ASSERT_RET(NULL != syncObject, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_STATUS_RET_CHECK(QLIB_WriteCombine_Flush_L(qlibContext, TRUE));
+    if ((0u != wc->end) && ((wc->sectionID != sectionID) || (wc->pageOffset != pageOffset) || ((start + size) > FLASH_PAGE_SIZE)))
+    {
+        QLIB_STATUS_RET_CHECK(QLIB_WriteCombine_Flush_L(qlibContext, FALSE));
+    }
+
+    if ((start + size) > FLASH_PAGE_SIZE)
+    {
+        return QLIB_STD_Write(qlibContext, buf, QLIB_MAKE_LOGICAL_ADDRESS(qlibContext, sectionID, offset), size);
+    }
 
     /*-----------------------------------------------------------------------------------------------------*/
-    /* Update the lib context                                                                              */
+    /* Merge the data. Bytes not written stay 0xFF and programming only clears bits, so the combined page  */
+    /* program leaves the flash exactly as the separate writes would                                       */
     /*-----------------------------------------------------------------------------------------------------*/
-    busIsLocked = qlibContext->busInterface.busIsLocked;
-    (void)memcpy(&qlibContext->busInterface, &syncObject->busInterface, sizeof(qlibContext->busInterface));
-    qlibContext->busInterface.busIsLocked = busIsLocked;
-    (void)memcpy((void*)qlibContext->wid, (const void*)syncObject->wid, sizeof(QLIB_WID_T));
-    qlibContext->resetStatus = syncObject->resetStatus;
-    qlibContext->addrSize    = syncObject->addrSize;
-    qlibContext->addrMode    = syncObject->addrMode;
-
-    for (die = 0; die < QLIB_NUM_OF_DIES; die++)
+    if (0u == wc->end)
     {
-        (void)memcpy(qlibContext->dieState[die].sectionsState,
-                     syncObject->sectionsState[die],
-                     sizeof(qlibContext->dieState[die].sectionsState));
-        qlibContext->dieState[die].vaultSize = syncObject->vaultSize[die];
+        (void)memset(wc->page, 0xFF, FLASH_PAGE_SIZE);
+        wc->sectionID  = sectionID;
+        wc->pageOffset = pageOffset;
+        wc->start      = start;
+        wc->firstUs    = (NULL != wc->getTimeUs) ? wc->getTimeUs() : 0u;
     }
-    (void)memcpy(qlibContext->cfgBitArr, syncObject->cfgBitArr, sizeof(qlibContext->cfgBitArr));
-    qlibContext->detectedDeviceID = syncObject->detectedDeviceID;
-    qlibContext->fastReadDummy    = syncObject->fastReadDummy;
+    for (i = 0; i < size; i++)
+    {
+        wc->page[start + i] &= buf[i];
+    }
+    wc->start = MIN(wc->start, start);
+    wc->end   = MAX(wc->end, start + size);
+    wc->writes++;
 
-    return QLIB_STATUS__OK;
-}
+    if ((0u == wc->start) && (FLASH_PAGE_SIZE == wc->end))
+    {
+        QLIB_STATUS_RET_CHECK(QLIB_WriteCombine_Flush_L(qlibContext, FALSE));
+    }
 
-QLIB_STATUS_T QLIB_GetVersion(QLIB_SW_VERSION_T* versionInfo)
-{
-    versionInfo->qlibVersion = QLIB_VERSION;
-#ifdef Q2_API
-    versionInfo->qlibTarget.isSingleDie = TRUE;
-#if (QLIB_TARGET == w77q32jw_revB)
-    versionInfo->qlibTarget.flashSize = QLIB_TARGET_SIZE_32Mb;
-    versionInfo->qlibTarget.revision  = QLIB_TARGET_REVISION_C;
-#elif ((QLIB_TARGET == w77q64jw_revA) || (QLIB_TARGET == w77q64jv_revA))
-    versionInfo->qlibTarget.flashSize = QLIB_TARGET_SIZE_64Mb;
-    versionInfo->qlibTarget.revision  = QLIB_TARGET_REVISION_A;
-#elif ((QLIB_TARGET == w77q128jw_revA) || (QLIB_TARGET == w77q128jv_revA))
-    versionInfo->qlibTarget.flashSize = QLIB_TARGET_SIZE_128Mb;
-    versionInfo->qlibTarget.revision  = QLIB_TARGET_REVISION_A;
-#else
-    versionInfo->qlibTarget.flashSize = QLIB_TARGET_SIZE_UNKNOWN;
-    versionInfo->qlibTarget.revision  = QLIB_TARGET_REVISION_UNKNOWN;
-#endif
-#if ((QLIB_TARGET == w77q128jv_revA) || (QLIB_TARGET == w77q64jv_revA))
-    versionInfo->qlibTarget.voltage = QLIB_TARGET_VOLTAGE_3_3V;
-#elif ((QLIB_TARGET == w77q32jw_revB) || (QLIB_TARGET == w77q128jw_revA) || (QLIB_TARGET == w77q64jw_revA))
-    versionInfo->qlibTarget.voltage   = QLIB_TARGET_VOLTAGE_1_8V;
-#else
-    versionInfo->qlibTarget.voltage   = QLIB_TARGET_VOLTAGE_UNKNOWN;
-#endif
-#else
-    versionInfo->qlibTarget = (U32)(QLIB_TARGET);
-#endif
     return QLIB_STATUS__OK;
 }
 
-
-#if QLIB_NUM_OF_DIES > 1
-QLIB_STATUS_T QLIB_SetActiveDie(QLIB_CONTEXT_T* qlibContext, U8 die)
+/************************************************************************************************************
+ * @brief       This routine programs the buffered data of the write combining buffer
+ *
+ * @param       qlibContext   qlib context object
+ * @param[in]   expiredOnly   If TRUE, the data is programmed only if it is buffered for more than the timeout
+ *
+ * @return      0 if no error occurred, QLIB_STATUS__(ERROR) otherwise
+************************************************************************************************************/
+static QLIB_STATUS_T QLIB_WriteCombine_Flush_L(QLIB_CONTEXT_T* qlibContext, BOOL expiredOnly)
 {
-    QLIB_ASSERT_RET(NULL != qlibContext, QLIB_STATUS__INVALID_PARAMETER);
-    QLIB_ASSERT_RET(QLIB_DEVICE_INITIALIZED(qlibContext), QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE);
-    QLIB_ASSERT_RET(QLIB_NUM_OF_DIES > die, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_WRITE_COMBINE_T* wc = qlibContext->writeCombine;
+    U32                   offset;
+    U32                   size;
 
-    if (die != qlibContext->activeDie)
+    if ((NULL == wc) || (0u == wc->end))
     {
-#ifdef QLIB_RESUME_ON_DIE_SELECT
-        // before leaving the previous die, resume suspend
-        {
-            if (QLIB_ACTIVE_DIE_STATE(qlibContext).isPoweredDown == 0u && qlibContext->isSuspended == 1u)
-            {
-                QLIB_STATUS_RET_CHECK(QLIB_Resume(qlibContext));
-            }
-        }
-#endif //QLIB_RESUME_ON_DIE_SELECT
-        QLIB_STATUS_RET_CHECK(QLIB_STD_SetActiveDie(qlibContext, die, FALSE));
-        qlibContext->activeDie = die;
+        return QLIB_STATUS__OK;
+    }
+    if ((TRUE == expiredOnly) && ((NULL == wc->getTimeUs) || ((wc->getTimeUs() - wc->firstUs) < (U64)wc->timeoutUs)))
+    {
+        return QLIB_STATUS__OK;
     }
 
-    return QLIB_STATUS__OK;
-}
-#endif
+    offset = wc->pageOffset + wc->start;
+    size   = wc->end - wc->start;
 
-QLIB_STATUS_T QLIB_GetResetStatus(QLIB_CONTEXT_T* qlibContext, QLIB_RESET_STATUS_T* resetStatus)
-{
-    QLIB_ASSERT_RET(NULL != qlibContext, QLIB_STATUS__INVALID_PARAMETER);
-    QLIB_ASSERT_RET(NULL != resetStatus, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_STATUS_RET_CHECK(QLIB_PreparePlainErase_L(qlibContext, wc->sectionID, offset, size));
+    QLIB_STATUS_RET_CHECK(
+        QLIB_STD_Write(qlibContext, &wc->page[wc->start], QLIB_MAKE_LOGICAL_ADDRESS(qlibContext, wc->sectionID, offset), size));
 
-    *resetStatus = qlibContext->resetStatus;
+    // the buffer is emptied only after the data is programmed, so a failed flush keeps it for a retry
+    wc->end = 0;
+    wc->flushes++;
 
     return QLIB_STATUS__OK;
 }
 
-#ifndef EXCLUDE_Q2_4_BYTES_ADDRESS_MODE
-QLIB_STATUS_T QLIB_SetAddressMode(QLIB_CONTEXT_T* qlibContext, QLIB_STD_ADDR_MODE_T addrMode)
-{
-    QLIB_ASSERT_RET(NULL != qlibContext, QLIB_STATUS__INVALID_PARAMETER);
-    QLIB_ASSERT_RET(QLIB_DEVICE_INITIALIZED(qlibContext), QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE);
-    QLIB_ASSERT_RET(Q2_4_BYTES_ADDRESS_MODE(qlibContext) != 0u, QLIB_STATUS__NOT_SUPPORTED);
-    QLIB_STATUS_RET_CHECK(QLIB_STD_SetAddressMode(qlibContext, addrMode));
+/************************************************************************************************************
+ * @brief       This routine flushes the write combining buffer if the buffered data overlaps a flash range that
+ *              is about to be read or changed by another operation
+ *
+ * @param       qlibContext   qlib context object
+ * @param[in]   sectionID     Section index, or QLIB_ALL_SECTIONS to flush unconditionally
+ * @param[in]   offset        Section offset of the range
+ * @param[in]   size          Size of the range
+ *
+ * @return      0 if no error occurred, QLIB_STATUS__(ERROR) otherwise
+************************************************************************************************************/
+static QLIB_STATUS_T QLIB_WriteCombine_Sync_L(QLIB_CONTEXT_T* qlibContext, U32 sectionID, U32 offset, U32 size)
+{
+    QLIB_WRITE_COMBINE_T* wc = qlibContext->writeCombine;
+
+    if ((NULL == wc) || (0u == wc->end))
+    {
+        return QLIB_STATUS__OK;
+    }
+    if ((QLIB_ALL_SECTIONS == sectionID) ||
+        ((wc->sectionID == sectionID) && ((wc->pageOffset + wc->end) > offset) && ((wc->pageOffset + wc->start) < (offset + size))))
+    {
+        QLIB_STATUS_RET_CHECK(QLIB_WriteCombine_Flush_L(qlibContext, FALSE));
+    }
+
     return QLIB_STATUS__OK;
 }
-#endif
 
-
-#ifdef QLIB_SIGN_DATA_BY_FLASH
-QLIB_STATUS_T QLIB_Sign(QLIB_CONTEXT_T* qlibContext, U32 sectionID, U8* dataIn, U32 dataSize, _256BIT signature)
+#ifndef EXCLUDE_SECURE_LOG
+/************************************************************************************************************
+ * @brief       This routine writes the pending entries of a secure log writer in a single call
+ *
+ * @param       qlibContext   qlib context object
+ * @param       writer        Secure log writer
+ * @param[in]   expiredOnly   If TRUE, commit only if the oldest pending entry waited for the flush interval
+ *
+ * @return      0 if no error occurred, QLIB_STATUS__(ERROR) otherwise
+************************************************************************************************************/
+static QLIB_STATUS_T QLIB_SecureLogWriter_Commit_L(QLIB_CONTEXT_T*           qlibContext,
+                                                   QLIB_SECURE_LOG_WRITER_T* writer,
+                                                   BOOL                      expiredOnly)
 {
-    QLIB_POLICY_T policy;
+    QLIB_STATUS_T ret     = QLIB_STATUS__OK;
+    U32           written = 0;
 
-    /*-----------------------------------------------------------------------------------------------------*/
-    /* Error checking                                                                                      */
-    /*-----------------------------------------------------------------------------------------------------*/
-    QLIB_ASSERT_RET(NULL != qlibContext, QLIB_STATUS__INVALID_PARAMETER);
-    QLIB_ASSERT_RET(QLIB_DEVICE_INITIALIZED(qlibContext), QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE);
-    QLIB_ASSERT_RET(NULL != dataIn, QLIB_STATUS__INVALID_PARAMETER);
-    QLIB_ASSERT_RET(0u != dataSize, QLIB_STATUS__INVALID_PARAMETER);
-    QLIB_ASSERT_RET(NULL != signature, QLIB_STATUS__INVALID_PARAMETER);
-    QLIB_ASSERT_RET(QLIB_NUM_OF_SECTIONS > sectionID, QLIB_STATUS__INVALID_PARAMETER);
-    QLIB_ASSERT_RET((W77Q_VAULT(qlibContext) != 0u) || (QLIB_SECTION_ID_VAULT != sectionID), QLIB_STATUS__INVALID_PARAMETER);
-    if (W77Q_SUPPORT_LMS_ATTESTATION(qlibContext) != 0u)
+    if (0u == writer->numEntries)
     {
-        return QLIB_STATUS__NOT_SUPPORTED;
+        return QLIB_STATUS__OK;
     }
-    else
+    if ((TRUE == expiredOnly) &&
+        ((NULL == writer->getTimeUs) || ((writer->getTimeUs() - writer->firstUs) < (U64)writer->intervalUs)))
     {
-        /*-------------------------------------------------------------------------------------------------*/
-        /* Verify section is not rollback protected since both active and inactive partitions are erased   */
-        /*-------------------------------------------------------------------------------------------------*/
-        QLIB_STATUS_RET_CHECK(QLIB_SEC_GetSectionConfiguration(qlibContext, sectionID, NULL, NULL, &policy, NULL, NULL, NULL));
-        QLIB_ASSERT_RET(policy.rollbackProt == 0u, QLIB_STATUS__INVALID_PARAMETER);
+        return QLIB_STATUS__OK;
+    }
 
-        /*-------------------------------------------------------------------------------------------------*/
-        /* Secure command is ignored if power is down or suspended                                         */
-        /*-------------------------------------------------------------------------------------------------*/
-        QLIB_ASSERT_RET(QLIB_ACTIVE_DIE_STATE(qlibContext).isPoweredDown == 0u, QLIB_STATUS__COMMAND_IGNORED);
-        QLIB_ASSERT_RET(qlibContext->isSuspended == 0u, QLIB_STATUS__COMMAND_IGNORED);
+    QLIB_ASSERT_RET(QLIB_DEVICE_INITIALIZED(qlibContext), QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE);
+    QLIB_ASSERT_RET(W77Q_SECURE_LOG(qlibContext) != 0u, QLIB_STATUS__NOT_SUPPORTED);
 
-        return QLIB_SEC_SignVerify(qlibContext, sectionID, dataIn, dataSize, signature, FALSE);
+    ret = QLIB_SEC_SecureLogWrite(qlibContext,
+                                  writer->buf,
+                                  writer->sectionID,
+                                  writer->numEntries * QLIB_SEC_LOG_ENTRY_SIZE,
+                                  writer->secure,
+                                  &written);
+
+    /********************************************************************************************************
+     * Drop the written entries. On failure only the entries that were not written stay pending, so a
+     * later commit does not write any entry twice
+    ********************************************************************************************************/
+    writer->numEntries -= written;
+    if ((0u != writer->numEntries) && (0u != written))
+    {
+        (void)memmove(writer->buf,
+                      &writer->buf[written * QLIB_SEC_LOG_ENTRY_SIZE],
+                      writer->numEntries * QLIB_SEC_LOG_ENTRY_SIZE);
     }
+    QLIB_STATUS_RET_CHECK(ret);
+    writer->commits++;
+
+    return QLIB_STATUS__OK;
 }
+#endif
 
-QLIB_STATUS_T QLIB_Verify(QLIB_CONTEXT_T* qlibContext, U32 sectionID, U8* dataIn, U32 dataSize, const _256BIT signature)
+#ifndef EXCLUDE_W77Q_RNG_FEATURE
+/************************************************************************************************************
+ * @brief       This routine fills the free part of the entropy pool from the flash RNG in one batch
+ *
+ * @param       qlibContext   qlib context object
+ *
+ * @return      0 if no error occurred, QLIB_STATUS__(ERROR) otherwise
+************************************************************************************************************/
+static QLIB_STATUS_T QLIB_EntropyPool_Refill_L(QLIB_CONTEXT_T* qlibContext)
 {
-    _256BIT tempSignature;
+    QLIB_ENTROPY_POOL_T* pool   = qlibContext->entropyPool;
+    BOOL                 secure = QLIB_EXECUTE_SIGNED_GET(qlibContext) ? TRUE : FALSE;
 
     /*-----------------------------------------------------------------------------------------------------*/
-    /* Error checking                                                                                      */
+    /* Bytes read without a session are dropped once a session is open                                     */
     /*-----------------------------------------------------------------------------------------------------*/
-    QLIB_ASSERT_RET(NULL != (void*)qlibContext, QLIB_STATUS__INVALID_PARAMETER);
-    QLIB_ASSERT_RET(QLIB_DEVICE_INITIALIZED(qlibContext), QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE);
-    QLIB_ASSERT_RET(NULL != (void*)dataIn, QLIB_STATUS__INVALID_PARAMETER);
-    QLIB_ASSERT_RET(0u != dataSize, QLIB_STATUS__INVALID_PARAMETER);
-    QLIB_ASSERT_RET(NULL != signature, QLIB_STATUS__INVALID_PARAMETER);
-    QLIB_ASSERT_RET(QLIB_NUM_OF_SECTIONS > sectionID, QLIB_STATUS__INVALID_PARAMETER);
-    QLIB_ASSERT_RET((W77Q_VAULT(qlibContext) != 0u) || (QLIB_SECTION_ID_VAULT != sectionID), QLIB_STATUS__INVALID_PARAMETER);
-    if (W77Q_SUPPORT_LMS_ATTESTATION(qlibContext) != 0u)
+    if ((TRUE == secure) && (FALSE == pool->secure))
     {
-        return QLIB_STATUS__NOT_SUPPORTED;
+        (void)memset(pool->buf, 0, pool->level);
+        pool->level  = 0;
+        pool->secure = TRUE;
     }
-    else
-    {
-        /*-------------------------------------------------------------------------------------------------*/
-        /* Open session is required for Verify                                                             */
-        /*-------------------------------------------------------------------------------------------------*/
-        QLIB_ASSERT_RET(QLIB_KEY_MNGR__SESSION_IS_OPEN(qlibContext), QLIB_STATUS__DEVICE_SESSION_ERR);
 
-        /*-----------------------------------------------------------------------------------------------------*/
-        /* Copy the signature to a temporary variable as the QLIB_SEC_SignVerify gets a non-const signature    */
-        /*-----------------------------------------------------------------------------------------------------*/
-        (void)memcpy(tempSignature, signature, sizeof(tempSignature));
-        return QLIB_SEC_SignVerify(qlibContext, sectionID, dataIn, dataSize, tempSignature, TRUE);
+    if (pool->level == pool->size)
+    {
+        return QLIB_STATUS__OK;
     }
-}
-
-#endif
 
-#ifndef EXCLUDE_LMS
-QLIB_STATUS_T QLIB_SendLMSCommand(QLIB_CONTEXT_T* qlibContext, const U32* cmd, U32 cmdSize, U32 sectionID)
-{
-    /********************************************************************************************************
-     * Error checking
-    ********************************************************************************************************/
-    QLIB_ASSERT_RET(NULL != qlibContext, QLIB_STATUS__INVALID_PARAMETER);
-    QLIB_ASSERT_RET(QLIB_DEVICE_INITIALIZED(qlibContext), QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE);
-    QLIB_ASSERT_RET(W77Q_SUPPORT_LMS(qlibContext) != 0u, QLIB_STATUS__NOT_SUPPORTED);
-    QLIB_ASSERT_RET(NULL != cmd, QLIB_STATUS__INVALID_PARAMETER);
-    QLIB_ASSERT_RET(QLIB_LMS_COMMAND_SIZE == cmdSize, QLIB_STATUS__PARAMETER_OUT_OF_RANGE);
-    QLIB_ASSERT_RET(QLIB_NUM_OF_SECTIONS > sectionID, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_STATUS_RET_CHECK(QLIB_SEC_GetRandom(qlibContext, &pool->buf[pool->level], pool->size - pool->level));
+    pool->level  = pool->size;
+    pool->secure = secure;
+    pool->refills++;
 
-    return QLIB_SEC_SendLMSCommand(qlibContext, cmd, cmdSize, sectionID);
+    return QLIB_STATUS__OK;
 }
 #endif
 
-#ifndef EXCLUDE_MEM_COPY
-QLIB_STATUS_T QLIB_MemCpy(QLIB_CONTEXT_T* qlibContext, U32 sectionID, U32 dest, U32 src, U32 size)
+/************************************************************************************************************
+ * @brief       This routine checks the parameters of a plain read and grants plain read access to the
+ *              section if needed
+ *
+ * @param       qlibContext   qlib context object
+ * @param[in]   sectionID     Section index
+ * @param[in]   offset        Section offset
+ * @param[in]   size          Read size
+ *
+ * @return      0 if no error occurred, QLIB_STATUS__(ERROR) otherwise
+************************************************************************************************************/
+static QLIB_STATUS_T QLIB_PreparePlainRead_L(QLIB_CONTEXT_T* qlibContext, U32 sectionID, U32 offset, U32 size)
 {
-    /********************************************************************************************************
-     * Error checking
-    ********************************************************************************************************/
-    QLIB_ASSERT_RET(NULL != qlibContext, QLIB_STATUS__INVALID_PARAMETER);
-    QLIB_ASSERT_RET(QLIB_DEVICE_INITIALIZED(qlibContext), QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE);
-    QLIB_ASSERT_RET(W77Q_MEM_COPY(qlibContext) != 0u, QLIB_STATUS__NOT_SUPPORTED);
-    QLIB_ASSERT_RET(0u < size, QLIB_STATUS__PARAMETER_OUT_OF_RANGE);
-    QLIB_ASSERT_RET((dest + size) >= size, QLIB_STATUS__INVALID_PARAMETER);
-    QLIB_ASSERT_RET((src + size) >= size, QLIB_STATUS__INVALID_PARAMETER);
-    QLIB_ASSERT_RET(QLIB_NUM_OF_SECTIONS > sectionID, QLIB_STATUS__INVALID_PARAMETER);
+    U32 section = QLIB_FALLBACK_SECTION(qlibContext, sectionID);
 
-    return QLIB_SEC_MemCopy(qlibContext, dest, src, size, sectionID);
-}
+    QLIB_ASSERT_RET(sectionID < QLIB_SECTION_ID_VAULT, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET((offset + size) <= _QLIB_MAX_LEGACY_OFFSET(qlibContext), QLIB_STATUS__PARAMETER_OUT_OF_RANGE);
+    QLIB_ASSERT_RET((offset + size) <= QLIB_CALC_SECTION_SIZE(qlibContext, section), QLIB_STATUS__PARAMETER_OUT_OF_RANGE);
+#if QLIB_NUM_OF_DIES > 1
+    QLIB_ASSERT_RET(qlibContext->activeDie == QLIB_INIT_DIE_ID || qlibContext->addrMode == QLIB_STD_ADDR_MODE__4_BYTE,
+                    QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE);
 #endif
+    if ((QLIB_ACTIVE_DIE_STATE(qlibContext).sectionsState[section].plainEnabled & QLIB_SECTION_PLAIN_EN_RD) == 0u)
+    {
+        QLIB_STATUS_RET_CHECK(QLIB_PlainAccessGrant_L(qlibContext,
+                                                      section,
+                                                      W77Q_CMD_PA_GRANT_REVOKE(qlibContext) != 0u
+                                                          ? QLIB_LOAD_ACLR_PLAIN_RD
+                                                          : QLIB_LOAD_ACLR_NON_AUTH_PLAIN_RD));
+    }
 
-#ifndef EXCLUDE_MEM_CRC
-QLIB_STATUS_T QLIB_MemCRC(QLIB_CONTEXT_T* qlibContext, U32* crc32, U32 sectionID, U32 offset, U32 size)
+    return QLIB_STATUS__OK;
+}
+
+/************************************************************************************************************
+ * @brief       This routine checks the parameters of a standard erase or write and grants plain write access
+ *              to the section if needed
+ *
+ * @param       qlibContext   qlib context object
+ * @param[in]   sectionID     Section index
+ * @param[in]   offset        Section offset
+ * @param[in]   size          Size to erase or write
+ *
+ * @return      0 if no error occurred, QLIB_STATUS__(ERROR) otherwise
+************************************************************************************************************/
+static QLIB_STATUS_T QLIB_PreparePlainErase_L(QLIB_CONTEXT_T* qlibContext, U32 sectionID, U32 offset, U32 size)
 {
-    QLIB_POLICY_T policy = {0};
-    /********************************************************************************************************
-     * Error checking
-    ********************************************************************************************************/
-    QLIB_ASSERT_RET(NULL != qlibContext, QLIB_STATUS__INVALID_PARAMETER);
-    QLIB_ASSERT_RET(QLIB_DEVICE_INITIALIZED(qlibContext), QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE);
-    QLIB_ASSERT_RET(W77Q_MEM_CRC(qlibContext) != 0u, QLIB_STATUS__NOT_SUPPORTED);
-    QLIB_ASSERT_RET(0u < size, QLIB_STATUS__INVALID_PARAMETER);
-    QLIB_ASSERT_RET(QLIB_NUM_OF_SECTIONS > sectionID, QLIB_STATUS__INVALID_PARAMETER);
-    /********************************************************************************************************
-     * Read current section version tag and check policy
-    ********************************************************************************************************/
-    QLIB_STATUS_RET_CHECK(QLIB_GetSectionConfiguration(qlibContext, sectionID, NULL, NULL, &policy, NULL, NULL, NULL));
-    QLIB_ASSERT_RET((offset + size) <= QLIB_CALC_SECTION_SIZE(qlibContext, sectionID), QLIB_STATUS__PARAMETER_OUT_OF_RANGE);
+    U32 section = QLIB_FALLBACK_SECTION(qlibContext, sectionID);
 
-    return QLIB_SEC_MemCrc(qlibContext, crc32, sectionID, offset, size);
-}
+    QLIB_ASSERT_RET(sectionID < QLIB_SECTION_ID_VAULT, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET((offset + size) <= _QLIB_MAX_LEGACY_OFFSET(qlibContext), QLIB_STATUS__PARAMETER_OUT_OF_RANGE);
+    QLIB_ASSERT_RET((offset + size) <= QLIB_CALC_SECTION_SIZE(qlibContext, section), QLIB_STATUS__PARAMETER_OUT_OF_RANGE);
+#if QLIB_NUM_OF_DIES > 1
+    QLIB_ASSERT_RET(qlibContext->activeDie == QLIB_INIT_DIE_ID || qlibContext->addrMode == QLIB_STD_ADDR_MODE__4_BYTE,
+                    QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE);
 #endif
 
-#ifndef EXCLUDE_SECURE_LOG
-QLIB_STATUS_T QLIB_SecureLogRead(QLIB_CONTEXT_T* qlibContext, U8* buf, U32* addr, U32 sectionID, BOOL secure)
-{
-    /********************************************************************************************************
-     * Error checking
-    ********************************************************************************************************/
-    QLIB_ASSERT_RET(NULL != qlibContext, QLIB_STATUS__INVALID_PARAMETER);
-    QLIB_ASSERT_RET(QLIB_DEVICE_INITIALIZED(qlibContext), QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE);
-    QLIB_ASSERT_RET(W77Q_SECURE_LOG(qlibContext) != 0u, QLIB_STATUS__NOT_SUPPORTED);
-    QLIB_ASSERT_RET(QLIB_NUM_OF_SECTIONS > sectionID, QLIB_STATUS__INVALID_PARAMETER);
-    QLIB_ASSERT_RET(!((FALSE == secure) && (QLIB_SECTION_ID_VAULT == sectionID)), QLIB_STATUS__INVALID_PARAMETER);
+    if ((QLIB_ACTIVE_DIE_STATE(qlibContext).sectionsState[section].plainEnabled & QLIB_SECTION_PLAIN_EN_WR) == 0u)
+    {
+        QLIB_STATUS_RET_CHECK(QLIB_PlainAccessGrant_L(qlibContext,
+                                                      section,
+                                                      W77Q_CMD_PA_GRANT_REVOKE(qlibContext) != 0u
+                                                          ? QLIB_LOAD_ACLR_PLAIN_WR
+                                                          : QLIB_LOAD_ACLR_NON_AUTH_PLAIN_WR));
+    }
 
-    return QLIB_SEC_SecureLogRead(qlibContext, buf, addr, sectionID, secure);
+    return QLIB_STATUS__OK;
 }
 
-QLIB_STATUS_T QLIB_SecureLogWrite(QLIB_CONTEXT_T* qlibContext, const U8* buf, U32 sectionID, U32 size, BOOL secure)
+/************************************************************************************************************
+ * @brief       This routine performs a standard read during a background erase, see QLIB_BgErase_Read
+ *
+ * @param       bgErase       Background erase state
+ * @param[out]  buf           Output buffer to read the data to
+ * @param[in]   sectionID     Section index
+ * @param[in]   offset        Section offset
+ * @param[in]   size          Size
+ *
+ * @return      0 if no error occurred, QLIB_STATUS__(ERROR) otherwise
+************************************************************************************************************/
+static QLIB_STATUS_T QLIB_BgErase_Read_L(QLIB_BG_ERASE_T* bgErase, U8* buf, U32 sectionID, U32 offset, U32 size)
 {
-    /********************************************************************************************************
-     * Error checking
-    ********************************************************************************************************/
-    QLIB_ASSERT_RET(NULL != qlibContext, QLIB_STATUS__INVALID_PARAMETER);
-    QLIB_ASSERT_RET(QLIB_DEVICE_INITIALIZED(qlibContext), QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE);
-    QLIB_ASSERT_RET(W77Q_SECURE_LOG(qlibContext) != 0u, QLIB_STATUS__NOT_SUPPORTED);
-    QLIB_ASSERT_RET(0u < size, QLIB_STATUS__PARAMETER_OUT_OF_RANGE);
-    QLIB_ASSERT_RET(QLIB_NUM_OF_SECTIONS > sectionID, QLIB_STATUS__INVALID_PARAMETER);
-    QLIB_ASSERT_RET(!((FALSE == secure) && (QLIB_SECTION_ID_VAULT == sectionID)), QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_CONTEXT_T* qlibContext = bgErase->qlibContext;
+    QLIB_STATUS_T   ret         = QLIB_STATUS__OK;
+    BOOL            overlap     = FALSE;
+    U64             startUs     = bgErase->getTimeUs();
+    U64             nowUs       = 0;
+    U64             waitUs      = 0;
+
+    while (TRUE)
+    {
+        /*-------------------------------------------------------------------------------------------------*/
+        /* Serve the read as soon as the erase command is completed, the next one starts after the read    */
+        /*-------------------------------------------------------------------------------------------------*/
+        QLIB_STATUS_RET_CHECK(QLIB_BgErase_Update_L(bgErase, FALSE));
+        if (FALSE == bgErase->busy)
+        {
+            QLIB_STATUS_RET_CHECK(QLIB_Read(qlibContext, buf, sectionID, offset, size, FALSE, FALSE));
+            return QLIB_BgErase_Update_L(bgErase, TRUE);
+        }
 
-    return QLIB_SEC_SecureLogWrite(qlibContext, buf, sectionID, size, secure);
-}
-#endif
+        /*-------------------------------------------------------------------------------------------------*/
+        /* Data of the erase command in progress is not readable while the command is suspended            */
+        /*-------------------------------------------------------------------------------------------------*/
+        overlap = ((sectionID == bgErase->sectionID) && (offset < (bgErase->eraseOffset + bgErase->eraseSize)) &&
+                   (bgErase->eraseOffset < (offset + size)))
+                      ? TRUE
+                      : FALSE;
 
-#ifndef EXCLUDE_W77Q_RNG_FEATURE
-QLIB_STATUS_T QLIB_GetRandom(QLIB_CONTEXT_T* qlibContext, U8* random, U32 randomSize)
-{
-    /********************************************************************************************************
-     * Error checking
-    ********************************************************************************************************/
-    QLIB_ASSERT_RET(NULL != qlibContext, QLIB_STATUS__INVALID_PARAMETER);
-    QLIB_ASSERT_RET(QLIB_DEVICE_INITIALIZED(qlibContext), QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE);
-    QLIB_ASSERT_RET(W77Q_RNG_FEATURE(qlibContext) != 0u, QLIB_STATUS__NOT_SUPPORTED);
-    QLIB_ASSERT_RET(NULL != random, QLIB_STATUS__INVALID_PARAMETER);
-    QLIB_ASSERT_RET(0u != randomSize, QLIB_STATUS__INVALID_PARAMETER);
+        /*-------------------------------------------------------------------------------------------------*/
+        /* Suspend the erase if the policy allows it, read and resume                                      */
+        /*-------------------------------------------------------------------------------------------------*/
+        nowUs = bgErase->getTimeUs();
+        if ((FALSE == overlap) && (bgErase->suspends < bgErase->policy.maxSuspends) &&
+            ((nowUs - bgErase->runStartUs) >= bgErase->policy.minEraseRunUs))
+        {
+            QLIB_STATUS_RET_CHECK(QLIB_Suspend(qlibContext));
+            bgErase->suspends++;
+            bgErase->totalSuspends++;
+
+            ret = QLIB_Read(qlibContext, buf, sectionID, offset, size, FALSE, FALSE);
+
+            QLIB_STATUS_RET_CHECK(QLIB_Resume(qlibContext));
+            bgErase->runStartUs = bgErase->getTimeUs();
+
+            return ret;
+        }
 
-    return QLIB_SEC_GetRandom(qlibContext, random, randomSize);
+        /*-------------------------------------------------------------------------------------------------*/
+        /* Otherwise sleep until the next poll, bounded by the policy (no limit if maxReadWaitUs is 0)     */
+        /*-------------------------------------------------------------------------------------------------*/
+        waitUs = QLIB_BG_ERASE_POLL_US;
+        if ((FALSE == overlap) && (bgErase->suspends < bgErase->policy.maxSuspends))
+        {
+            // wake up when the erase may be suspended
+            waitUs = MAX(MIN(waitUs, (bgErase->runStartUs + bgErase->policy.minEraseRunUs) - nowUs), 1u);
+        }
+        if (0u < bgErase->policy.maxReadWaitUs)
+        {
+            QLIB_ASSERT_RET((nowUs - startUs) < bgErase->policy.maxReadWaitUs, QLIB_STATUS__DEVICE_BUSY);
+            waitUs = MIN(waitUs, (startUs + bgErase->policy.maxReadWaitUs) - nowUs);
+        }
+        bgErase->sleepUs((U32)waitUs);
+    }
 }
-#endif
 
-#if !defined EXCLUDE_LMS_ATTESTATION && !defined Q2_API
-QLIB_STATUS_T                                    QLIB_LMS_Attest_SetPrivateKey(QLIB_CONTEXT_T*                 qlibContext,
-                                                                               const LMS_ATTEST_PRIVATE_SEED_T seed,
-                                                                               const LMS_ATTEST_KEY_ID_T       keyId)
+/************************************************************************************************************
+ * @brief       This routine routes the plain reads of the QLIB context through the background erase while
+ *              an erase command is pending or in progress
+ *
+ * @param       bgErase       Background erase state
+ * @param[in]   status        Status of the last background erase operation
+ *
+ * @return      @p status
+************************************************************************************************************/
+static QLIB_STATUS_T QLIB_BgErase_Attach_L(QLIB_BG_ERASE_T* bgErase, QLIB_STATUS_T status)
 {
-    /********************************************************************************************************
-     * Error checking
-    ********************************************************************************************************/
-    QLIB_ASSERT_RET(NULL != qlibContext, QLIB_STATUS__INVALID_PARAMETER);
-    QLIB_ASSERT_RET(QLIB_DEVICE_INITIALIZED(qlibContext), QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE);
-    QLIB_ASSERT_RET(W77Q_SUPPORT_LMS_ATTESTATION(qlibContext) != 0u, QLIB_STATUS__NOT_SUPPORTED);
-    QLIB_ASSERT_RET(NULL != seed, QLIB_STATUS__INVALID_PARAMETER);
-    QLIB_ASSERT_RET(NULL != keyId, QLIB_STATUS__INVALID_PARAMETER);
+    bgErase->qlibContext->bgErase = ((TRUE == bgErase->busy) || (0u < bgErase->size)) ? bgErase : NULL;
 
-    return QLIB_SEC_LMS_Attest_SetPrivateKey(qlibContext, seed, keyId);
+    return status;
 }
 
-QLIB_STATUS_T QLIB_LMS_Attest_GetPublicKey(QLIB_CONTEXT_T*    qlibContext,
-                                           LMS_ATTEST_CHUNK_T pubKey,
-                                           LMS_ATTEST_CHUNK_T pubCache[],
-                                           U32                pubCacheLen)
+/************************************************************************************************************
+ * @brief       This routine tracks the background erase. When the erase command in progress is completed,
+ *              its status is checked and the next erase command is started
+ *
+ * @param       bgErase       Background erase state
+ * @param[in]   startNext     If TRUE, the next erase command is started when the previous one is completed
+ *
+ * @return      0 if no error occurred, QLIB_STATUS__(ERROR) otherwise
+************************************************************************************************************/
+static QLIB_STATUS_T QLIB_BgErase_Update_L(QLIB_BG_ERASE_T* bgErase, BOOL startNext)
 {
-    /********************************************************************************************************
-     * Error checking
-    ********************************************************************************************************/
-    QLIB_ASSERT_RET(NULL != qlibContext, QLIB_STATUS__INVALID_PARAMETER)
-    QLIB_ASSERT_RET(QLIB_DEVICE_INITIALIZED(qlibContext), QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE);
-    QLIB_ASSERT_RET(W77Q_SUPPORT_LMS_ATTESTATION(qlibContext) != 0u, QLIB_STATUS__NOT_SUPPORTED);
-    QLIB_ASSERT_RET(NULL != pubKey, QLIB_STATUS__INVALID_PARAMETER);
-    QLIB_ASSERT_RET(0u == pubCacheLen || NULL != pubCache, QLIB_STATUS__INVALID_PARAMETER);
-    QLIB_ASSERT_RET(pubCacheLen <= QLIB_LMS_ATTEST_ALL_NODES, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_CONTEXT_T* qlibContext = bgErase->qlibContext;
+    QLIB_ERASE_T    eraseType   = QLIB_ERASE_FIRST;
+    BOOL            busy        = FALSE;
+
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Check if the erase command in progress is completed                                                 */
+    /*-----------------------------------------------------------------------------------------------------*/
+    if (TRUE == bgErase->busy)
+    {
+        QLIB_STATUS_RET_CHECK(QLIB_STD_IsBusy(qlibContext, &busy));
+        if (TRUE == busy)
+        {
+            return QLIB_STATUS__OK;
+        }
+        bgErase->busy = FALSE;
+        QLIB_STATUS_RET_CHECK(QLIB_CMD_PROC__get_SSR_UNSIGNED(qlibContext, NULL, SSR_MASK__ALL_ERRORS));
+    }
+
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Start the next erase command                                                                        */
+    /*-----------------------------------------------------------------------------------------------------*/
+    if ((TRUE == startNext) && (0u < bgErase->size))
+    {
+        bgErase->eraseOffset = bgErase->offset;
+        bgErase->eraseSize   = QLIB_COMMON_GetEraseStep(qlibContext, bgErase->offset, bgErase->size, &eraseType);
+        bgErase->suspends    = 0;
+
+        QLIB_STATUS_RET_CHECK(QLIB_STD_PerformErase(qlibContext,
+                                                    eraseType,
+                                                    QLIB_MAKE_LOGICAL_ADDRESS(qlibContext, bgErase->sectionID, bgErase->offset),
+                                                    FALSE));
+
+        bgErase->busy       = TRUE;
+        bgErase->runStartUs = bgErase->getTimeUs();
+        bgErase->offset += bgErase->eraseSize;
+        bgErase->size -= bgErase->eraseSize;
+    }
 
-    return QLIB_SEC_LMS_Attest_GetPublicKey(qlibContext, pubKey, pubCache, pubCacheLen);
+    return QLIB_STATUS__OK;
 }
 
-QLIB_STATUS_T QLIB_LMS_Attest_Sign(QLIB_CONTEXT_T*          qlibContext,
-                                   const U8*                msg,
-                                   U32                      msgSize,
-                                   const LMS_ATTEST_NONCE_T nonce,
-                                   LMS_ATTEST_CHUNK_T       pubCache[],
-                                   U32                      pubCacheLen,
-                                   QLIB_OTS_SIG_T*          sig)
+#if QLIB_NUM_OF_DIES > 1
+/************************************************************************************************************
+ * @brief       This routine finds the next operation of a die
+ *
+ * @param[in]   ops           Operations
+ * @param[in]   numOps        Number of operations
+ * @param[in]   die           Die index
+ * @param[in]   first         Index of the first operation to check
+ *
+ * @return      Index of the next operation of @p die, @p numOps if there is none
+************************************************************************************************************/
+static U32 QLIB_DieSched_NextOp_L(const QLIB_DIE_OP_T* ops, U32 numOps, U8 die, U32 first)
 {
-    /********************************************************************************************************
-     * Error checking
-    ********************************************************************************************************/
-    QLIB_ASSERT_RET(NULL != qlibContext, QLIB_STATUS__INVALID_PARAMETER);
-    QLIB_ASSERT_RET(QLIB_DEVICE_INITIALIZED(qlibContext), QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE);
-    QLIB_ASSERT_RET(W77Q_SUPPORT_LMS_ATTESTATION(qlibContext) != 0u, QLIB_STATUS__NOT_SUPPORTED);
-    QLIB_ASSERT_RET(NULL != msg, QLIB_STATUS__INVALID_PARAMETER);
-    QLIB_ASSERT_RET(0u < msgSize, QLIB_STATUS__INVALID_PARAMETER);
-    QLIB_ASSERT_RET(NULL != nonce, QLIB_STATUS__INVALID_PARAMETER);
-    QLIB_ASSERT_RET(NULL != sig, QLIB_STATUS__INVALID_PARAMETER);
-    QLIB_ASSERT_RET(0u == pubCacheLen || NULL != pubCache, QLIB_STATUS__INVALID_PARAMETER);
-    QLIB_ASSERT_RET(pubCacheLen <= QLIB_LMS_ATTEST_ALL_NODES, QLIB_STATUS__INVALID_PARAMETER);
+    while ((first < numOps) && (ops[first].die != die))
+    {
+        first++;
+    }
 
-    return QLIB_SEC_LMS_Attest_Sign(qlibContext, msg, msgSize, nonce, pubCache, pubCacheLen, sig);
+    return first;
 }
-#endif
 
-QLIB_STATUS_T QLIB_IsKeyProvisioned(QLIB_CONTEXT_T* qlibContext, QLIB_KID_TYPE_T keyIdType, U32 sectionID, BOOL* isProvisioned)
+/************************************************************************************************************
+ * @brief       This routine advances the operations of the active die. If the command in progress is
+ *              completed, its status is checked and the next program or erase command is issued without
+ *              waiting
+ *
+ * @param       qlibContext   qlib context object
+ * @param[in]   ops           Operations
+ * @param[in]   numOps        Number of operations
+ * @param       sched         Progress of the active die
+ *
+ * @return      0 if no error occurred, QLIB_STATUS__(ERROR) otherwise
+************************************************************************************************************/
+static QLIB_STATUS_T QLIB_DieSched_Step_L(QLIB_CONTEXT_T* qlibContext, const QLIB_DIE_OP_T* ops, U32 numOps, QLIB_DIE_SCHED_T* sched)
 {
-    QLIB_STATUS_T status = QLIB_STATUS__OK;
+    const QLIB_DIE_OP_T* op        = NULL;
+    QLIB_ERASE_T         eraseType = QLIB_ERASE_FIRST;
+    BOOL                 busy      = FALSE;
+    U32                  offset;
+    U32                  size;
 
-    QLIB_ASSERT_RET(NULL != qlibContext, QLIB_STATUS__INVALID_PARAMETER);
-    QLIB_ASSERT_RET(NULL != isProvisioned, QLIB_STATUS__INVALID_PARAMETER);
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Check if the command in progress is completed, its status is kept in the die SSR                    */
+    /*-----------------------------------------------------------------------------------------------------*/
+    if (QLIB_ACTIVE_DIE_STATE(qlibContext).isBusy == 1u)
+    {
+        QLIB_STATUS_RET_CHECK(QLIB_STD_IsBusy(qlibContext, &busy));
+        if (TRUE == busy)
+        {
+            return QLIB_STATUS__OK;
+        }
+        QLIB_ACTIVE_DIE_STATE(qlibContext).isBusy = 0u;
+        QLIB_STATUS_RET_CHECK(QLIB_CMD_PROC__get_SSR_UNSIGNED(qlibContext, NULL, SSR_MASK__ALL_ERRORS));
+    }
 
-    if (W77Q_CMD_GET_KEYS_STATUS(qlibContext) != 0u)
+    if (numOps == sched->op)
     {
-        status = QLIB_SEC_IsKeyProvisioned(qlibContext, keyIdType, sectionID, isProvisioned);
+        return QLIB_STATUS__OK;
+    }
+
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Grant plain access when the operation starts. Same checks as a plain write or erase                 */
+    /*-----------------------------------------------------------------------------------------------------*/
+    op = &ops[sched->op];
+    if (0u == sched->done)
+    {
+        QLIB_STATUS_RET_CHECK(QLIB_PreparePlainErase_L(qlibContext, op->sectionID, op->offset, op->size));
+        QLIB_ViewInvalidate_L(qlibContext, op->sectionID, op->offset, op->size);
+    }
+
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Issue the next erase step or page program. Code can not execute from flash while a die is busy, so  */
+    /* with XIP every command is waited for and the dies are not interleaved                               */
+    /*-----------------------------------------------------------------------------------------------------*/
+    offset = op->offset + sched->done;
+    if (QLIB_DIE_OP__ERASE == op->type)
+    {
+        size = QLIB_COMMON_GetEraseStep(qlibContext, offset, op->size - sched->done, &eraseType);
+        QLIB_STATUS_RET_CHECK(QLIB_STD_PerformErase(qlibContext,
+                                                    eraseType,
+                                                    QLIB_MAKE_LOGICAL_ADDRESS(qlibContext, op->sectionID, offset),
+                                                    QLIB_DIE_SCHED_BLOCKING));
     }
     else
     {
-        status = QLIB_STATUS__NOT_SUPPORTED;
+        size = MIN(op->size - sched->done, FLASH_PAGE_SIZE - (offset % FLASH_PAGE_SIZE));
+        QLIB_STATUS_RET_CHECK(QLIB_STD_PageProgram(qlibContext,
+                                                   &op->buf[sched->done],
+                                                   QLIB_MAKE_LOGICAL_ADDRESS(qlibContext, op->sectionID, offset),
+                                                   size,
+                                                   QLIB_DIE_SCHED_BLOCKING));
     }
-    return status;
-}
+#ifndef QLIB_SUPPORT_XIP
+    QLIB_ACTIVE_DIE_STATE(qlibContext).isBusy = 1u;
+#endif
 
-/*---------------------------------------------------------------------------------------------------------*/
-/*---------------------------------------------------------------------------------------------------------*/
-/*                                             LOCAL FUNCTIONS                                             */
-/*---------------------------------------------------------------------------------------------------------*/
-/*---------------------------------------------------------------------------------------------------------*/
+    sched->done += size;
+    if (op->size == sched->done)
+    {
+        sched->op   = QLIB_DieSched_NextOp_L(ops, numOps, op->die, sched->op + 1u);
+        sched->done = 0;
+    }
+
+    return QLIB_STATUS__OK;
+}
+#endif
 
 /************************************************************************************************************
-* @brief       This routine waits till flash is ready and detects and sets the bus mode (SPI/QPI) and flash device ID
-*
-* @param       qlibContext   qlib context object
-*
-* @return      0 if no error occurred, QLIB_STATUS__(ERROR) otherwise
+ * @brief       This routine compares data to the flash content of a part of a page
+ *
+ * @param       qlibContext   qlib context object
+ * @param[in]   buf           Data to compare
+ * @param[in]   sectionID     Section index
+ * @param[in]   offset        Section offset
+ * @param[in]   size          Data size, the data must not cross a page boundary
+ * @param[in]   secure        If TRUE then secure read, else standard read
+ * @param[out]  identical     TRUE if the flash holds the same data
+ *
+ * @return      0 if no error occurred, QLIB_STATUS__(ERROR) otherwise
 ************************************************************************************************************/
-static QLIB_STATUS_T QLIB_waitReadyAndInitBusMode_L(QLIB_CONTEXT_T* qlibContext)
+static QLIB_STATUS_T QLIB_ComparePage_L(QLIB_CONTEXT_T* qlibContext,
+                                        const U8*       buf,
+                                        U32             sectionID,
+                                        U32             offset,
+                                        U32             size,
+                                        BOOL            secure,
+                                        BOOL*           identical)
 {
-    QLIB_BUS_FORMAT_T currentFormat;
+    U8 page[FLASH_PAGE_SIZE];
 
-    // identify and set current bus mode
-    QLIB_STATUS_RET_CHECK(QLIB_STD_WaitTillFlashIsReady(qlibContext, &currentFormat, &qlibContext->detectedDeviceID));
-
-    // Set bus mode
-    qlibContext->busInterface.busMode = QLIB_BUS_FORMAT_GET_MODE(currentFormat);
-    qlibContext->busInterface.dtr     = QLIB_BUS_FORMAT_GET_DTR(currentFormat);
-    QLIB_STATUS_RET_CHECK(QLIB_SetInterface(qlibContext, currentFormat));
-
-    // Clear errors in SSR caused by AutoSense
-    QLIB_STATUS_RET_CHECK(QLIB_SEC_ClearSSR(qlibContext));
+    QLIB_STATUS_RET_CHECK(QLIB_Read(qlibContext, page, sectionID, offset, size, secure, FALSE));
+    *identical = (0 == memcmp(page, buf, size)) ? TRUE : FALSE;
 
     return QLIB_STATUS__OK;
 }
 
 /************************************************************************************************************
-* @brief       This routine loads the ACL from Section Security Policy Register (SSPR), affecting the 
-*              plain access runtime privileges of the Section
-*
-* @param       qlibContext   qlib context object
-* @param       sectionID     Section ID
-* @param       condition     load ACL only if the section is with specific authentication or access. fail otherwise
-*
-* @return      0 if no error occurred, QLIB_STATUS__(ERROR) otherwise
+ * @brief       This routine calculates the CRC of a full page of data, the same CRC as @ref QLIB_MemCRC
+ *
+ * @param[in]   buf           Page data, no alignment is required
+ * @param[out]  crc           CRC of the page
+ *
+ * @return      0 if no error occurred, QLIB_STATUS__(ERROR) otherwise
 ************************************************************************************************************/
-static QLIB_STATUS_T QLIB_PlainAccessGrant_L(QLIB_CONTEXT_T* qlibContext, U32 sectionID, QLIB_LOAD_ACLR_T condition)
+static QLIB_STATUS_T QLIB_PageCRC_L(const U8* buf, U32* crc)
 {
-    QLIB_POLICY_T policy = {0};
-    U32           sectionSize;
-    QLIB_STATUS_T ret;
+    U32 page[FLASH_PAGE_SIZE / sizeof(U32)];
 
-    /********************************************************************************************************
-     * Error checking
-    ********************************************************************************************************/
-    QLIB_ASSERT_RET(NULL != qlibContext, QLIB_STATUS__INVALID_PARAMETER);
-    QLIB_ASSERT_RET(QLIB_DEVICE_INITIALIZED(qlibContext), QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE);
-    QLIB_ASSERT_RET(QLIB_SECTION_ID_VAULT > sectionID, QLIB_STATUS__INVALID_PARAMETER);
+    (void)memcpy(page, buf, FLASH_PAGE_SIZE);
+    *crc = QLIB_COMMON_CalcCRC(0, page, FLASH_PAGE_SIZE);
 
-    /********************************************************************************************************
-     * check if the section is authenticated plain access
-    ********************************************************************************************************/
-    QLIB_STATUS_RET_CHECK(QLIB_GetSectionConfiguration(qlibContext, sectionID, NULL, &sectionSize, &policy, NULL, NULL, NULL));
-    QLIB_ASSERT_RET(sectionSize != 0u, QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE); // section is disabled
+    return QLIB_STATUS__OK;
+}
 
-    QLIB_ASSERT_RET((policy.plainAccessWriteEnable == 1u) || (((U8)condition & (U8)QLIB_LOAD_ACLR_PLAIN_WR) == 0u),
-                    QLIB_STATUS__DEVICE_PRIVILEGE_ERR);
-    QLIB_ASSERT_RET((policy.plainAccessReadEnable == 1u) || (((U8)condition & (U8)QLIB_LOAD_ACLR_PLAIN_RD) == 0u),
-                    QLIB_STATUS__DEVICE_PRIVILEGE_ERR);
+/************************************************************************************************************
+ * @brief       This routine calculates the CRC of each page of a flash range.
+ *              For plain access the CRCs are calculated by the flash with MEM_CRC commands if supported,
+ *              so the data is not read back. Otherwise the pages are read and the CRCs are calculated
+ *              by the host
+ *
+ * @param       qlibContext   qlib context object
+ * @param[in]   sectionID     Section index
+ * @param[in]   offset        Section offset, aligned to FLASH_PAGE_SIZE
+ * @param[in]   numPages      Number of pages
+ * @param[in]   secure        If TRUE then secure read, else standard read
+ * @param[out]  crcs          Array of @p numPages CRCs
+ *
+ * @return      0 if no error occurred, QLIB_STATUS__(ERROR) otherwise
+************************************************************************************************************/
+static QLIB_STATUS_T QLIB_ReadPageCRCs_L(QLIB_CONTEXT_T* qlibContext,
+                                         U32             sectionID,
+                                         U32             offset,
+                                         U32             numPages,
+                                         BOOL            secure,
+                                         U32*            crcs)
+{
+    U32 page[FLASH_PAGE_SIZE / sizeof(U32)];
+    U32 i;
 
-    if (policy.authPlainAccess == 1u)
-    {
-        QLIB_ASSERT_RET(((U8)condition & (U8)QLIB_LOAD_ACLR_NON_AUTH) == 0u, QLIB_STATUS__DEVICE_PRIVILEGE_ERR);
-        ret = QLIB_SEC_AuthPlainAccess_Grant(qlibContext, sectionID);
-    }
-    else
+#ifndef EXCLUDE_MEM_CRC
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* MEM_CRC needs plain read access to the section, on failure fall back to read                        */
+    /*-----------------------------------------------------------------------------------------------------*/
+    if ((FALSE == secure) && (W77Q_MEM_CRC(qlibContext) != 0u))
     {
-        ret = QLIB_SEC_EnablePlainAccess(qlibContext, sectionID);
+        if (QLIB_STATUS__OK ==
+            QLIB_MemCRCMap(qlibContext, crcs, sectionID, offset, numPages * FLASH_PAGE_SIZE, FLASH_PAGE_SIZE))
+        {
+            return QLIB_STATUS__OK;
+        }
     }
+#endif
 
-    /*---------------------------------------------------------------------------------------------*/
-    /* Mark plain access is enabled                                                                */
-    /*---------------------------------------------------------------------------------------------*/
-    if (QLIB_STATUS__OK == ret || QLIB_STATUS__DEVICE_INTEGRITY_ERR == ret)
+    for (i = 0; i < numPages; i++)
     {
-        QLIB_ACTIVE_DIE_STATE(qlibContext).sectionsState[sectionID].plainEnabled = QLIB_SECTION_PLAIN_EN_NO;
-        if (policy.plainAccessWriteEnable == 1u)
-        {
-            QLIB_ACTIVE_DIE_STATE(qlibContext).sectionsState[sectionID].plainEnabled |= QLIB_SECTION_PLAIN_EN_WR;
-        }
-        if (policy.plainAccessReadEnable == 1u && QLIB_STATUS__DEVICE_INTEGRITY_ERR != ret)
-        {
-            QLIB_ACTIVE_DIE_STATE(qlibContext).sectionsState[sectionID].plainEnabled |= QLIB_SECTION_PLAIN_EN_RD;
-        }
+        QLIB_STATUS_RET_CHECK(
+            QLIB_Read(qlibContext, (U8*)page, sectionID, offset + (i * FLASH_PAGE_SIZE), FLASH_PAGE_SIZE, secure, FALSE));
+        crcs[i] = QLIB_COMMON_CalcCRC(0, page, FLASH_PAGE_SIZE);
     }
-    QLIB_STATUS_RET_CHECK(ret);
+
     return QLIB_STATUS__OK;
 }
 
 /************************************************************************************************************
- * @brief       This function translates the flash HW version to qlib target as defined in @ref qlib_targets.h
+ * @brief       This routine writes a full sector. The flash content is compared by page CRCs, an identical
+ *              sector is skipped. Otherwise the sector is erased unless it is already erased, and the pages
+ *              that are not erased in the new data are programmed. A page is never programmed twice
+ *              without an erase
  *
- * @param[in]   hwVer        Hardware version information
- * @param[out]  target       The detected flash target
+ * @param       qlibContext   qlib context object
+ * @param[in]   buf           Sector data
+ * @param[in]   sectionID     Section index
+ * @param[in]   offset        Section offset, aligned to FLASH_SECTOR_SIZE
+ * @param[in]   secure        If TRUE then secure access, else standard access
+ * @param[out]  pagesSkipped  Incremented by the number of pages that were not programmed
  *
- * @return      QLIB_STATUS__OK on success or QLIB_STATUS__[ERROR] otherwise
+ * @return      0 if no error occurred, QLIB_STATUS__(ERROR) otherwise
 ************************************************************************************************************/
-static QLIB_STATUS_T QLIB_GetTargetFlash_L(QLIB_HW_VER_T* hwVer, U32* target)
+static QLIB_STATUS_T QLIB_WriteSector_L(QLIB_CONTEXT_T* qlibContext,
+                                        const U8*       buf,
+                                        U32             sectionID,
+                                        U32             offset,
+                                        BOOL            secure,
+                                        U32*            pagesSkipped)
 {
-    if ((hwVer->sec.securityVersion & 0xF0u) == 0x20u)
+    U32  flashCrc[QLIB_PAGES_PER_SECTOR];
+    U32  erasedPage[FLASH_PAGE_SIZE / sizeof(U32)];
+    U32  dataCrc   = 0;
+    U32  erasedCrc = 0;
+    U32  program   = 0; // bit per page that is not erased in the new data
+    BOOL identical = TRUE;
+    BOOL erased    = TRUE;
+    U32  page;
+    U32  i;
+
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Compare the sector to the flash content                                                             */
+    /*-----------------------------------------------------------------------------------------------------*/
+    QLIB_STATUS_RET_CHECK(QLIB_ReadPageCRCs_L(qlibContext, sectionID, offset, QLIB_PAGES_PER_SECTOR, secure, flashCrc));
+    (void)memset(erasedPage, 0xFF, sizeof(erasedPage));
+    erasedCrc = QLIB_COMMON_CalcCRC(0, erasedPage, FLASH_PAGE_SIZE);
+
+    for (page = 0; page < QLIB_PAGES_PER_SECTOR; page++)
     {
-        // Q2 flash
-        if (hwVer->sec.securityVersion == 0x20u)
-        {
-            // Q2 MCD (32Mb)
-            if (hwVer->info.revision == QLIB_TARGET_REVISION_B || hwVer->info.revision == QLIB_TARGET_REVISION_C)
-            {
-                *target = w77q32jw_revB;
-            }
-            else
-            {
-                return QLIB_STATUS__NOT_SUPPORTED;
-            }
-        }
-        else if ((hwVer->sec.securityVersion == 0x24u) || (hwVer->sec.securityVersion == 0x28u))
+        QLIB_STATUS_RET_CHECK(QLIB_PageCRC_L(&buf[page * FLASH_PAGE_SIZE], &dataCrc));
+        if (dataCrc != flashCrc[page])
         {
-            // Q2 HCD (64Mb/128Mb)
-            if (hwVer->info.voltage == QLIB_TARGET_VOLTAGE_1_8V)
-            {
-                if (hwVer->info.revision == QLIB_TARGET_REVISION_A)
-                {
-                    *target = (hwVer->info.flashSize == QLIB_TARGET_SIZE_64Mb ? w77q64jw_revA : w77q128jw_revA);
-                }
-                else
-                {
-                    return QLIB_STATUS__NOT_SUPPORTED;
-                }
-            }
-            else
-            {
-                // QLIB_TARGET_VOLTAGE_3_3V
-                if (hwVer->info.revision == QLIB_TARGET_REVISION_A)
-                {
-                    *target = (hwVer->info.flashSize == QLIB_TARGET_SIZE_64Mb ? w77q64jv_revA : w77q128jv_revA);
-                }
-                else
-                {
-                    return QLIB_STATUS__NOT_SUPPORTED;
-                }
-            }
+            identical = FALSE;
         }
-        else
+        if (erasedCrc != flashCrc[page])
         {
-            return QLIB_STATUS__NOT_SUPPORTED;
+            erased = FALSE;
         }
-    }
-    else if ((hwVer->sec.securityVersion & 0xF0u) == 0x30u)
-    {
-        // Q3 chip
-        if (hwVer->sec.securityVersion == 0x30u)
+        for (i = 0; i < FLASH_PAGE_SIZE; i++)
         {
-            // Q3 chip W77Q/T industrial
-            if (hwVer->std.memoryType == 0x8Eu)
-            {
-                // W77T : Octal SPI secure flash
-                *target = w77t25nwxxi_revA;
-            }
-            else
+            if (buf[(page * FLASH_PAGE_SIZE) + i] != 0xFFu)
             {
-                // W77Q: Quad SPI secure flash
-                *target = w77q25nwxxi_revA;
+                program |= (1u << page);
+                break;
             }
         }
-        else if (hwVer->sec.securityVersion == 0x34u)
+    }
+
+    if (TRUE == identical)
+    {
+        *pagesSkipped += QLIB_PAGES_PER_SECTOR;
+        return QLIB_STATUS__OK;
+    }
+
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Programmed pages are erased before they are programmed again                                        */
+    /*-----------------------------------------------------------------------------------------------------*/
+    if (FALSE == erased)
+    {
+        QLIB_STATUS_RET_CHECK(QLIB_Erase(qlibContext, sectionID, offset, FLASH_SECTOR_SIZE, secure));
+    }
+
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Program the pages that are not erased in the new data                                               */
+    /*-----------------------------------------------------------------------------------------------------*/
+    for (page = 0; page < QLIB_PAGES_PER_SECTOR; page++)
+    {
+        if ((program & (1u << page)) != 0u)
         {
-            // Q3 chip W77Q/T automotive
-            if (hwVer->std.memoryType == 0x8Eu)
-            {
-                // W77T : Octal SPI secure flash
-                *target = w77t25nwxxa_revA;
-            }
-            else
-            {
-                // W77Q: Quad SPI secure flash
-                *target = w77q25nwxxa_revA;
-            }
+            QLIB_STATUS_RET_CHECK(QLIB_Write(qlibContext,
+                                             &buf[page * FLASH_PAGE_SIZE],
+                                             sectionID,
+                                             offset + (page * FLASH_PAGE_SIZE),
+                                             FLASH_PAGE_SIZE,
+                                             secure));
         }
         else
         {
-            return QLIB_STATUS__NOT_SUPPORTED;
+            (*pagesSkipped)++;
         }
     }
-    else
+
+    return QLIB_STATUS__OK;
+}
+
+/************************************************************************************************************
+ * @brief       This routine erases a single range with the cheapest erase commands according to the erase
+ *              cost model. A range that covers a full section is erased with a section erase if it is not
+ *              slower than erasing the section blocks
+ *
+ * @param       qlibContext   qlib context object
+ * @param[in]   range         Range to erase
+ * @param[in]   secure        If TRUE then secure erase, else standard erase
+ *
+ * @return      0 if no error occurred, QLIB_STATUS__(ERROR) otherwise
+************************************************************************************************************/
+static QLIB_STATUS_T QLIB_EraseRange_L(QLIB_CONTEXT_T* qlibContext, const QLIB_ERASE_RANGE_T* range, BOOL secure)
+{
+    U32 sectionSize = QLIB_CALC_SECTION_SIZE(qlibContext, range->sectionID);
+    U64 sectionTime;
+
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Standard erase of a remapped section is left to QLIB_Erase                                          */
+    /*-----------------------------------------------------------------------------------------------------*/
+    if ((0u == range->offset) && (_64KB_ <= sectionSize) && (sectionSize == range->size) &&
+        ((TRUE == secure) || (QLIB_FALLBACK_SECTION(qlibContext, range->sectionID) == range->sectionID)))
     {
-        return QLIB_STATUS__NOT_SUPPORTED;
+        sectionTime = (U64)qlibContext->eraseCost.timeUs[QLIB_ERASE_COST_INDEX(QLIB_ERASE_SECTION)] * (sectionSize / _64KB_);
+        if (sectionTime <= QLIB_COMMON_GetEraseTime(qlibContext, 0, sectionSize))
+        {
+            return QLIB_EraseSection(qlibContext, range->sectionID, secure);
+        }
     }
 
-    return QLIB_STATUS__OK;
+    return QLIB_Erase(qlibContext, range->sectionID, range->offset, range->size, secure);
 }
@@ -146,6 +146,36 @@ QLIB_STATUS_T QLIB_InitLib(QLIB_CONTEXT_T* qlibContext);
 ************************************************************************************************************/
 QLIB_STATUS_T QLIB_InitDevice(QLIB_CONTEXT_T* qlibContext, QLIB_BUS_FORMAT_T busFormat);
 
+/************************************************************************************************************
+ * @brief       This function initializes the communication with W77Q and selects the fastest working read
+ *              configuration.
+ *
+ * The device is first initialized with @p busFormat as in @ref QLIB_InitDevice. Then every candidate bus
+ * format is tried with fast read dummy cycles from @p config maxDummyCycles down to minDummyCycles
+ * (dummy cycles are tried only if configurable in the device). Each candidate is verified by reading a known
+ * pattern. The candidate that passes with the least estimated read cycles is kept.\n
+ * The read cycles are estimated from the read command format of the candidate, reads are not timed, so the
+ * ranking ignores the bus clock and the platform overhead.\n
+ * A candidate not supported by the device or the library build is skipped.\n
+ * The pattern section must allow plain read.
+ *
+ * @param[out]  qlibContext   [QLIB internal state](md_definitions.html#DEF_CONTEXT)
+ * @param[in]   busFormat     Initial flash interface format, used if no candidate is faster
+ * @param[in]   config        Autotune configuration
+ * @param[out]  result        Selected configuration and statistics
+ *
+ * @return
+ * QLIB_STATUS__OK = 0                  - no error occurred\n
+ * QLIB_STATUS__INVALID_PARAMETER       - @p qlibContext, @p config or @p result is NULL, or wrong dummy cycles range\n
+ * QLIB_STATUS__PARAMETER_OUT_OF_RANGE  - pattern size is 0 or above QLIB_AUTOTUNE_MAX_PATTERN_SIZE\n
+ * QLIB_STATUS__CONNECTIVITY_ERR        - the selected configuration failed the final pattern check\n
+ * QLIB_STATUS__(ERROR)                 - Other error
+************************************************************************************************************/
+QLIB_STATUS_T QLIB_InitDeviceAutotune(QLIB_CONTEXT_T*               qlibContext,
+                                      QLIB_BUS_FORMAT_T             busFormat,
+                                      const QLIB_AUTOTUNE_CONFIG_T* config,
+                                      QLIB_AUTOTUNE_RESULT_T*       result);
+
 /************************************************************************************************************
  * @brief       This function establishes a communication channel with the flash and sets the active die to 0
  *
@@ -292,6 +322,31 @@ QLIB_STATUS_T QLIB_CloseSession(QLIB_CONTEXT_T* qlibContext, U32 sectionID);
 ************************************************************************************************************/
 QLIB_STATUS_T QLIB_PlainAccessGrant(QLIB_CONTEXT_T* qlibContext, U32 sectionID);
 
+/************************************************************************************************************
+ * @brief       This function grants plain access to several sections, typically on boot.
+ *
+ * Same as calling @ref QLIB_PlainAccessGrant for every section, but the configuration of all the sections
+ * is checked and the grant keys are selected before any grant is sent. In Q3 flash, the grants of the
+ * authenticated sections are sent back to back in one multi-transaction sequence, without opening
+ * sessions. An integrity error of a section does not stop the grant of the other sections. If a grant
+ * fails, the sections granted before it keep their plain access.
+ *
+ * @param[out]  qlibContext   [QLIB internal state](md_definitions.html#DEF_CONTEXT)
+ * @param[in]   sectionIDs    Array of [section indexes](md_definitions.html#DEF_SECTION)
+ * @param[in]   num           Number of sections in @p sectionIDs
+ *
+ * @return:
+ * QLIB_STATUS__OK = 0                    - no error occurred\n
+ * QLIB_STATUS__INVALID_PARAMETER         - @p qlibContext or @p sectionIDs is NULL, or @p num is invalid\n
+ * QLIB_STATUS__INVALID_PARAMETER         - a section index is invalid\n
+ * QLIB_STATUS__DEVICE_PRIVILEGE_ERR      - section is authenticated and the section key is not loaded\n
+ * QLIB_STATUS__DEVICE_INTEGRITY_ERR      - integrity check failed on at least one section, plain read
+ *                                          access is not granted to these sections\n
+ * QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE - Flash device was not initialized or a section is not enabled\n
+ * QLIB_STATUS__(ERROR)                   - Other error
+************************************************************************************************************/
+QLIB_STATUS_T QLIB_PlainAccessGrantMulti(QLIB_CONTEXT_T* qlibContext, const U32* sectionIDs, U32 num);
+
 /************************************************************************************************************
  * @brief       This routine revokes access to the section
  *              In Q2 flash, if the section is open, the function closes it.
@@ -563,6 +618,175 @@ QLIB_STATUS_T QLIB_ConfigAccess(QLIB_CONTEXT_T* qlibContext, U32 sectionID, BOOL
 ************************************************************************************************************/
 QLIB_STATUS_T QLIB_Read(QLIB_CONTEXT_T* qlibContext, U8* buf, U32 sectionID, U32 offset, U32 size, BOOL secure, BOOL auth);
 
+/************************************************************************************************************
+ * @brief       This function reads data in standard (legacy) mode as a stream of chunks.
+ *
+ * The data is read in chunks into the two halves of @p buf, and every chunk is passed to @p consumer in
+ * order, so reading a large range does not need a buffer of the full size.\n
+ * The chunk size is half of @p bufSize, limited by @ref QLIB_SetReadChunkSize.\n
+ * If QLIB_SPI_ASYNC_READ_ENABLED is defined, the next chunk is read with PLAT_SPI_ReadAsync while
+ * @p consumer processes the current one. In this case @p consumer must not access the flash directly.\n
+ * If plain access is needed and it is not opened, it will be opened automatically by this routine.
+ *
+ * @param[out]  qlibContext   [QLIB internal state](md_definitions.html#DEF_CONTEXT)
+ * @param[in]   sectionID     [Section index](md_definitions.html#DEF_SECTION)
+ * @param[in]   offset        [Section offset](md_definitions.html#DEF_OFFSET)
+ * @param[in]   size          [Size](md_definitions.html#DEF_SIZE)
+ * @param[out]  buf           Chunk buffer
+ * @param[in]   bufSize       Chunk buffer size, holds two chunks
+ * @param[in]   consumer      Called for every chunk. An error returned by @p consumer stops the read
+ * @param[in]   arg           @p consumer argument
+ *
+ * @return
+ * QLIB_STATUS__OK = 0                    - no error occurred\n
+ * QLIB_STATUS__INVALID_PARAMETER         - @p qlibContext, @p buf or @p consumer is NULL\n
+ * QLIB_STATUS__INVALID_DATA_SIZE         - @p bufSize is less than 2\n
+ * QLIB_STATUS__(ERROR)                   - Same errors as @ref QLIB_Read in standard mode, or error returned by @p consumer
+************************************************************************************************************/
+QLIB_STATUS_T QLIB_ReadStream(QLIB_CONTEXT_T*        qlibContext,
+                              U32                    sectionID,
+                              U32                    offset,
+                              U32                    size,
+                              U8*                    buf,
+                              U32                    bufSize,
+                              QLIB_READ_CHUNK_FUNC_T consumer,
+                              void*                  arg);
+
+/************************************************************************************************************
+ * @brief       This function sets the maximal size of a single standard read SPI transaction.
+ *              Larger standard reads are split into several read commands. The default is
+ *              QLIB_MAX_SPI_INPUT_SIZE if defined, else no limit
+ *
+ * @param[out]  qlibContext   [QLIB internal state](md_definitions.html#DEF_CONTEXT)
+ * @param[in]   chunkSize     Maximal transaction data size, 0 for no limit
+************************************************************************************************************/
+void QLIB_SetReadChunkSize(QLIB_CONTEXT_T* qlibContext, U32 chunkSize);
+
+/************************************************************************************************************
+ * @brief       This function opens a cached read-only view of a plain section.
+ *
+ * The view reads the section in FLASH_SECTOR_SIZE pages and keeps up to QLIB_VIEW_MAX_PAGES of them in
+ * @p cache, replacing the least recently used page. Writes and erases done through QLIB drop the cached
+ * pages they change. Changes not done through QLIB (e.g. by another host) are not detected.\n
+ * The view must be closed with @ref QLIB_View_Close before @p view or @p cache are released.
+ *
+ * @param[out]  view          Section view object
+ * @param[in]   qlibContext   [QLIB internal state](md_definitions.html#DEF_CONTEXT)
+ * @param[in]   sectionID     [Section index](md_definitions.html#DEF_SECTION)
+ * @param[in]   cache         Page cache buffer
+ * @param[in]   cacheSize     Page cache size, at least FLASH_SECTOR_SIZE
+ *
+ * @return
+ * QLIB_STATUS__OK = 0                    - no error occurred\n
+ * QLIB_STATUS__INVALID_PARAMETER         - @p view, @p qlibContext or @p cache is NULL, or @p sectionID is invalid\n
+ * QLIB_STATUS__INVALID_DATA_SIZE         - @p cacheSize is less than FLASH_SECTOR_SIZE\n
+ * QLIB_STATUS__DEVICE_PRIVILEGE_ERR      - section is not readable in plain access\n
+ * QLIB_STATUS__(ERROR)                   - Other error
+************************************************************************************************************/
+QLIB_STATUS_T QLIB_View_Open(QLIB_VIEW_T* view, QLIB_CONTEXT_T* qlibContext, U32 sectionID, U8* cache, U32 cacheSize);
+
+/************************************************************************************************************
+ * @brief       This function closes a view opened by @ref QLIB_View_Open
+ *
+ * @param[in]   view          Section view object
+ *
+ * @return      QLIB_STATUS__OK if no error occurred, QLIB_STATUS__(ERROR) otherwise
+************************************************************************************************************/
+QLIB_STATUS_T QLIB_View_Close(QLIB_VIEW_T* view);
+
+/************************************************************************************************************
+ * @brief       This function returns a pointer to the section data at @p offset, without copying.
+ *
+ * The data is contiguous up to the end of its page. The pointer is valid until the next call to a view
+ * function, or a write or erase of the section.
+ *
+ * @param[in]   view          Section view object
+ * @param[in]   offset        [Section offset](md_definitions.html#DEF_OFFSET)
+ * @param[out]  data          Section data
+ * @param[out]  size          Number of bytes available at @p data
+ *
+ * @return
+ * QLIB_STATUS__OK = 0                    - no error occurred\n
+ * QLIB_STATUS__PARAMETER_OUT_OF_RANGE    - @p offset is out of the section\n
+ * QLIB_STATUS__(ERROR)                   - Same errors as @ref QLIB_Read in standard mode
+************************************************************************************************************/
+QLIB_STATUS_T QLIB_View_Map(QLIB_VIEW_T* view, U32 offset, const U8** data, U32* size);
+
+/************************************************************************************************************
+ * @brief       This function copies section data through the view cache
+ *
+ * @param[in]   view          Section view object
+ * @param[out]  buf           The data read
+ * @param[in]   offset        [Section offset](md_definitions.html#DEF_OFFSET)
+ * @param[in]   size          [Size](md_definitions.html#DEF_SIZE)
+ *
+ * @return
+ * QLIB_STATUS__OK = 0                    - no error occurred\n
+ * QLIB_STATUS__PARAMETER_OUT_OF_RANGE    - @p offset + @p size is out of the section\n
+ * QLIB_STATUS__(ERROR)                   - Same errors as @ref QLIB_Read in standard mode
+************************************************************************************************************/
+QLIB_STATUS_T QLIB_View_Read(QLIB_VIEW_T* view, U8* buf, U32 offset, U32 size);
+
+/************************************************************************************************************
+ * @brief       This function enables combining of small plain writes
+ *
+ * Plain writes (@ref QLIB_Write with @p secure FALSE) that fit in one flash page are accumulated in
+ * @p writeCombine and programmed by a single page program. The buffered page is programmed when a write
+ * to another page arrives, when the page is full, when the data is buffered for more than @p timeoutUs,
+ * on @ref QLIB_WriteCombine_Flush, and before any read, erase or other operation that overlaps it, so
+ * @ref QLIB_Read always returns the written data.\n
+ * Buffered data is lost on power failure. Errors of a buffered write are reported by the operation that
+ * flushes it.
+ *
+ * @param       qlibContext   [QLIB internal state](md_definitions.html#DEF_CONTEXT)
+ * @param[out]  writeCombine  Write combining buffer, must stay valid until @ref QLIB_WriteCombine_Disable
+ * @param[in]   getTimeUs     Time source in microseconds, NULL for no timeout
+ * @param[in]   timeoutUs     Maximal time data is buffered. Checked on writes and on @ref QLIB_WriteCombine_Poll
+ *
+ * @return
+ * QLIB_STATUS__OK = 0                    - no error occurred\n
+ * QLIB_STATUS__INVALID_PARAMETER         - @p qlibContext or @p writeCombine is NULL\n
+ * QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE - Flash device was not initialized, or write combining is already enabled
+************************************************************************************************************/
+QLIB_STATUS_T QLIB_WriteCombine_Enable(QLIB_CONTEXT_T*       qlibContext,
+                                       QLIB_WRITE_COMBINE_T* writeCombine,
+                                       QLIB_TIME_US_FUNC_T   getTimeUs,
+                                       U32                   timeoutUs);
+
+/************************************************************************************************************
+ * @brief       This function flushes the buffered data and disables write combining
+ *
+ * @param       qlibContext   [QLIB internal state](md_definitions.html#DEF_CONTEXT)
+ *
+ * @return
+ * QLIB_STATUS__OK = 0                    - no error occurred\n
+ * QLIB_STATUS__(ERROR)                   - Same errors as @ref QLIB_Write in standard mode, write combining stays enabled
+************************************************************************************************************/
+QLIB_STATUS_T QLIB_WriteCombine_Disable(QLIB_CONTEXT_T* qlibContext);
+
+/************************************************************************************************************
+ * @brief       This function programs the data buffered by write combining
+ *
+ * @param       qlibContext   [QLIB internal state](md_definitions.html#DEF_CONTEXT)
+ *
+ * @return
+ * QLIB_STATUS__OK = 0                    - no error occurred\n
+ * QLIB_STATUS__(ERROR)                   - Same errors as @ref QLIB_Write in standard mode
+************************************************************************************************************/
+QLIB_STATUS_T QLIB_WriteCombine_Flush(QLIB_CONTEXT_T* qlibContext);
+
+/************************************************************************************************************
+ * @brief       This function programs the data buffered by write combining if its timeout expired.
+ *              Call it periodically when writes may stop for a long time
+ *
+ * @param       qlibContext   [QLIB internal state](md_definitions.html#DEF_CONTEXT)
+ *
+ * @return
+ * QLIB_STATUS__OK = 0                    - no error occurred\n
+ * QLIB_STATUS__(ERROR)                   - Same errors as @ref QLIB_Write in standard mode
+************************************************************************************************************/
+QLIB_STATUS_T QLIB_WriteCombine_Poll(QLIB_CONTEXT_T* qlibContext);
+
 /************************************************************************************************************
  * @brief       This function writes data to the flash
  *
@@ -598,6 +822,44 @@ QLIB_STATUS_T QLIB_Read(QLIB_CONTEXT_T* qlibContext, U8* buf, U32 sectionID, U32
 ************************************************************************************************************/
 QLIB_STATUS_T QLIB_Write(QLIB_CONTEXT_T* qlibContext, const U8* buf, U32 sectionID, U32 offset, U32 size, BOOL secure);
 
+/************************************************************************************************************
+ * @brief       This function writes data to the flash, skipping the work that is not needed
+ *
+ * The flash content is compared to @p buf first. Full pages are compared by CRC, calculated by the flash
+ * with @ref QLIB_MemCRCMap for standard access if supported, so the data is not read back:\n
+ * QLIB_WRITE_MODE__PROGRAM       - all the data is programmed, same as @ref QLIB_Write\n
+ * QLIB_WRITE_MODE__CHANGED_PAGES - only pages that differ from the flash content are programmed.
+ *                                  The target must be erased as with @ref QLIB_Write\n
+ * QLIB_WRITE_MODE__DIRTY_SECTORS - identical sectors are skipped. Other sectors are erased unless they are
+ *                                  already erased, then the pages that are not erased in @p buf are
+ *                                  programmed. @p offset and @p size must be aligned to FLASH_SECTOR_SIZE\n
+ * If plain access is needed and it is not opened, it will be opened automatically by this routine.
+ *
+ * @param[out]  qlibContext   [QLIB internal state](md_definitions.html#DEF_CONTEXT)
+ * @param[in]   buf           The data to write
+ * @param[in]   sectionID     [Section index](md_definitions.html#DEF_SECTION)
+ * @param[in]   offset        [Section offset](md_definitions.html#DEF_OFFSET)
+ * @param[in]   size          [Size](md_definitions.html#DEF_SIZE)
+ * @param[in]   secure        If TRUE then secure access, else standard access.
+ * @param[in]   mode          Write mode
+ * @param[out]  pagesSkipped  Number of pages that were not programmed. Can be NULL
+ *
+ * @return
+ * QLIB_STATUS__OK = 0                    - no error occurred\n
+ * QLIB_STATUS__INVALID_PARAMETER         - @p qlibContext or @p buf is NULL\n
+ * QLIB_STATUS__INVALID_PARAMETER         - @p mode is invalid\n
+ * QLIB_STATUS__INVALID_DATA_ALIGNMENT    - @p offset or @p size is not aligned to sector size in QLIB_WRITE_MODE__DIRTY_SECTORS mode\n
+ * QLIB_STATUS__(ERROR)                   - Error returned by @ref QLIB_Read, @ref QLIB_Write or @ref QLIB_Erase
+************************************************************************************************************/
+QLIB_STATUS_T QLIB_WriteWithMode(QLIB_CONTEXT_T*   qlibContext,
+                                 const U8*         buf,
+                                 U32               sectionID,
+                                 U32               offset,
+                                 U32               size,
+                                 BOOL              secure,
+                                 QLIB_WRITE_MODE_T mode,
+                                 U32*              pagesSkipped);
+
 /************************************************************************************************************
  * @brief       This function erases the given memory range.
  *
@@ -659,6 +921,119 @@ QLIB_STATUS_T QLIB_Erase(QLIB_CONTEXT_T* qlibContext, U32 sectionID, U32 offset,
 ************************************************************************************************************/
 QLIB_STATUS_T QLIB_EraseSection(QLIB_CONTEXT_T* qlibContext, U32 sectionID, BOOL secure);
 
+/************************************************************************************************************
+ * @brief       This function erases a set of memory ranges in minimal time.
+ *
+ * The ranges are sorted and coalesced, and each range is erased with the erase commands that take the
+ * least time according to the erase cost model. A range that covers a full section is erased using
+ * @ref QLIB_EraseSection when it is not slower. The cost model starts with typical erase times and
+ * can be calibrated with measured timings using @ref QLIB_CalibrateEraseTime.\n
+ * Each range follows the restrictions of @ref QLIB_Erase.
+ *
+ * @param[out]     qlibContext   [QLIB internal state](md_definitions.html#DEF_CONTEXT)
+ * @param[in,out]  ranges        Ranges to erase. The array is sorted and coalesced in place
+ * @param[in]      numRanges     Number of ranges
+ * @param[in]      secure        If TRUE then secure erase, else standard erase.
+ *
+ * @return
+ * QLIB_STATUS__OK = 0                    - no error occurred\n
+ * QLIB_STATUS__INVALID_PARAMETER         - @p qlibContext or @p ranges is NULL\n
+ * QLIB_STATUS__INVALID_PARAMETER         - Section index of a range is invalid\n
+ * QLIB_STATUS__PARAMETER_OUT_OF_RANGE    - @p numRanges is 0 or size of a range is 0\n
+ * QLIB_STATUS__(ERROR)                   - Error returned by @ref QLIB_Erase or @ref QLIB_EraseSection
+************************************************************************************************************/
+QLIB_STATUS_T QLIB_EraseRanges(QLIB_CONTEXT_T* qlibContext, QLIB_ERASE_RANGE_T* ranges, U32 numRanges, BOOL secure);
+
+/************************************************************************************************************
+ * @brief       This function calibrates the erase cost model with a measured erase time.
+ *
+ * The first measurement of an erase type replaces its typical time, next measurements are averaged.
+ *
+ * @param[out]  qlibContext   [QLIB internal state](md_definitions.html#DEF_CONTEXT)
+ * @param[in]   eraseType     Measured erase type: QLIB_ERASE_SECTOR_4K, QLIB_ERASE_BLOCK_32K, QLIB_ERASE_BLOCK_64K or QLIB_ERASE_SECTION
+ * @param[in]   size          Size of the erased section, used only with QLIB_ERASE_SECTION
+ * @param[in]   timeUs        Measured erase time in microseconds
+ *
+ * @return
+ * QLIB_STATUS__OK = 0                    - no error occurred\n
+ * QLIB_STATUS__INVALID_PARAMETER         - @p qlibContext is NULL or @p eraseType is invalid\n
+ * QLIB_STATUS__PARAMETER_OUT_OF_RANGE    - @p timeUs is 0\n
+ * QLIB_STATUS__INVALID_DATA_SIZE         - @p size is smaller than 64KB with QLIB_ERASE_SECTION
+************************************************************************************************************/
+QLIB_STATUS_T QLIB_CalibrateEraseTime(QLIB_CONTEXT_T* qlibContext, QLIB_ERASE_T eraseType, U32 size, U32 timeUs);
+
+/************************************************************************************************************
+ * @brief       This function starts a background standard erase.
+ *
+ * The range is erased by non-blocking erase commands, selected as in @ref QLIB_EraseRanges. The erase
+ * progresses by calling @ref QLIB_BgErase_Poll, and reads can be served during the erase with
+ * @ref QLIB_BgErase_Read. Standard reads with @ref QLIB_Read are served the same way. No other flash
+ * access is allowed until the background erase is done.
+ * If plain access is needed and it is not opened, it will be opened automatically by this routine.
+ *
+ * @param[out]  bgErase       Background erase state
+ * @param[in]   qlibContext   [QLIB internal state](md_definitions.html#DEF_CONTEXT)
+ * @param[in]   policy        Read scheduling policy
+ * @param[in]   getTimeUs     Time source in microseconds
+ * @param[in]   sleepUs       Sleep function in microseconds, called while a read waits for the flash
+ * @param[in]   sectionID     [Section index](md_definitions.html#DEF_SECTION)
+ * @param[in]   offset        [Section offset](md_definitions.html#DEF_OFFSET). The offset must be aligned to FLASH_SECTOR_SIZE.
+ * @param[in]   size          [Size](md_definitions.html#DEF_SIZE). The size must be aligned to FLASH_SECTOR_SIZE.
+ *
+ * @return
+ * QLIB_STATUS__OK = 0                    - no error occurred\n
+ * QLIB_STATUS__INVALID_PARAMETER         - @p bgErase, @p qlibContext, @p policy, @p getTimeUs or @p sleepUs is NULL\n
+ * QLIB_STATUS__INVALID_DATA_ALIGNMENT    - @p offset or @p size is not aligned to sector size\n
+ * QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE - Flash device was not initialized, or an operation is suspended\n
+ * QLIB_STATUS__(ERROR)                   - Other error, as in @ref QLIB_Erase
+************************************************************************************************************/
+QLIB_STATUS_T QLIB_BgErase_Start(QLIB_BG_ERASE_T*              bgErase,
+                                 QLIB_CONTEXT_T*               qlibContext,
+                                 const QLIB_BG_ERASE_POLICY_T* policy,
+                                 QLIB_TIME_US_FUNC_T           getTimeUs,
+                                 QLIB_SLEEP_US_FUNC_T          sleepUs,
+                                 U32                           sectionID,
+                                 U32                           offset,
+                                 U32                           size);
+
+/************************************************************************************************************
+ * @brief       This function progresses a background erase. It never waits for the flash.
+ *
+ * @param[in,out]  bgErase    Background erase state
+ * @param[out]     done       TRUE if the whole range is erased. Can be NULL
+ *
+ * @return
+ * QLIB_STATUS__OK = 0                    - no error occurred\n
+ * QLIB_STATUS__INVALID_PARAMETER         - @p bgErase is NULL\n
+ * QLIB_STATUS__(ERROR)                   - Erase command failed or other error
+************************************************************************************************************/
+QLIB_STATUS_T QLIB_BgErase_Poll(QLIB_BG_ERASE_T* bgErase, BOOL* done);
+
+/************************************************************************************************************
+ * @brief       This function performs a standard read during a background erase.
+ *
+ * If an erase command is in progress, it is suspended for the read and resumed afterwards, as long as
+ * the policy allows: the erase ran at least minEraseRunUs since it was started or resumed, and it was
+ * suspended less than maxSuspends times. Data of the erase command in progress can not be read while
+ * it is suspended, so such reads wait for the command to complete. A read waits at most maxReadWaitUs, or
+ * without limit if maxReadWaitUs is 0. While waiting, the flash is polled every QLIB_BG_ERASE_POLL_US and the
+ * sleep function of @ref QLIB_BgErase_Start is called in between.\n
+ * Plain read access to the section must be granted before the background erase starts.
+ *
+ * @param[in,out]  bgErase    Background erase state
+ * @param[out]     buf        Output buffer to read the data to
+ * @param[in]      sectionID  [Section index](md_definitions.html#DEF_SECTION)
+ * @param[in]      offset     [Section offset](md_definitions.html#DEF_OFFSET)
+ * @param[in]      size       [Size](md_definitions.html#DEF_SIZE)
+ *
+ * @return
+ * QLIB_STATUS__OK = 0                    - no error occurred\n
+ * QLIB_STATUS__INVALID_PARAMETER         - @p bgErase is NULL\n
+ * QLIB_STATUS__DEVICE_BUSY               - the read waited for maxReadWaitUs\n
+ * QLIB_STATUS__(ERROR)                   - Other error, as in @ref QLIB_Read
+************************************************************************************************************/
+QLIB_STATUS_T QLIB_BgErase_Read(QLIB_BG_ERASE_T* bgErase, U8* buf, U32 sectionID, U32 offset, U32 size);
+
 /************************************************************************************************************
  * @brief       This function suspends an ongoing erase or write operations.
  *
@@ -817,6 +1192,39 @@ QLIB_STATUS_T QLIB_GetDeviceConfig(QLIB_CONTEXT_T*       qlibContext,
 ************************************************************************************************************/
 QLIB_STATUS_T QLIB_CheckIntegrity(QLIB_CONTEXT_T* qlibContext, U32 sectionID, QLIB_INTEGRITY_T integrityType);
 
+/************************************************************************************************************
+ * @brief       This function forces an integrity check on several sections.
+ *              All section policies are read first, then the checks are issued back to back so the flash
+ *              does not wait for the host between sections. All sections in @p sectionMask must be
+ *              configured for @p integrityType. A failing section does not stop the check of the following ones.
+ *              A digest check on a flash without VER_INTG digest support uses signed CALC_SIG commands,
+ *              which are issued one section at a time
+ *
+ * @param[out]  qlibContext     [QLIB internal state](md_definitions.html#DEF_CONTEXT)
+ * @param[in]   sectionMask     Bit mask of [section indexes](md_definitions.html#DEF_SECTION) to check
+ * @param[in]   integrityType   The integrity type to perform. Integrity type should be in range of enumeration QLIB_INTEGRITY_T.
+ * @param[out]  checkedMask     Bit mask of the sections checked
+ * @param[out]  failedMask      Bit mask of the sections that failed the check
+ *
+ * @return
+ * QLIB_STATUS__OK = 0                    - no error occurred\n
+ * QLIB_STATUS__INVALID_PARAMETER         - @p qlibContext, @p checkedMask or @p failedMask is NULL\n
+ * QLIB_STATUS__INVALID_PARAMETER         - @p sectionMask contains an invalid section\n
+ * QLIB_STATUS__INVALID_PARAMETER         - @p integrityType is invalid\n
+ * QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE - Flash device was not initialized. use @ref QLIB_InitDevice or @ref QLIB_ImportState \n
+ * QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE - A section in @p sectionMask is not configured for @p integrityType\n
+ * QLIB_STATUS__DEVICE_SESSION_ERR        - Session is closed. Need to open session using @ref QLIB_OpenSession
+ * QLIB_STATUS__NOT_CONNECTED             - Need to perform connect using @ref QLIB_Connect function\n
+ * QLIB_STATUS__DEVICE_INTEGRITY_ERR      - CRC or digest of a section in @p failedMask is incorrect\n
+ * QLIB_STATUS__SECURITY_ERR              - Digest of a section in @p failedMask is incorrect, checked by the host\n
+ * QLIB_STATUS__(ERROR)                   - Other error
+************************************************************************************************************/
+QLIB_STATUS_T QLIB_CheckIntegrityAll(QLIB_CONTEXT_T*  qlibContext,
+                                     U32              sectionMask,
+                                     QLIB_INTEGRITY_T integrityType,
+                                     U32*             checkedMask,
+                                     U32*             failedMask);
+
 /************************************************************************************************************
  * @brief       This function calculates the CDI value.
  *
@@ -840,6 +1248,35 @@ QLIB_STATUS_T QLIB_CheckIntegrity(QLIB_CONTEXT_T* qlibContext, U32 sectionID, QL
 ************************************************************************************************************/
 QLIB_STATUS_T QLIB_CalcCDI(QLIB_CONTEXT_T* qlibContext, _256BIT nextCdi, const _256BIT prevCdi, U32 sectionId);
 
+/************************************************************************************************************
+ * @brief       This function calculates the CDI values of a chain of modules, typically on measured boot.
+ *
+ * Same as calling @ref QLIB_CalcCDI for every section in @p sectionIds, passing the CDI of each module as
+ * the previous CDI of the next one. The device commands of all the modules run back to back, and the
+ * chain is hashed on the host once they complete.\n
+ * If the chain starts with section 0, its CDI is calculated by the device and @p prevCdi is not used.
+ * Section 0 can not appear anywhere else in the chain.
+ *
+ * @param[out]  qlibContext     [QLIB internal state](md_definitions.html#DEF_CONTEXT)
+ * @param[out]  cdis            Array of @p num CDI values, CDI value produced by every module
+ * @param[in]   prevCdi         CDI value obtained from the module before the chain
+ * @param[in]   sectionIds      Section numbers of the modules, in chain order
+ * @param[in]   num             Number of modules
+ *
+ * @return
+ * QLIB_STATUS__OK = 0                    - no error occurred\n
+ * QLIB_STATUS__INVALID_PARAMETER         - @p qlibContext, @p cdis or @p sectionIds is NULL\n
+ * QLIB_STATUS__INVALID_PARAMETER         - @p num or a section number is invalid\n
+ * QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE - Flash device was not initialized. use @ref QLIB_InitDevice or @ref QLIB_ImportState \n
+ * QLIB_STATUS__DEVICE_SESSION_ERR        - Session is closed. Need to open session using @ref QLIB_OpenSession
+ * QLIB_STATUS__(ERROR)                   - Other error
+************************************************************************************************************/
+QLIB_STATUS_T QLIB_CalcCDIChain(QLIB_CONTEXT_T* qlibContext,
+                                _256BIT*        cdis,
+                                const _256BIT   prevCdi,
+                                const U32*      sectionIds,
+                                U32             num);
+
 /************************************************************************************************************
  * @brief       This function configures the Secure Watchdog.
  *
@@ -1066,6 +1503,27 @@ QLIB_STATUS_T QLIB_GetVersion(QLIB_SW_VERSION_T* versionInfo);
  * QLIB_STATUS__(ERROR)                   - Other error
 ************************************************************************************************************/
 QLIB_STATUS_T QLIB_SetActiveDie(QLIB_CONTEXT_T* qlibContext, U8 die);
+
+/************************************************************************************************************
+ * @brief       This function performs standard erase and write operations on several dies in parallel
+ *
+ * Operations of the same die are performed in order. Operations of different dies are interleaved, while
+ * one die is busy with a page program or an erase command, the commands of the other dies are issued.
+ * The busy state of each die is tracked in its die state. The active die is restored when done.\n
+ * If QLIB_SUPPORT_XIP is defined, every command is waited for, so the dies are not interleaved.
+ *
+ * @param       qlibContext   [QLIB internal state](md_definitions.html#DEF_CONTEXT)
+ * @param[in]   ops           Operations to perform
+ * @param[in]   numOps        Number of operations
+ *
+ * @return
+ * QLIB_STATUS__OK = 0                    - no error occurred\n
+ * QLIB_STATUS__INVALID_PARAMETER         - invalid operation type, die, section or data pointer\n
+ * QLIB_STATUS__INVALID_DATA_ALIGNMENT    - erase range is not sector aligned\n
+ * QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE - Flash device was not initialized or is suspended\n
+ * QLIB_STATUS__(ERROR)                   - Other error
+************************************************************************************************************/
+QLIB_STATUS_T QLIB_RunDieOperations(QLIB_CONTEXT_T* qlibContext, const QLIB_DIE_OP_T* ops, U32 numOps);
 #endif
 
 /************************************************************************************************************
@@ -1150,6 +1608,42 @@ QLIB_STATUS_T QLIB_Sign(QLIB_CONTEXT_T* qlibContext, U32 sectionID, U8* dataIn,
 ************************************************************************************************************/
 QLIB_STATUS_T QLIB_Verify(QLIB_CONTEXT_T* qlibContext, U32 sectionID, U8* dataIn, U32 dataSize, const _256BIT signature);
 
+/************************************************************************************************************
+ * @brief       This function signs the SHA-256 digest of the given data using given section keys.
+ *              The digest is calculated by the host, so the number of flash commands does not depend on
+ *              the data size. The signature differs from the one of @ref QLIB_Sign on the same data and is
+ *              verified by @ref QLIB_VerifyHashed
+ *
+ * @param[out]  qlibContext     [QLIB internal state](md_definitions.html#DEF_CONTEXT)
+ * @param[in]   sectionID       [Section index](md_definitions.html#DEF_SECTION)
+ * @param[in]   dataIn          Input data
+ * @param[in]   dataSize        Input data size
+ * @param[out]  signature       Output signature
+ *
+ * @return
+ * QLIB_STATUS__OK = 0                    - No error occurred\n
+ * QLIB_STATUS__INVALID_PARAMETER         - @p dataIn is NULL or @p dataSize is zero\n
+ * QLIB_STATUS__(ERROR)                   - Same errors as @ref QLIB_Sign
+************************************************************************************************************/
+QLIB_STATUS_T QLIB_SignHashed(QLIB_CONTEXT_T* qlibContext, U32 sectionID, const U8* dataIn, U32 dataSize, _256BIT signature);
+
+/************************************************************************************************************
+ * @brief       This function verifies the signature, generated by @ref QLIB_SignHashed on a given data
+ *
+ * @param[out]  qlibContext     [QLIB internal state](md_definitions.html#DEF_CONTEXT)
+ * @param[in]   sectionID       [Section index](md_definitions.html#DEF_SECTION)
+ * @param[in]   dataIn          Input data
+ * @param[in]   dataSize        Input data size
+ * @param[in]   signature       Expected signature
+ *
+ * @return
+ * QLIB_STATUS__OK = 0                       - No error occurred\n
+ * QLIB_STATUS__INVALID_PARAMETER           - @p dataIn is NULL or @p dataSize is zero\n
+ * QLIB_STATUS__DEVICE_AUTHENTICATION_ERR    - Signature verification failed\n
+ * QLIB_STATUS__(ERROR)                      - Same errors as @ref QLIB_Verify
+************************************************************************************************************/
+QLIB_STATUS_T QLIB_VerifyHashed(QLIB_CONTEXT_T* qlibContext, U32 sectionID, const U8* dataIn, U32 dataSize, const _256BIT signature);
+
 #endif
 
 #ifndef EXCLUDE_LMS
@@ -1188,6 +1682,39 @@ QLIB_STATUS_T QLIB_SendLMSCommand(QLIB_CONTEXT_T* qlibContext, const U32* cmd, U
  * @return      QLIB_STATUS__OK on success or QLIB_STATUS__[ERROR] otherwise
 ************************************************************************************************************/
 QLIB_STATUS_T QLIB_MemCpy(QLIB_CONTEXT_T* qlibContext, U32 sectionID, U32 dest, U32 src, U32 size);
+
+/************************************************************************************************************
+ * @brief       This function copies a range of memory within a single section in chunks.
+ *
+ * The 32B aligned part of the range is copied by the device with MEM_COPY commands of up to @p chunkSize
+ * bytes, so the host is not blocked for the whole copy. Head and tail bytes that are not 32B aligned are
+ * copied with secure read and write. If @p dest and @p src do not have the same 32B alignment, the whole
+ * range is copied with secure read and write.\n
+ * As with @ref QLIB_MemCpy, the destination range must be erased and must not overlap the source range.\n
+ * @p progressFunc is called after every chunk, and cancels the copy by returning an error. The bytes
+ * copied before the cancellation are left in place.\n
+ * A session with full access to the section must be open.
+ *
+ * @param       qlibContext   QLIB state object
+ * @param       sectionID     Section index
+ * @param       dest          Starting address offset of destination memory range
+ * @param       src           Starting address offset of source memory range
+ * @param       size          Number of bytes to copy
+ * @param       chunkSize     Maximal size of a single MEM_COPY command. Note 32B granularity, 5 LS-bits ignored
+ * @param       progressFunc  Progress callback, or NULL
+ * @param       arg           Argument passed to @p progressFunc
+ *
+ * @return      QLIB_STATUS__OK on success, the status returned by @p progressFunc if the copy was cancelled,
+ *              QLIB_STATUS__PARAMETER_OUT_OF_RANGE if the ranges overlap, or QLIB_STATUS__[ERROR] otherwise
+************************************************************************************************************/
+QLIB_STATUS_T QLIB_MemCpyChunked(QLIB_CONTEXT_T*      qlibContext,
+                                 U32                  sectionID,
+                                 U32                  dest,
+                                 U32                  src,
+                                 U32                  size,
+                                 U32                  chunkSize,
+                                 QLIB_PROGRESS_FUNC_T progressFunc,
+                                 void*                arg);
 #endif
 #ifndef EXCLUDE_MEM_CRC
 /************************************************************************************************************
@@ -1208,6 +1735,31 @@ QLIB_STATUS_T QLIB_MemCpy(QLIB_CONTEXT_T* qlibContext, U32 sectionID, U32 dest,
  * QLIB_STATUS__(ERROR)                   - Other error
 ************************************************************************************************************/
 QLIB_STATUS_T QLIB_MemCRC(QLIB_CONTEXT_T* qlibContext, U32* crc32, U32 sectionID, U32 offset, U32 size);
+
+/************************************************************************************************************
+ * @brief       This function calculates a CRC map of a memory Section or part of it.
+ *
+ * The range is split to blocks of @p blockSize bytes, and entry i of @p crcMap is the CRC-32 checksum of
+ * block i, as returned by @ref QLIB_MemCRC for that block. The last block may be shorter.\n
+ * The MEM_CRC commands are pipelined, each block is calculated as soon as the previous checksum is returned.\n
+ * The map can be compared to a map of the expected image to find the blocks that differ without reading
+ * the data back.
+ *
+ * @param       qlibContext   QLIB state object
+ * @param       crcMap        Array of DIV_CEIL(size, blockSize) entries where the checksums will be stored
+ * @param       sectionID     Section index
+ * @param       offset        Starting offset of the memory section. Must be a multiple of 32B
+ * @param       size          Size of the memory section. Must be a multiple of 32B
+ * @param       blockSize     Size of a block. Must be a multiple of 32B
+ *
+ * @return      QLIB_STATUS__OK = 0       - no error occurred\n
+ * QLIB_STATUS__INVALID_PARAMETER         - @p qlibContext or @p crcMap is NULL\n
+ * QLIB_STATUS__INVALID_PARAMETER         - @p sectionID is invalid\n
+ * QLIB_STATUS__INVALID_PARAMETER         - @p size, @p offset or @p blockSize is invalid\n
+ * QLIB_STATUS__DEVICE_PRIVILEGE_ERR      - Section is defined without plain read access enabled\n
+ * QLIB_STATUS__(ERROR)                   - Other error
+************************************************************************************************************/
+QLIB_STATUS_T QLIB_MemCRCMap(QLIB_CONTEXT_T* qlibContext, U32* crcMap, U32 sectionID, U32 offset, U32 size, U32 blockSize);
 #endif
 #ifndef EXCLUDE_SECURE_LOG
 /************************************************************************************************************
@@ -1270,6 +1822,135 @@ QLIB_STATUS_T QLIB_SecureLogRead(QLIB_CONTEXT_T* qlibContext, U8* buf, U32* addr
  * QLIB_STATUS__(ERROR)                                             - Other error
 ************************************************************************************************************/
 QLIB_STATUS_T QLIB_SecureLogWrite(QLIB_CONTEXT_T* qlibContext, const U8* buf, U32 sectionID, U32 size, BOOL secure);
+
+/************************************************************************************************************
+ * @brief       This function starts reading the log from its head, see @ref QLIB_SecureLogIter_Next
+ *
+ * The entry at the head of the log and its address are read with @ref QLIB_SecureLogRead.
+ * The head address must point to an entry of the section.\n
+ *
+ * @param[out]  qlibContext   [QLIB internal state](md_definitions.html#DEF_CONTEXT)
+ * @param[out]  iter          Log iterator
+ * @param[in]   sectionID     [Section index](md_definitions.html#DEF_SECTION)
+ * @param[in]   secure        If TRUE then secure read, else standard read.
+ *
+ * @return
+ * QLIB_STATUS__OK = 0                    - no error occurred\n
+ * QLIB_STATUS__INVALID_PARAMETER         - @p qlibContext or @p iter is NULL\n
+ * QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE - Flash device was not initialized\n
+ * QLIB_STATUS__SECURITY_ERR              - The head address is not an entry of the section\n
+ * QLIB_STATUS__(ERROR)                   - Errors of @ref QLIB_SecureLogRead
+************************************************************************************************************/
+QLIB_STATUS_T QLIB_SecureLogIter_Start(QLIB_CONTEXT_T* qlibContext, QLIB_SECURE_LOG_ITER_T* iter, U32 sectionID, BOOL secure);
+
+/************************************************************************************************************
+ * @brief       This function returns the next log entries, from the newest to the oldest
+ *
+ * Up to @p maxEntries entries preceding the last returned one are read in bulk using @ref QLIB_Read,
+ * wrapping to the end of the section. The first call checks that the newest entry matches the head
+ * entry read by @ref QLIB_SecureLogIter_Start.
+ * With secure reads, every entry is read with an authenticated read and verified. The log entries have no
+ * integrity data of their own, so with standard reads only the head entry is verified.\n
+ * The iteration ends at the first erased (all 0xFF) entry, which was never written, or after all the
+ * entries of the section were returned.\n
+ *
+ * @param[out]  qlibContext   [QLIB internal state](md_definitions.html#DEF_CONTEXT)
+ * @param[in,out]  iter      Log iterator
+ * @param[out]  buf           Log entries, newest first
+ * @param[in]   maxEntries    Maximal number of entries to return, @p buf size is @p maxEntries * 16B
+ * @param[out]  numEntries    Number of entries returned, 0 at the end of the log
+ *
+ * @return
+ * QLIB_STATUS__OK = 0                    - no error occurred\n
+ * QLIB_STATUS__INVALID_PARAMETER         - @p iter, @p buf or @p numEntries is NULL\n
+ * QLIB_STATUS__SECURITY_ERR              - The newest entry does not match the head entry\n
+ * QLIB_STATUS__(ERROR)                   - Errors of @ref QLIB_Read
+************************************************************************************************************/
+QLIB_STATUS_T QLIB_SecureLogIter_Next(QLIB_CONTEXT_T*         qlibContext,
+                                      QLIB_SECURE_LOG_ITER_T* iter,
+                                      U8*                     buf,
+                                      U32                     maxEntries,
+                                      U32*                    numEntries);
+
+/************************************************************************************************************
+ * @brief       This function initializes a buffered secure log writer
+ *
+ * Entries appended with @ref QLIB_SecureLogWriter_Append are kept in @p buf and committed together by a
+ * single @ref QLIB_SecureLogWrite call, in one multi-transaction window and under the session open at
+ * commit time. A batch is committed when @p buf is full, or when the oldest pending entry waited for
+ * @p intervalUs and the writer is appended to or polled.\n
+ *
+ * @param[out]  writer        Secure log writer
+ * @param[in]   sectionID     [Section index](md_definitions.html#DEF_SECTION)
+ * @param[in]   secure        If TRUE then secure write, else standard write.
+ * @param[in]   buf           Buffer of the pending entries, @p maxEntries * 16B
+ * @param[in]   maxEntries    Maximal number of entries in a batch
+ * @param[in]   getTimeUs     Time source, NULL to commit only full batches and on flush
+ * @param[in]   intervalUs    Maximal time an entry is pending
+ *
+ * @return
+ * QLIB_STATUS__OK = 0                    - no error occurred\n
+ * QLIB_STATUS__INVALID_PARAMETER         - @p writer or @p buf is NULL, or @p maxEntries is 0\n
+ * QLIB_STATUS__INVALID_PARAMETER         - @p sectionID is invalid
+************************************************************************************************************/
+QLIB_STATUS_T QLIB_SecureLogWriter_Init(QLIB_SECURE_LOG_WRITER_T* writer,
+                                        U32                       sectionID,
+                                        BOOL                      secure,
+                                        U8*                       buf,
+                                        U32                       maxEntries,
+                                        QLIB_TIME_US_FUNC_T       getTimeUs,
+                                        U32                       intervalUs);
+
+/************************************************************************************************************
+ * @brief       This function appends entries to a secure log writer, committing the batch when needed
+ *
+ * A full batch is committed before more entries are added. If that commit fails, the remaining entries
+ * are not appended and @p appended tells how many were.\n
+ *
+ * @param[out]  qlibContext   [QLIB internal state](md_definitions.html#DEF_CONTEXT)
+ * @param[in,out]  writer     Secure log writer
+ * @param[in]   buf           The entries to append
+ * @param[in]   size          [Size](md_definitions.html#DEF_SIZE), a multiple of log entry size (16B)
+ * @param[out]  appended      Number of entries appended to the writer, also on error. Can be NULL
+ *
+ * @return
+ * QLIB_STATUS__OK = 0                    - no error occurred\n
+ * QLIB_STATUS__INVALID_PARAMETER         - @p qlibContext, @p writer or @p buf is NULL\n
+ * QLIB_STATUS__INVALID_DATA_SIZE         - @p size is not a multiple of log entry size (16B)\n
+ * QLIB_STATUS__(ERROR)                   - Errors of @ref QLIB_SecureLogWrite, the entries not written stay pending
+************************************************************************************************************/
+QLIB_STATUS_T QLIB_SecureLogWriter_Append(QLIB_CONTEXT_T*           qlibContext,
+                                          QLIB_SECURE_LOG_WRITER_T* writer,
+                                          const U8*                 buf,
+                                          U32                       size,
+                                          U32*                      appended);
+
+/************************************************************************************************************
+ * @brief       This function commits the pending entries of a secure log writer
+ *
+ * @param[out]  qlibContext   [QLIB internal state](md_definitions.html#DEF_CONTEXT)
+ * @param[in,out]  writer     Secure log writer
+ *
+ * @return
+ * QLIB_STATUS__OK = 0                    - no error occurred\n
+ * QLIB_STATUS__INVALID_PARAMETER         - @p qlibContext or @p writer is NULL\n
+ * QLIB_STATUS__(ERROR)                   - Errors of @ref QLIB_SecureLogWrite, the entries not written stay pending
+************************************************************************************************************/
+QLIB_STATUS_T QLIB_SecureLogWriter_Flush(QLIB_CONTEXT_T* qlibContext, QLIB_SECURE_LOG_WRITER_T* writer);
+
+/************************************************************************************************************
+ * @brief       This function commits the pending entries of a secure log writer if the flush interval
+ *              expired. Should be called periodically when entries are appended irregularly
+ *
+ * @param[out]  qlibContext   [QLIB internal state](md_definitions.html#DEF_CONTEXT)
+ * @param[in,out]  writer     Secure log writer
+ *
+ * @return
+ * QLIB_STATUS__OK = 0                    - no error occurred\n
+ * QLIB_STATUS__INVALID_PARAMETER         - @p qlibContext or @p writer is NULL\n
+ * QLIB_STATUS__(ERROR)                   - Errors of @ref QLIB_SecureLogWrite, the entries not written stay pending
+************************************************************************************************************/
+QLIB_STATUS_T QLIB_SecureLogWriter_Poll(QLIB_CONTEXT_T* qlibContext, QLIB_SECURE_LOG_WRITER_T* writer);
 #endif
 
 #ifndef EXCLUDE_W77Q_RNG_FEATURE
@@ -1289,6 +1970,59 @@ QLIB_STATUS_T QLIB_SecureLogWrite(QLIB_CONTEXT_T* qlibContext, const U8* buf, U3
  * QLIB_STATUS__(ERROR)                   - Other error
 ************************************************************************************************************/
 QLIB_STATUS_T QLIB_GetRandom(QLIB_CONTEXT_T* qlibContext, U8* random, U32 randomSize);
+
+/************************************************************************************************************
+ * @brief       This function enables the entropy pool of @ref QLIB_GetRandom
+ *
+ * The pool is filled from the flash RNG in one batch, and @ref QLIB_GetRandom is then served from memory.
+ * The pool is refilled in the background by @ref QLIB_EntropyPool_Poll when fewer than @p lowLevel bytes
+ * are available, and by @ref QLIB_GetRandom only when it runs empty. Every byte is returned only once,
+ * and served bytes are cleared from the pool.\n
+ * Bytes are read with secure commands only if a session is open when the pool is refilled. Bytes read
+ * without a session are dropped, and the pool is refilled, on the first request made with a session open.
+ *
+ * @param       qlibContext   [QLIB internal state](md_definitions.html#DEF_CONTEXT)
+ * @param[out]  pool          Entropy pool object, must stay valid until @ref QLIB_EntropyPool_Disable
+ * @param[out]  buf           Buffer of the pool, must stay valid until @ref QLIB_EntropyPool_Disable
+ * @param[in]   size          Size of @p buf
+ * @param[in]   lowLevel      Number of available bytes below which @ref QLIB_EntropyPool_Poll refills the pool
+ *
+ * @return
+ * QLIB_STATUS__OK = 0                    - no error occurred\n
+ * QLIB_STATUS__INVALID_PARAMETER         - @p qlibContext, @p pool or @p buf is NULL, or @p size is zero\n
+ * QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE - Flash device was not initialized, or the pool is already enabled\n
+ * QLIB_STATUS__(ERROR)                   - Same errors as @ref QLIB_GetRandom, the pool is not enabled
+************************************************************************************************************/
+QLIB_STATUS_T QLIB_EntropyPool_Enable(QLIB_CONTEXT_T* qlibContext, QLIB_ENTROPY_POOL_T* pool, U8* buf, U32 size, U32 lowLevel);
+
+/************************************************************************************************************
+ * @brief       This function disables the entropy pool and clears its buffer
+ *
+ * @param       qlibContext   [QLIB internal state](md_definitions.html#DEF_CONTEXT)
+ *
+ * @return      QLIB_STATUS__OK if no error occurred, QLIB_STATUS__(ERROR) otherwise
+************************************************************************************************************/
+QLIB_STATUS_T QLIB_EntropyPool_Disable(QLIB_CONTEXT_T* qlibContext);
+
+/************************************************************************************************************
+ * @brief       This function refills the entropy pool if it is below its low level.
+ *              Call it periodically when the device is idle
+ *
+ * @param       qlibContext   [QLIB internal state](md_definitions.html#DEF_CONTEXT)
+ *
+ * @return      QLIB_STATUS__OK if no error occurred, QLIB_STATUS__(ERROR) otherwise
+************************************************************************************************************/
+QLIB_STATUS_T QLIB_EntropyPool_Poll(QLIB_CONTEXT_T* qlibContext);
+
+/************************************************************************************************************
+ * @brief       This function reseeds the PRNG used by the library (e.g. for the erase address masking)
+ *              with random bytes from @ref QLIB_GetRandom, so it is served from the entropy pool if enabled
+ *
+ * @param       qlibContext   [QLIB internal state](md_definitions.html#DEF_CONTEXT)
+ *
+ * @return      QLIB_STATUS__OK if no error occurred, QLIB_STATUS__(ERROR) otherwise
+************************************************************************************************************/
+QLIB_STATUS_T QLIB_EntropyPool_Reseed(QLIB_CONTEXT_T* qlibContext);
 #endif
 
 #if !defined EXCLUDE_LMS_ATTESTATION && !defined Q2_API
@@ -293,6 +293,7 @@ QLIB_STATUS_T QLIB_CMD_PROC__SFORMAT(QLIB_CONTEXT_T* qlibContext, BOOL modeReset
     U8 mode = 0;
     QLIB_SEC_CMD_FORMAT_MODE_SET(mode, modeReset, modeDefault, modeInit);
 
+    QLIB_SEC__SHADOW_INVALIDATE(qlibContext);
     QLIB_ASSERT_RET(QLIB_ACTIVE_DIE_STATE(qlibContext).keyMngr.kid == (QLIB_KID_T)QLIB_KID__DEVICE_MASTER,
                     QLIB_STATUS__COMMAND_IGNORED);
     QLIB_STATUS_RET_CHECK(QLIB_CMD_PROC__execute_signed_setter_L(qlibContext,
@@ -317,6 +318,7 @@ QLIB_STATUS_T QLIB_CMD_PROC__FORMAT(QLIB_CONTEXT_T* qlibContext, BOOL modeReset,
     U8  mode = 0;
     QLIB_SEC_CMD_FORMAT_MODE_SET(mode, modeReset, modeDefault, 0);
 
+    QLIB_SEC__SHADOW_INVALIDATE(qlibContext);
     QLIB_STATUS_RET_CHECK(QLIB_CMD_PROC_execute_sec_cmd_write(qlibContext,
                                                               QLIB_CMD_PROC__MAKE_CTAG_MODE(QLIB_CMD_SEC_FORMAT, mode),
                                                               &ver,
@@ -340,6 +342,8 @@ QLIB_STATUS_T QLIB_CMD_PROC__set_KEY(QLIB_CONTEXT_T* qlibContext, QLIB_KID_T kid
     /*-----------------------------------------------------------------------------------------------------*/
     U32 ctag = QLIB_CMD_PROC__MAKE_CTAG_PARAMS(QLIB_CMD_SEC_SET_KEY, kid, 0, 0);
 
+    QLIB_SEC__SHADOW_INVALIDATE(qlibContext);
+
     /*-----------------------------------------------------------------------------------------------------*/
     /* set key is never done on provisioning key id                                                        */
     /*-----------------------------------------------------------------------------------------------------*/
@@ -417,6 +421,7 @@ QLIB_STATUS_T QLIB_CMD_PROC__set_GMT(QLIB_CONTEXT_T* qlibContext, const GMT_T* p
     /* OP1, CTAG (32b), GMT (160b), SIG (64b)                                                              */
     /* CTAG = CMD (8b), 24'b0                                                                              */
     /*-----------------------------------------------------------------------------------------------------*/
+    QLIB_SEC__SHADOW_INVALIDATE(qlibContext);
     QLIB_ASSERT_RET(QLIB_ACTIVE_DIE_STATE(qlibContext).keyMngr.kid == (QLIB_KID_T)QLIB_KID__DEVICE_MASTER,
                     QLIB_STATUS__COMMAND_IGNORED);
     QLIB_STATUS_RET_CHECK(QLIB_CMD_PROC__execute_signed_setter_L(qlibContext,
@@ -522,6 +527,7 @@ QLIB_STATUS_T QLIB_CMD_PROC__set_SCRn(QLIB_CONTEXT_T* qlibContext, U32 sectionIn
 
     ctag = QLIB_CMD_PROC__MAKE_CTAG_PARAMS(QLIB_CMD_SEC_SET_SCR, (U8)sectionIndex, mode, 0);
 
+    QLIB_SEC__SHADOW_INVALIDATE(qlibContext);
     QLIB_ASSERT_RET(QLIB_ACTIVE_DIE_STATE(qlibContext).keyMngr.kid ==
                         QLIB_KEY_MNGR__KID_WITH_SECTION(QLIB_KID__FULL_ACCESS_SECTION, sectionIndex),
                     QLIB_STATUS__COMMAND_IGNORED);
@@ -560,6 +566,7 @@ QLIB_STATUS_T QLIB_CMD_PROC__set_SCRn_swap(QLIB_CONTEXT_T* qlibContext,
     QLIB_SEC_CMD_SET_SCR_MODE_SET(mode, reset, reload);
     ctag = QLIB_CMD_PROC__MAKE_CTAG_PARAMS(QLIB_CMD_SEC_SET_SCR_SWAP, (U8)sectionIndex, mode, 0);
 
+    QLIB_SEC__SHADOW_INVALIDATE(qlibContext);
     QLIB_ASSERT_RET(QLIB_ACTIVE_DIE_STATE(qlibContext).keyMngr.kid ==
                         QLIB_KEY_MNGR__KID_WITH_SECTION(QLIB_KID__FULL_ACCESS_SECTION, sectionIndex),
                     QLIB_STATUS__COMMAND_IGNORED);
@@ -635,6 +642,7 @@ QLIB_STATUS_T QLIB_CMD_PROC__get_RST_RESP(QLIB_CONTEXT_T* qlibContext, U32* RST_
 
 QLIB_STATUS_T QLIB_CMD_PROC__set_ACLR(QLIB_CONTEXT_T* qlibContext, ACLR_T ACLR)
 {
+    QLIB_SEC__SHADOW_INVALIDATE(qlibContext);
     QLIB_STATUS_RET_CHECK(
         QLIB_CMD_PROC_execute_sec_cmd_write(qlibContext, QLIB_CMD_PROC__MAKE_CTAG(QLIB_CMD_SEC_SET_ACLR), &ACLR, sizeof(ACLR_T)));
     QLIB_STATUS_RET_CHECK(QLIB_CMD_PROC__checkLastSsrErrors(qlibContext, SSR_MASK__ALL_ERRORS));
@@ -747,6 +755,8 @@ QLIB_STATUS_T QLIB_CMD_PROC__Session_Open(QLIB_CONTEXT_T* qlibContext,
     _64BIT          seed;
     QLIB_REG_ESSR_T essr;
 
+    QLIB_SEC__SHADOW_INVALIDATE_ACLR(qlibContext);
+
     /*-----------------------------------------------------------------------------------------------------*/
     /* OP1, CTAG (32b), NONCE (64b), SIG (64b)                                                             */
     /*-----------------------------------------------------------------------------------------------------*/
@@ -897,6 +907,7 @@ exit:
 
 QLIB_STATUS_T QLIB_CMD_PROC__Session_Close(QLIB_CONTEXT_T* qlibContext, QLIB_KID_T kid, BOOL revokePA)
 {
+    QLIB_SEC__SHADOW_INVALIDATE_ACLR(qlibContext);
     if (Q2_SESSION_CLOSE_NOT_SUPPORTED(qlibContext) == 0u)
     {
         return QLIB_CMD_PROC__Session_Close_L(qlibContext, kid, revokePA);
@@ -909,6 +920,7 @@ QLIB_STATUS_T QLIB_CMD_PROC__Session_Close(QLIB_CONTEXT_T* qlibContext, QLIB_KID
 
 QLIB_STATUS_T QLIB_CMD_PROC__init_section_PA(QLIB_CONTEXT_T* qlibContext, U32 sectionIndex)
 {
+    QLIB_SEC__SHADOW_INVALIDATE_ACLR(qlibContext);
     QLIB_STATUS_RET_CHECK(
         QLIB_CMD_PROC_execute_sec_cmd_only(qlibContext,
                                            QLIB_CMD_PROC__MAKE_CTAG_PARAMS(QLIB_CMD_SEC_INIT_SECTION_PA, sectionIndex, 0, 0)));
@@ -922,6 +934,7 @@ QLIB_STATUS_T QLIB_CMD_PROC__PA_grant_plain(QLIB_CONTEXT_T* qlibContext, U32 sec
      * OP1, CTAG (32b)
      * CTAG = CMD (8b), SID (8b), 16'b0
     ********************************************************************************************************/
+    QLIB_SEC__SHADOW_INVALIDATE_ACLR(qlibContext);
     QLIB_STATUS_RET_CHECK(
         QLIB_CMD_PROC_execute_sec_cmd_only(qlibContext,
                                            QLIB_CMD_PROC__MAKE_CTAG_PARAMS(QLIB_CMD_SEC_PA_GRANT_PLAIN, sectionIndex, 0, 0)));
@@ -961,6 +974,7 @@ QLIB_STATUS_T QLIB_CMD_PROC__PA_grant(QLIB_CONTEXT_T* qlibContext, QLIB_KID_T ki
     ********************************************************************************************************/
     QLIB_CRYPTO_SessionKeyAndSignature(key, ctag, mc, zeroNonce, qlibContext->wid, NULL, sig, NULL);
 
+    QLIB_SEC__SHADOW_INVALIDATE_ACLR(qlibContext);
     QLIB_STATUS_RET_CHECK(QLIB_CMD_PROC_execute_sec_cmd_write(qlibContext, ctag, sig, sizeof(_64BIT)));
     QLIB_STATUS_RET_CHECK(QLIB_CMD_PROC__checkLastSsrErrors(qlibContext, SSR_MASK__ALL_ERRORS));
     return QLIB_STATUS__OK;
@@ -968,6 +982,7 @@ QLIB_STATUS_T QLIB_CMD_PROC__PA_grant(QLIB_CONTEXT_T* qlibContext, QLIB_KID_T ki
 
 QLIB_STATUS_T QLIB_CMD_PROC__PA_revoke(QLIB_CONTEXT_T* qlibContext, U32 sectionIndex, QLIB_PA_REVOKE_TYPE_T revokeType)
 {
+    QLIB_SEC__SHADOW_INVALIDATE_ACLR(qlibContext);
     QLIB_STATUS_RET_CHECK(QLIB_CMD_PROC_execute_sec_cmd_only(qlibContext,
                                                              QLIB_CMD_PROC__MAKE_CTAG_PARAMS(QLIB_CMD_SEC_PA_REVOKE,
                                                                                              sectionIndex,
@@ -1028,6 +1043,76 @@ QLIB_STATUS_T QLIB_CMD_PROC__Check_Integrity(QLIB_CONTEXT_T* qlibContext, U32 se
     return QLIB_STATUS__OK;
 }
 
+QLIB_STATUS_T QLIB_CMD_PROC__Check_Integrity_Multi(QLIB_CONTEXT_T* qlibContext,
+                                                   const U32*      sectionIndex,
+                                                   U32             num,
+                                                   BOOL            verifyDigest,
+                                                   U32*            failedMask)
+{
+    QLIB_STATUS_T ret = QLIB_STATUS__OK;
+    U32           i;
+
+    *failedMask = 0;
+
+#ifdef QLIB_SUPPORT_XIP
+    for (i = 0; i < num; i++)
+    {
+        ret = QLIB_CMD_PROC__Check_Integrity(qlibContext, sectionIndex[i], verifyDigest);
+        QLIB_ASSERT_RET((QLIB_STATUS__OK == ret) || (QLIB_STATUS__DEVICE_INTEGRITY_ERR == ret), ret);
+        if (QLIB_STATUS__DEVICE_INTEGRITY_ERR == ret)
+        {
+            *failedMask |= (1u << sectionIndex[i]);
+        }
+    }
+#else
+    if (0u == num)
+    {
+        return QLIB_STATUS__OK;
+    }
+
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Start first check (non-blocking)                                                                    */
+    /*-----------------------------------------------------------------------------------------------------*/
+    QLIB_STATUS_RET_CHECK(QLIB_CMD_PROC__OP1_only(qlibContext,
+                                                  QLIB_CMD_PROC__MAKE_CTAG_PARAMS(QLIB_CMD_SEC_VER_INTG,
+                                                                                  sectionIndex[0],
+                                                                                  BOOLEAN_TO_INT(verifyDigest),
+                                                                                  0)));
+
+    for (i = 0; i < num; i++)
+    {
+        /*-------------------------------------------------------------------------------------------------*/
+        /* Wait while busy, the SSR of the completed check is kept in the context                          */
+        /*-------------------------------------------------------------------------------------------------*/
+        QLIB_STATUS_RET_CHECK(QLIB_CMD_PROC__OP0_busy_wait(qlibContext));
+
+        /*-------------------------------------------------------------------------------------------------*/
+        /* Errors are cleared before the next check is started, so they are not mixed with its result      */
+        /*-------------------------------------------------------------------------------------------------*/
+        if ((QLIB_GET_LAST_SEC_STATUS_FIELD(qlibContext) & SSR_MASK__ALL_ERRORS) != 0u)
+        {
+            ret = QLIB_CMD_PROC__checkLastSsrErrors(qlibContext, SSR_MASK__ALL_ERRORS);
+            QLIB_ASSERT_RET(QLIB_STATUS__DEVICE_INTEGRITY_ERR == ret, ret);
+            *failedMask |= (1u << sectionIndex[i]);
+        }
+
+        /*-------------------------------------------------------------------------------------------------*/
+        /* Start next check                                                                                */
+        /*-------------------------------------------------------------------------------------------------*/
+        if ((i + 1u) < num)
+        {
+            QLIB_STATUS_RET_CHECK(QLIB_CMD_PROC__OP1_only(qlibContext,
+                                                          QLIB_CMD_PROC__MAKE_CTAG_PARAMS(QLIB_CMD_SEC_VER_INTG,
+                                                                                          sectionIndex[i + 1u],
+                                                                                          BOOLEAN_TO_INT(verifyDigest),
+                                                                                          0)));
+        }
+    }
+#endif
+
+    return QLIB_STATUS__OK;
+}
+
 /*---------------------------------------------------------------------------------------------------------*/
 /*                                       Secure Transport Commands                                         */
 /*---------------------------------------------------------------------------------------------------------*/
@@ -1423,6 +1508,64 @@ QLIB_STATUS_T QLIB_CMD_PROC__SARD_Verify(QLIB_CONTEXT_T* qlibContext, U32 enc_ad
 
     return QLIB_STATUS__OK;
 }
+
+QLIB_STATUS_T QLIB_CMD_PROC__SARD_Sign_Multi(QLIB_CONTEXT_T* qlibContext, const U32* enc_addr, U32 num, U32* signatures)
+{
+#ifdef QLIB_SUPPORT_XIP
+    U32 i;
+
+    for (i = 0; i < num; i++)
+    {
+        QLIB_STATUS_RET_CHECK(QLIB_CMD_PROC__SARD_Sign(qlibContext, enc_addr[i], &signatures[2u * i]));
+    }
+
+    return QLIB_STATUS__OK;
+#else
+    QLIB_HASH_BUF_T dataOut;
+    QLIB_STATUS_T   ret = QLIB_STATUS__SECURITY_ERR;
+    U32             i;
+
+    if (0u == num)
+    {
+        return QLIB_STATUS__OK;
+    }
+
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Start first sign transaction (non-blocking)                                                         */
+    /*-----------------------------------------------------------------------------------------------------*/
+    QLIB_STATUS_RET_CHECK(QLIB_CMD_PROC__OP1_only(qlibContext, QLIB_CMD_PROC__MAKE_CTAG_ADDR(QLIB_CMD_SEC_SARD, enc_addr[0])));
+
+    for (i = 0; i < num; i++)
+    {
+        /*-------------------------------------------------------------------------------------------------*/
+        /* Wait while busy and read the signature                                                          */
+        /*-------------------------------------------------------------------------------------------------*/
+        ret = QLIB_CMD_PROC__OP0_busy_wait_OP2(qlibContext,
+                                               QLIB_HASH_BUF_GET__READ_PAGE(dataOut),
+                                               sizeof(U32) + QLIB_SEC_READ_PAGE_SIZE_BYTE + sizeof(_64BIT)); // TC + DATA + Signature
+
+        /*-------------------------------------------------------------------------------------------------*/
+        /* Start next command, the flash executes it while the signature is returned                       */
+        /*-------------------------------------------------------------------------------------------------*/
+        if ((i + 1u) < num)
+        {
+            QLIB_STATUS_RET_CHECK(
+                QLIB_CMD_PROC__OP1_only(qlibContext, QLIB_CMD_PROC__MAKE_CTAG_ADDR(QLIB_CMD_SEC_SARD, enc_addr[i + 1u])));
+        }
+
+        /*-------------------------------------------------------------------------------------------------*/
+        /* Check errors after starting new command                                                         */
+        /*-------------------------------------------------------------------------------------------------*/
+        QLIB_STATUS_RET_CHECK(QLIB_CMD_PROC__checkLastSsrErrors(qlibContext, SSR_MASK__ALL_ERRORS));
+        QLIB_STATUS_RET_CHECK(ret);
+
+        signatures[2u * i]      = QLIB_HASH_BUF_GET__READ_SIG(dataOut)[0];
+        signatures[2u * i + 1u] = QLIB_HASH_BUF_GET__READ_SIG(dataOut)[1];
+    }
+
+    return QLIB_STATUS__OK;
+#endif
+}
 #endif
 
 #ifndef QLIB_SUPPORT_XIP
@@ -1856,6 +1999,76 @@ QLIB_STATUS_T QLIB_CMD_PROC__MEM_CRC(QLIB_CONTEXT_T* qlibContext, U32 section, U
     return QLIB_STATUS__OK;
 }
 
+QLIB_STATUS_T QLIB_CMD_PROC__MEM_CRC_Multi(QLIB_CONTEXT_T* qlibContext, U32 section, U32 addr, U32 len, U32 blockSize, U32* crc)
+{
+    U32 num = DIV_CEIL(len, blockSize);
+    U32 i;
+#ifdef QLIB_SUPPORT_XIP
+    for (i = 0; i < num; i++)
+    {
+        QLIB_STATUS_RET_CHECK(QLIB_CMD_PROC__MEM_CRC(qlibContext,
+                                                     section,
+                                                     addr + (i * blockSize),
+                                                     MIN(blockSize, len - (i * blockSize)),
+                                                     &crc[i]));
+    }
+
+    return QLIB_STATUS__OK;
+#else
+    /********************************************************************************************************
+     * OP1, CTAG (32b), addr (32b), len (32b)
+     * OP2, <CRC (32b)>
+     * CTAG = CMD (8b), SID (8b), 16'b0
+     * CMD =  MEM_CRC (54h)
+    ********************************************************************************************************/
+    U32           buff[(sizeof(U32) + sizeof(U32)) / sizeof(U32)]; // address + length
+    U32           ctag     = QLIB_CMD_PROC__MAKE_CTAG_PARAMS(QLIB_CMD_SEC_MEM_CRC, (U8)section, 0, 0);
+    U32           blockLen = MIN(blockSize, len);
+    QLIB_STATUS_T ret      = QLIB_STATUS__SECURITY_ERR;
+
+    if (0u == num)
+    {
+        return QLIB_STATUS__OK;
+    }
+
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Start first CRC calculation (non-blocking)                                                          */
+    /*-----------------------------------------------------------------------------------------------------*/
+    (void)memcpy(&buff[0], &addr, sizeof(U32));
+    (void)memcpy(&buff[1], &blockLen, sizeof(U32));
+    QLIB_STATUS_RET_CHECK(QLIB_CMD_PROC_execute_sec_cmd(qlibContext, ctag, buff, sizeof(buff), NULL, 0, NULL));
+
+    for (i = 0; i < num; i++)
+    {
+        /*-------------------------------------------------------------------------------------------------*/
+        /* Wait while busy and read the CRC                                                                */
+        /*-------------------------------------------------------------------------------------------------*/
+        ret = QLIB_CMD_PROC__OP0_busy_wait_OP2(qlibContext, &crc[i], sizeof(U32));
+
+        /*-------------------------------------------------------------------------------------------------*/
+        /* Start next command, the flash calculates the next block while the CRC is checked                */
+        /*-------------------------------------------------------------------------------------------------*/
+        if ((i + 1u) < num)
+        {
+            U32 blockAddr = addr + ((i + 1u) * blockSize);
+
+            blockLen = MIN(blockSize, len - ((i + 1u) * blockSize));
+            (void)memcpy(&buff[0], &blockAddr, sizeof(U32));
+            (void)memcpy(&buff[1], &blockLen, sizeof(U32));
+            QLIB_STATUS_RET_CHECK(QLIB_CMD_PROC_execute_sec_cmd(qlibContext, ctag, buff, sizeof(buff), NULL, 0, NULL));
+        }
+
+        /*-------------------------------------------------------------------------------------------------*/
+        /* Check errors after starting new command                                                         */
+        /*-------------------------------------------------------------------------------------------------*/
+        QLIB_STATUS_RET_CHECK(QLIB_CMD_PROC__checkLastSsrErrors(qlibContext, SSR_MASK__ALL_ERRORS));
+        QLIB_STATUS_RET_CHECK(ret);
+    }
+
+    return QLIB_STATUS__OK;
+#endif
+}
+
 QLIB_STATUS_T QLIB_CMD_PROC__SERASE(QLIB_CONTEXT_T* qlibContext, QLIB_ERASE_T type, U32 addr)
 {
     QLIB_STATUS_T status = QLIB_STATUS__OK;
@@ -1987,6 +2200,8 @@ QLIB_STATUS_T QLIB_CMD_PROC__LMS_execute(QLIB_CONTEXT_T* qlibContext,
         ctag = ctag | QLIB_TM_CTAG_SCR_NEED_GRANT_PA_MASK;
     }
 
+    // the executed command may change the configuration, and the transaction layer may grant plain access
+    QLIB_SEC__SHADOW_INVALIDATE(qlibContext);
     QLIB_STATUS_RET_CHECK(QLIB_CMD_PROC_execute_sec_cmd_write(qlibContext, ctag, digest, sizeof(_64BIT)));
 
     QLIB_STATUS_RET_CHECK(QLIB_CMD_PROC__checkLastSsrErrors(qlibContext, SSR_MASK__ALL_ERRORS));
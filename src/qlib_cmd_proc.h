@@ -591,6 +591,24 @@ QLIB_STATUS_T QLIB_CMD_PROC__CALC_CDI(QLIB_CONTEXT_T* qlibContext, U32 mode, _25
 ************************************************************************************************************/
 QLIB_STATUS_T QLIB_CMD_PROC__Check_Integrity(QLIB_CONTEXT_T* qlibContext, U32 sectionIndex, BOOL verifyDigest);
 
+/************************************************************************************************************
+ * @brief       This routine forces integrity check on several sections. Each check is started as soon as
+ *              the previous one completes, integrity errors are collected and do not stop the sequence
+ *
+ * @param[in,out]   qlibContext    Context
+ * @param[in]       sectionIndex   Section indexes
+ * @param[in]       num            Number of sections
+ * @param[in]       verifyDigest   TRUE to verify digest, FALSE for CRC
+ * @param[out]      failedMask     Bit mask of the sections that failed the check
+ *
+ * @return      QLIB_STATUS__OK on success or QLIB_STATUS__[ERROR] otherwise
+************************************************************************************************************/
+QLIB_STATUS_T QLIB_CMD_PROC__Check_Integrity_Multi(QLIB_CONTEXT_T* qlibContext,
+                                                   const U32*      sectionIndex,
+                                                   U32             num,
+                                                   BOOL            verifyDigest,
+                                                   U32*            failedMask);
+
 /*---------------------------------------------------------------------------------------------------------*/
 /*                                        SECURE TRANSPORT COMMANDS                                        */
 /*---------------------------------------------------------------------------------------------------------*/
@@ -702,6 +720,19 @@ QLIB_STATUS_T QLIB_CMD_PROC__SARD_Sign(QLIB_CONTEXT_T* qlibContext, U32 enc_addr
  * @return      QLIB_STATUS__OK on success or QLIB_STATUS__[ERROR] otherwise
 ************************************************************************************************************/
 QLIB_STATUS_T QLIB_CMD_PROC__SARD_Verify(QLIB_CONTEXT_T* qlibContext, U32 enc_addr, _64BIT signature);
+
+/************************************************************************************************************
+ * @brief   This function sends several raw encrypted addresses and collects their signatures.
+ *          Each command is started before the signature of the previous one is processed
+ *
+ * @param[in,out]   qlibContext   Context
+ * @param[in]       enc_addr      Encrypted addresses
+ * @param[in]       num           Number of addresses
+ * @param[out]      signatures    Output signatures, 64 bits per address
+ *
+ * @return      QLIB_STATUS__OK on success or QLIB_STATUS__[ERROR] otherwise
+************************************************************************************************************/
+QLIB_STATUS_T QLIB_CMD_PROC__SARD_Sign_Multi(QLIB_CONTEXT_T* qlibContext, const U32* enc_addr, U32 num, U32* signatures);
 #endif
 
 #ifndef QLIB_SUPPORT_XIP
@@ -798,6 +829,21 @@ QLIB_STATUS_T QLIB_CMD_PROC__LOG_PWR(QLIB_CONTEXT_T* qlibContext, U32 section, U
 ************************************************************************************************************/
 QLIB_STATUS_T QLIB_CMD_PROC__MEM_CRC(QLIB_CONTEXT_T* qlibContext, U32 section, U32 addr, U32 len, U32* crc);
 
+/************************************************************************************************************
+ * @brief       This routine calculates the CRC-32 checksum of every block of a memory section part.
+ *              The calculation of each block is started as soon as the previous CRC is returned
+ *
+ * @param[in,out]   qlibContext   Context
+ * @param[in]       section       Section number
+ * @param[in]       addr          Address
+ * @param[in]       len           Length of the memory range
+ * @param[in]       blockSize     Size of a block, the last block may be shorter
+ * @param[out]      crc           Calculated CRC of every block
+ *
+ * @return      QLIB_STATUS__OK on success or QLIB_STATUS__[ERROR] otherwise
+************************************************************************************************************/
+QLIB_STATUS_T QLIB_CMD_PROC__MEM_CRC_Multi(QLIB_CONTEXT_T* qlibContext, U32 section, U32 addr, U32 len, U32 blockSize, U32* crc);
+
 /************************************************************************************************************
  * @brief       This routine performs all kind of secure erase commands
  *
@@ -18,6 +18,14 @@
 /*---------------------------------------------------------------------------------------------------------*/
 #include "qlib.h"
 
+// CRC-32 of a single 32-bit word, by bit. This is the CRC calculated by the flash MEM_CRC command
+static const U32 QLIB_COMMON_CrcTable[] = {
+    0xb8bc6765u, 0xaa09c88bu, 0x8f629757u, 0xc5b428efu, 0x5019579fu, 0xa032af3eu, 0x9b14583du, 0xed59b63bu,
+    0x01c26a37u, 0x0384d46eu, 0x0709a8dcu, 0x0e1351b8u, 0x1c26a370u, 0x384d46e0u, 0x709a8dc0u, 0xe1351b80u,
+    0x191b3141u, 0x32366282u, 0x646cc504u, 0xc8d98a08u, 0x4ac21251u, 0x958424a2u, 0xf0794f05u, 0x3b83984bu,
+    0x77073096u, 0xee0e612cu, 0x076dc419u, 0x0edb8832u, 0x1db71064u, 0x3b6e20c8u, 0x76dc4190u, 0xedb88320u,
+};
+
 #ifdef Q2_API
 QLIB_STATUS_T QLIB_HASH(U32* output, const void* data, U32 dataSize)
 {
@@ -88,3 +96,71 @@ QLIB_STATUS_T QLIB_HASH_Async_WaitWhileBusy(QLIB_CONTEXT_T* qlibContext)
 }
 #endif // QLIB_HASH_OPTIMIZATION_ENABLED
 #endif // Q2_API
+
+U32 QLIB_COMMON_GetEraseStep(const QLIB_CONTEXT_T* qlibContext, U32 offset, U32 size, QLIB_ERASE_T* eraseType)
+{
+    const U32* timeUs  = qlibContext->eraseCost.timeUs;
+    U64        time4K  = timeUs[QLIB_ERASE_COST_INDEX(QLIB_ERASE_SECTOR_4K)];
+    U64        time32K = timeUs[QLIB_ERASE_COST_INDEX(QLIB_ERASE_BLOCK_32K)];
+    U64        time64K = timeUs[QLIB_ERASE_COST_INDEX(QLIB_ERASE_BLOCK_64K)];
+
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Block sizes are nested, so a larger block is used only if it is not slower than its content erased  */
+    /* with the best smaller commands                                                                      */
+    /*-----------------------------------------------------------------------------------------------------*/
+    if ((_64KB_ <= size) && (0u == (offset % _64KB_)) && (time64K <= (2u * MIN(time32K, 8u * time4K))))
+    {
+        *eraseType = QLIB_ERASE_BLOCK_64K;
+        return _64KB_;
+    }
+
+    if ((_32KB_ <= size) && (0u == (offset % _32KB_)) && (time32K <= (8u * time4K)))
+    {
+        *eraseType = QLIB_ERASE_BLOCK_32K;
+        return _32KB_;
+    }
+
+    *eraseType = QLIB_ERASE_SECTOR_4K;
+    return FLASH_SECTOR_SIZE;
+}
+
+U32 QLIB_COMMON_CalcCRC(U32 crc, const U32* buf, U32 size)
+{
+    U32 res = crc ^ 0xFFFFFFFFu;
+    U32 x;
+    U32 i;
+    U32 j;
+
+    for (i = 0; i < (size / sizeof(U32)); i++)
+    {
+        x   = buf[i] ^ res;
+        res = 0;
+        for (j = 0; j < 32u; j++)
+        {
+            if ((x & 1u) == 1u)
+            {
+                res ^= QLIB_COMMON_CrcTable[j];
+            }
+            x >>= 1;
+        }
+    }
+
+    return res ^ 0xFFFFFFFFu;
+}
+
+U64 QLIB_COMMON_GetEraseTime(const QLIB_CONTEXT_T* qlibContext, U32 offset, U32 size)
+{
+    U64          time      = 0;
+    U32          eraseSize = 0;
+    QLIB_ERASE_T eraseType = QLIB_ERASE_FIRST;
+
+    while (size >= FLASH_SECTOR_SIZE)
+    {
+        eraseSize = QLIB_COMMON_GetEraseStep(qlibContext, offset, size, &eraseType);
+        time += qlibContext->eraseCost.timeUs[QLIB_ERASE_COST_INDEX(eraseType)];
+        offset += eraseSize;
+        size -= eraseSize;
+    }
+
+    return time;
+}
@@ -53,6 +53,10 @@ extern "C" {
 #error "QLIB must support direct flash access in order to support XIP"
 #endif
 
+#if defined QLIB_SUPPORT_XIP && defined QLIB_SPI_ASYNC_READ_ENABLED
+#error "QLIB_SPI_ASYNC_READ_ENABLED is not supported with XIP, the code runs from flash during the read"
+#endif
+
 #define QLIB_INIT_DIE_ID     0u
 #define QLIB_WATCHDOG_DIE_ID 0u
 
@@ -85,6 +89,42 @@ extern "C" {
                 : ((U32)sectionID == (U32)W77Q_BOOT_SECTION_FALLBACK ? (U32)W77Q_BOOT_SECTION : (U32)sectionID)) \
          : (sectionID))
 
+/************************************************************************************************************
+ * Typical erase times in microseconds, used by the erase planner until calibrated with measured timings
+************************************************************************************************************/
+#ifndef QLIB_ERASE_TIME_US__SECTOR_4K
+#define QLIB_ERASE_TIME_US__SECTOR_4K 45000u
+#endif
+#ifndef QLIB_ERASE_TIME_US__BLOCK_32K
+#define QLIB_ERASE_TIME_US__BLOCK_32K 120000u
+#endif
+#ifndef QLIB_ERASE_TIME_US__BLOCK_64K
+#define QLIB_ERASE_TIME_US__BLOCK_64K 150000u
+#endif
+#ifndef QLIB_ERASE_TIME_US__SECTION_64K
+#define QLIB_ERASE_TIME_US__SECTION_64K 150000u ///< Section erase time per 64KB of section size
+#endif
+
+/************************************************************************************************************
+ * Index of an erase type in the erase cost model (sector, 32K block, 64K block and section)
+************************************************************************************************************/
+#define QLIB_ERASE_COST_INDEX(eraseType) ((U32)(eraseType) - (U32)QLIB_ERASE_SECTOR_4K)
+#define QLIB_ERASE_COST_NUM              (QLIB_ERASE_COST_INDEX(QLIB_ERASE_SECTION) + 1u)
+
+/************************************************************************************************************
+ * Maximal size of the known pattern used to verify read configurations during autotune
+************************************************************************************************************/
+#ifndef QLIB_AUTOTUNE_MAX_PATTERN_SIZE
+#define QLIB_AUTOTUNE_MAX_PATTERN_SIZE 256u
+#endif
+
+/************************************************************************************************************
+ * Maximal number of cached pages of a section view. A view page is one flash sector
+************************************************************************************************************/
+#ifndef QLIB_VIEW_MAX_PAGES
+#define QLIB_VIEW_MAX_PAGES 16u
+#endif
+
 /*---------------------------------------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------------------------------------*/
 /*                                               PURE TYPES                                                */
@@ -121,6 +161,29 @@ typedef enum
     QLIB_ERASE_LAST
 } QLIB_ERASE_T;
 
+/************************************************************************************************************
+ * Write mode selector
+************************************************************************************************************/
+typedef enum
+{
+    QLIB_WRITE_MODE__PROGRAM,       ///< Program all the data, same as QLIB_Write
+    QLIB_WRITE_MODE__CHANGED_PAGES, ///< Program only pages that differ from the flash content
+    QLIB_WRITE_MODE__DIRTY_SECTORS, ///< Skip identical sectors, erase the others if not erased, then program them
+
+    QLIB_WRITE_MODE__LAST
+} QLIB_WRITE_MODE_T;
+
+/************************************************************************************************************
+ * Multi-die operation type
+************************************************************************************************************/
+typedef enum
+{
+    QLIB_DIE_OP__ERASE, ///< Standard erase of a sector aligned range
+    QLIB_DIE_OP__WRITE, ///< Standard write, the range must be erased
+
+    QLIB_DIE_OP__LAST
+} QLIB_DIE_OP_TYPE_T;
+
 /************************************************************************************************************
  * This enumeration defines the Authenticated watchdog threshold
 ************************************************************************************************************/
@@ -654,6 +717,21 @@ typedef struct QLIB_ASYNC_HASH_STATE_T
 ************************************************************************************************************/
 typedef U8 QLIB_CFG_T[((U32)QLIB_CFG_FEATURE_MAX / BYTES_TO_BITS(sizeof(U8))) + 1u];
 
+/************************************************************************************************************
+ * Host copy of the configuration registers. Bits 0 to QLIB_NUM_OF_SECTIONS-1 of the masks refer to SCRn
+************************************************************************************************************/
+#define QLIB_CONFIG_SHADOW_GMT  QLIB_NUM_OF_SECTIONS        ///< GMT bit in the shadow masks
+#define QLIB_CONFIG_SHADOW_ACLR (QLIB_NUM_OF_SECTIONS + 1u) ///< ACLR bit in the shadow masks
+
+typedef struct QLIB_CONFIG_SHADOW_T
+{
+    U32    valid;                       ///< Bit per register holding a value read from the device
+    U32    signedMask;                  ///< Bit per register that was read with a signed command
+    SCRn_T SCRn[QLIB_NUM_OF_SECTIONS];  ///< Section configuration registers
+    GMT_T  GMT;                         ///< Global mapping table
+    ACLR_T ACLR;                        ///< Access control lock register
+} QLIB_CONFIG_SHADOW_T;
+
 /************************************************************************************************************
  * QLIB DIE state
 ************************************************************************************************************/
@@ -662,12 +740,67 @@ typedef struct QLIB_DIE_STATE_T
     QLIB_MC_T                mc;                                       ///< Monotonic counter
     U32                      mcInSync : 1;                             ///< Monotonic counter is synced indication
     U32                      isPoweredDown : 1;                        ///< The flash is in powered-down state indication
+    U32                      isBusy : 1;                               ///< Program or erase started without waiting is in progress
     QLIB_KEY_MNGR_T          keyMngr;                                  ///< Key manager
     QLIB_REG_SSR_T           ssr;                                      ///< Last SSR
     QLIB_VAULT_RPMC_CONFIG_T vaultSize;                                ///< Vault and RPMC size
     QLIB_SECTION_STATE_T     sectionsState[QLIB_NUM_OF_MAIN_SECTIONS]; ///< section state and configuration (not including vault)
+    QLIB_CONFIG_SHADOW_T     configShadow;                             ///< Host copy of the configuration registers
 } QLIB_DIE_STATE_T;
 
+/************************************************************************************************************
+ * Erase range
+************************************************************************************************************/
+typedef struct QLIB_ERASE_RANGE_T
+{
+    U32 sectionID; ///< Section index
+    U32 offset;    ///< Section offset, aligned to FLASH_SECTOR_SIZE
+    U32 size;      ///< Size, aligned to FLASH_SECTOR_SIZE
+} QLIB_ERASE_RANGE_T;
+
+/************************************************************************************************************
+ * Erase cost model
+************************************************************************************************************/
+typedef struct QLIB_ERASE_COST_T
+{
+    U32 timeUs[QLIB_ERASE_COST_NUM]; ///< Erase time per erase type, indexed by QLIB_ERASE_COST_INDEX
+    U32 calibrated;                  ///< Bit per erase type that holds a measured time
+} QLIB_ERASE_COST_T;
+
+/************************************************************************************************************
+ * Standard commands with a precompiled descriptor
+************************************************************************************************************/
+typedef enum QLIB_STD_CMD_DESC_ID_T
+{
+    QLIB_STD_CMD_DESC__READ,    ///< Fast read
+    QLIB_STD_CMD_DESC__PROGRAM, ///< Page program
+    QLIB_STD_CMD_DESC__NUM
+} QLIB_STD_CMD_DESC_ID_T;
+
+/************************************************************************************************************
+ * Standard command descriptor
+************************************************************************************************************/
+typedef struct QLIB_STD_CMD_DESC_T
+{
+    QLIB_BUS_MODE_T format;      ///< Transaction format
+    U8              cmd;         ///< Command value
+    U8              dtr;         ///< Transaction uses DTR mode
+    U8              modeExist;   ///< Mode byte is sent after the address
+    U8              dummyCycles; ///< Dummy cycles between output and input phases
+} QLIB_STD_CMD_DESC_T;
+
+/************************************************************************************************************
+ * Standard command descriptor table. Built once for the current bus mode and dummy cycles configuration
+************************************************************************************************************/
+typedef struct QLIB_STD_CMD_TABLE_T
+{
+    QLIB_STD_CMD_DESC_T desc[QLIB_STD_CMD_DESC__NUM]; ///< Descriptors indexed by QLIB_STD_CMD_DESC_ID_T
+    QLIB_BUS_MODE_T     busMode;                      ///< Bus mode the table was built for
+    U8                  dtr;                          ///< DTR mode the table was built for
+    U8                  fastReadDummy;                ///< Fast read dummy cycles the table was built for
+    U8                  valid;                        ///< Table is built
+} QLIB_STD_CMD_TABLE_T;
+
 /************************************************************************************************************
  * QLIB context structure\n
  * [QLIB internal state](md_definitions.html#DEF_CONTEXT)
@@ -694,8 +827,193 @@ typedef struct QLIB_CONTEXT_T
     QLIB_DIE_STATE_T        dieState[QLIB_NUM_OF_DIES];
     QLIB_ASYNC_HASH_STATE_T hashState;
     QLIB_CFG_T cfgBitArr;
+    QLIB_STD_CMD_TABLE_T         stdCmdTable;   ///< Precompiled standard command descriptors
+    QLIB_ERASE_COST_T            eraseCost;     ///< Erase cost model
+    U32                          readChunkSize; ///< Maximal size of a single standard read transaction, 0 for no limit
+    struct QLIB_VIEW_T*          views;         ///< Open section views, invalidated on writes and erases
+    struct QLIB_WRITE_COMBINE_T* writeCombine;  ///< Write combining buffer of plain writes, NULL if disabled
+    struct QLIB_ENTROPY_POOL_T*  entropyPool;   ///< Pool of random bytes read from the flash, NULL if disabled
+    struct QLIB_BG_ERASE_T*      bgErase;       ///< Background erase in progress, plain reads are routed through it, NULL if none
 } QLIB_CONTEXT_T;
 
+/************************************************************************************************************
+ * Consumer of streamed read data. @p offset is the offset of @p data from the start of the stream
+************************************************************************************************************/
+typedef QLIB_STATUS_T (*QLIB_READ_CHUNK_FUNC_T)(void* arg, const U8* data, U32 offset, U32 size);
+
+/************************************************************************************************************
+ * Progress report of a long operation, @p done of @p total bytes are completed.
+ * A return value other than QLIB_STATUS__OK cancels the operation and is returned to its caller
+************************************************************************************************************/
+typedef QLIB_STATUS_T (*QLIB_PROGRESS_FUNC_T)(void* arg, U32 done, U32 total);
+
+/************************************************************************************************************
+ * Time source in microseconds, used by the background erase
+************************************************************************************************************/
+typedef U64 (*QLIB_TIME_US_FUNC_T)(void);
+
+/************************************************************************************************************
+ * Sleep for @p us microseconds, used by the background erase while a read waits for the flash
+************************************************************************************************************/
+typedef void (*QLIB_SLEEP_US_FUNC_T)(U32 us);
+
+/************************************************************************************************************
+ * Background erase policy
+************************************************************************************************************/
+typedef struct QLIB_BG_ERASE_POLICY_T
+{
+    U32 maxReadWaitUs; ///< Maximal time a read waits for the erase before it fails with QLIB_STATUS__DEVICE_BUSY, 0 for no limit
+    U32 minEraseRunUs; ///< Minimal erase run time after start or resume before the erase may be suspended
+    U32 maxSuspends;   ///< Maximal number of suspends of a single erase command
+} QLIB_BG_ERASE_POLICY_T;
+
+/************************************************************************************************************
+ * Background erase state
+************************************************************************************************************/
+typedef struct QLIB_BG_ERASE_T
+{
+    QLIB_CONTEXT_T*        qlibContext;   ///< QLIB state object
+    QLIB_BG_ERASE_POLICY_T policy;        ///< Scheduling policy
+    QLIB_TIME_US_FUNC_T    getTimeUs;     ///< Time source
+    QLIB_SLEEP_US_FUNC_T   sleepUs;       ///< Sleep between busy polls of a waiting read
+    U32                    sectionID;     ///< Section being erased
+    U32                    offset;        ///< Start of the range not erased yet
+    U32                    size;          ///< Size of the range not erased yet
+    U32                    eraseOffset;   ///< Start of the erase command in progress
+    U32                    eraseSize;     ///< Size of the erase command in progress
+    U32                    suspends;      ///< Number of suspends of the erase command in progress
+    U32                    totalSuspends; ///< Number of suspends since the background erase started
+    U64                    runStartUs;    ///< Time the erase command in progress was started or resumed
+    BOOL                   busy;          ///< Erase command in progress
+} QLIB_BG_ERASE_T;
+
+/************************************************************************************************************
+ * Write combining buffer of small plain writes, see QLIB_WriteCombine_Enable
+************************************************************************************************************/
+typedef struct QLIB_WRITE_COMBINE_T
+{
+    QLIB_TIME_US_FUNC_T getTimeUs;             ///< Time source, NULL to disable the timeout
+    U32                 timeoutUs;             ///< Maximal time data is buffered, checked on writes and polls
+    U32                 sectionID;             ///< Section of the buffered page
+    U32                 pageOffset;            ///< Section offset of the buffered page
+    U32                 start;                 ///< Start of the buffered data in the page
+    U32                 end;                   ///< End of the buffered data in the page, 0 if empty
+    U64                 firstUs;               ///< Time the first write to the buffered page was done
+    U32                 writes;                ///< Number of writes added to the buffer
+    U32                 flushes;               ///< Number of page programs issued by the buffer
+    U8                  page[FLASH_PAGE_SIZE]; ///< Buffered data, bytes not written are 0xFF
+} QLIB_WRITE_COMBINE_T;
+
+/************************************************************************************************************
+ * Pool of random bytes read from the flash RNG, see QLIB_EntropyPool_Enable
+************************************************************************************************************/
+typedef struct QLIB_ENTROPY_POOL_T
+{
+    U8*  buf;      ///< Random bytes, the available bytes are at the start of the buffer
+    U32  size;     ///< Size of the buffer
+    U32  level;    ///< Number of available bytes
+    U32  lowLevel; ///< The pool is refilled on polls when fewer bytes are available
+    U32  refills;  ///< Number of refills from the flash
+    BOOL secure;   ///< All the available bytes were read with secure commands
+} QLIB_ENTROPY_POOL_T;
+
+/************************************************************************************************************
+ * Multi-die operation, see QLIB_RunDieOperations
+************************************************************************************************************/
+typedef struct QLIB_DIE_OP_T
+{
+    QLIB_DIE_OP_TYPE_T type;      ///< Operation type
+    U8                 die;       ///< Die to operate on
+    U32                sectionID; ///< Section index
+    U32                offset;    ///< Section offset
+    U32                size;      ///< Size of the range
+    const U8*          buf;       ///< Data to write, unused for erase
+} QLIB_DIE_OP_T;
+
+/************************************************************************************************************
+ * Secure log iterator, see QLIB_SecureLogIter_Start
+************************************************************************************************************/
+typedef struct QLIB_SECURE_LOG_ITER_T
+{
+    U32  sectionID;                     ///< Log section index
+    BOOL secure;                        ///< Secure or standard read
+    U32  headAddr;                      ///< Log head address, read when the iteration started
+    U32  sectionSize;                   ///< Log section size
+    U32  next;                          ///< Section offset following the next entry to return
+    U32  remaining;                     ///< Number of entries not returned yet
+    U8   head[QLIB_SEC_LOG_ENTRY_SIZE]; ///< Entry at the head of the log
+} QLIB_SECURE_LOG_ITER_T;
+
+/************************************************************************************************************
+ * Buffered secure log writer, see QLIB_SecureLogWriter_Init
+************************************************************************************************************/
+typedef struct QLIB_SECURE_LOG_WRITER_T
+{
+    U32                 sectionID;  ///< Log section index
+    BOOL                secure;     ///< Secure or standard write
+    U8*                 buf;        ///< Pending entries
+    U32                 maxEntries; ///< Capacity of the buffer in entries, a full buffer is committed
+    U32                 numEntries; ///< Number of pending entries
+    QLIB_TIME_US_FUNC_T getTimeUs;  ///< Time source, NULL to disable the flush interval
+    U32                 intervalUs; ///< Maximal time an entry is pending, checked on appends and polls
+    U64                 firstUs;    ///< Time the oldest pending entry was appended
+    U32                 commits;    ///< Number of batches committed
+} QLIB_SECURE_LOG_WRITER_T;
+
+/************************************************************************************************************
+ * Read interface autotune configuration
+************************************************************************************************************/
+typedef struct QLIB_AUTOTUNE_CONFIG_T
+{
+    const QLIB_BUS_FORMAT_T* busFormats;     ///< Candidate bus formats, formats not supported by the device are skipped
+    U32                      numBusFormats;  ///< Number of candidate bus formats
+    U8                       minDummyCycles; ///< Smallest fast read dummy cycles value to try (configurable devices only)
+    U8                       maxDummyCycles; ///< Largest fast read dummy cycles value to try (configurable devices only)
+    U32                      sectionID;      ///< Plain readable section holding the known pattern
+    U32                      offset;         ///< Offset of the known pattern inside the section
+    U32                      size;           ///< Pattern size, up to QLIB_AUTOTUNE_MAX_PATTERN_SIZE
+    const U8*                pattern;        ///< Expected pattern, or NULL to use the data read with the initial bus format
+} QLIB_AUTOTUNE_CONFIG_T;
+
+/************************************************************************************************************
+ * Read interface autotune result
+************************************************************************************************************/
+typedef struct QLIB_AUTOTUNE_RESULT_T
+{
+    QLIB_BUS_FORMAT_T busFormat;   ///< Selected bus format
+    U8                dummyCycles; ///< Selected fast read dummy cycles
+    U32               readCycles;  ///< Estimated bus cycles of a page read with the selected configuration
+    U32               numTested;   ///< Number of tested configurations
+    U32               numPassed;   ///< Number of configurations that passed the pattern check
+} QLIB_AUTOTUNE_RESULT_T;
+
+/************************************************************************************************************
+ * Section view cached page
+************************************************************************************************************/
+typedef struct QLIB_VIEW_PAGE_T
+{
+    U32 offset;  ///< Section offset of the page
+    U32 lastUse; ///< Access counter value at the last access, used to evict the least recently used page
+    U8  valid;   ///< Page holds flash data
+} QLIB_VIEW_PAGE_T;
+
+/************************************************************************************************************
+ * Cached read-only view of a plain section
+************************************************************************************************************/
+typedef struct QLIB_VIEW_T
+{
+    QLIB_CONTEXT_T*     qlibContext;                ///< QLIB state object
+    struct QLIB_VIEW_T* next;                       ///< Next open view of the same context
+    U32                 sectionID;                  ///< Section index
+    U32                 size;                       ///< Size of the section readable in plain access
+    U8*                 cache;                      ///< Page data, numPages * FLASH_SECTOR_SIZE bytes
+    U32                 numPages;                   ///< Number of cached pages
+    U32                 useCounter;                 ///< Access counter
+    U32                 hits;                       ///< Accesses served from the cache
+    U32                 misses;                     ///< Accesses that read a page from the flash
+    QLIB_VIEW_PAGE_T    pages[QLIB_VIEW_MAX_PAGES]; ///< Cached pages
+} QLIB_VIEW_T;
+
 /************************************************************************************************************
  * Synchronization object
 ************************************************************************************************************/
@@ -798,6 +1116,44 @@ typedef struct
  ************************************************************************************************************/
 QLIB_STATUS_T QLIB_HASH(U32* output, const void* data, U32 dataSize);
 
+/************************************************************************************************************
+ * @brief       This function selects the erase command for the beginning of a range to erase, according to
+ *              the erase cost model. Only the given range is erased
+ *
+ * @param[in]   qlibContext     QLIB state object
+ * @param[in]   offset          Range start, aligned to FLASH_SECTOR_SIZE
+ * @param[in]   size            Range size, aligned to FLASH_SECTOR_SIZE
+ * @param[out]  eraseType       Erase command type
+ *
+ * @return      Size erased by the selected command
+************************************************************************************************************/
+U32 QLIB_COMMON_GetEraseStep(const QLIB_CONTEXT_T* qlibContext, U32 offset, U32 size, QLIB_ERASE_T* eraseType);
+
+/************************************************************************************************************
+ * @brief       This function estimates the time of erasing a range, using the erase commands selected by
+ *              @ref QLIB_COMMON_GetEraseStep
+ *
+ * @param[in]   qlibContext     QLIB state object
+ * @param[in]   offset          Range start, aligned to FLASH_SECTOR_SIZE
+ * @param[in]   size            Range size, aligned to FLASH_SECTOR_SIZE
+ *
+ * @return      Estimated erase time in microseconds
+************************************************************************************************************/
+U64 QLIB_COMMON_GetEraseTime(const QLIB_CONTEXT_T* qlibContext, U32 offset, U32 size);
+
+/************************************************************************************************************
+ * @brief       This function calculates the CRC of data in chunks, the same CRC as @ref QLIB_MemCRC.
+ *              The first chunk is calculated with @p crc 0, and every next chunk with the CRC returned
+ *              for the previous one
+ *
+ * @param[in]   crc             CRC of the previous chunks, 0 for the first chunk
+ * @param[in]   buf             Data
+ * @param[in]   size            Data size in bytes, multiple of 4
+ *
+ * @return      CRC of the data so far
+************************************************************************************************************/
+U32 QLIB_COMMON_CalcCRC(U32 crc, const U32* buf, U32 size);
+
 #ifdef QLIB_HASH_OPTIMIZATION_ENABLED
 /************************************************************************************************************
  * @brief The function starts asynchronous HASH calculation
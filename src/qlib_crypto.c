@@ -272,6 +272,12 @@ void QLIB_CRYPTO_Reseed(QLIB_PRNG_STATE_T* prng)
     prng->count = QLIB_PRNG_RESEED_COUNT;
 }
 
+void QLIB_CRYPTO_ReseedWithEntropy(QLIB_PRNG_STATE_T* prng, U64 entropy)
+{
+    QLIB_CRYPTO_Reseed(prng);
+    prng->state ^= entropy;
+}
+
 U32 QLIB_CRYPTO_GetRand32(QLIB_PRNG_STATE_T* prng)
 {
     if ((prng->count == 0u) || (prng->state == 0u))
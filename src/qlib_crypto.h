@@ -233,6 +233,14 @@ void QLIB_CRYPTO_SessionKeyAndSignature(const _256BIT   key,
 ************************************************************************************************************/
 void QLIB_CRYPTO_Reseed(QLIB_PRNG_STATE_T* prng);
 
+/************************************************************************************************************
+ * @brief           This function reseeds prng and mixes additional entropy into its state
+ *
+ * @param[in,out]   prng      PRNG state
+ * @param[in]       entropy   Additional entropy, e.g. random bytes from the flash RNG
+************************************************************************************************************/
+void QLIB_CRYPTO_ReseedWithEntropy(QLIB_PRNG_STATE_T* prng, U64 entropy);
+
 /************************************************************************************************************
  * @brief           This function returns pseudo-random 32bit value
  *
@@ -54,9 +54,6 @@
 /*---------------------------------------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------------------------------------*/
 typedef QLIB_STATUS_T (*QLIB_READ_FUNC_T)(QLIB_CONTEXT_T* qlibContext, U32 addr, U32* data32B);
-#ifdef QLIB_SIGN_DATA_BY_FLASH
-typedef QLIB_STATUS_T (*QLIB_SIGN_VERIFY_FUNC_T)(QLIB_CONTEXT_T* qlibContext, U32 enc_addr, _64BIT signature);
-#endif
 
 #ifndef EXCLUDE_LMS_ATTESTATION
 /************************************************************************************************************
@@ -125,6 +122,8 @@ static QLIB_STATUS_T QLIB_SEC_CloseSessionInternal_L(QLIB_CONTEXT_T* qlibContext
 static QLIB_STATUS_T QLIB_SEC_GetWID_L(QLIB_CONTEXT_T* qlibContext, QLIB_WID_T id);
 static QLIB_STATUS_T QLIB_SEC_GetStdAddrSize_L(QLIB_CONTEXT_T* qlibContext);
 static QLIB_STATUS_T QLIB_SEC_GetSectionsSize_L(QLIB_CONTEXT_T* qlibContext);
+static QLIB_STATUS_T QLIB_SEC_GetSCRn_L(QLIB_CONTEXT_T* qlibContext, U32 sectionID, SCRn_T SCRn);
+static QLIB_STATUS_T QLIB_SEC_GetGMT_L(QLIB_CONTEXT_T* qlibContext, GMT_T* GMT);
 static QLIB_STATUS_T QLIB_SEC_GetWatchdogConfig_L(QLIB_CONTEXT_T* qlibContext);
 static void          QLIB_SEC_MarkSessionClose_L(QLIB_CONTEXT_T* qlibContext, U8 die);
 static QLIB_STATUS_T QLIB_SEC_ConfigInitialSection_L(QLIB_CONTEXT_T*      qlibContext,
@@ -137,6 +136,7 @@ static BOOL          QLIB_SEC_ConfigSectionPolicyAfterSize_L(QLIB_CONTEXT_T*
                                                              U32                          sectionIndex,
                                                              const QLIB_SECTION_CONFIG_T* config);
 static QLIB_STATUS_T QLIB_SEC_HwAuthPlainAccess_Grant_L(QLIB_CONTEXT_T* qlibContext, U32 sectionID);
+static QLIB_STATUS_T QLIB_SEC_GetPlainAccessGrantKid_L(QLIB_CONTEXT_T* qlibContext, U32 sectionID, QLIB_KID_T* kid);
 static QLIB_STATUS_T QLIB_SEC_SwGrantRevokePA_L(QLIB_CONTEXT_T* qlibContext, U32 sectionID, BOOL grant);
 static QLIB_STATUS_T QLIB_SEC_VerifyAddressSizeConfig_L(QLIB_CONTEXT_T* qlibContext, const QLIB_STD_ADDR_SIZE_T* addrSizeConf);
 static void          QLIB_SEC_SetInterface_L(QLIB_CONTEXT_T* qlibContext, QLIB_BUS_MODE_T format);
@@ -154,6 +154,8 @@ static QLIB_STATUS_T QLIB_SEC_LMS_Execute_L(QLIB_CONTEXT_T* qlibContext,
                                             BOOL            grantPA);
 #endif
 static QLIB_STATUS_T QLIB_SEC_GetVaultSize_L(QLIB_CONTEXT_T* qlibContext);
+static QLIB_STATUS_T QLIB_SEC_GetCDIDigest_L(QLIB_CONTEXT_T* qlibContext, U32 sectionId, U64* digest);
+static QLIB_STATUS_T QLIB_SEC_CDIHash_L(_256BIT nextCdi, const _256BIT prevCdi, U64 digest, U32 sectionId);
 
 #if !defined EXCLUDE_LMS_ATTESTATION && !defined Q2_API
 static QLIB_STATUS_T                             QLIB_SEC_LMS_Attest_Sign_L(QLIB_CONTEXT_T*          qlibContext,
@@ -190,8 +192,9 @@ QLIB_STATUS_T QLIB_SEC_InitLib(QLIB_CONTEXT_T* qlibContext)
     qlibContext->isSuspended = FALSE;
     for (die = 0; die < QLIB_NUM_OF_DIES; die++)
     {
-        qlibContext->dieState[die].isPoweredDown = FALSE;
-        qlibContext->dieState[die].mcInSync      = FALSE;
+        qlibContext->dieState[die].isPoweredDown      = FALSE;
+        qlibContext->dieState[die].mcInSync           = FALSE;
+        qlibContext->dieState[die].configShadow.valid = 0;
         // Set the cached SSR busy bit in order to mark it as invalid
         SET_VAR_FIELD_32(qlibContext->dieState[die].ssr.asUint, QLIB_REG_SSR__BUSY, 1u);
 #ifdef Q3_TEST_MODE
@@ -890,7 +893,7 @@ QLIB_STATUS_T QLIB_SEC_GetSectionConfiguration(QLIB_CONTEXT_T* qlibContext,
     /*-----------------------------------------------------------------------------------------------------*/
     /* Read the SCR                                                                                        */
     /*-----------------------------------------------------------------------------------------------------*/
-    QLIB_STATUS_RET_CHECK(QLIB_SEC__get_SCRn(qlibContext, sectionID, SCRn));
+    QLIB_STATUS_RET_CHECK(QLIB_SEC_GetSCRn_L(qlibContext, sectionID, SCRn));
 
     if (NULL != version)
     {
@@ -938,7 +941,7 @@ QLIB_STATUS_T QLIB_SEC_GetSectionConfiguration(QLIB_CONTEXT_T* qlibContext,
         }
         else
         {
-            QLIB_STATUS_RET_CHECK(QLIB_SEC__get_GMT(qlibContext, &GMT));
+            QLIB_STATUS_RET_CHECK(QLIB_SEC_GetGMT_L(qlibContext, &GMT));
             *baseAddr = QLIB_REG_SMRn__BASE_IN_TAG_TO_BYTES(QLIB_REG_GMT_GET_BASE(qlibContext, GMT, sectionID));
         }
     }
@@ -1270,6 +1273,92 @@ QLIB_STATUS_T QLIB_SEC_AuthPlainAccess_Grant(QLIB_CONTEXT_T* qlibContext, U32 se
     return QLIB_STATUS__OK;
 }
 
+QLIB_STATUS_T QLIB_SEC_AuthPlainAccess_GrantMulti(QLIB_CONTEXT_T* qlibContext,
+                                                  const U32*      sectionIDs,
+                                                  U32             num,
+                                                  U32*            grantedMask,
+                                                  U32*            integrityErrMask)
+{
+    QLIB_KID_T    kids[QLIB_NUM_OF_SECTIONS];
+    QLIB_STATUS_T ret = QLIB_STATUS__OK;
+    U32           i;
+
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Secure command is ignored if power is down or suspended                                             */
+    /*-----------------------------------------------------------------------------------------------------*/
+    QLIB_ASSERT_RET(QLIB_ACTIVE_DIE_STATE(qlibContext).isPoweredDown == 0u, QLIB_STATUS__COMMAND_IGNORED);
+    QLIB_ASSERT_RET(qlibContext->isSuspended == 0u, QLIB_STATUS__COMMAND_IGNORED);
+
+    /********************************************************************************************************
+     * Error checking
+    ********************************************************************************************************/
+    QLIB_ASSERT_RET(QLIB_NUM_OF_SECTIONS >= num, QLIB_STATUS__INVALID_PARAMETER);
+
+    *grantedMask      = 0;
+    *integrityErrMask = 0;
+
+    if (W77Q_CMD_PA_GRANT_REVOKE(qlibContext) == 0u)
+    {
+        /****************************************************************************************************
+         * Without PA_GRANT, plain access is granted by closing a session on the section, one at a time
+        ****************************************************************************************************/
+        for (i = 0; i < num; i++)
+        {
+            ret = QLIB_SEC_SwGrantRevokePA_L(qlibContext, sectionIDs[i], TRUE);
+            QLIB_ASSERT_RET((QLIB_STATUS__OK == ret) || (QLIB_STATUS__DEVICE_INTEGRITY_ERR == ret), ret);
+            if (QLIB_STATUS__DEVICE_INTEGRITY_ERR == ret)
+            {
+                *integrityErrMask |= (1u << sectionIDs[i]);
+            }
+            *grantedMask |= (1u << sectionIDs[i]);
+        }
+        return QLIB_STATUS__OK;
+    }
+
+    /********************************************************************************************************
+     * Select the grant keys first, so a missing key fails before any command is sent
+    ********************************************************************************************************/
+    for (i = 0; i < num; i++)
+    {
+        QLIB_STATUS_RET_CHECK(QLIB_SEC_GetPlainAccessGrantKid_L(qlibContext, sectionIDs[i], &kids[i]));
+    }
+
+    /********************************************************************************************************
+     * Mark multi-transaction command
+    ********************************************************************************************************/
+    qlibContext->multiTransactionCmd = TRUE;
+
+#ifdef QLIB_SPI_OPTIMIZATION_ENABLED
+    PLAT_SPI_MultiTransactionStart();
+#endif //QLIB_SPI_OPTIMIZATION_ENABLED
+
+    for (i = 0; i < num; i++)
+    {
+        ret = QLIB_CMD_PROC__PA_grant(qlibContext, kids[i]);
+        if (QLIB_STATUS__DEVICE_INTEGRITY_ERR == ret)
+        {
+            *integrityErrMask |= (1u << sectionIDs[i]);
+            ret = QLIB_STATUS__OK;
+        }
+        QLIB_STATUS_RET_CHECK_GOTO(ret, ret, finish);
+        *grantedMask |= (1u << sectionIDs[i]);
+    }
+
+finish:
+    /********************************************************************************************************
+     * Multi-transaction ended
+    ********************************************************************************************************/
+    if (qlibContext->multiTransactionCmd == 1u)
+    {
+        qlibContext->multiTransactionCmd = 0u;
+
+#ifdef QLIB_SPI_OPTIMIZATION_ENABLED
+        PLAT_SPI_MultiTransactionStop();
+#endif //QLIB_SPI_OPTIMIZATION_ENABLED
+    }
+    return ret;
+}
+
 QLIB_STATUS_T QLIB_SEC_PlainAccess_Revoke(QLIB_CONTEXT_T* qlibContext, U32 sectionID, QLIB_PA_REVOKE_TYPE_T revokeType)
 {
     /*-----------------------------------------------------------------------------------------------------*/
@@ -1514,21 +1603,7 @@ QLIB_STATUS_T QLIB_SEC_Erase(QLIB_CONTEXT_T* qlibContext, U32 sectionID, U32 off
     /*-----------------------------------------------------------------------------------------------------*/
     while (0u < size)
     {
-        if (_64KB_ <= size && 0u == (offset % _64KB_))
-        {
-            eraseSize = _64KB_;
-            eraseType = QLIB_ERASE_BLOCK_64K;
-        }
-        else if (_32KB_ <= size && 0u == (offset % _32KB_))
-        {
-            eraseSize = _32KB_;
-            eraseType = QLIB_ERASE_BLOCK_32K;
-        }
-        else
-        {
-            eraseSize = _4KB_;
-            eraseType = QLIB_ERASE_SECTOR_4K;
-        }
+        eraseSize = QLIB_COMMON_GetEraseStep(qlibContext, offset, size, &eraseType);
 
         /*-------------------------------------------------------------------------------------------------*/
         /* Perform the erase                                                                               */
@@ -1596,6 +1671,31 @@ QLIB_STATUS_T QLIB_SEC_MemCrc(QLIB_CONTEXT_T* qlibContext, U32* crc32, U32 secti
     return QLIB_STATUS__OK;
 }
 
+QLIB_STATUS_T QLIB_SEC_MemCrcMap(QLIB_CONTEXT_T* qlibContext, U32* crcMap, U32 sectionID, U32 offset, U32 size, U32 blockSize)
+{
+    U32 mask = 0xff000000u;
+
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Secure command is ignored if power is down or suspended                                             */
+    /*-----------------------------------------------------------------------------------------------------*/
+    QLIB_ASSERT_RET(QLIB_ACTIVE_DIE_STATE(qlibContext).isPoweredDown == 0u, QLIB_STATUS__COMMAND_IGNORED);
+    QLIB_ASSERT_RET(qlibContext->isSuspended == 0u, QLIB_STATUS__COMMAND_IGNORED);
+
+    /********************************************************************************************************
+     * Error checking
+    ********************************************************************************************************/
+    QLIB_ASSERT_RET((size & mask) == 0u, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET((offset & mask) == 0u, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET((blockSize % QLIB_SEC_READ_PAGE_SIZE_BYTE) == 0u, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET((size % QLIB_SEC_READ_PAGE_SIZE_BYTE) == 0u, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET((offset % QLIB_SEC_READ_PAGE_SIZE_BYTE) == 0u, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET(0u < blockSize, QLIB_STATUS__INVALID_PARAMETER);
+
+    QLIB_STATUS_RET_CHECK(QLIB_CMD_PROC__MEM_CRC_Multi(qlibContext, sectionID, offset, size, blockSize, crcMap));
+
+    return QLIB_STATUS__OK;
+}
+
 QLIB_STATUS_T QLIB_SEC_EraseSection(QLIB_CONTEXT_T* qlibContext, U32 sectionID, BOOL secure)
 {
     /*-----------------------------------------------------------------------------------------------------*/
@@ -1642,7 +1742,7 @@ QLIB_STATUS_T QLIB_SEC_ConfigAccess(QLIB_CONTEXT_T* qlibContext, U32 sectionID,
     /*-----------------------------------------------------------------------------------------------------*/
     /* Read ACLR                                                                                           */
     /*-----------------------------------------------------------------------------------------------------*/
-    QLIB_STATUS_RET_CHECK(QLIB_CMD_PROC__get_ACLR(qlibContext, &aclr));
+    QLIB_STATUS_RET_CHECK(QLIB_SEC_GetACLR(qlibContext, &aclr));
 
     /*-----------------------------------------------------------------------------------------------------*/
     /* Update section configuration                                                                        */
@@ -1669,6 +1769,20 @@ QLIB_STATUS_T QLIB_SEC_ConfigAccess(QLIB_CONTEXT_T* qlibContext, U32 sectionID,
     return QLIB_STATUS__OK;
 }
 
+QLIB_STATUS_T QLIB_SEC_GetACLR(QLIB_CONTEXT_T* qlibContext, ACLR_T* aclr)
+{
+    QLIB_CONFIG_SHADOW_T* shadow = &QLIB_ACTIVE_DIE_STATE(qlibContext).configShadow;
+
+    if (!QLIB_SEC__SHADOW_HIT(qlibContext, QLIB_CONFIG_SHADOW_ACLR))
+    {
+        QLIB_STATUS_RET_CHECK(QLIB_CMD_PROC__get_ACLR(qlibContext, &shadow->ACLR));
+        shadow->valid |= (1u << QLIB_CONFIG_SHADOW_ACLR);
+    }
+    *aclr = shadow->ACLR;
+
+    return QLIB_STATUS__OK;
+}
+
 QLIB_STATUS_T QLIB_SEC_LoadKey(QLIB_CONTEXT_T* qlibContext, U32 sectionID, const KEY_T key, BOOL fullAccess)
 {
     /*-----------------------------------------------------------------------------------------------------*/
@@ -1776,12 +1890,19 @@ QLIB_STATUS_T QLIB_SEC_CheckIntegrity(QLIB_CONTEXT_T* qlibContext, U32 sectionID
     return QLIB_STATUS__OK;
 }
 
-QLIB_STATUS_T QLIB_SEC_CalcCDI(QLIB_CONTEXT_T* qlibContext, _256BIT nextCdi, const _256BIT prevCdi, U32 sectionId)
+QLIB_STATUS_T QLIB_SEC_CheckIntegrityAll(QLIB_CONTEXT_T*  qlibContext,
+                                         U32              sectionMask,
+                                         QLIB_INTEGRITY_T integrityType,
+                                         U32*             checkedMask,
+                                         U32*             failedMask)
 {
-    _512BIT       hashData;
-    U8*           hashDataP = (U8*)hashData;
     QLIB_POLICY_T policy;
-    U64           digest = 0;
+    U32           sections[QLIB_NUM_OF_SECTIONS];
+    U32           numSections = 0;
+    U32           sectionID;
+    U32           i;
+    BOOL          configured;
+    BOOL          signedCheck;
 
     /*-----------------------------------------------------------------------------------------------------*/
     /* Secure command is ignored if power is down or suspended                                             */
@@ -1789,63 +1910,200 @@ QLIB_STATUS_T QLIB_SEC_CalcCDI(QLIB_CONTEXT_T* qlibContext, _256BIT nextCdi, con
     QLIB_ASSERT_RET(QLIB_ACTIVE_DIE_STATE(qlibContext).isPoweredDown == 0u, QLIB_STATUS__COMMAND_IGNORED);
     QLIB_ASSERT_RET(qlibContext->isSuspended == 0u, QLIB_STATUS__COMMAND_IGNORED);
 
-    (void)memset(&policy, 0, sizeof(QLIB_POLICY_T));
-    if (sectionId == 0u)
-    {
-        QLIB_ASSERT_RET(QLIB_KEYMNGR_IS_SECTION_FULL_ACCESS(qlibContext, 0u) ||
-                            QLIB_KEY_MNGR_IS_SECTION_RESTRICTED_ACCESS(qlibContext, 0u),
-                        QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE);
-        return QLIB_CMD_PROC__CALC_CDI(qlibContext, 0, nextCdi);
-    }
-    else
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Error checking                                                                                      */
+    /*-----------------------------------------------------------------------------------------------------*/
+    QLIB_ASSERT_RET((sectionMask >> QLIB_NUM_OF_SECTIONS) == 0u, QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET((W77Q_VAULT(qlibContext) != 0u) || ((sectionMask & (1u << QLIB_SECTION_ID_VAULT)) == 0u),
+                    QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET((QLIB_INTEGRITY_CRC == integrityType) || (QLIB_INTEGRITY_DIGEST == integrityType),
+                    QLIB_STATUS__INVALID_PARAMETER);
+
+    *checkedMask = 0;
+    *failedMask  = 0;
+    signedCheck  = INT_TO_BOOLEAN((QLIB_INTEGRITY_DIGEST == integrityType) && (W77Q_VER_INTG_DIGEST(qlibContext) == 0u));
+
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Read all policies before the first check                                                            */
+    /*-----------------------------------------------------------------------------------------------------*/
+    for (sectionID = 0; sectionID < QLIB_NUM_OF_SECTIONS; sectionID++)
     {
-        QLIB_ASSERT_RET(NULL != prevCdi, QLIB_STATUS__INVALID_PARAMETER);
-        QLIB_STATUS_RET_CHECK(QLIB_SEC_GetSectionConfiguration(qlibContext, sectionId, NULL, NULL, &policy, &digest, NULL, NULL));
+        if ((sectionMask & (1u << sectionID)) == 0u)
+        {
+            continue;
+        }
+
+        (void)memset(&policy, 0, sizeof(QLIB_POLICY_T));
+        QLIB_STATUS_RET_CHECK(QLIB_SEC_GetSectionConfiguration(qlibContext, sectionID, NULL, NULL, &policy, NULL, NULL, NULL));
 
-        if (((policy.digestIntegrity == 1u) ||
-             ((Q2_POLICY_AUTH_PROT_AC_BIT(qlibContext) != 0u) && (policy.digestIntegrityOnAccess == 1u))) &&
-            ((policy.writeProt == 1u) || (policy.rollbackProt == 1u)))
+        if (QLIB_INTEGRITY_DIGEST == integrityType)
         {
-            /*---------------------------------------------------------------------------------------------*/
-            /* Using stored digest                                                                         */
-            /*---------------------------------------------------------------------------------------------*/
-            QLIB_ASSERT_RET(digest != 0u, QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE);
+            configured =
+                INT_TO_BOOLEAN((policy.digestIntegrity == 1u) ||
+                               ((Q2_POLICY_AUTH_PROT_AC_BIT(qlibContext) != 0u) && (policy.digestIntegrityOnAccess == 1u)));
         }
         else
         {
-            /*---------------------------------------------------------------------------------------------*/
-            /* recalculating digest                                                                        */
-            /*---------------------------------------------------------------------------------------------*/
+            configured = INT_TO_BOOLEAN(policy.checksumIntegrity == 1u);
+        }
+
+        QLIB_ASSERT_RET(TRUE == configured, QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE);
+        sections[numSections++] = sectionID;
+    }
+
+    *checkedMask = sectionMask;
+
+    if (TRUE == signedCheck)
+    {
+        U64    digest = 0;
+        SCRn_T SCRn;
+
+        QLIB_ASSERT_RET((0u == numSections) || QLIB_KEY_MNGR__SESSION_IS_OPEN(qlibContext), QLIB_STATUS__DEVICE_SESSION_ERR);
+
+        /*-------------------------------------------------------------------------------------------------*/
+        /* CALC_SIG is not pipelined, each signed response is verified with the TC before the next one     */
+        /*-------------------------------------------------------------------------------------------------*/
+        for (i = 0; i < numSections; i++)
+        {
             QLIB_STATUS_RET_CHECK(QLIB_CMD_PROC__CALC_SIG(qlibContext,
                                                           QLIB_SIGNED_DATA_TYPE_SECTION_DIGEST,
-                                                          sectionId,
+                                                          sections[i],
                                                           NULL,
                                                           0,
                                                           &digest,
                                                           sizeof(digest),
                                                           NULL));
+            QLIB_STATUS_RET_CHECK(QLIB_CMD_PROC__CALC_SIG(qlibContext,
+                                                          QLIB_SIGNED_DATA_TYPE_SECTION_CONFIG,
+                                                          sections[i],
+                                                          NULL,
+                                                          0,
+                                                          SCRn,
+                                                          sizeof(SCRn),
+                                                          NULL));
+
+            if (0 != memcmp((U8*)&digest, (U8*)QLIB_REG_SCRn_GET_DIGEST_PTR(SCRn), sizeof(digest)))
+            {
+                *failedMask |= (1u << sections[i]);
+            }
         }
+    }
+    else
+    {
+        QLIB_STATUS_RET_CHECK(QLIB_CMD_PROC__Check_Integrity_Multi(qlibContext,
+                                                                   sections,
+                                                                   numSections,
+                                                                   INT_TO_BOOLEAN(QLIB_INTEGRITY_DIGEST == integrityType),
+                                                                   failedMask));
+    }
 
-        /*-------------------------------------------------------------------------------------------------*/
-        /* data consists of the following                                                                  */
-        /* 256 bit  => prevCdi                                                                             */
-        /* 64  bit  => digest                                                                              */
-        /* 64  bit  => zero bits                                                                           */
-        /* 48  bit  => zero bits                                                                           */
-        /* 8   bit  => index                                                                               */
-        /*-------------------------------------------------------------------------------------------------*/
-        (void)memcpy((void*)hashDataP, (const void*)prevCdi, BITS_TO_BYTES(256u));
-        hashDataP += BITS_TO_BYTES(256u);
+    QLIB_ASSERT_RET(0u == *failedMask, (TRUE == signedCheck) ? QLIB_STATUS__SECURITY_ERR : QLIB_STATUS__DEVICE_INTEGRITY_ERR);
+
+    return QLIB_STATUS__OK;
+}
+
+QLIB_STATUS_T QLIB_SEC_CalcCDI(QLIB_CONTEXT_T* qlibContext, _256BIT nextCdi, const _256BIT prevCdi, U32 sectionId)
+{
+    U64 digest = 0;
+
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Secure command is ignored if power is down or suspended                                             */
+    /*-----------------------------------------------------------------------------------------------------*/
+    QLIB_ASSERT_RET(QLIB_ACTIVE_DIE_STATE(qlibContext).isPoweredDown == 0u, QLIB_STATUS__COMMAND_IGNORED);
+    QLIB_ASSERT_RET(qlibContext->isSuspended == 0u, QLIB_STATUS__COMMAND_IGNORED);
+
+    if (sectionId == 0u)
+    {
+        QLIB_ASSERT_RET(QLIB_KEYMNGR_IS_SECTION_FULL_ACCESS(qlibContext, 0u) ||
+                            QLIB_KEY_MNGR_IS_SECTION_RESTRICTED_ACCESS(qlibContext, 0u),
+                        QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE);
+        return QLIB_CMD_PROC__CALC_CDI(qlibContext, 0, nextCdi);
+    }
+    else
+    {
+        QLIB_ASSERT_RET(NULL != prevCdi, QLIB_STATUS__INVALID_PARAMETER);
+        QLIB_STATUS_RET_CHECK(QLIB_SEC_GetCDIDigest_L(qlibContext, sectionId, &digest));
+        QLIB_STATUS_RET_CHECK(QLIB_SEC_CDIHash_L(nextCdi, prevCdi, digest, sectionId));
+    }
+
+    return QLIB_STATUS__OK;
+}
+
+QLIB_STATUS_T QLIB_SEC_CalcCDIChain(QLIB_CONTEXT_T* qlibContext,
+                                    _256BIT*        cdis,
+                                    const _256BIT   prevCdi,
+                                    const U32*      sectionIds,
+                                    U32             num)
+{
+    U64           digests[QLIB_NUM_OF_SECTIONS];
+    QLIB_STATUS_T ret   = QLIB_STATUS__OK;
+    U32           first = 0;
+    U32           i;
+
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Secure command is ignored if power is down or suspended                                             */
+    /*-----------------------------------------------------------------------------------------------------*/
+    QLIB_ASSERT_RET(QLIB_ACTIVE_DIE_STATE(qlibContext).isPoweredDown == 0u, QLIB_STATUS__COMMAND_IGNORED);
+    QLIB_ASSERT_RET(qlibContext->isSuspended == 0u, QLIB_STATUS__COMMAND_IGNORED);
+
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Error checking. Section 0 can only be the root of the chain                                         */
+    /*-----------------------------------------------------------------------------------------------------*/
+    QLIB_ASSERT_RET((0u < num) && (QLIB_NUM_OF_SECTIONS >= num), QLIB_STATUS__INVALID_PARAMETER);
+    QLIB_ASSERT_RET((sectionIds[0] == 0u) || (NULL != prevCdi), QLIB_STATUS__INVALID_PARAMETER);
+    for (i = 1; i < num; i++)
+    {
+        QLIB_ASSERT_RET(sectionIds[i] != 0u, QLIB_STATUS__INVALID_PARAMETER);
+    }
+    if (sectionIds[0] == 0u)
+    {
+        QLIB_ASSERT_RET(QLIB_KEYMNGR_IS_SECTION_FULL_ACCESS(qlibContext, 0u) ||
+                            QLIB_KEY_MNGR_IS_SECTION_RESTRICTED_ACCESS(qlibContext, 0u),
+                        QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE);
+        first = 1;
+    }
 
-        (void)memcpy((void*)hashDataP, (void*)&digest, BITS_TO_BYTES(64u));
-        hashDataP += BITS_TO_BYTES(64u);
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Mark multi-transaction command                                                                      */
+    /*-----------------------------------------------------------------------------------------------------*/
+    qlibContext->multiTransactionCmd = TRUE;
 
-        (void)memset(hashDataP, 0, BITS_TO_BYTES(112u));
-        hashDataP += BITS_TO_BYTES(112u);
+#ifdef QLIB_SPI_OPTIMIZATION_ENABLED
+    PLAT_SPI_MultiTransactionStart();
+#endif //QLIB_SPI_OPTIMIZATION_ENABLED
 
-        (void)memcpy((void*)hashDataP, (void*)&sectionId, BITS_TO_BYTES(8u));
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Run all the device commands back to back: the root CDI and the digest of every module               */
+    /*-----------------------------------------------------------------------------------------------------*/
+    if (first == 1u)
+    {
+        QLIB_STATUS_RET_CHECK_GOTO(QLIB_CMD_PROC__CALC_CDI(qlibContext, 0, cdis[0]), ret, finish);
+    }
+    for (i = first; i < num; i++)
+    {
+        QLIB_STATUS_RET_CHECK_GOTO(QLIB_SEC_GetCDIDigest_L(qlibContext, sectionIds[i], &digests[i]), ret, finish);
+    }
 
-        QLIB_STATUS_RET_CHECK(QLIB_HASH(nextCdi, hashData, BITS_TO_BYTES(256u + 64u + 112u + 8u)));
+finish:
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Multi-transaction ended                                                                             */
+    /*-----------------------------------------------------------------------------------------------------*/
+    if (qlibContext->multiTransactionCmd == 1u)
+    {
+        qlibContext->multiTransactionCmd = 0u;
+
+#ifdef QLIB_SPI_OPTIMIZATION_ENABLED
+        PLAT_SPI_MultiTransactionStop();
+#endif //QLIB_SPI_OPTIMIZATION_ENABLED
+    }
+    QLIB_STATUS_RET_CHECK(ret);
+
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Hash the chain                                                                                      */
+    /*-----------------------------------------------------------------------------------------------------*/
+    for (i = first; i < num; i++)
+    {
+        QLIB_STATUS_RET_CHECK(QLIB_SEC_CDIHash_L(cdis[i], (i == 0u) ? prevCdi : cdis[i - 1u], digests[i], sectionIds[i]));
     }
 
     return QLIB_STATUS__OK;
@@ -2177,6 +2435,10 @@ QLIB_STATUS_T QLIB_SEC_SyncAfterFlashReset(QLIB_CONTEXT_T* qlibContext)
     {
         QLIB_SEC_MarkSessionClose_L(qlibContext, dieId);
         /*-----------------------------------------------------------------------------------------------------*/
+        /* Reset reloads the configuration registers                                                           */
+        /*-----------------------------------------------------------------------------------------------------*/
+        qlibContext->dieState[dieId].configShadow.valid = 0;
+        /*-----------------------------------------------------------------------------------------------------*/
         /* Plain sessions got closed after reset                                                               */
         /*-----------------------------------------------------------------------------------------------------*/
         for (sectionID = 0; sectionID < QLIB_NUM_OF_MAIN_SECTIONS; sectionID++)
@@ -2207,8 +2469,14 @@ QLIB_STATUS_T QLIB_SEC_SyncAfterFlashReset(QLIB_CONTEXT_T* qlibContext)
 #endif
 
     /*-----------------------------------------------------------------------------------------------------*/
-    /* Wait while secure module is not-ready. It will also clear errors on SSR                             */
+    /* Wait while secure module is not-ready. Polling is done by the transaction layer if supported,       */
+    /* otherwise (or on time out) the loop below polls. It will also clear errors on SSR                   */
     /*-----------------------------------------------------------------------------------------------------*/
+    status = QLIB_TM_WaitReady(qlibContext, QLIB_TM_WAIT_READY__SSR, SSR__BUSY_BIT, QLIB_TM_WAIT_READY_NUM_POLLS, NULL, NULL);
+    if ((QLIB_STATUS__NOT_SUPPORTED != status) && (QLIB_STATUS__TIME_OUT != status))
+    {
+        QLIB_STATUS_RET_CHECK(status);
+    }
     do
     {
         status = QLIB_SEC__get_SSR(qlibContext, &ssr, SSR_MASK__ALL_ERRORS);
@@ -2316,40 +2584,57 @@ QLIB_STATUS_T QLIB_SEC_SignVerify(QLIB_CONTEXT_T* qlibContext,
                                   _256BIT         signature,
                                   BOOL            verify)
 {
-    const U32               sec_addr_size    = 3;
-    U32                     i                = 0;
-    U32                     enc_addr         = 0;
-    U32                     offset           = 0;
-    BOOL                    need_compression = TRUE;
-    _64BIT                  sig64            = {0};
-    U32                     cache[32]        = {0};
-    QLIB_SIGN_VERIFY_FUNC_T signFunc         = (verify == FALSE) ? QLIB_CMD_PROC__SARD_Sign : QLIB_CMD_PROC__SARD_Verify;
-    U32                     numOfIter        = DIV_CEIL(dataSize, sec_addr_size);
+    const U32 sec_addr_size    = 3;
+    U32       i                = 0;
+    U32       j                = 0;
+    U32       k                = 0;
+    U32       batch            = 0;
+    U32       offset           = 0;
+    BOOL      need_compression = TRUE;
+    U32       cache[32]        = {0};
+    U32       enc_addr[ARRAY_SIZE(cache) / 2u];
+    U32       numOfIter = DIV_CEIL(dataSize, sec_addr_size);
 
     /*-----------------------------------------------------------------------------------------------------*/
     /* Unused parameters                                                                                   */
     /*-----------------------------------------------------------------------------------------------------*/
     TOUCH(sectionID);
 
-    for (i = 0; i < numOfIter; ++i)
+    for (i = 0; i < numOfIter; i += batch)
     {
         /*-------------------------------------------------------------------------------------------------*/
-        /* Construct an address out of the given data                                                      */
+        /* Process as many 'addresses' as the cache can hold before the next compression                   */
         /*-------------------------------------------------------------------------------------------------*/
-        enc_addr = MAKE_32_BIT(dataIn[i * sec_addr_size],
-                               i * sec_addr_size + 1u < dataSize ? dataIn[i * sec_addr_size + 1u] : 0u,
-                               i * sec_addr_size + 2u < dataSize ? dataIn[i * sec_addr_size + 2u] : 0u,
-                               0);
+        batch = MIN(numOfIter - i, (ARRAY_SIZE(cache) - offset) / 2u);
+
         /*-------------------------------------------------------------------------------------------------*/
-        /* Sign the 'address' using Flash commands                                                         */
+        /* Construct addresses out of the given data                                                       */
         /*-------------------------------------------------------------------------------------------------*/
-        QLIB_STATUS_RET_CHECK(signFunc(qlibContext, enc_addr, sig64));
+        for (j = 0; j < batch; ++j)
+        {
+            k           = (i + j) * sec_addr_size;
+            enc_addr[j] = MAKE_32_BIT(dataIn[k],
+                                      k + 1u < dataSize ? dataIn[k + 1u] : 0u,
+                                      k + 2u < dataSize ? dataIn[k + 2u] : 0u,
+                                      0);
+        }
 
         /*-------------------------------------------------------------------------------------------------*/
-        /* Cache the signature                                                                             */
+        /* Sign the 'addresses' into the cache. Signing uses pipelined Flash commands, verifying           */
+        /* calculates the expected signatures locally                                                      */
         /*-------------------------------------------------------------------------------------------------*/
-        (void)memcpy(&cache[offset], sig64, sizeof(_64BIT));
-        offset += 2u;
+        if (verify == FALSE)
+        {
+            QLIB_STATUS_RET_CHECK(QLIB_CMD_PROC__SARD_Sign_Multi(qlibContext, enc_addr, batch, &cache[offset]));
+        }
+        else
+        {
+            for (j = 0; j < batch; ++j)
+            {
+                QLIB_STATUS_RET_CHECK(QLIB_CMD_PROC__SARD_Verify(qlibContext, enc_addr[j], &cache[offset + (2u * j)]));
+            }
+        }
+        offset += 2u * batch;
         need_compression = TRUE;
 
         /*-------------------------------------------------------------------------------------------------*/
@@ -2449,7 +2734,8 @@ QLIB_STATUS_T QLIB_SEC_SendLMSCommand(QLIB_CONTEXT_T* qlibContext, const U32* cm
 
 QLIB_STATUS_T QLIB_SEC_GetRandom(QLIB_CONTEXT_T* qlibContext, void* random, U32 randomSize)
 {
-    RNGR_T rngr;
+    RNGR_T        rngr;
+    QLIB_STATUS_T ret = QLIB_STATUS__OK;
 
     /********************************************************************************************************
      * Secure command is ignored if power is down or suspended
@@ -2457,22 +2743,43 @@ QLIB_STATUS_T QLIB_SEC_GetRandom(QLIB_CONTEXT_T* qlibContext, void* random, U32
     QLIB_ASSERT_RET(QLIB_ACTIVE_DIE_STATE(qlibContext).isPoweredDown == 0u, QLIB_STATUS__COMMAND_IGNORED);
     QLIB_ASSERT_RET(qlibContext->isSuspended == 0u, QLIB_STATUS__COMMAND_IGNORED);
 
+    /********************************************************************************************************
+     * Mark multi-transaction command, large requests read many RNGR values
+    ********************************************************************************************************/
+    qlibContext->multiTransactionCmd = TRUE;
+
+#ifdef QLIB_SPI_OPTIMIZATION_ENABLED
+    PLAT_SPI_MultiTransactionStart();
+#endif //QLIB_SPI_OPTIMIZATION_ENABLED
+
     while (randomSize > 0u)
     {
         U32             size = MIN(randomSize, sizeof(U32));
         QLIB_REG_ESSR_T essr;
         do
         {
-            QLIB_STATUS_RET_CHECK(QLIB_SEC__get_ESSR(qlibContext, &essr));
+            QLIB_STATUS_RET_CHECK_GOTO(QLIB_SEC__get_ESSR(qlibContext, &essr), ret, finish);
         } while (READ_VAR_FIELD(essr.asUint64, QLIB_REG_ESSR__RNG_RDY) == 0u);
 
-        QLIB_STATUS_RET_CHECK(QLIB_SEC__get_RNGR(qlibContext, rngr));
+        QLIB_STATUS_RET_CHECK_GOTO(QLIB_SEC__get_RNGR(qlibContext, rngr), ret, finish);
         (void)memcpy(random, (void*)(&QLIB_REG_RNGR_GET_RND(rngr)), size);
         randomSize = randomSize - size;
         random     = (void*)(((U8*)(random)) + size);
     }
 
-    return QLIB_STATUS__OK;
+finish:
+    /********************************************************************************************************
+     * Multi-transaction ended
+    ********************************************************************************************************/
+    if (qlibContext->multiTransactionCmd == 1u)
+    {
+        qlibContext->multiTransactionCmd = 0u;
+
+#ifdef QLIB_SPI_OPTIMIZATION_ENABLED
+        PLAT_SPI_MultiTransactionStop();
+#endif //QLIB_SPI_OPTIMIZATION_ENABLED
+    }
+    return ret;
 }
 
 #if !defined EXCLUDE_LMS_ATTESTATION && !defined Q2_API
@@ -3477,6 +3784,13 @@ static QLIB_STATUS_T QLIB_SEC_GetSectionsSize_L(QLIB_CONTEXT_T* qlibContext)
 
     QLIB_STATUS_RET_CHECK(QLIB_CMD_PROC__get_GMT_UNSIGNED(qlibContext, &gmt));
 
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Keep the GMT for later section configuration lookups                                                */
+    /*-----------------------------------------------------------------------------------------------------*/
+    (void)memcpy(&QLIB_ACTIVE_DIE_STATE(qlibContext).configShadow.GMT, &gmt, sizeof(GMT_T));
+    QLIB_ACTIVE_DIE_STATE(qlibContext).configShadow.valid |= (1u << QLIB_CONFIG_SHADOW_GMT);
+    QLIB_ACTIVE_DIE_STATE(qlibContext).configShadow.signedMask &= ~(1u << QLIB_CONFIG_SHADOW_GMT);
+
     for (sectionID = 0; sectionID < QLIB_NUM_OF_MAIN_SECTIONS; sectionID++)
     {
         if (!QLIB_REG_GMT_IS_CONFIGURED(gmt))
@@ -3512,6 +3826,57 @@ static QLIB_STATUS_T QLIB_SEC_GetSectionsSize_L(QLIB_CONTEXT_T* qlibContext)
     return QLIB_STATUS__OK;
 }
 
+/************************************************************************************************************
+ * @brief       This function returns the SCRn of a section. The host copy is used unless it was read
+ *              unsigned and a signed read is required, in which case it is read again
+ *
+ * @param       qlibContext   QLIB state object
+ * @param       sectionID     Section index
+ * @param[out]  SCRn          SCRn register value
+ *
+ * @return      QLIB_STATUS__OK on success or QLIB_STATUS__[ERROR] otherwise
+************************************************************************************************************/
+static QLIB_STATUS_T QLIB_SEC_GetSCRn_L(QLIB_CONTEXT_T* qlibContext, U32 sectionID, SCRn_T SCRn)
+{
+    QLIB_CONFIG_SHADOW_T* shadow = &QLIB_ACTIVE_DIE_STATE(qlibContext).configShadow;
+
+    if (!QLIB_SEC__SHADOW_HIT(qlibContext, sectionID))
+    {
+        shadow->valid &= ~(1u << sectionID);
+        QLIB_STATUS_RET_CHECK(QLIB_SEC__get_SCRn(qlibContext, sectionID, shadow->SCRn[sectionID]));
+        shadow->valid |= (1u << sectionID);
+        WRITE_VAR_BIT_32(shadow->signedMask, sectionID, QLIB_EXECUTE_SIGNED_GET(qlibContext));
+    }
+    (void)memcpy(SCRn, shadow->SCRn[sectionID], sizeof(SCRn_T));
+
+    return QLIB_STATUS__OK;
+}
+
+/************************************************************************************************************
+ * @brief       This function returns the GMT. The host copy is used unless it was read unsigned and
+ *              a signed read is required, in which case it is read again
+ *
+ * @param       qlibContext   QLIB state object
+ * @param[out]  GMT           GMT register value
+ *
+ * @return      QLIB_STATUS__OK on success or QLIB_STATUS__[ERROR] otherwise
+************************************************************************************************************/
+static QLIB_STATUS_T QLIB_SEC_GetGMT_L(QLIB_CONTEXT_T* qlibContext, GMT_T* GMT)
+{
+    QLIB_CONFIG_SHADOW_T* shadow = &QLIB_ACTIVE_DIE_STATE(qlibContext).configShadow;
+
+    if (!QLIB_SEC__SHADOW_HIT(qlibContext, QLIB_CONFIG_SHADOW_GMT))
+    {
+        shadow->valid &= ~(1u << QLIB_CONFIG_SHADOW_GMT);
+        QLIB_STATUS_RET_CHECK(QLIB_SEC__get_GMT(qlibContext, &shadow->GMT));
+        shadow->valid |= (1u << QLIB_CONFIG_SHADOW_GMT);
+        WRITE_VAR_BIT_32(shadow->signedMask, QLIB_CONFIG_SHADOW_GMT, QLIB_EXECUTE_SIGNED_GET(qlibContext));
+    }
+    (void)memcpy(GMT, &shadow->GMT, sizeof(GMT_T));
+
+    return QLIB_STATUS__OK;
+}
+
 /************************************************************************************************************
  * @brief       This function reads the watchdog configuration from the device
  *
@@ -3562,10 +3927,21 @@ QLIB_STATUS_T QLIB_SEC_SecureLogRead(QLIB_CONTEXT_T* qlibContext, U8* buf, U32*
     return QLIB_STATUS__OK;
 }
 
-QLIB_STATUS_T QLIB_SEC_SecureLogWrite(QLIB_CONTEXT_T* qlibContext, const U8* buf, U32 sectionID, U32 size, BOOL secure)
+QLIB_STATUS_T QLIB_SEC_SecureLogWrite(QLIB_CONTEXT_T* qlibContext,
+                                      const U8*       buf,
+                                      U32             sectionID,
+                                      U32             size,
+                                      BOOL            secure,
+                                      U32*            written)
 {
-    U32 offset;
-    U32 alignedLogEntry[QLIB_SEC_LOG_ENTRY_SIZE / sizeof(U32)];
+    U32           offset;
+    U32           alignedLogEntry[QLIB_SEC_LOG_ENTRY_SIZE / sizeof(U32)];
+    QLIB_STATUS_T ret = QLIB_STATUS__OK;
+
+    if (NULL != written)
+    {
+        *written = 0;
+    }
 
     /********************************************************************************************************
      * Secure command is ignored if power is down or suspended
@@ -3580,6 +3956,15 @@ QLIB_STATUS_T QLIB_SEC_SecureLogWrite(QLIB_CONTEXT_T* qlibContext, const U8* buf
     QLIB_ASSERT_RET((FALSE == secure) || (QLIB_KEY_MNGR__SESSION_IS_OPEN(qlibContext)), QLIB_STATUS__DEVICE_SESSION_ERR);
     QLIB_ASSERT_RET(ALIGNED_TO(size, QLIB_SEC_LOG_ENTRY_SIZE), QLIB_STATUS__INVALID_DATA_SIZE);
 
+    /********************************************************************************************************
+     * Mark multi-transaction command
+    ********************************************************************************************************/
+    qlibContext->multiTransactionCmd = TRUE;
+
+#ifdef QLIB_SPI_OPTIMIZATION_ENABLED
+    PLAT_SPI_MultiTransactionStart();
+#endif //QLIB_SPI_OPTIMIZATION_ENABLED
+
     offset = 0;
     while (0u != size)
     {
@@ -3587,17 +3972,33 @@ QLIB_STATUS_T QLIB_SEC_SecureLogWrite(QLIB_CONTEXT_T* qlibContext, const U8* buf
 
         if (TRUE == secure)
         {
-            QLIB_STATUS_RET_CHECK(QLIB_CMD_PROC__LOG_SAWR(qlibContext, alignedLogEntry));
+            QLIB_STATUS_RET_CHECK_GOTO(QLIB_CMD_PROC__LOG_SAWR(qlibContext, alignedLogEntry), ret, finish);
         }
         else
         {
-            QLIB_STATUS_RET_CHECK(QLIB_CMD_PROC__LOG_PWR(qlibContext, sectionID, alignedLogEntry));
+            QLIB_STATUS_RET_CHECK_GOTO(QLIB_CMD_PROC__LOG_PWR(qlibContext, sectionID, alignedLogEntry), ret, finish);
+        }
+        if (NULL != written)
+        {
+            (*written)++;
         }
         offset += QLIB_SEC_LOG_ENTRY_SIZE;
         size -= QLIB_SEC_LOG_ENTRY_SIZE;
     }
 
-    return QLIB_STATUS__OK;
+finish:
+    /********************************************************************************************************
+     * Multi-transaction ended
+    ********************************************************************************************************/
+    if (qlibContext->multiTransactionCmd == 1u)
+    {
+        qlibContext->multiTransactionCmd = 0u;
+
+#ifdef QLIB_SPI_OPTIMIZATION_ENABLED
+        PLAT_SPI_MultiTransactionStop();
+#endif //QLIB_SPI_OPTIMIZATION_ENABLED
+    }
+    return ret;
 }
 
 /************************************************************************************************************
@@ -3748,21 +4149,37 @@ static QLIB_STATUS_T QLIB_SEC_HwAuthPlainAccess_Grant_L(QLIB_CONTEXT_T* qlibCont
     QLIB_ASSERT_RET(QLIB_ACTIVE_DIE_STATE(qlibContext).isPoweredDown == 0u, QLIB_STATUS__COMMAND_IGNORED);
     QLIB_ASSERT_RET(qlibContext->isSuspended == 0u, QLIB_STATUS__COMMAND_IGNORED);
 
+    QLIB_STATUS_RET_CHECK(QLIB_SEC_GetPlainAccessGrantKid_L(qlibContext, sectionID, &kid));
+    QLIB_STATUS_RET_CHECK(QLIB_CMD_PROC__PA_grant(qlibContext, kid));
+
+    return QLIB_STATUS__OK;
+}
+
+/************************************************************************************************************
+ * @brief       This function selects the key used to grant plain access to the section.
+ *              The restricted key is preferred over the full access key
+ *
+ * @param       qlibContext   QLIB state object
+ * @param       sectionID     Section index
+ * @param       kid           Key ID
+ *
+ * @return      QLIB_STATUS__OK on success or QLIB_STATUS__DEVICE_PRIVILEGE_ERR if no key is loaded
+************************************************************************************************************/
+static QLIB_STATUS_T QLIB_SEC_GetPlainAccessGrantKid_L(QLIB_CONTEXT_T* qlibContext, U32 sectionID, QLIB_KID_T* kid)
+{
     if (NULL != QLIB_KEY_MNGR__GET_SECTION_KEY_RESTRICTED(qlibContext, sectionID))
     {
-        kid = QLIB_KEY_MNGR__KID_WITH_SECTION(QLIB_KID__RESTRICTED_ACCESS_SECTION, sectionID);
+        *kid = QLIB_KEY_MNGR__KID_WITH_SECTION(QLIB_KID__RESTRICTED_ACCESS_SECTION, sectionID);
     }
     else if (NULL != QLIB_KEY_MNGR__GET_SECTION_KEY_FULL_ACCESS(qlibContext, sectionID))
     {
-        kid = QLIB_KEY_MNGR__KID_WITH_SECTION(QLIB_KID__FULL_ACCESS_SECTION, sectionID);
+        *kid = QLIB_KEY_MNGR__KID_WITH_SECTION(QLIB_KID__FULL_ACCESS_SECTION, sectionID);
     }
     else
     {
         return QLIB_STATUS__DEVICE_PRIVILEGE_ERR;
     }
 
-    QLIB_STATUS_RET_CHECK(QLIB_CMD_PROC__PA_grant(qlibContext, kid));
-
     return QLIB_STATUS__OK;
 }
 
@@ -4170,6 +4587,90 @@ static QLIB_STATUS_T QLIB_SEC_GetVaultSize_L(QLIB_CONTEXT_T* qlibContext)
     return QLIB_STATUS__OK;
 }
 
+/************************************************************************************************************
+ * @brief       This function returns the digest of a section used in its CDI.
+ *              The stored digest is used if the section is digest protected, otherwise it is recalculated
+ *
+ * @param       qlibContext   QLIB state object
+ * @param       sectionId     Section index
+ * @param[out]  digest        Section digest
+ *
+ * @return      QLIB_STATUS__OK on success or QLIB_STATUS__[ERROR] otherwise
+************************************************************************************************************/
+static QLIB_STATUS_T QLIB_SEC_GetCDIDigest_L(QLIB_CONTEXT_T* qlibContext, U32 sectionId, U64* digest)
+{
+    QLIB_POLICY_T policy;
+
+    (void)memset(&policy, 0, sizeof(QLIB_POLICY_T));
+    *digest = 0;
+    QLIB_STATUS_RET_CHECK(QLIB_SEC_GetSectionConfiguration(qlibContext, sectionId, NULL, NULL, &policy, digest, NULL, NULL));
+
+    if (((policy.digestIntegrity == 1u) ||
+         ((Q2_POLICY_AUTH_PROT_AC_BIT(qlibContext) != 0u) && (policy.digestIntegrityOnAccess == 1u))) &&
+        ((policy.writeProt == 1u) || (policy.rollbackProt == 1u)))
+    {
+        /*-------------------------------------------------------------------------------------------------*/
+        /* Using stored digest                                                                             */
+        /*-------------------------------------------------------------------------------------------------*/
+        QLIB_ASSERT_RET(*digest != 0u, QLIB_STATUS__SYSTEM_IN_INCORRECT_STATE);
+    }
+    else
+    {
+        /*-------------------------------------------------------------------------------------------------*/
+        /* recalculating digest                                                                            */
+        /*-------------------------------------------------------------------------------------------------*/
+        QLIB_STATUS_RET_CHECK(QLIB_CMD_PROC__CALC_SIG(qlibContext,
+                                                      QLIB_SIGNED_DATA_TYPE_SECTION_DIGEST,
+                                                      sectionId,
+                                                      NULL,
+                                                      0,
+                                                      digest,
+                                                      sizeof(U64),
+                                                      NULL));
+    }
+
+    return QLIB_STATUS__OK;
+}
+
+/************************************************************************************************************
+ * @brief       This function calculates the CDI of a module from the CDI of the previous module
+ *
+ * @param[out]  nextCdi       CDI value produced by this module
+ * @param[in]   prevCdi       CDI value obtained from previous module
+ * @param[in]   digest        Digest of the module section
+ * @param[in]   sectionId     Section index
+ *
+ * @return      QLIB_STATUS__OK on success or QLIB_STATUS__[ERROR] otherwise
+************************************************************************************************************/
+static QLIB_STATUS_T QLIB_SEC_CDIHash_L(_256BIT nextCdi, const _256BIT prevCdi, U64 digest, U32 sectionId)
+{
+    _512BIT hashData;
+    U8*     hashDataP = (U8*)hashData;
+
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* data consists of the following                                                                      */
+    /* 256 bit  => prevCdi                                                                                 */
+    /* 64  bit  => digest                                                                                  */
+    /* 64  bit  => zero bits                                                                               */
+    /* 48  bit  => zero bits                                                                               */
+    /* 8   bit  => index                                                                                   */
+    /*-----------------------------------------------------------------------------------------------------*/
+    (void)memcpy((void*)hashDataP, (const void*)prevCdi, BITS_TO_BYTES(256u));
+    hashDataP += BITS_TO_BYTES(256u);
+
+    (void)memcpy((void*)hashDataP, (void*)&digest, BITS_TO_BYTES(64u));
+    hashDataP += BITS_TO_BYTES(64u);
+
+    (void)memset(hashDataP, 0, BITS_TO_BYTES(112u));
+    hashDataP += BITS_TO_BYTES(112u);
+
+    (void)memcpy((void*)hashDataP, (void*)&sectionId, BITS_TO_BYTES(8u));
+
+    QLIB_STATUS_RET_CHECK(QLIB_HASH(nextCdi, hashData, BITS_TO_BYTES(256u + 64u + 112u + 8u)));
+
+    return QLIB_STATUS__OK;
+}
+
 #if !defined EXCLUDE_LMS_ATTESTATION && !defined Q2_API
 /************************************************************************************************************
  * @brief This function calculates the OTS signature for give message hash using internal flash state
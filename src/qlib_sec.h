@@ -58,6 +58,25 @@ extern "C" {
     (QLIB_EXECUTE_SIGNED_GET(contextP) ? QLIB_CMD_PROC__get_SSR_SIGNED((contextP), (ssr), (mask)) \
                                        : QLIB_CMD_PROC__get_SSR_UNSIGNED((contextP), (ssr), (mask)))
 
+/*---------------------------------------------------------------------------------------------------------*/
+/* Drops the host copy of the configuration registers. Called before any command that may change them      */
+/*---------------------------------------------------------------------------------------------------------*/
+#define QLIB_SEC__SHADOW_INVALIDATE(contextP) (QLIB_ACTIVE_DIE_STATE(contextP).configShadow.valid = 0u)
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Drops the host copy of ACLR. Called before any command that grants or revokes plain access              */
+/*---------------------------------------------------------------------------------------------------------*/
+#define QLIB_SEC__SHADOW_INVALIDATE_ACLR(contextP) \
+    (QLIB_ACTIVE_DIE_STATE(contextP).configShadow.valid &= ~(1u << QLIB_CONFIG_SHADOW_ACLR))
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Shadow entry can be used. An entry read unsigned is not used when a signed read is required             */
+/*---------------------------------------------------------------------------------------------------------*/
+#define QLIB_SEC__SHADOW_HIT(contextP, bit)                                                     \
+    ((READ_VAR_BIT(QLIB_ACTIVE_DIE_STATE(contextP).configShadow.valid, (bit)) != 0u) &&         \
+     (!QLIB_EXECUTE_SIGNED_GET(contextP) ||                                                     \
+      (READ_VAR_BIT(QLIB_ACTIVE_DIE_STATE(contextP).configShadow.signedMask, (bit)) != 0u)))
+
 #define QLIB_SEC__get_ESSR(contextP, essr)                                                  \
     (QLIB_EXECUTE_SIGNED_GET(contextP) ? QLIB_CMD_PROC__get_ESSR_SIGNED((contextP), (essr)) \
                                        : QLIB_CMD_PROC__get_ESSR_UNSIGNED((contextP), (essr)))
@@ -366,6 +385,26 @@ QLIB_STATUS_T QLIB_SEC_CloseSession(QLIB_CONTEXT_T* qlibContext, U32 sectionID);
 ************************************************************************************************************/
 QLIB_STATUS_T QLIB_SEC_AuthPlainAccess_Grant(QLIB_CONTEXT_T* qlibContext, U32 sectionID);
 
+/************************************************************************************************************
+ * @brief       This function grants plain access to several authenticated plain access sections.
+ *              The grant keys are selected for all the sections before any command is sent, and the
+ *              grants are sent back to back in a single multi-transaction sequence.
+ *              Integrity errors are collected and do not stop the sequence
+ *
+ * @param       qlibContext        QLIB state object
+ * @param       sectionIDs         Section indexes
+ * @param       num                Number of sections
+ * @param       grantedMask        Bit mask of the sections that were granted, also valid on error
+ * @param       integrityErrMask   Bit mask of the sections that failed the integrity check
+ *
+ * @return      QLIB_STATUS__OK on success or QLIB_STATUS__[ERROR] otherwise
+************************************************************************************************************/
+QLIB_STATUS_T QLIB_SEC_AuthPlainAccess_GrantMulti(QLIB_CONTEXT_T* qlibContext,
+                                                  const U32*      sectionIDs,
+                                                  U32             num,
+                                                  U32*            grantedMask,
+                                                  U32*            integrityErrMask);
+
 /************************************************************************************************************
  * @brief       This function revokes plain access from a section
  *
@@ -443,6 +482,20 @@ QLIB_STATUS_T QLIB_SEC_MemCopy(QLIB_CONTEXT_T* qlibContext, U32 dest, U32 src, U
 ************************************************************************************************************/
 QLIB_STATUS_T QLIB_SEC_MemCrc(QLIB_CONTEXT_T* qlibContext, U32* crc32, U32 sectionID, U32 offset, U32 size);
 
+/************************************************************************************************************
+ * @brief       This function calculates the CRC-32 checksum of every block of a memory Section or part of it
+ *
+ * @param       qlibContext   QLIB state object
+ * @param       crcMap        Array of DIV_CEIL(size, blockSize) entries where the checksums will be stored
+ * @param       sectionID     Section index
+ * @param       offset        Starting offset of the memory section
+ * @param       size          Size of the memory section
+ * @param       blockSize     Size of a block
+ *
+ * @return      QLIB_STATUS__OK on success or QLIB_STATUS__[ERROR] otherwise
+************************************************************************************************************/
+QLIB_STATUS_T QLIB_SEC_MemCrcMap(QLIB_CONTEXT_T* qlibContext, U32* crcMap, U32 sectionID, U32 offset, U32 size, U32 blockSize);
+
 /************************************************************************************************************
  * @brief       This function erases the entire section with either plain-text or secure command
  *
@@ -466,6 +519,16 @@ QLIB_STATUS_T QLIB_SEC_EraseSection(QLIB_CONTEXT_T* qlibContext, U32 sectionID,
 ************************************************************************************************************/
 QLIB_STATUS_T QLIB_SEC_ConfigAccess(QLIB_CONTEXT_T* qlibContext, U32 sectionID, BOOL readEnable, BOOL writeEnable);
 
+/************************************************************************************************************
+ * @brief       This function returns the ACLR register. The host copy is used if it is valid
+ *
+ * @param       qlibContext   QLIB state object
+ * @param[out]  aclr          ACLR register value
+ *
+ * @return      QLIB_STATUS__OK on success or QLIB_STATUS__[ERROR] otherwise
+************************************************************************************************************/
+QLIB_STATUS_T QLIB_SEC_GetACLR(QLIB_CONTEXT_T* qlibContext, ACLR_T* aclr);
+
 /************************************************************************************************************
  * @brief       This function allows loading of the section keys
  *
@@ -502,6 +565,25 @@ QLIB_STATUS_T QLIB_SEC_RemoveKey(QLIB_CONTEXT_T* qlibContext, U32 sectionID, BOO
 ************************************************************************************************************/
 QLIB_STATUS_T QLIB_SEC_CheckIntegrity(QLIB_CONTEXT_T* qlibContext, U32 sectionID, QLIB_INTEGRITY_T integrityType);
 
+/************************************************************************************************************
+ * @brief       This function forces an integrity check on several sections. The policies are read first,
+ *              then the checks are issued back to back. All sections must be configured for the
+ *              integrity type
+ *
+ * @param       qlibContext     QLIB state object
+ * @param       sectionMask     Bit mask of the sections to check
+ * @param       integrityType   The integrity type to perform
+ * @param       checkedMask     Bit mask of the sections checked
+ * @param       failedMask      Bit mask of the sections that failed the check
+ *
+ * @return      QLIB_STATUS__OK on success or QLIB_STATUS__[ERROR] otherwise
+************************************************************************************************************/
+QLIB_STATUS_T QLIB_SEC_CheckIntegrityAll(QLIB_CONTEXT_T*  qlibContext,
+                                         U32              sectionMask,
+                                         QLIB_INTEGRITY_T integrityType,
+                                         U32*             checkedMask,
+                                         U32*             failedMask);
+
 /************************************************************************************************************
  * @brief       This function returns CDI value
  *
@@ -514,6 +596,26 @@ QLIB_STATUS_T QLIB_SEC_CheckIntegrity(QLIB_CONTEXT_T* qlibContext, U32 sectionID
 ************************************************************************************************************/
 QLIB_STATUS_T QLIB_SEC_CalcCDI(QLIB_CONTEXT_T* qlibContext, _256BIT nextCdi, const _256BIT prevCdi, U32 sectionId);
 
+/************************************************************************************************************
+ * @brief       This function returns the CDI values of a chain of modules.
+ *              The digests of all the sections are retrieved first in one multi-transaction sequence,
+ *              then the chain is hashed on the host
+ *
+ * @param       qlibContext     QLIB state object
+ * @param[out]  cdis            CDI value produced by every module
+ * @param[in]   prevCdi         CDI value obtained from the module before the chain, unused if the chain
+ *                              starts with section 0
+ * @param[in]   sectionIds      Section numbers of the modules, in chain order
+ * @param[in]   num             Number of modules
+ *
+ * @return      QLIB_STATUS__OK on success or QLIB_STATUS__[ERROR] otherwise
+************************************************************************************************************/
+QLIB_STATUS_T QLIB_SEC_CalcCDIChain(QLIB_CONTEXT_T* qlibContext,
+                                    _256BIT*        cdis,
+                                    const _256BIT   prevCdi,
+                                    const U32*      sectionIds,
+                                    U32             num);
+
 /************************************************************************************************************
  * @brief       This function configures the Secure Watchdog functionality.
  *              The key used for the Watchdog functionality, is the key used in currently open session.
@@ -718,10 +820,16 @@ QLIB_STATUS_T QLIB_SEC_SecureLogRead(QLIB_CONTEXT_T* qlibContext, U8* buf, U32*
  * @param       sectionID     Section index
  * @param       size          Data size
  * @param       secure         If TRUE then secure write, else standard write.
+ * @param       written       Number of entries written, also on failure. Can be NULL
  *
  * @return      QLIB_STATUS__OK on success or QLIB_STATUS__[ERROR] otherwise
 ************************************************************************************************************/
-QLIB_STATUS_T QLIB_SEC_SecureLogWrite(QLIB_CONTEXT_T* qlibContext, const U8* buf, U32 sectionID, U32 size, BOOL secure);
+QLIB_STATUS_T QLIB_SEC_SecureLogWrite(QLIB_CONTEXT_T* qlibContext,
+                                      const U8*       buf,
+                                      U32             sectionID,
+                                      U32             size,
+                                      BOOL            secure,
+                                      U32*            written);
 
 /************************************************************************************************************
  * @brief       This function returns an arbitrary number of random bytes generated by the Secure Flash
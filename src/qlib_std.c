@@ -49,6 +49,11 @@
 #define Q3_READY_TEST_NUM_RETRIES       (Q3_MAX_FLASH_BOOT_CYCLES / Q3_MIN_READY_TEST_CYCLES)
 
 #define READY_TEST_NUM_RETRIES MAX(Q2_READY_TEST_NUM_RETRIES, Q3_READY_TEST_NUM_RETRIES)
+
+#define MIN_READ_STATUS_CYCLES         (4)    // num cycles for read status register 1 command in QPI mode
+#define MAX_PAGE_PROGRAM_TIME_MICROSEC (5000) // page program time (5ms max)
+#define PAGE_PROGRAM_NUM_POLLS \
+    ((MAX(Q2_MAX_SPI_FREQUENCY_IN_MHz, Q3_MAX_SPI_FREQUENCY_IN_MHz) * MAX_PAGE_PROGRAM_TIME_MICROSEC) / MIN_READ_STATUS_CYCLES)
 /*---------------------------------------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------------------------------------*/
 /*                                             LOCAL FUNCTIONS                                             */
@@ -77,14 +82,13 @@ static QLIB_STATUS_T QLIB_STD_GetQuadEnableFromSR_L(QLIB_CONTEXT_T* qlibContext,
 static QLIB_STATUS_T QLIB_STD_SetStatus_L(QLIB_CONTEXT_T*     qlibContext,
                                           STD_FLASH_STATUS_T  statusIn,
                                           STD_FLASH_STATUS_T* statusOut);
-static QLIB_STATUS_T QLIB_STD_PageProgram_L(QLIB_CONTEXT_T* qlibContext,
-                                            const U8*       input,
-                                            U32             logicalAddr,
-                                            U32             size,
-                                            BOOL            blocking);
+#ifndef QLIB_SUPPORT_XIP
+static QLIB_STATUS_T QLIB_STD_WaitWhileBusy_L(QLIB_CONTEXT_T* qlibContext);
+#endif
 static U8            QLIB_STD_GetReadCMD_L(QLIB_CONTEXT_T* qlibContext, U32* dummyCycles, QLIB_BUS_MODE_T* format);
 static U8            QLIB_STD_GetWriteCMD_L(QLIB_CONTEXT_T* qlibContext, QLIB_BUS_MODE_T* format);
 static U8 QLIB_STD_GetReadDummyCyclesCMD_L(QLIB_CONTEXT_T* qlibContext, QLIB_BUS_MODE_T busMode, BOOL dtr, U32* dummyCycles);
+static const QLIB_STD_CMD_DESC_T* QLIB_STD_GetCmdDesc_L(QLIB_CONTEXT_T* qlibContext, QLIB_STD_CMD_DESC_ID_T id);
 #ifdef QLIB_SUPPORT_QPI
 static QLIB_STATUS_T QLIB_STD_CheckWritePrivilege_L(QLIB_CONTEXT_T* qlibContext, U32 logicalAddr);
 #endif // QLIB_SUPPORT_QPI
@@ -235,10 +239,107 @@ QLIB_STATUS_T
     /*-----------------------------------------------------------------------------------------------------*/
     qlibContext->busInterface.busMode = QLIB_BUS_FORMAT_GET_MODE(busFormat);
     qlibContext->busInterface.dtr     = QLIB_BUS_FORMAT_GET_DTR(busFormat);
+    QLIB_STD_UpdateCmdTable(qlibContext);
 
     return QLIB_STATUS__OK;
 }
 
+void QLIB_STD_UpdateCmdTable(QLIB_CONTEXT_T* qlibContext)
+{
+    QLIB_STD_CMD_TABLE_T* table = &qlibContext->stdCmdTable;
+    QLIB_STD_CMD_DESC_T*  desc;
+    U32                   dummyCycles = 0;
+
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Read command                                                                                        */
+    /*-----------------------------------------------------------------------------------------------------*/
+    desc              = &table->desc[QLIB_STD_CMD_DESC__READ];
+    desc->format      = QLIB_BUS_MODE_INVALID;
+    desc->cmd         = QLIB_STD_GetReadCMD_L(qlibContext, &dummyCycles, &desc->format);
+    desc->dtr         = (U8)qlibContext->busInterface.dtr;
+    desc->modeExist   = SPI_FLASH_CMD_FAST_READ__MODE_EXIST(qlibContext, desc->cmd) ? 1u : 0u;
+    desc->dummyCycles = (U8)dummyCycles;
+
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Page program command                                                                                */
+    /*-----------------------------------------------------------------------------------------------------*/
+    desc              = &table->desc[QLIB_STD_CMD_DESC__PROGRAM];
+    desc->format      = QLIB_BUS_MODE_INVALID;
+    desc->cmd         = QLIB_STD_GetWriteCMD_L(qlibContext, &desc->format);
+    desc->dtr         = 0u;
+    desc->modeExist   = 0u;
+    desc->dummyCycles = 0u;
+
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Save the configuration the table was built for                                                      */
+    /*-----------------------------------------------------------------------------------------------------*/
+    table->busMode       = qlibContext->busInterface.busMode;
+    table->dtr           = (U8)qlibContext->busInterface.dtr;
+    table->fastReadDummy = qlibContext->fastReadDummy;
+    table->valid         = 1u;
+}
+
+U32 QLIB_STD_GetReadCycles(QLIB_CONTEXT_T* qlibContext, U32 size)
+{
+    const QLIB_STD_CMD_DESC_T* desc      = QLIB_STD_GetCmdDesc_L(qlibContext, QLIB_STD_CMD_DESC__READ);
+    U32                        cmdWidth  = 1;
+    U32                        addrWidth = 1;
+    U32                        dataWidth = 1;
+    U32                        addrBits  = (qlibContext->addrMode == QLIB_STD_ADDR_MODE__4_BYTE) ? 32u : 24u;
+    U32                        rate      = (desc->dtr != 0u) ? 2u : 1u;
+    U32                        cycles;
+
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Number of data lines of the command, address and data phases                                        */
+    /*-----------------------------------------------------------------------------------------------------*/
+    switch (desc->format)
+    {
+        case QLIB_BUS_MODE_1_1_2:
+            dataWidth = 2;
+            break;
+        case QLIB_BUS_MODE_1_2_2:
+            addrWidth = 2;
+            dataWidth = 2;
+            break;
+        case QLIB_BUS_MODE_1_1_4:
+            dataWidth = 4;
+            break;
+        case QLIB_BUS_MODE_1_4_4:
+            addrWidth = 4;
+            dataWidth = 4;
+            break;
+        case QLIB_BUS_MODE_4_4_4:
+            cmdWidth  = 4;
+            addrWidth = 4;
+            dataWidth = 4;
+            break;
+        case QLIB_BUS_MODE_1_8_8:
+            addrWidth = 8;
+            dataWidth = 8;
+            break;
+        case QLIB_BUS_MODE_8_8_8:
+            cmdWidth  = 8;
+            addrWidth = 8;
+            dataWidth = 8;
+            break;
+        default:
+            // single SPI
+            break;
+    }
+
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Command, address, mode, dummy and data cycles                                                       */
+    /*-----------------------------------------------------------------------------------------------------*/
+    cycles = (8u / cmdWidth) + (addrBits / (addrWidth * rate)) + (U32)desc->dummyCycles;
+    if (desc->modeExist != 0u)
+    {
+        cycles += 8u / (addrWidth * rate);
+    }
+    cycles += ((size * 8u) + (dataWidth * rate) - 1u) / (dataWidth * rate);
+
+    return cycles;
+}
+
 QLIB_STATUS_T QLIB_STD_SetQuadEnable(QLIB_CONTEXT_T* qlibContext, BOOL enable)
 {
     if (W77Q_EXTENDED_CONFIG_REGISTER(qlibContext) != 0u)
@@ -291,10 +392,11 @@ QLIB_STATUS_T QLIB_STD_SetResetInEnable(QLIB_CONTEXT_T* qlibContext, BOOL enable
 
 QLIB_STATUS_T QLIB_STD_Read(QLIB_CONTEXT_T* qlibContext, U8* output, U32 logicalAddr, U32 size)
 {
-    U8              readCMD     = 0;
-    U32             dummyCycles = 0;
-    QLIB_BUS_MODE_T format      = QLIB_BUS_MODE_INVALID;
-    U8              mode;
+    const QLIB_STD_CMD_DESC_T* desc      = NULL;
+    U8                         mode      = SPI_FLASH_CMD_FAST_READ__MODE_BYTE;
+    U32                        chunkSize = (qlibContext->readChunkSize != 0u) ? qlibContext->readChunkSize : size;
+    U32                        size_tmp  = 0;
+    BOOL                       last      = FALSE;
 
     /*-----------------------------------------------------------------------------------------------------*/
     /* Error checking                                                                                      */
@@ -304,33 +406,137 @@ QLIB_STATUS_T QLIB_STD_Read(QLIB_CONTEXT_T* qlibContext, U8* output, U32 logical
     /*-----------------------------------------------------------------------------------------------------*/
     /* Get read command                                                                                    */
     /*-----------------------------------------------------------------------------------------------------*/
-    readCMD = QLIB_STD_GetReadCMD_L(qlibContext, &dummyCycles, &format);
+    desc = QLIB_STD_GetCmdDesc_L(qlibContext, QLIB_STD_CMD_DESC__READ);
+
+    do
+    {
+        size_tmp = MIN(size, chunkSize);
+        last     = (size_tmp == size) ? TRUE : FALSE;
+
+        /*-------------------------------------------------------------------------------------------------*/
+        /* Perform read. Status is read only after the last chunk (SSR error bits are sticky)              */
+        /*-------------------------------------------------------------------------------------------------*/
+        QLIB_STATUS_RET_CHECK(QLIB_STD_execute_std_cmd_L(qlibContext,
+                                                         desc->format,
+                                                         (BOOL)desc->dtr,
+                                                         FALSE,
+                                                         last,
+                                                         desc->cmd,
+                                                         &logicalAddr,
+                                                         (desc->modeExist != 0u) ? &mode : NULL,
+                                                         (desc->modeExist != 0u) ? 1u : 0u,
+                                                         desc->dummyCycles,
+                                                         output,
+                                                         size_tmp,
+                                                         (TRUE == last) ? &QLIB_ACTIVE_DIE_STATE(qlibContext).ssr : NULL));
+
+        output += size_tmp;
+        logicalAddr += size_tmp;
+        size -= size_tmp;
+    } while (0u < size);
 
     /*-----------------------------------------------------------------------------------------------------*/
-    /* Perform read                                                                                        */
+    /* Error checking                                                                                      */
     /*-----------------------------------------------------------------------------------------------------*/
-    if (SPI_FLASH_CMD_FAST_READ__MODE_EXIST(qlibContext, readCMD))
+    QLIB_STATUS_RET_CHECK(QLIB_CMD_PROC__checkLastSsrErrors(qlibContext, SSR_MASK__ALL_ERRORS));
+
+    return QLIB_STATUS__OK;
+}
+
+QLIB_STATUS_T QLIB_STD_ReadStream(QLIB_CONTEXT_T*        qlibContext,
+                                  U32                    logicalAddr,
+                                  U32                    size,
+                                  U8*                    buf,
+                                  U32                    chunkSize,
+                                  QLIB_READ_CHUNK_FUNC_T consumer,
+                                  void*                  arg)
+{
+    U32 offset   = 0;
+    U32 size_tmp = 0;
+    U8* chunk    = buf;
+#ifdef QLIB_SPI_ASYNC_READ_ENABLED
+    QLIB_STATUS_T              ret  = QLIB_STATUS__OK;
+    const QLIB_STD_CMD_DESC_T* desc = NULL;
+    U8                         mode = SPI_FLASH_CMD_FAST_READ__MODE_BYTE;
+    U32                        addr = logicalAddr;
+#endif
+
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Error checking                                                                                      */
+    /*-----------------------------------------------------------------------------------------------------*/
+    QLIB_ASSERT_RET((buf != NULL) && (consumer != NULL) && (0u < chunkSize), QLIB_STATUS__INVALID_PARAMETER);
+
+#ifdef QLIB_SPI_ASYNC_READ_ENABLED
+    QLIB_ASSERT_RET(QLIB_ACTIVE_DIE_STATE(qlibContext).isPoweredDown == 0u, QLIB_STATUS__COMMAND_IGNORED);
+    desc = QLIB_STD_GetCmdDesc_L(qlibContext, QLIB_STD_CMD_DESC__READ);
+
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Start the first chunk                                                                               */
+    /*-----------------------------------------------------------------------------------------------------*/
+    if (0u < size)
     {
-        mode = SPI_FLASH_CMD_FAST_READ__MODE_BYTE;
+        QLIB_STATUS_RET_CHECK(QLIB_TM_StandardReadAsync(qlibContext,
+                                                        QLIB_BUS_FORMAT(desc->format, (BOOL)desc->dtr),
+                                                        desc->cmd,
+                                                        &addr,
+                                                        (desc->modeExist != 0u) ? &mode : NULL,
+                                                        (desc->modeExist != 0u) ? 1u : 0u,
+                                                        desc->dummyCycles,
+                                                        chunk,
+                                                        MIN(size, chunkSize)));
     }
-    QLIB_STATUS_RET_CHECK(QLIB_STD_execute_std_cmd_L(qlibContext,
-                                                     format,
-                                                     qlibContext->busInterface.dtr,
-                                                     FALSE,
-                                                     TRUE,
-                                                     readCMD,
-                                                     &logicalAddr,
-                                                     SPI_FLASH_CMD_FAST_READ__MODE_EXIST(qlibContext, readCMD) ? &mode : NULL,
-                                                     SPI_FLASH_CMD_FAST_READ__MODE_EXIST(qlibContext, readCMD) ? 1u : 0u,
-                                                     dummyCycles,
-                                                     output,
-                                                     size,
-                                                     &QLIB_ACTIVE_DIE_STATE(qlibContext).ssr));
+#endif
+
+    while (offset < size)
+    {
+        size_tmp = MIN(size - offset, chunkSize);
+
+#ifdef QLIB_SPI_ASYNC_READ_ENABLED
+        /*-------------------------------------------------------------------------------------------------*/
+        /* Wait for the current chunk and start the next one into the other half of the buffer             */
+        /*-------------------------------------------------------------------------------------------------*/
+        QLIB_STATUS_RET_CHECK(QLIB_TM_StandardReadAsyncWait(qlibContext));
+        if ((offset + size_tmp) < size)
+        {
+            addr = logicalAddr + offset + size_tmp;
+            QLIB_STATUS_RET_CHECK(QLIB_TM_StandardReadAsync(qlibContext,
+                                                            QLIB_BUS_FORMAT(desc->format, (BOOL)desc->dtr),
+                                                            desc->cmd,
+                                                            &addr,
+                                                            (desc->modeExist != 0u) ? &mode : NULL,
+                                                            (desc->modeExist != 0u) ? 1u : 0u,
+                                                            desc->dummyCycles,
+                                                            (chunk == buf) ? &buf[chunkSize] : buf,
+                                                            MIN(size - offset - size_tmp, chunkSize)));
+        }
+
+        ret = consumer(arg, chunk, offset, size_tmp);
+        if (QLIB_STATUS__OK != ret)
+        {
+            if ((offset + size_tmp) < size)
+            {
+                (void)QLIB_TM_StandardReadAsyncWait(qlibContext);
+            }
+            return ret;
+        }
+#else
+        /*-------------------------------------------------------------------------------------------------*/
+        /* Read the chunk and pass it to the consumer                                                      */
+        /*-------------------------------------------------------------------------------------------------*/
+        QLIB_STATUS_RET_CHECK(QLIB_STD_Read(qlibContext, chunk, logicalAddr + offset, size_tmp));
+        QLIB_STATUS_RET_CHECK(consumer(arg, chunk, offset, size_tmp));
+#endif
 
+        offset += size_tmp;
+        chunk = (chunk == buf) ? &buf[chunkSize] : buf;
+    }
+
+#ifdef QLIB_SPI_ASYNC_READ_ENABLED
     /*-----------------------------------------------------------------------------------------------------*/
     /* Error checking                                                                                      */
     /*-----------------------------------------------------------------------------------------------------*/
-    QLIB_STATUS_RET_CHECK(QLIB_CMD_PROC__checkLastSsrErrors(qlibContext, SSR_MASK__ALL_ERRORS));
+    QLIB_STATUS_RET_CHECK(QLIB_CMD_PROC__get_SSR_UNSIGNED(qlibContext, NULL, SSR_MASK__ALL_ERRORS));
+#endif
 
     return QLIB_STATUS__OK;
 }
@@ -338,6 +544,9 @@ QLIB_STATUS_T QLIB_STD_Read(QLIB_CONTEXT_T* qlibContext, U8* output, U32 logical
 QLIB_STATUS_T QLIB_STD_Write(QLIB_CONTEXT_T* qlibContext, const U8* input, U32 logicalAddr, U32 size)
 {
     U32 size_tmp = 0;
+#ifndef QLIB_SUPPORT_XIP
+    BOOL inProgress = FALSE;
+#endif
 
     /*-----------------------------------------------------------------------------------------------------*/
     /* Error checking                                                                                      */
@@ -355,10 +564,26 @@ QLIB_STATUS_T QLIB_STD_Write(QLIB_CONTEXT_T* qlibContext, const U8* input, U32 l
             size_tmp = size;
         }
 
+#ifdef QLIB_SUPPORT_XIP
+        /*-------------------------------------------------------------------------------------------------*/
+        /* One page program. Code can not execute from flash while it is busy, so every page is waited for */
+        /*-------------------------------------------------------------------------------------------------*/
+        QLIB_STATUS_RET_CHECK(QLIB_STD_PageProgram(qlibContext, input, logicalAddr, size_tmp, TRUE));
+#else
+        /*-------------------------------------------------------------------------------------------------*/
+        /* Next page is ready, wait for the previous page program to complete and check its status         */
+        /*-------------------------------------------------------------------------------------------------*/
+        if (TRUE == inProgress)
+        {
+            QLIB_STATUS_RET_CHECK(QLIB_STD_WaitWhileBusy_L(qlibContext));
+        }
+
         /*-------------------------------------------------------------------------------------------------*/
-        /* One page program                                                                                */
+        /* One page program. Pages are programmed without waiting, except of the last one                  */
         /*-------------------------------------------------------------------------------------------------*/
-        QLIB_STATUS_RET_CHECK(QLIB_STD_PageProgram_L(qlibContext, input, logicalAddr, size_tmp, TRUE));
+        inProgress = (size_tmp < size) ? TRUE : FALSE;
+        QLIB_STATUS_RET_CHECK(QLIB_STD_PageProgram(qlibContext, input, logicalAddr, size_tmp, (TRUE == inProgress) ? FALSE : TRUE));
+#endif // QLIB_SUPPORT_XIP
 
         /*-------------------------------------------------------------------------------------------------*/
         /* Update pointers for next iteration                                                              */
@@ -371,6 +596,76 @@ QLIB_STATUS_T QLIB_STD_Write(QLIB_CONTEXT_T* qlibContext, const U8* input, U32 l
     return QLIB_STATUS__OK;
 }
 
+QLIB_STATUS_T QLIB_STD_PageProgram(QLIB_CONTEXT_T* qlibContext, const U8* input, U32 logicalAddr, U32 size, BOOL blocking)
+{
+    const QLIB_STD_CMD_DESC_T* desc = NULL;
+#ifdef QLIB_SUPPORT_QPI
+#define BYPASS_MIN_WRITE_SIZE 16u
+    U8 buffer[BYPASS_MIN_WRITE_SIZE];
+#endif // QLIB_SUPPORT_QPI
+
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Error checking                                                                                      */
+    /*-----------------------------------------------------------------------------------------------------*/
+    QLIB_ASSERT_RET(0u < size, QLIB_STATUS__PARAMETER_OUT_OF_RANGE);
+    QLIB_ASSERT_RET(size <= FLASH_PAGE_SIZE, QLIB_STATUS__INVALID_DATA_SIZE);
+    QLIB_ASSERT_RET(((logicalAddr % FLASH_PAGE_SIZE) + size) <= FLASH_PAGE_SIZE, QLIB_STATUS__PARAMETER_OUT_OF_RANGE);
+
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Get write command                                                                                   */
+    /*-----------------------------------------------------------------------------------------------------*/
+    desc = QLIB_STD_GetCmdDesc_L(qlibContext, QLIB_STD_CMD_DESC__PROGRAM);
+
+#ifdef QLIB_SUPPORT_QPI
+
+    if ((Q2_BYPASS_HW_ISSUE_60(qlibContext) != 0u) && desc->format == QLIB_BUS_MODE_4_4_4 && desc->cmd == SPI_FLASH_CMD__PAGE_PROGRAM &&
+        size < BYPASS_MIN_WRITE_SIZE)
+    {
+        (void)memset(buffer, 0xFF, BYPASS_MIN_WRITE_SIZE);
+
+        if ((logicalAddr % FLASH_PAGE_SIZE) >= (BYPASS_MIN_WRITE_SIZE - size))
+        {
+            //read extra bytes b4 the beginning instead of the end
+            logicalAddr = logicalAddr - (BYPASS_MIN_WRITE_SIZE - size);
+            (void)memcpy(buffer + (BYPASS_MIN_WRITE_SIZE - size), input, size);
+        }
+        else
+        {
+            (void)memcpy(buffer, input, size);
+        }
+
+        input = buffer;
+        size  = BYPASS_MIN_WRITE_SIZE;
+    }
+#endif // QLIB_SUPPORT_QPI
+
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Perform write                                                                                       */
+    /*-----------------------------------------------------------------------------------------------------*/
+    QLIB_STATUS_RET_CHECK(QLIB_STD_execute_std_cmd_L(qlibContext,
+                                                     desc->format,
+                                                     (BOOL)desc->dtr,
+                                                     TRUE,
+                                                     blocking,
+                                                     desc->cmd,
+                                                     &logicalAddr,
+                                                     input,
+                                                     size,
+                                                     0,
+                                                     NULL,
+                                                     0,
+                                                     (TRUE == blocking) ? &QLIB_ACTIVE_DIE_STATE(qlibContext).ssr : NULL));
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Error checking                                                                                      */
+    /*-----------------------------------------------------------------------------------------------------*/
+    if (TRUE == blocking)
+    {
+        QLIB_STATUS_RET_CHECK(QLIB_CMD_PROC__checkLastSsrErrors(qlibContext, SSR_MASK__ALL_ERRORS));
+    }
+
+    return QLIB_STATUS__OK;
+}
+
 QLIB_STATUS_T QLIB_STD_PerformErase(QLIB_CONTEXT_T* qlibContext, QLIB_ERASE_T eraseType, U32 logicalAddr, BOOL blocking)
 {
     U8 cmd = 0;
@@ -466,7 +761,12 @@ QLIB_STATUS_T QLIB_STD_PerformErase(QLIB_CONTEXT_T* qlibContext, QLIB_ERASE_T er
                                                          0,
                                                          NULL,
                                                          0,
-                                                         &QLIB_ACTIVE_DIE_STATE(qlibContext).ssr));
+                                                         (TRUE == blocking) ? &QLIB_ACTIVE_DIE_STATE(qlibContext).ssr : NULL));
+        if (FALSE == blocking)
+        {
+            // status is checked by the caller once the erase is completed
+            return QLIB_STATUS__OK;
+        }
     }
 
     /*-----------------------------------------------------------------------------------------------------*/
@@ -506,21 +806,7 @@ QLIB_STATUS_T QLIB_STD_Erase(QLIB_CONTEXT_T* qlibContext, U32 logicalAddr, U32 s
     /*-----------------------------------------------------------------------------------------------------*/
     while (0u < size)
     {
-        if (_64KB_ <= size && 0u == (logicalAddr % _64KB_))
-        {
-            eraseSize = _64KB_;
-            eraseType = QLIB_ERASE_BLOCK_64K;
-        }
-        else if (_32KB_ <= size && 0u == (logicalAddr % _32KB_))
-        {
-            eraseSize = _32KB_;
-            eraseType = QLIB_ERASE_BLOCK_32K;
-        }
-        else
-        {
-            eraseSize = FLASH_SECTOR_SIZE;
-            eraseType = QLIB_ERASE_SECTOR_4K;
-        }
+        eraseSize = QLIB_COMMON_GetEraseStep(qlibContext, logicalAddr, size, &eraseType);
 
         /*-------------------------------------------------------------------------------------------------*/
         /* Start erase                                                                                     */
@@ -537,6 +823,32 @@ QLIB_STATUS_T QLIB_STD_Erase(QLIB_CONTEXT_T* qlibContext, U32 logicalAddr, U32 s
     return QLIB_STATUS__OK;
 }
 
+QLIB_STATUS_T QLIB_STD_IsBusy(QLIB_CONTEXT_T* qlibContext, BOOL* busy)
+{
+    U8 statusReg1 = 0;
+
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Read status register without waiting for the flash to be ready                                      */
+    /*-----------------------------------------------------------------------------------------------------*/
+    QLIB_STATUS_RET_CHECK(QLIB_STD_execute_std_cmd_L(qlibContext,
+                                                     QLIB_STD_GET_BUS_MODE(qlibContext),
+                                                     FALSE,
+                                                     FALSE,
+                                                     FALSE,
+                                                     SPI_FLASH_CMD__READ_STATUS_REGISTER_1,
+                                                     NULL,
+                                                     NULL,
+                                                     0,
+                                                     0,
+                                                     &statusReg1,
+                                                     1,
+                                                     NULL));
+
+    *busy = (READ_VAR_FIELD(statusReg1, SPI_FLASH__STATUS_1_FIELD__BUSY) == 1u) ? TRUE : FALSE;
+
+    return QLIB_STATUS__OK;
+}
+
 QLIB_STATUS_T QLIB_STD_EraseSuspend(QLIB_CONTEXT_T* qlibContext)
 {
     /*-----------------------------------------------------------------------------------------------------*/
@@ -911,6 +1223,41 @@ error:
 
     return ret;
 }
+
+QLIB_STATUS_T QLIB_STD_SwitchDie(QLIB_CONTEXT_T* qlibContext, U8 die)
+{
+    U32 dataOutSize;
+    U8  dataOut[2];
+
+    if (die == qlibContext->activeDie)
+    {
+        return QLIB_STATUS__OK;
+    }
+
+    QLIB_DATA_EXTENSION_SET_DATA_OUT(qlibContext, dataOut, die);
+    dataOutSize = QLIB_DATA_EXTENSION_SIZE(qlibContext);
+
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Die select is accepted while the dies are busy, do not wait for the selected die to be ready        */
+    /*-----------------------------------------------------------------------------------------------------*/
+    QLIB_STATUS_RET_CHECK(QLIB_STD_execute_std_cmd_L(qlibContext,
+                                                     QLIB_STD_GET_BUS_MODE(qlibContext),
+                                                     FALSE,
+                                                     FALSE,
+                                                     FALSE,
+                                                     SPI_FLASH_CMD__DIE_SELECT,
+                                                     NULL,
+                                                     dataOut,
+                                                     dataOutSize,
+                                                     0,
+                                                     NULL,
+                                                     0,
+                                                     NULL));
+
+    qlibContext->activeDie = die;
+
+    return QLIB_STATUS__OK;
+}
 #endif
 
 QLIB_STATUS_T QLIB_STD_SetAddressMode(QLIB_CONTEXT_T* qlibContext, QLIB_STD_ADDR_MODE_T addrMode)
@@ -1019,6 +1366,7 @@ QLIB_STATUS_T QLIB_STD_SetAddressMode(QLIB_CONTEXT_T* qlibContext, QLIB_STD_ADDR
     QLIB_ASSERT_WITH_ERROR_GOTO(testAddrMode == addrMode, QLIB_STATUS__COMMAND_IGNORED, ret, error);
 
     qlibContext->addrMode = addrMode;
+    QLIB_STD_UpdateCmdTable(qlibContext);
 
     return QLIB_STATUS__OK;
 error:
@@ -1183,6 +1531,7 @@ QLIB_STATUS_T QLIB_STD_SetFastReadDummyCycles(QLIB_CONTEXT_T* qlibContext, U8 du
     SET_VAR_FIELD_8(configReg, SPI_FLASH__EXTENDED_CONFIGURATION_1_FIELD__DUMMY, dummyCycles);
     QLIB_STATUS_RET_CHECK(QLIB_STD_set_CR_L(qlibContext, CONFIG_REG_ADDR__DUMMY, configReg));
     qlibContext->fastReadDummy = dummyCycles;
+    QLIB_STD_UpdateCmdTable(qlibContext);
     return QLIB_STATUS__OK;
 }
 
@@ -1385,89 +1734,33 @@ static QLIB_STATUS_T QLIB_STD_GetStatus_L(QLIB_CONTEXT_T* qlibContext, STD_FLASH
     return QLIB_STATUS__OK;
 }
 
+#ifndef QLIB_SUPPORT_XIP
 /************************************************************************************************************
- * @brief       This routine performs blocking / non-blocking page program
+ * @brief       This routine waits for a page program started without waiting, by polling the standard
+ *              status register which is the cheapest status read. Then the status of the program is checked
  *
  * @param       qlibContext   qlib context object
- * @param[in]   input         buffer of data to write
- * @param[in]   logicalAddr   logical flash address
- * @param[in]   size          data size to write (page-size bytes max)
- * @param[in]   blocking      if TRUE, this function is blocking till the program is finish
  *
- * @return      0 in no error occurred, or QLIB_STATUS__(ERROR) otherwise
+ * @return      0 if no error occurred, QLIB_STATUS__TIME_OUT if the program did not complete in its maximal
+ *              time, QLIB_STATUS__(ERROR) otherwise
 ************************************************************************************************************/
-static QLIB_STATUS_T QLIB_STD_PageProgram_L(QLIB_CONTEXT_T* qlibContext,
-                                            const U8*       input,
-                                            U32             logicalAddr,
-                                            U32             size,
-                                            BOOL            blocking)
+static QLIB_STATUS_T QLIB_STD_WaitWhileBusy_L(QLIB_CONTEXT_T* qlibContext)
 {
-    U8              writeCMD = 0;
-    QLIB_BUS_MODE_T format   = QLIB_BUS_MODE_INVALID;
-#ifdef QLIB_SUPPORT_QPI
-#define BYPASS_MIN_WRITE_SIZE 16u
-    U8 buffer[BYPASS_MIN_WRITE_SIZE];
-#endif // QLIB_SUPPORT_QPI
+    BOOL busy  = TRUE;
+    U32  polls = 0;
 
-    /*-----------------------------------------------------------------------------------------------------*/
-    /* Error checking                                                                                      */
-    /*-----------------------------------------------------------------------------------------------------*/
-    QLIB_ASSERT_RET(0u < size, QLIB_STATUS__PARAMETER_OUT_OF_RANGE);
-    QLIB_ASSERT_RET(size <= FLASH_PAGE_SIZE, QLIB_STATUS__INVALID_DATA_SIZE);
-    QLIB_ASSERT_RET(((logicalAddr % FLASH_PAGE_SIZE) + size) <= FLASH_PAGE_SIZE, QLIB_STATUS__PARAMETER_OUT_OF_RANGE);
-
-    /*-----------------------------------------------------------------------------------------------------*/
-    /* Get write command                                                                                   */
-    /*-----------------------------------------------------------------------------------------------------*/
-    writeCMD = QLIB_STD_GetWriteCMD_L(qlibContext, &format);
-    // TODO - make this calculation in Config time and store the command in the globals
-
-#ifdef QLIB_SUPPORT_QPI
-
-    if ((Q2_BYPASS_HW_ISSUE_60(qlibContext) != 0u) && format == QLIB_BUS_MODE_4_4_4 && writeCMD == SPI_FLASH_CMD__PAGE_PROGRAM &&
-        size < BYPASS_MIN_WRITE_SIZE)
+    do
     {
-        (void)memset(buffer, 0xFF, BYPASS_MIN_WRITE_SIZE);
-
-        if ((logicalAddr % FLASH_PAGE_SIZE) >= (BYPASS_MIN_WRITE_SIZE - size))
-        {
-            //read extra bytes b4 the beginning instead of the end
-            logicalAddr = logicalAddr - (BYPASS_MIN_WRITE_SIZE - size);
-            (void)memcpy(buffer + (BYPASS_MIN_WRITE_SIZE - size), input, size);
-        }
-        else
-        {
-            (void)memcpy(buffer, input, size);
-        }
+        QLIB_ASSERT_RET(polls < PAGE_PROGRAM_NUM_POLLS, QLIB_STATUS__TIME_OUT);
+        QLIB_STATUS_RET_CHECK(QLIB_STD_IsBusy(qlibContext, &busy));
+        polls++;
+    } while (TRUE == busy);
 
-        input = buffer;
-        size  = BYPASS_MIN_WRITE_SIZE;
-    }
-#endif // QLIB_SUPPORT_QPI
-
-    /*-----------------------------------------------------------------------------------------------------*/
-    /* Perform write                                                                                       */
-    /*-----------------------------------------------------------------------------------------------------*/
-    QLIB_STATUS_RET_CHECK(QLIB_STD_execute_std_cmd_L(qlibContext,
-                                                     format,
-                                                     FALSE,
-                                                     TRUE,
-                                                     blocking,
-                                                     writeCMD,
-                                                     &logicalAddr,
-                                                     input,
-                                                     size,
-                                                     0,
-                                                     NULL,
-                                                     0,
-                                                     &QLIB_ACTIVE_DIE_STATE(qlibContext).ssr));
-    /*-----------------------------------------------------------------------------------------------------*/
-    /* Error checking                                                                                      */
-    /*-----------------------------------------------------------------------------------------------------*/
-    QLIB_STATUS_RET_CHECK(QLIB_CMD_PROC__checkLastSsrErrors(qlibContext, SSR_MASK__ALL_ERRORS));
+    QLIB_STATUS_RET_CHECK(QLIB_CMD_PROC__get_SSR_UNSIGNED(qlibContext, NULL, SSR_MASK__ALL_ERRORS));
 
     return QLIB_STATUS__OK;
 }
+#endif // QLIB_SUPPORT_XIP
 
 #if defined QLIB_SUPPORT_QPI || defined QLIB_SUPPORT_OPI
 /************************************************************************************************************
@@ -1662,6 +1955,28 @@ static U8 QLIB_STD_GetWriteCMD_L(QLIB_CONTEXT_T* qlibContext, QLIB_BUS_MODE_T* f
     return cmd;
 }
 
+/************************************************************************************************************
+ * @brief       This routine returns a standard command descriptor. The table is rebuilt if the bus mode or
+ *              the dummy cycles were changed since it was built (e.g. by flash reset or state import)
+ *
+ * @param       qlibContext    internal context object
+ * @param[in]   id             Command descriptor ID
+ *
+ * @return      Command descriptor
+************************************************************************************************************/
+static const QLIB_STD_CMD_DESC_T* QLIB_STD_GetCmdDesc_L(QLIB_CONTEXT_T* qlibContext, QLIB_STD_CMD_DESC_ID_T id)
+{
+    const QLIB_STD_CMD_TABLE_T* table = &qlibContext->stdCmdTable;
+
+    if ((table->valid == 0u) || (table->busMode != qlibContext->busInterface.busMode) ||
+        (table->dtr != (U8)qlibContext->busInterface.dtr) || (table->fastReadDummy != qlibContext->fastReadDummy))
+    {
+        QLIB_STD_UpdateCmdTable(qlibContext);
+    }
+
+    return &table->desc[id];
+}
+
 static QLIB_STATUS_T QLIB_STD_SetStatus_L(QLIB_CONTEXT_T* qlibContext, STD_FLASH_STATUS_T statusIn, STD_FLASH_STATUS_T* statusOut)
 {
     /*-----------------------------------------------------------------------------------------------------*/
@@ -1893,7 +2208,7 @@ static QLIB_STATUS_T QLIB_STD_CheckWritePrivilege_L(QLIB_CONTEXT_T* qlibContext,
     /*-----------------------------------------------------------------------------------------------------*/
     /* Check ACLR write lock                                                                               */
     /*-----------------------------------------------------------------------------------------------------*/
-    QLIB_STATUS_RET_CHECK(QLIB_CMD_PROC__get_ACLR(qlibContext, &aclr));
+    QLIB_STATUS_RET_CHECK(QLIB_SEC_GetACLR(qlibContext, &aclr));
     sectionWriteLock = (U32)READ_VAR_BIT(READ_VAR_FIELD(aclr, QLIB_REG_ACLR__WR_LOCK), sectionID);
     QLIB_ASSERT_RET(sectionWriteLock != 1u, QLIB_STATUS__DEVICE_PRIVILEGE_ERR);
 
@@ -2149,6 +2464,19 @@ static QLIB_STATUS_T QLIB_STD_PrepareForResetFlash_L(QLIB_CONTEXT_T* qlibContext
             else
             {
                 STD_FLASH_STATUS_T status;
+                QLIB_STATUS_T      waitRet;
+                // let the transaction layer wait for erase/program to end, the loop below also checks suspend
+                // and keeps polling if the transaction layer does not support it or reached the polls limit
+                waitRet = QLIB_TM_WaitReady(qlibContext,
+                                            QLIB_TM_WAIT_READY__SR1,
+                                            MASK_FIELD(SPI_FLASH__STATUS_1_FIELD__BUSY),
+                                            QLIB_TM_WAIT_READY_NUM_POLLS,
+                                            NULL,
+                                            NULL);
+                if ((QLIB_STATUS__NOT_SUPPORTED != waitRet) && (QLIB_STATUS__TIME_OUT != waitRet))
+                {
+                    QLIB_STATUS_RET_CHECK_GOTO(waitRet, ret, error);
+                }
                 do
                 {
                     QLIB_STATUS_RET_CHECK(QLIB_STD_GetStatus_L(qlibContext, &status));
@@ -92,6 +92,26 @@ QLIB_STATUS_T QLIB_STD_WaitTillFlashIsReady(QLIB_CONTEXT_T* qlibContext, QLIB_BU
 ************************************************************************************************************/
 QLIB_STATUS_T QLIB_STD_SetInterface(QLIB_CONTEXT_T* qlibContext, QLIB_BUS_FORMAT_T busFormat);
 
+/************************************************************************************************************
+ * @brief       This routine builds the standard command descriptor table for the current bus mode, DTR mode
+ *              and fast read dummy cycles. Read and page program use the table instead of calculating the
+ *              command on every call
+ *
+ * @param       qlibContext   qlib context object
+************************************************************************************************************/
+void QLIB_STD_UpdateCmdTable(QLIB_CONTEXT_T* qlibContext);
+
+/************************************************************************************************************
+ * @brief       This routine estimates the number of bus cycles of a standard read with the current
+ *              bus interface configuration. Used to compare read configurations
+ *
+ * @param       qlibContext   qlib context object
+ * @param[in]   size          Read size in bytes
+ *
+ * @return      Estimated number of bus cycles
+************************************************************************************************************/
+U32 QLIB_STD_GetReadCycles(QLIB_CONTEXT_T* qlibContext, U32 size);
+
 /************************************************************************************************************
  * @brief           This function sets non-volatile QE (QuadEnable) bit value
  *
@@ -134,6 +154,30 @@ QLIB_STATUS_T QLIB_STD_SetResetInEnable(QLIB_CONTEXT_T* qlibContext, BOOL enable
 ************************************************************************************************************/
 QLIB_STATUS_T QLIB_STD_Read(QLIB_CONTEXT_T* qlibContext, U8* output, U32 logicalAddr, U32 size);
 
+/************************************************************************************************************
+ * @brief       This routine performs legacy Flash read as a stream of chunks. The chunks are read
+ *              alternately into the two halves of @p buf and passed to @p consumer. If
+ *              QLIB_SPI_ASYNC_READ_ENABLED is defined, the next chunk is read while @p consumer processes
+ *              the current one
+ *
+ * @param       qlibContext   qlib context object
+ * @param[in]   logicalAddr   logical flash address
+ * @param[in]   size          Number of bytes to read from Flash
+ * @param[out]  buf           Chunk buffer, 2 * @p chunkSize bytes
+ * @param[in]   chunkSize     Chunk size
+ * @param[in]   consumer      Called for every chunk in order
+ * @param[in]   arg           @p consumer argument
+ *
+ * @return      0 in no error occurred, or QLIB_STATUS__(ERROR) otherwise
+************************************************************************************************************/
+QLIB_STATUS_T QLIB_STD_ReadStream(QLIB_CONTEXT_T*        qlibContext,
+                                  U32                    logicalAddr,
+                                  U32                    size,
+                                  U8*                    buf,
+                                  U32                    chunkSize,
+                                  QLIB_READ_CHUNK_FUNC_T consumer,
+                                  void*                  arg);
+
 /************************************************************************************************************
  * @brief       This routine performs STD Flash write command
  *
@@ -146,6 +190,19 @@ QLIB_STATUS_T QLIB_STD_Read(QLIB_CONTEXT_T* qlibContext, U8* output, U32 logical
 ************************************************************************************************************/
 QLIB_STATUS_T QLIB_STD_Write(QLIB_CONTEXT_T* qlibContext, const U8* input, U32 logicalAddr, U32 size);
 
+/************************************************************************************************************
+ * @brief       This routine performs blocking / non-blocking page program
+ *
+ * @param       qlibContext   qlib context object
+ * @param[in]   input         buffer of data to write
+ * @param[in]   logicalAddr   logical flash address
+ * @param[in]   size          data size to write (page-size bytes max)
+ * @param[in]   blocking      if TRUE, this function is blocking till the program is finish
+ *
+ * @return      0 in no error occurred, or QLIB_STATUS__(ERROR) otherwise
+************************************************************************************************************/
+QLIB_STATUS_T QLIB_STD_PageProgram(QLIB_CONTEXT_T* qlibContext, const U8* input, U32 logicalAddr, U32 size, BOOL blocking);
+
 /************************************************************************************************************
  * @brief       This routine performs blocking / non-blocking Flash erase (sector/block/chip)
  *
@@ -169,6 +226,16 @@ QLIB_STATUS_T QLIB_STD_PerformErase(QLIB_CONTEXT_T* qlibContext, QLIB_ERASE_T er
 ************************************************************************************************************/
 QLIB_STATUS_T QLIB_STD_Erase(QLIB_CONTEXT_T* qlibContext, U32 logicalAddr, U32 size);
 
+/************************************************************************************************************
+ * @brief       This routine checks if the flash is busy with an erase or write operation, without waiting
+ *
+ * @param       qlibContext   qlib context object
+ * @param[out]  busy          TRUE if an erase or write operation is in progress
+ *
+ * @return      0 if no error occurred, QLIB_STATUS__(ERROR) otherwise
+************************************************************************************************************/
+QLIB_STATUS_T QLIB_STD_IsBusy(QLIB_CONTEXT_T* qlibContext, BOOL* busy);
+
 /************************************************************************************************************
  * @brief       This routine suspends the on-going erase operation
  *
@@ -241,6 +308,17 @@ QLIB_STATUS_T QLIB_STD_GetId(QLIB_CONTEXT_T* qlibContext, QLIB_STD_ID_T* id_p);
  * @return      QLIB_STATUS__OK on success or QLIB_STATUS__[ERROR] otherwise
 ************************************************************************************************************/
 QLIB_STATUS_T QLIB_STD_SetActiveDie(QLIB_CONTEXT_T* qlibContext, U8 die, BOOL clearErrors);
+
+/************************************************************************************************************
+ * @brief       This function sets flash active die without waiting for the die to be ready. The die ID is
+ *              not verified since the die may be busy with a program or erase operation
+ *
+ * @param       qlibContext     QLIB state object
+ * @param       die             Flash die number to set
+ *
+ * @return      QLIB_STATUS__OK on success or QLIB_STATUS__[ERROR] otherwise
+************************************************************************************************************/
+QLIB_STATUS_T QLIB_STD_SwitchDie(QLIB_CONTEXT_T* qlibContext, U8 die);
 #endif
 
 /************************************************************************************************************
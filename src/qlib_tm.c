@@ -295,6 +295,122 @@ error:
     return ret;
 }
 
+#ifdef QLIB_SPI_ASYNC_READ_ENABLED
+QLIB_STATUS_T QLIB_TM_StandardReadAsync(QLIB_CONTEXT_T*   qlibContext,
+                                        QLIB_BUS_FORMAT_T busFormat,
+                                        U8                cmd,
+                                        const U32*        address,
+                                        const U8*         writeData,
+                                        U32               writeDataSize,
+                                        U32               dummyCycles,
+                                        U8*               readData,
+                                        U32               readDataSize)
+{
+    QLIB_STATUS_T   ret             = QLIB_STATUS__OK;
+    U32             addr            = *address;
+    U32             addrSize        = 0;
+    QLIB_BUS_MODE_T mode            = QLIB_BUS_FORMAT_GET_MODE(busFormat);
+    U32             dtr             = QLIB_DTR_TO_DTR_FLAGS(qlibContext, mode, QLIB_BUS_FORMAT_GET_DTR(busFormat));
+    U8              addressMsb      = (U8)((addr >> 24) & 0xFFu);
+    BOOL            setExtendedAddr = FALSE;
+    U32             cmdSize         = QLIB_CMD_EXTENSION_SIZE(qlibContext);
+    U8              cmdBuf[2u + 4u + 1u]; // command + address + mode
+    INTERRUPTS_VAR_DECLARE(ints);
+
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Error checking                                                                                      */
+    /*-----------------------------------------------------------------------------------------------------*/
+    if (FALSE == qlibContext->busInterface.busIsLocked)
+    {
+        return QLIB_STATUS__NOT_CONNECTED;
+    }
+    QLIB_ASSERT_RET(writeDataSize <= 1u, QLIB_STATUS__INVALID_DATA_SIZE);
+
+    QLIB_TM_GetAddressParams_L(qlibContext, cmd, addressMsb, &addrSize, &setExtendedAddr);
+
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Start atomic transaction, the extended address stays set until the read is completed                */
+    /*-----------------------------------------------------------------------------------------------------*/
+    INTERRUPTS_SAVE_DISABLE(ints);
+
+    if (setExtendedAddr == TRUE)
+    {
+        QLIB_STATUS_RET_CHECK_GOTO(QLIB_TM_SetExtendedAddress_L(qlibContext, addressMsb), ret, error);
+    }
+
+    QLIB_DATA_EXTENSION_SET_CMD_BUFFER(qlibContext, cmdBuf, cmd);
+    cmdBuf[cmdSize]      = BYTE(addr, addrSize - 1u);
+    cmdBuf[cmdSize + 1u] = BYTE(addr, addrSize - 2u);
+    cmdBuf[cmdSize + 2u] = BYTE(addr, addrSize - 3u);
+    if (addrSize == 4u)
+    {
+        cmdBuf[cmdSize + 3u] = BYTE(addr, 0);
+    }
+    if (writeDataSize > 0u)
+    {
+        cmdBuf[cmdSize + addrSize] = writeData[0];
+    }
+
+    QLIB_ASSERT_WITH_ERROR_GOTO((PLAT_SPI_ReadAsync(qlibContext->userData,
+                                                    mode,
+                                                    dtr,
+                                                    cmdBuf,
+                                                    cmdSize,
+                                                    addrSize,
+                                                    writeDataSize,
+                                                    dummyCycles,
+                                                    readData,
+                                                    readDataSize) == 0),
+                                QLIB_STATUS__HARDWARE_FAILURE,
+                                ret,
+                                error);
+
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* End atomic transaction                                                                              */
+    /*-----------------------------------------------------------------------------------------------------*/
+    INTERRUPTS_RESTORE(ints);
+
+    return QLIB_STATUS__OK;
+
+error:
+#ifndef QLIB_NO_DIRECT_FLASH_ACCESS
+    if (qlibContext->extendedAddr != (U8)QLIB_EXTENDED_ADDRESS_INIT_VAL)
+    {
+        (void)QLIB_TM_SetExtendedAddress_L(qlibContext, QLIB_EXTENDED_ADDRESS_INIT_VAL);
+    }
+#endif
+
+    INTERRUPTS_RESTORE(ints);
+
+    return ret;
+}
+
+QLIB_STATUS_T QLIB_TM_StandardReadAsyncWait(QLIB_CONTEXT_T* qlibContext)
+{
+    QLIB_STATUS_T ret = QLIB_STATUS__OK;
+    INTERRUPTS_VAR_DECLARE(ints);
+
+    if (PLAT_SPI_ReadAsync_WaitWhileBusy(qlibContext->userData) != 0)
+    {
+        ret = QLIB_STATUS__HARDWARE_FAILURE;
+    }
+
+#ifndef QLIB_NO_DIRECT_FLASH_ACCESS
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Restore extended address                                                                            */
+    /*-----------------------------------------------------------------------------------------------------*/
+    if ((QLIB_STATUS__OK == ret) && (qlibContext->extendedAddr != (U8)QLIB_EXTENDED_ADDRESS_INIT_VAL))
+    {
+        INTERRUPTS_SAVE_DISABLE(ints);
+        ret = QLIB_TM_SetExtendedAddress_L(qlibContext, QLIB_EXTENDED_ADDRESS_INIT_VAL);
+        INTERRUPTS_RESTORE(ints);
+    }
+#endif
+
+    return ret;
+}
+#endif // QLIB_SPI_ASYNC_READ_ENABLED
+
 QLIB_STATUS_T QLIB_TM_Secure(QLIB_CONTEXT_T* qlibContext,
                              U32             ctag,
                              const U32*      writeData,
@@ -573,6 +689,90 @@ exit:
     return ret;
 }
 
+QLIB_STATUS_T QLIB_TM_WaitReady(QLIB_CONTEXT_T*      qlibContext,
+                                QLIB_TM_WAIT_READY_T source,
+                                U32                  busyMask,
+                                U32                  maxPolls,
+                                U32*                 regValue,
+                                QLIB_REG_SSR_T*      ssr)
+{
+    QLIB_STATUS_T  ret      = QLIB_STATUS__OK;
+    QLIB_REG_SSR_T ssrLocal = {0};
+    U32            value    = 0;
+    U32            polls    = 0;
+    U8             sr1      = 0;
+
+    INTERRUPTS_VAR_DECLARE(ints);
+
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Error checking                                                                                      */
+    /*-----------------------------------------------------------------------------------------------------*/
+    if (FALSE == qlibContext->busInterface.busIsLocked)
+    {
+        return QLIB_STATUS__NOT_CONNECTED;
+    }
+    QLIB_ASSERT_RET(0u < maxPolls, QLIB_STATUS__INVALID_PARAMETER);
+
+#ifdef QLIB_SUPPORT_QPI
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* OP0 doesn't support QPI, the caller should use the secure command flow that exits QPI               */
+    /*-----------------------------------------------------------------------------------------------------*/
+    if ((QLIB_TM_WAIT_READY__SSR == source) && (QLIB_BUS_MODE_4_4_4 == qlibContext->busInterface.secureCmdsFormat) &&
+        ((Q2_BYPASS_HW_ISSUE_23(qlibContext) != 0u) || Q2_SEC_INST_SUPPORTED_IN_QPI(qlibContext->detectedDeviceID) == FALSE))
+    {
+        return QLIB_STATUS__NOT_SUPPORTED;
+    }
+#endif // QLIB_SUPPORT_QPI
+
+    /*-----------------------------------------------------------------------------------------------------*/
+    /* Poll till busy bits are cleared or polls limit is reached. Each poll is a separate atomic           */
+    /* transaction, so interrupts are served between polls                                                 */
+    /*-----------------------------------------------------------------------------------------------------*/
+    do
+    {
+        INTERRUPTS_SAVE_DISABLE(ints);
+        PLATFORM_XIP_DISABLE();
+
+        if (QLIB_TM_WAIT_READY__SR1 == source)
+        {
+            ret   = QLIB_TM_GetSR1_L(qlibContext, &sr1);
+            value = (U32)sr1;
+        }
+        else
+        {
+            ret   = QLIB_TM__OP0_get_ssr_L(qlibContext, &ssrLocal);
+            value = ssrLocal.asUint;
+        }
+
+        PLATFORM_XIP_ENABLE();
+        INTERRUPTS_RESTORE(ints);
+
+        QLIB_STATUS_RET_CHECK(ret);
+        if (QLIB_TM_WAIT_READY__SSR == source)
+        {
+            QLIB_ASSERT_RET((ssrLocal.asUint != MAX_U32) && (ssrLocal.asUint != 0u), QLIB_STATUS__CONNECTIVITY_ERR);
+        }
+        polls++;
+    } while (((value & busyMask) != 0u) && (polls < maxPolls));
+
+    if ((value & busyMask) != 0u)
+    {
+        ret = QLIB_STATUS__TIME_OUT;
+    }
+
+    if (regValue != NULL)
+    {
+        *regValue = value;
+    }
+
+    if (ssr != NULL)
+    {
+        ssr->asUint = ssrLocal.asUint;
+    }
+
+    return ret;
+}
+
 /*---------------------------------------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------------------------------------*/
 /*                                             LOCAL FUNCTIONS                                             */
@@ -32,6 +32,23 @@ extern "C" {
 #define QLIB_TM_CTAG_SCR_NEED_RESET_MASK    (0x01000000u)
 #define QLIB_TM_CTAG_SCR_NEED_GRANT_PA_MASK (0x02000000u)
 
+// Polls limit of QLIB_TM_WaitReady for callers that fall back to their own polling loop on time out
+#define QLIB_TM_WAIT_READY_NUM_POLLS (0x10000u)
+
+/*---------------------------------------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------------------------------------*/
+/*                                                  TYPES                                                  */
+/*---------------------------------------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------------------------------------*/
+/* Register polled by @ref QLIB_TM_WaitReady                                                               */
+/*---------------------------------------------------------------------------------------------------------*/
+typedef enum
+{
+    QLIB_TM_WAIT_READY__SSR = 0, // Secure Status Register, read with OP0
+    QLIB_TM_WAIT_READY__SR1 = 1, // Standard Status Register-1
+} QLIB_TM_WAIT_READY_T;
+
 /*---------------------------------------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------------------------------------*/
 /*                                           INTERFACE FUNCTIONS                                           */
@@ -97,6 +114,44 @@ QLIB_STATUS_T QLIB_TM_Standard(QLIB_CONTEXT_T*   qlibContext,
                                U32               readDataSize,
                                QLIB_REG_SSR_T*   ssr) __RAM_SECTION;
 
+#ifdef QLIB_SPI_ASYNC_READ_ENABLED
+/************************************************************************************************************
+ * @brief       This function starts a standard Flash read command without waiting for the data.
+ *              The extended address register stays set until @ref QLIB_TM_StandardReadAsyncWait, so
+ *              direct flash access is not allowed in between. Not supported with QLIB_SUPPORT_XIP
+ *
+ * @param[in]   qlibContext       pointer to qlib context
+ * @param[in]   busFormat         SPI transaction format, consists of bus mode and dtr
+ * @param[in]   cmd               Command value
+ * @param[in]   address           Pointer to address value
+ * @param[in]   writeData         Pointer to output data (mode byte) or NULL if no output data available
+ * @param[in]   writeDataSize     Size of the output data
+ * @param[in]   dummyCycles       Delay Cycles between output and input command phases
+ * @param[out]  readData          Pointer to input data, valid after @ref QLIB_TM_StandardReadAsyncWait
+ * @param[in]   readDataSize      Size of the input data
+ *
+ * @return      0 if no error occurred, QLIB_STATUS__(ERROR) otherwise
+************************************************************************************************************/
+QLIB_STATUS_T QLIB_TM_StandardReadAsync(QLIB_CONTEXT_T*   qlibContext,
+                                        QLIB_BUS_FORMAT_T busFormat,
+                                        U8                cmd,
+                                        const U32*        address,
+                                        const U8*         writeData,
+                                        U32               writeDataSize,
+                                        U32               dummyCycles,
+                                        U8*               readData,
+                                        U32               readDataSize) __RAM_SECTION;
+
+/************************************************************************************************************
+ * @brief       This function waits for the read started by @ref QLIB_TM_StandardReadAsync to complete
+ *
+ * @param[in]   qlibContext       pointer to qlib context
+ *
+ * @return      0 if no error occurred, QLIB_STATUS__(ERROR) otherwise
+************************************************************************************************************/
+QLIB_STATUS_T QLIB_TM_StandardReadAsyncWait(QLIB_CONTEXT_T* qlibContext) __RAM_SECTION;
+#endif // QLIB_SPI_ASYNC_READ_ENABLED
+
 /************************************************************************************************************
  * @brief       This function performs a secure command flow
  *              This function verifies that session is open before sending the command
@@ -119,6 +174,33 @@ QLIB_STATUS_T QLIB_TM_Secure(QLIB_CONTEXT_T* qlibContext,
                              U32             readDataSize,
                              QLIB_REG_SSR_T* ssr) __RAM_SECTION;
 
+/************************************************************************************************************
+ * @brief       This function polls a flash status register till all the bits of busyMask are cleared.
+ *              When the transaction layer is remote, the polling is performed by the remote side and
+ *              costs a single round trip. Each poll is a separate atomic transaction, so interrupts are
+ *              served between polls
+ *
+ * @param[in]   qlibContext     pointer to qlib context
+ * @param[in]   source          register to poll
+ * @param[in]   busyMask        bits of the register that must be cleared
+ * @param[in]   maxPolls        maximal number of polls, must be greater than 0
+ * @param[out]  regValue        Last value of the polled register (can be NULL)
+ * @param[out]  ssr             Last SSR value, valid only if source is QLIB_TM_WAIT_READY__SSR (can be NULL)
+ *
+ * @return
+ * QLIB_STATUS__OK                 - busyMask bits are cleared\n
+ * QLIB_STATUS__TIME_OUT           - busyMask bits are still set after maxPolls polls\n
+ * QLIB_STATUS__INVALID_PARAMETER  - maxPolls is 0\n
+ * QLIB_STATUS__NOT_SUPPORTED      - the transaction layer does not support this function\n
+ * QLIB_STATUS__(ERROR)            - other error
+************************************************************************************************************/
+QLIB_STATUS_T QLIB_TM_WaitReady(QLIB_CONTEXT_T*      qlibContext,
+                                QLIB_TM_WAIT_READY_T source,
+                                U32                  busyMask,
+                                U32                  maxPolls,
+                                U32*                 regValue,
+                                QLIB_REG_SSR_T*      ssr) __RAM_SECTION;
+
 #ifdef __cplusplus
 }
 #endif